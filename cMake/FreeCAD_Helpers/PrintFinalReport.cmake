@@ -78,6 +78,7 @@ macro(PrintFinalReport)
     value(CMAKE_CXX_FLAGS)
     value(CMAKE_BUILD_TYPE)
     value(ENABLE_DEVELOPER_TESTS)
+    value(ENABLE_DEVELOPER_BENCHMARKS)
     value(FREECAD_USE_FREETYPE)
     value(FREECAD_USE_EXTERNAL_SMESH)
     value(FREECAD_USE_SANITIZER_ASAN)
@@ -228,6 +229,9 @@ macro(PrintFinalReport)
     conditional(PYCXX PYCXX_FOUND "not found" "${PYCXX_VERSION} Incl: ${PYCXX_INCLUDE_DIRS} Src:${PYCXX_SOURCE_DIR}")
     conditional(fmt fmt_FOUND "Sources downloaded to ${fmt_SOURCE_DIR}" "${fmt_VERSION}")
     conditional(GTest ENABLE_DEVELOPER_TESTS "not found" ${GTest_VERSION})
+    if(ENABLE_DEVELOPER_BENCHMARKS)
+        conditional(benchmark benchmark_FOUND "not found" ${benchmark_VERSION})
+    endif()
     conditional(yaml-cpp yaml-cpp_FOUND "not found" "${yaml-cpp_VERSION}")
     conditional(Vtk VTK_FOUND "not found" ${VTK_VERSION})
     if(BUILD_BIM)
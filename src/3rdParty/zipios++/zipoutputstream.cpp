@@ -63,6 +63,12 @@ void ZipOutputStream::putNextEntry(const std::string& entryName) {
   putNextEntry( ZipCDirEntry(entryName));
 }
 
+void ZipOutputStream::putRawEntry( const std::string &entryName, StorageMethod method,
+                                   const char *data, uint32 compressed_size,
+                                   uint32 size, uint32 crc ) {
+  ozf->putRawEntry( ZipCDirEntry( entryName ), method, data, compressed_size, size, crc ) ;
+}
+
 
 void ZipOutputStream::setComment( const std::string &comment ) {
   ozf->setComment( comment ) ;
@@ -54,6 +54,12 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Writes a complete entry whose data has already been compressed,
+      see ZipOutputStreambuf::putRawEntry(). */
+  void putRawEntry( const std::string &entryName, StorageMethod method,
+                    const char *data, uint32 compressed_size,
+                    uint32 size, uint32 crc ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 
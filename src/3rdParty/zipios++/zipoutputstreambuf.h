@@ -49,6 +49,19 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes a complete entry whose data has already been compressed.
+      The data must be raw deflate data if method is DEFLATED, or the
+      uncompressed data if method is STORED.
+      @param entry the entry to write.
+      @param method the method the data was compressed with.
+      @param data the compressed data.
+      @param compressed_size the number of bytes in data.
+      @param size the uncompressed size.
+      @param crc the crc32 of the uncompressed data. */
+  void putRawEntry( const ZipCDirEntry &entry, StorageMethod method,
+                    const char *data, uint32 compressed_size,
+                    uint32 size, uint32 crc ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
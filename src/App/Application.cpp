@@ -836,6 +836,15 @@ bool Application::isFineGrainedRecomputeEnabled()
     return enableFineGrainedRecompute;
 }
 
+bool Application::isParallelRecomputeEnabled()
+{
+    static const ParameterGrp::handle hGrp = GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document"
+    );
+    bool enableParallelRecompute = hGrp->GetBool("EnableParallelRecompute", false);
+    return enableParallelRecompute;
+}
+
 bool Application::canRecomputeRequestOnWorker(const RecomputeRequest& req) const
 {
     if (DocumentObject* documentObject = req.resolveDocumentObject()) {
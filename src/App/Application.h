@@ -394,6 +394,8 @@ public:
     // Returns if document and object recomputes should be done async.
     bool isAsyncRecomputeEnabled();
     bool isFineGrainedRecomputeEnabled();
+    // Returns if independent objects may be recomputed concurrently.
+    bool isParallelRecomputeEnabled();
     bool canRecomputeRequestOnWorker(const RecomputeRequest& req) const;
 
     // Adds a recompute request to the processing queue.
@@ -23,12 +23,15 @@
  ***************************************************************************/
 
 #include <bitset>
+#include <condition_variable>
+#include <cstring>
 #include <stack>
 #include <deque>
 #include <iostream>
 #include <utility>
 #include <set>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <string>
 #include <map>
@@ -68,6 +71,7 @@
 #include <Base/Uuid.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/ThreadPool.h>
 #include <Base/UnitsApi.h>
 
 #include "Document.h"
@@ -75,6 +79,7 @@
 #include "Application.h"
 #include "AutoTransaction.h"
 #include "BackupPolicy.h"
+#include "DocumentSettings.h"
 #include "ExpressionParser.h"
 #include "GeoFeature.h"
 #include "License.h"
@@ -116,6 +121,9 @@ bool transactionStateBlocksRecoveryWrite(const DocumentP& documentPrivate)
         || documentPrivate.activeUndoTransaction != nullptr || documentPrivate.committing;
 }
 
+// Set on pool threads while they recompute an object, see Document::lockConcurrentChange()
+thread_local bool concurrentRecomputeThread = false;
+
 }  // namespace
 
 namespace App
@@ -1937,6 +1945,8 @@ bool Document::save()
 
 bool Document::saveToFile(const char* filename) const
 {
+    ZoneScoped;
+    ZoneText(filename, std::strlen(filename));
     signalStartSave(*this, filename);
 
     auto hGrp = GetApplication().GetParameterGroupByPath(
@@ -2009,6 +2019,10 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        // Serialize and compress shapes, meshes etc. on all cores
+        if (hGrp->GetBool("EnableParallelSave", false)) {
+            writer.setThreads(0);
+        }
         writer.putNextEntry("Document.xml");
 
         if (hGrp->GetBool("SaveBinaryBrep", false)) {
@@ -2114,6 +2128,7 @@ void Document::restore(const char* filename,
                        bool delaySignal,
                        const std::vector<std::string>& objNames)
 {
+    ZoneScoped;
     clearUndos();
     d->activeObject = nullptr;
 
@@ -2147,6 +2162,7 @@ void Document::restore(const char* filename,
     if (!filename) {
         filename = FileName.getValue();
     }
+    ZoneText(filename, std::strlen(filename));
     Base::FileInfo fi(filename);
     Base::ifstream file(fi, std::ios::in | std::ios::binary);
     std::streambuf* buf = file.rdbuf();
@@ -2163,6 +2179,13 @@ void Document::restore(const char* filename,
         throw Base::FileException("Error reading compression file", filename);
     }
 
+    // Parse shapes, meshes etc. on all cores
+    auto hGrp = GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    if (hGrp->GetBool("EnableParallelRestore", false)) {
+        reader.setThreads(0);
+    }
+
     GetApplication().signalStartRestoreDocument(*this);
     setStatus(Document::Restoring, true);
 
@@ -2866,8 +2889,10 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
 
     // delete recompute log
     d->clearRecomputeLog();
+    d->recomputeProfile.clear();
 
     Base::TimeTracker tracker("Document::recompute");
+    Base::TimeElapsed recomputeStart;
     std::optional<Base::ObjectStatusLocker<Document::Status, Document>> recomputingStatus;
     recomputingStatus.emplace(Document::Recomputing, this);
 
@@ -2906,6 +2931,19 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
         GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute", true);
 
+    std::size_t threads = 1;
+    if (GetApplication().isParallelRecomputeEnabled()) {
+        int limit = getRecomputeThreadLimit();
+        threads = limit > 0 ? std::size_t(limit) : Base::ThreadPool::hardwareConcurrency();
+        threads = std::min(threads, topoSortedObjects.size());
+        // Pool threads deliver the document signals to the GUI thread and wait for it, so the
+        // GUI thread itself must not wait for the pool threads.
+        if (App::MainThreadSignalConfig::hasHooks()
+            && App::MainThreadSignalConfig::isMainThread()) {
+            threads = 1;
+        }
+    }
+
     tracker.checkpoint("pre-recompute & topo sort");
 
     try {
@@ -2918,7 +2956,44 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                 seq = std::make_unique<Base::SequencerLauncher>("Recompute...",
                                                                 topoSortedObjects.size());
             }
+            auto postRecompute = [&](DocumentObject* obj, bool doRecompute) {
+                if (obj->isTouched() || doRecompute) {
+                    signalRecomputedObject(*obj);
+                    if (fineGrained) {
+                        // set all dependent objects touched based on properties
+                        std::vector<DepEdge> inList = obj->getInListProp();
+                        for (auto& [objFrom, propFrom, objTo, propTo] : inList) {
+                            if (obj->touchedProps.contains(propTo) || propTo.empty()) {
+                                objFrom->enforceRecompute(propFrom);
+                            }
+                        }
+                        obj->purgeTouched();
+                    }
+                    else {
+                        obj->purgeTouched();
+                        // set all dependent objects touched to force recompute
+                        for (auto inObjIt : obj->getInList()) {
+                            inObjIt->enforceRecompute();
+                        }
+                    }
+                }
+                if (seq) {
+                    seq->next(true);
+                }
+            };
             FC_LOG("Recompute pass " << passes);
+            if (passes == 0 && threads > 1) {
+                int res = _recomputeConcurrently(topoSortedObjects,
+                                                 filter,
+                                                 postRecompute,
+                                                 threads,
+                                                 objectCount,
+                                                 hasError);
+                if (res < 0) {
+                    passes = 2;
+                }
+                idx = topoSortedObjects.size();
+            }
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()) {
@@ -2945,29 +3020,7 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                         continue;
                     }
                 }
-                if (obj->isTouched() || doRecompute) {
-                    signalRecomputedObject(*obj);
-                    if (fineGrained) {
-                        // set all dependent objects touched based on properties
-                        std::vector<DepEdge> inList = obj->getInListProp();
-                        for (auto& [objFrom, propFrom, objTo, propTo] : inList) {
-                            if (obj->touchedProps.contains(propTo) || propTo.empty()) {
-                                objFrom->enforceRecompute(propFrom);
-                            }
-                        }
-                        obj->purgeTouched();
-                    }
-                    else {
-                        obj->purgeTouched();
-                        // set all dependent objects touched to force recompute
-                        for (auto inObjIt : obj->getInList()) {
-                            inObjIt->enforceRecompute();
-                        }
-                    }
-                }
-                if (seq) {
-                    seq->next(true);
-                }
+                postRecompute(obj, doRecompute);
             }
             // check if all objects are recomputed but still thouched
             for (size_t i = 0; i < topoSortedObjects.size(); ++i) {
@@ -3014,6 +3067,8 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     signalBecameStable(*this);
 
     tracker.checkpoint("Recompute total");
+    TracyPlot("Recomputed objects", static_cast<int64_t>(objectCount));
+    d->recomputeProfile.setWallTime(Base::TimeElapsed::diffTimeF(recomputeStart));
 
     if (!d->_RecomputeLog.empty()) {
         if (!testStatus(Status::IgnoreErrorOnRecompute)) {
@@ -3233,13 +3288,21 @@ const char* Document::getErrorDescription(const DocumentObject* Obj) const
 // call the recompute of the Feature and handle the exceptions and errors.
 int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
 {
+    ZoneScoped;
+    ZoneText(Feat->getNameInDocument(), std::strlen(Feat->getNameInDocument()));
     FC_LOG("Recomputing " << Feat->getFullName());
+    RecomputeProfile::ObjectScope profile(d->recomputeProfile, Feat);
 
     DocumentObjectExecReturn* returnCode = nullptr;
     try {
         returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
         if (returnCode == DocumentObject::StdReturn) {
+            ZoneNamedN(executeZone, "execute", true);
+            ZoneTextV(executeZone, Feat->getTypeId().getName(),
+                      std::strlen(Feat->getTypeId().getName()));
+            profile.beginExecute();
             returnCode = Feat->recompute();
+            profile.endExecute();
             if (returnCode == DocumentObject::StdReturn) {
                 returnCode =
                     Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
@@ -3288,6 +3351,224 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
     return 0;
 }
 
+int Document::_recomputeConcurrently(const std::vector<DocumentObject*>& objs,
+                                     std::set<DocumentObject*>& filter,
+                                     const std::function<void(DocumentObject*, bool)>& postRecompute,
+                                     std::size_t threads,
+                                     int& objectCount,
+                                     bool* hasError)
+{
+    const std::size_t count = objs.size();
+    std::unordered_map<DocumentObject*, std::size_t> indices;
+    indices.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        indices.emplace(objs[i], i);
+    }
+
+    // number of unfinished dependencies and the dependents of each object
+    std::vector<std::size_t> waiting(count, 0);
+    std::vector<std::vector<std::size_t>> dependents(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto outList = objs[i]->getOutList();
+        std::sort(outList.begin(), outList.end());
+        outList.erase(std::unique(outList.begin(), outList.end()), outList.end());
+        for (auto dep : outList) {
+            auto it = indices.find(dep);
+            if (it != indices.end() && it->second != i) {
+                ++waiting[i];
+                dependents[it->second].push_back(i);
+            }
+        }
+    }
+
+    // ordered by topological index so that serial objects keep their order
+    std::set<std::size_t> ready;
+    // objects of a dependency cycle are queued before their dependencies are
+    // done, so remember what was queued to never run an object twice
+    std::vector<bool> queued(count, false);
+    auto enqueue = [&](std::size_t i) {
+        if (!queued[i]) {
+            queued[i] = true;
+            ready.insert(i);
+        }
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        if (waiting[i] == 0) {
+            enqueue(i);
+        }
+    }
+
+    std::size_t doneCount = 0;
+    auto release = [&](std::size_t i) {
+        ++doneCount;
+        for (auto dep : dependents[i]) {
+            if (waiting[dep] > 0 && --waiting[dep] == 0) {
+                enqueue(dep);
+            }
+        }
+    };
+
+    bool aborted = false;
+    auto handleResult = [&](std::size_t i, int res) {
+        auto obj = objs[i];
+        if (res != 0) {
+            if (hasError) {
+                *hasError = true;
+            }
+            if (res < 0) {
+                aborted = true;
+            }
+            else {
+                // filter all objects in its inListRecursive from the queue
+                obj->getInListEx(filter, true);
+                filter.insert(obj);
+            }
+        }
+        else {
+            postRecompute(obj, true);
+        }
+        release(i);
+    };
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::vector<std::pair<std::size_t, int>> results;
+    std::size_t running = 0;
+
+    auto execute = [&](std::size_t i) {
+        int res = 1;
+        concurrentRecomputeThread = true;
+        try {
+            res = _recomputeFeature(objs[i]);
+        }
+        catch (...) {
+            FC_ERR("Unknown exception in " << objs[i]->getFullName() << " thrown");
+            d->addRecomputeLog("Unknown exception!", objs[i]);
+        }
+        concurrentRecomputeThread = false;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        results.emplace_back(i, res);
+        finished.notify_one();
+    };
+
+    Base::StateLocker concurrent(d->concurrentRecompute);
+    Base::ThreadPool pool(threads);
+
+    try {
+        while (doneCount < count) {
+            bool progress = false;
+            for (auto it = ready.begin(); it != ready.end() && !aborted && !progress;) {
+                std::size_t i = *it;
+                auto obj = objs[i];
+                if (!obj->isAttachedToDocument() || filter.contains(obj)) {
+                    it = ready.erase(it);
+                    release(i);
+                }
+                else if (!obj->mustRecompute()) {
+                    it = ready.erase(it);
+                    postRecompute(obj, false);
+                    release(i);
+                }
+                else if (obj->canRecomputeConcurrently()) {
+                    it = ready.erase(it);
+                    ++objectCount;
+                    ++running;
+                    pool.submit([&execute, i] {
+                        execute(i);
+                    });
+                }
+                else if (running == 0) {
+                    // objects that need the GIL or thread-affine state run
+                    // alone on this thread
+                    ready.erase(it);
+                    ++objectCount;
+                    handleResult(i, _recomputeFeature(obj));
+                    progress = true;
+                }
+                else {
+                    ++it;
+                }
+            }
+
+            if (running > 0) {
+                decltype(results) finishedJobs;
+                {
+                    // jobs may need the GIL, e.g. to evaluate expressions
+                    Base::PyGILStateRelease unlock;
+                    std::unique_lock<std::mutex> lock(mutex);
+                    finished.wait(lock, [&results] {
+                        return !results.empty();
+                    });
+                    finishedJobs.swap(results);
+                }
+                running -= finishedJobs.size();
+                for (const auto& [i, res] : finishedJobs) {
+                    handleResult(i, res);
+                }
+            }
+            else if (aborted) {
+                break;
+            }
+            else if (!progress && ready.empty()) {
+                // the rest is part of a dependency cycle, continue in topological order
+                // with the first object that neither ran nor waits in the queue
+                auto it = std::find(queued.begin(), queued.end(), false);
+                enqueue(std::size_t(it - queued.begin()));
+            }
+        }
+    }
+    catch (...) {
+        Base::PyGILStateRelease unlock;
+        pool.wait();
+        throw;
+    }
+
+    return aborted ? -1 : 0;
+}
+
+int Document::getRecomputeThreadLimit() const
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    DocumentSettings settings(const_cast<Document*>(this), "Recompute");
+    return static_cast<int>(settings.getInt("MaxThreads", 0));
+}
+
+void Document::setRecomputeThreadLimit(int threads)
+{
+    DocumentSettings settings(this, "Recompute");
+    settings.setInt("MaxThreads", std::max(threads, 0));
+}
+
+std::unique_lock<std::recursive_mutex> Document::lockConcurrentChange() const
+{
+    if (!concurrentRecomputeThread || !d->concurrentRecompute) {
+        return {};
+    }
+
+    std::unique_lock<std::recursive_mutex> lock(d->concurrentChangeMutex, std::defer_lock);
+    if (Py_IsInitialized() && PyGILState_Check()) {
+        // never wait for the lock while holding the GIL, another pool thread
+        // may need it to finish its notification
+        Base::PyGILStateRelease unlock;
+        lock.lock();
+    }
+    else {
+        lock.lock();
+    }
+    return lock;
+}
+
+bool Document::isConcurrentRecomputeThread()
+{
+    return concurrentRecomputeThread;
+}
+
+const RecomputeProfile& Document::getRecomputeProfile() const
+{
+    return d->recomputeProfile;
+}
+
 bool Document::recomputeFeature(DocumentObject* feature, bool recursive)
 {
     // delete recompute log
@@ -3303,6 +3584,7 @@ bool Document::recomputeFeature(DocumentObject* feature, bool recursive)
         recompute({feature}, true, &hasError);
         return !hasError;
     }
+    d->recomputeProfile.clear();
     _recomputeFeature(feature);
     signalRecomputedObject(*feature);
     return feature->isValid();
@@ -39,9 +39,11 @@
 #include "TransactionDefs.h"
 
 #include <map>
+#include <mutex>
 #include <vector>
 #include <utility>
 #include <list>
+#include <set>
 #include <string>
 #include <string_view>
 
@@ -87,6 +89,7 @@ class DocumentPy;
 class Application;
 class Transaction;
 class StringHasher;
+class RecomputeProfile;
 using StringHasherRef = Base::Reference<StringHasher>;
 
 /**
@@ -821,6 +824,49 @@ public:
      */
     bool recomputeFeature(DocumentObject* Feat, bool recursive = false);
 
+    /**
+     * @brief Get the maximum number of objects recomputed at the same time.
+     *
+     * The limit is only used if parallel recompute is enabled, see
+     * Application::isParallelRecomputeEnabled(). It is stored in the document
+     * settings namespace "Recompute" under the key "MaxThreads".
+     *
+     * @return The number of threads, 0 means one per hardware thread.
+     */
+    int getRecomputeThreadLimit() const;
+
+    /**
+     * @brief Set the maximum number of objects recomputed at the same time.
+     *
+     * @param[in] threads The number of threads, 0 means one per hardware
+     * thread and 1 disables parallel recompute for this document.
+     */
+    void setRecomputeThreadLimit(int threads);
+
+    /**
+     * @brief Serialize property changes during a parallel recompute.
+     *
+     * When called from a thread that recomputes an object of this document
+     * concurrently with others, the returned lock serializes the change
+     * notifications of all those threads. Otherwise an empty lock is returned.
+     */
+    std::unique_lock<std::recursive_mutex> lockConcurrentChange() const;
+
+    /**
+     * @brief Whether the calling thread recomputes an object concurrently with others.
+     *
+     * Such a thread must not modify other objects, e.g. to fill caches.
+     */
+    static bool isConcurrentRecomputeThread();
+
+    /**
+     * @brief Get the per object timings of the last recompute.
+     *
+     * The profile is reset by every call of recompute() and
+     * recomputeFeature().
+     */
+    const RecomputeProfile& getRecomputeProfile() const;
+
     /**
      * @brief Get the text of the error for a specified object.
      * @param[in] Obj The object to get the error text for.
@@ -1410,6 +1456,31 @@ protected:
      */
     int _recomputeFeature(DocumentObject* Feat);
 
+    /**
+     * @brief Recompute objects on a thread pool.
+     *
+     * An object is scheduled as soon as all objects of @p objs it depends on
+     * are done, so that independent branches of the dependency graph are
+     * recomputed at the same time. Objects that cannot be recomputed
+     * concurrently are run on the calling thread while no pool job is active.
+     *
+     * @param[in] objs The topologically sorted objects to recompute.
+     * @param[in,out] filter The objects that are skipped because of an error.
+     * @param[in] postRecompute Called on the calling thread for each object
+     * that is done, with the information whether it has been executed.
+     * @param[in] threads The number of pool threads.
+     * @param[in,out] objectCount Incremented for each executed object.
+     * @param[out] hasError If not `nullptr`, set to true if there was any error.
+     *
+     * @return 0 if succeeded, -1 if aborted by user.
+     */
+    int _recomputeConcurrently(const std::vector<DocumentObject*>& objs,
+                               std::set<DocumentObject*>& filter,
+                               const std::function<void(DocumentObject*, bool)>& postRecompute,
+                               std::size_t threads,
+                               int& objectCount,
+                               bool* hasError);
+
     /// Clear the redos.
     void _clearRedos();
 
@@ -430,6 +430,22 @@ class Document(PropertyContainer):
         """
         ...
 
+    def getRecomputeProfile(self) -> list[dict[str, str | float]]:
+        """
+        Returns the timings of the objects of the last recompute, in the order they
+        finished. Each entry holds the Name, Label and Type of the object and the time
+        in seconds spent in total, in execute (Execute), in onChanged cascades
+        (OnChanged) and waiting for the Python GIL (GILWait).
+        """
+        ...
+
+    def exportRecomputeProfile(self, path: str, /) -> None:
+        """
+        Write the timings of the last recompute to a file. A file with the extension
+        .csv is written as CSV table, any other as JSON.
+        """
+        ...
+
     def mustExecute(self) -> bool:
         """
         Check if any object must be recomputed
@@ -911,6 +911,8 @@ void DocumentObject::onBeforeChange(const Property* prop)
         return;
     }
 
+    auto lock = _pDoc ? _pDoc->lockConcurrentChange() : std::unique_lock<std::recursive_mutex>();
+
     // Store current name in oldLabel, to be able to easily retrieve old name of document object later
     // when renaming expressions.
     if (prop == &Label)
@@ -1015,6 +1017,8 @@ void DocumentObject::onEarlyChange(const Property* prop)
 /// get called by the container when a Property was changed
 void DocumentObject::onChanged(const Property* prop)
 {
+    auto lock = _pDoc ? _pDoc->lockConcurrentChange() : std::unique_lock<std::recursive_mutex>();
+
     if (prop == &Label && _pDoc && _pDoc->containsObject(this) && oldLabel != Label.getStrValue()) {
         _pDoc->unregisterLabel(oldLabel);
         _pDoc->registerLabel(Label.getStrValue());
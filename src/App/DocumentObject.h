@@ -1309,6 +1309,21 @@ public:
         return true;
     }
 
+    /**
+     * @brief Whether this object can be recomputed concurrently with other objects.
+     *
+     * This is used by parallel recompute scheduling. Objects returning true
+     * are executed on a pool thread without holding the Python GIL, at the
+     * same time as other objects of the document that do not depend on each
+     * other. Their recompute path must only modify the object's own
+     * properties and must not add, remove or relink objects. Property change
+     * notifications are serialized by the document.
+     */
+    virtual bool canRecomputeConcurrently() const
+    {
+        return false;
+    }
+
     /**
      * @brief Called when an element reference is updated.
      *
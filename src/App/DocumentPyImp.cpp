@@ -32,6 +32,7 @@
 #include "DocumentSettings.h"
 #include "DocumentSettingsPy.h"
 #include "MergeDocuments.h"
+#include "RecomputeProfile.h"
 
 // inclusion of the generated files (generated By DocumentPy.xml)
 #include "DocumentPy.h"
@@ -789,6 +790,56 @@ PyObject* DocumentPy::recompute(PyObject* args)
     PY_CATCH;
 }
 
+PyObject* DocumentPy::getRecomputeProfile(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    Py::List list;
+    for (const auto& timing : getDocumentPtr()->getRecomputeProfile().getTimings()) {
+        Py::Dict dict;
+        dict.setItem("Name", Py::String(timing.name));
+        dict.setItem("Label", Py::String(timing.label));
+        dict.setItem("Type", Py::String(timing.type));
+        dict.setItem("Total", Py::Float(timing.total));
+        dict.setItem("Execute", Py::Float(timing.execute));
+        dict.setItem("OnChanged", Py::Float(timing.onChanged));
+        dict.setItem("GILWait", Py::Float(timing.gilWait));
+        list.append(dict);
+    }
+    return Py::new_reference_to(list);
+}
+
+PyObject* DocumentPy::exportRecomputeProfile(PyObject* args)
+{
+    char* fn = nullptr;
+    if (!PyArg_ParseTuple(args, "et", "utf-8", &fn)) {
+        return nullptr;
+    }
+
+    std::string fileName(fn);
+    PyMem_Free(fn);
+
+    PY_TRY
+    {
+        Base::FileInfo fi(fileName);
+        Base::ofstream str(fi);
+        if (!str) {
+            throw Base::FileException("Cannot open file", fi);
+        }
+        const auto& profile = getDocumentPtr()->getRecomputeProfile();
+        if (fi.hasExtension("csv")) {
+            profile.exportCsv(str);
+        }
+        else {
+            profile.exportJson(str);
+        }
+        Py_Return;
+    }
+    PY_CATCH;
+}
+
 PyObject* DocumentPy::mustExecute(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -355,6 +355,12 @@ public:
         return imp->supportsAsyncRecompute() == FeaturePythonImp::Accepted;
     }
 
+    bool canRecomputeConcurrently() const override
+    {
+        // Python features need the GIL for their whole recompute
+        return false;
+    }
+
     /**
      * @brief Called when a property is edited by the user.
      *
@@ -205,6 +205,7 @@ public:
     /** @name methods override Feature */
     //@{
     DocumentObjectExecReturn* execute() override;
+    bool canRecomputeConcurrently() const override { return true; }
     //@}
 };
 
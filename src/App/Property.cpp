@@ -34,6 +34,7 @@
 #include "Property.h"
 #include "ObjectIdentifier.h"
 #include "PropertyContainer.h"
+#include "RecomputeProfile.h"
 
 
 using namespace App;
@@ -273,6 +274,7 @@ void Property::touch()
 {
     PropertyCleaner guard(this);
     if (father && isNotifyEnabled()) {
+        RecomputeProfile::ChangeScope profile;
         father->onEarlyChange(this);
         father->onChanged(this);
     }
@@ -289,6 +291,7 @@ void Property::hasSetValue()
     PropertyCleaner guard(this);
     if (father) {
         if (isNotifyEnabled()) {
+            RecomputeProfile::ChangeScope profile;
             father->onChanged(this);
         }
         if (!testStatus(Busy)) {
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                   *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include <iomanip>
+#include <ostream>
+
+#include <Base/Interpreter.h>
+
+#include "RecomputeProfile.h"
+#include "DocumentObject.h"
+
+
+using namespace App;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+thread_local RecomputeProfile::ObjectScope* currentScope = nullptr;
+
+void writeJsonString(std::ostream& out, const std::string& str)
+{
+    out << '"';
+    for (unsigned char c : str) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\r':
+                out << "\\r";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (c < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+                        << std::dec << std::setfill(' ');
+                }
+                else {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+void writeCsvString(std::ostream& out, const std::string& str)
+{
+    if (str.find_first_of(",\"\r\n") == std::string::npos) {
+        out << str;
+        return;
+    }
+    out << '"';
+    for (char c : str) {
+        if (c == '"') {
+            out << '"';
+        }
+        out << c;
+    }
+    out << '"';
+}
+}  // namespace
+
+void RecomputeProfile::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    timings.clear();
+    wallTime = 0.0;
+}
+
+void RecomputeProfile::add(RecomputeTiming timing)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    timings.push_back(std::move(timing));
+}
+
+std::vector<RecomputeTiming> RecomputeProfile::getTimings() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return timings;
+}
+
+double RecomputeProfile::getWallTime() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return wallTime;
+}
+
+void RecomputeProfile::setWallTime(double seconds)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    wallTime = seconds;
+}
+
+void RecomputeProfile::exportJson(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto precision = out.precision(9);
+    out << "{\n  \"wallTime\": " << wallTime << ",\n  \"objects\": [";
+    const char* sep = "\n";
+    for (const auto& timing : timings) {
+        out << sep << "    {\"name\": ";
+        writeJsonString(out, timing.name);
+        out << ", \"label\": ";
+        writeJsonString(out, timing.label);
+        out << ", \"type\": ";
+        writeJsonString(out, timing.type);
+        out << ", \"total\": " << timing.total << ", \"execute\": " << timing.execute
+            << ", \"onChanged\": " << timing.onChanged << ", \"gilWait\": " << timing.gilWait
+            << "}";
+        sep = ",\n";
+    }
+    out << (timings.empty() ? "]\n}\n" : "\n  ]\n}\n");
+    out.precision(precision);
+}
+
+void RecomputeProfile::exportCsv(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto precision = out.precision(9);
+    out << "name,label,type,total,execute,onChanged,gilWait\n";
+    for (const auto& timing : timings) {
+        writeCsvString(out, timing.name);
+        out << ',';
+        writeCsvString(out, timing.label);
+        out << ',';
+        writeCsvString(out, timing.type);
+        out << ',' << timing.total << ',' << timing.execute << ',' << timing.onChanged << ','
+            << timing.gilWait << '\n';
+    }
+    out.precision(precision);
+}
+
+// ----------------------------------------------------------------------------
+
+RecomputeProfile::ObjectScope::ObjectScope(RecomputeProfile& profile, const DocumentObject* obj)
+    : profile(profile)
+    , start(Clock::now())
+    , previous(currentScope)
+{
+    if (const char* name = obj->getNameInDocument()) {
+        timing.name = name;
+    }
+    timing.label = obj->Label.getStrValue();
+    timing.type = obj->getTypeId().getName();
+    gilTimer = std::make_unique<Base::PyGILWaitTimer>(timing.gilWait);
+    currentScope = this;
+}
+
+RecomputeProfile::ObjectScope::~ObjectScope()
+{
+    if (executing) {
+        endExecute();
+    }
+    currentScope = previous;
+    gilTimer.reset();
+    timing.total = std::chrono::duration<double>(Clock::now() - start).count();
+    try {
+        profile.add(std::move(timing));
+    }
+    catch (...) {  // NOLINT(bugprone-empty-catch) never throw from a destructor
+    }
+}
+
+void RecomputeProfile::ObjectScope::beginExecute()
+{
+    executeStart = Clock::now();
+    executing = true;
+}
+
+void RecomputeProfile::ObjectScope::endExecute()
+{
+    timing.execute += std::chrono::duration<double>(Clock::now() - executeStart).count();
+    executing = false;
+}
+
+RecomputeProfile::ChangeScope::ChangeScope()
+    : scope(currentScope)
+{
+    if (scope && scope->changeDepth++ == 0) {
+        start = Clock::now();
+    }
+}
+
+RecomputeProfile::ChangeScope::~ChangeScope()
+{
+    if (scope && --scope->changeDepth == 0) {
+        auto elapsed = Clock::now() - start;
+        scope->timing.onChanged += std::chrono::duration<double>(elapsed).count();
+    }
+}
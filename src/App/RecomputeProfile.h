@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                   *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <FCGlobal.h>
+
+namespace Base
+{
+class PyGILWaitTimer;
+}
+
+namespace App
+{
+
+class DocumentObject;
+
+/// The time spent on recomputing a single object, in seconds
+struct AppExport RecomputeTiming
+{
+    std::string name;
+    std::string label;
+    std::string type;
+    /// Total time of the object's recompute, including its expressions
+    double total {0.0};
+    /// Time spent in DocumentObject::recompute(), i.e. mainly execute()
+    double execute {0.0};
+    /// Time spent in onChanged() of any object while this object recomputes
+    double onChanged {0.0};
+    /// Time spent waiting for the global interpreter lock
+    double gilWait {0.0};
+};
+
+/** Per object timings of the last recompute of a document
+ *
+ * Document::recompute() records the timing of every object it recomputes. As
+ * onChanged() cascades are triggered from within execute(), the onChanged time
+ * is usually part of the execute time. When objects are recomputed in parallel
+ * the sum of all timings can exceed the wall time of the recompute.
+ */
+class AppExport RecomputeProfile
+{
+public:
+    /// Remove all timings
+    void clear();
+    /// Add the timing of an object, thread safe
+    void add(RecomputeTiming timing);
+
+    /// Returns the timings in the order the objects finished recomputing
+    std::vector<RecomputeTiming> getTimings() const;
+
+    /// Wall time of the whole recompute in seconds
+    double getWallTime() const;
+    void setWallTime(double seconds);
+
+    /// Write the timings as JSON object
+    void exportJson(std::ostream& out) const;
+    /// Write the timings as CSV table with a header line
+    void exportCsv(std::ostream& out) const;
+
+    class ChangeScope;
+
+    /** Measures the recompute of an object on the current thread
+     *
+     * Property changes and GIL waits of the current thread are attributed to
+     * the innermost scope. The timing is added to the profile on destruction.
+     */
+    class AppExport ObjectScope
+    {
+    public:
+        ObjectScope(RecomputeProfile& profile, const DocumentObject* obj);
+        ~ObjectScope();
+
+        ObjectScope(const ObjectScope&) = delete;
+        ObjectScope(ObjectScope&&) = delete;
+        ObjectScope& operator=(const ObjectScope&) = delete;
+        ObjectScope& operator=(ObjectScope&&) = delete;
+
+        /// Start measuring the execute time
+        void beginExecute();
+        /// Stop measuring the execute time
+        void endExecute();
+
+    private:
+        friend class ChangeScope;
+
+        RecomputeProfile& profile;
+        RecomputeTiming timing;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point executeStart;
+        bool executing {false};
+        int changeDepth {0};
+        ObjectScope* previous;
+        std::unique_ptr<Base::PyGILWaitTimer> gilTimer;
+    };
+
+    /** Measures an onChanged() call
+     *
+     * Only the outermost call of a cascade is measured, and only while an
+     * ObjectScope is active on the current thread.
+     */
+    class AppExport ChangeScope
+    {
+    public:
+        ChangeScope();
+        ~ChangeScope();
+
+        ChangeScope(const ChangeScope&) = delete;
+        ChangeScope(ChangeScope&&) = delete;
+        ChangeScope& operator=(const ChangeScope&) = delete;
+        ChangeScope& operator=(ChangeScope&&) = delete;
+
+    private:
+        ObjectScope* scope;
+        std::chrono::steady_clock::time_point start;
+    };
+
+private:
+    mutable std::mutex mutex;
+    std::vector<RecomputeTiming> timings;
+    double wallTime {0.0};
+};
+
+}  // namespace App
@@ -19,6 +19,8 @@
  *                                                                            *
  ******************************************************************************/
 
+#include <map>
+#include <memory>
 #include <sstream>
 #include <utility>
 
@@ -86,6 +88,22 @@ void writeRecoveryMetadataFile(const App::Document& doc)
          << "</AutoRecovery>\n";
 }
 
+// Compressed files of the last snapshot of each open document
+std::shared_ptr<Base::ZipEntryCache> entryCacheFor(const App::Document& doc)
+{
+    static std::map<const App::Document*, std::shared_ptr<Base::ZipEntryCache>> caches;
+    static fastsignals::connection connection =
+        App::GetApplication().signalDeleteDocument.connect([](const App::Document& doc) {
+            caches.erase(&doc);
+        });
+
+    auto& cache = caches[&doc];
+    if (!cache) {
+        cache = std::make_shared<Base::ZipEntryCache>();
+    }
+    return cache;
+}
+
 template<typename WriterT>
 void writeRecoverySnapshotContents(const App::Document& doc, WriterT& writer)
 {
@@ -120,7 +138,10 @@ void writeUncompressedRecoverySnapshot(const App::Document& doc, bool saveBinary
     writeRecoverySnapshotContents(doc, writer);
 }
 
-void writeCompressedRecoverySnapshot(const App::Document& doc, bool saveBinaryBrep)
+void writeCompressedRecoverySnapshot(
+    const App::Document& doc,
+    const App::RecoverySnapshotSaveOptions& options
+)
 {
     std::string fileName = doc.TransientDir.getValue();
     fileName += "/fc_recovery_file.fcstd";
@@ -132,12 +153,16 @@ void writeCompressedRecoverySnapshot(const App::Document& doc, bool saveBinaryBr
     }
 
     Base::ZipWriter writer(file);
-    if (saveBinaryBrep) {
+    if (options.saveBinaryBrep) {
         writer.setMode("BinaryBrep");
     }
 
     writer.setComment("AutoRecovery file");
     writer.setLevel(1);  // Prefer lower latency over compression ratio for autosave.
+    writer.setStoreThreshold(options.storeThreshold);
+    if (options.reuseUnchangedFiles) {
+        writer.setEntryCache(entryCacheFor(doc));
+    }
     writeRecoverySnapshotContents(doc, writer);
 }
 
@@ -168,7 +193,7 @@ bool writeRecoverySnapshotToTransientDir(const Document& doc,
         return true;
     }
 
-    writeCompressedRecoverySnapshot(doc, options.saveBinaryBrep);
+    writeCompressedRecoverySnapshot(doc, options);
     return true;
 }
 
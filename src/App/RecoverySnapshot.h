@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "ExportInfo.h"
 
 namespace App
@@ -32,6 +34,10 @@ struct AppExport RecoverySnapshotSaveOptions
     bool compressed {true};
     bool saveBinaryBrep {true};
     bool saveThumbnail {false};
+    /// Files of at least this many bytes are stored uncompressed, 0 compresses all files
+    std::size_t storeThreshold {0};
+    /// Reuse the compressed data of files that didn't change since the last snapshot
+    bool reuseUnchangedFiles {false};
 };
 
 AppExport bool writeRecoverySnapshotToTransientDir(
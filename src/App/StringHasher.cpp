@@ -24,8 +24,10 @@
 #include <QCryptographicHash>
 #include <QHash>
 #include <deque>
+#include <mutex>
 
 #include <Base/Console.h>
+#include <Base/Profiler.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
@@ -82,6 +84,8 @@ class StringHasher::HashMap: public HashMapBase
 public:
     bool SaveAll = false;
     int Threshold = 0;
+    // Serializes lookups and insertions from objects recomputed concurrently
+    TracyLockableN(std::recursive_mutex, Mutex, "StringHasher");
 };
 
 ///////////////////////////////////////////////////////////
@@ -91,6 +95,7 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 StringID::~StringID()
 {
     if (_hasher) {
+        std::lock_guard<LockableBase(std::recursive_mutex)> lock(_hasher->_hashes->Mutex);
         _hasher->_hashes->right.erase(_id);
     }
 }
@@ -191,6 +196,7 @@ void StringHasher::setSaveAll(bool enable)
 
 void StringHasher::compact()
 {
+    std::lock_guard<LockableBase(std::recursive_mutex)> lock(_hashes->Mutex);
     if (_hashes->SaveAll) {
         return;
     }
@@ -261,6 +267,7 @@ StringIDRef StringHasher::getID(const char* text, int len, bool hashable)
 
 StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 {
+    std::lock_guard<LockableBase(std::recursive_mutex)> lock(_hashes->Mutex);
     bool binary = options.testFlag(Option::Binary);
     bool hashable = options.testFlag(Option::Hashable);
     bool nocopy = options.testFlag(Option::NoCopy);
@@ -300,6 +307,7 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 
 StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<StringIDRef>& sids)
 {
+    std::lock_guard<LockableBase(std::recursive_mutex)> lock(_hashes->Mutex);
     StringID tempID;
     tempID._postfix = name.postfixBytes();
 
@@ -437,6 +445,7 @@ StringIDRef StringHasher::getID(long id, int index) const
     if (id <= 0) {
         return {};
     }
+    std::lock_guard<LockableBase(std::recursive_mutex)> lock(_hashes->Mutex);
     auto it = _hashes->right.find(id);
     if (it == _hashes->right.end()) {
         return {};
@@ -762,6 +771,7 @@ void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 
 void StringHasher::clear()
 {
+    std::lock_guard<LockableBase(std::recursive_mutex)> lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_hasher = nullptr;
         hasher.second->unref();
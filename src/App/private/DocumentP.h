@@ -29,6 +29,7 @@
 #endif
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
 #include <vector>
@@ -45,6 +46,8 @@
 #include <App/DocumentObserver.h>
 #include <App/StringHasher.h>
 #include <App/ExportInfo.h>
+#include <App/RecomputeProfile.h>
+#include <Base/Profiler.h>
 #include <Base/UniqueNameManager.h>
 
 // using VertexProperty = boost::property<boost::vertex_root_t, DocumentObject* >;
@@ -106,6 +109,12 @@ struct DocumentP
 
     StringHasherRef Hasher {new StringHasher};
 
+    // Set while objects are recomputed on a thread pool
+    bool concurrentRecompute {false};
+    std::recursive_mutex concurrentChangeMutex;
+    TracyLockableN(std::mutex, recomputeLogMutex, "Document::recomputeLog");
+    RecomputeProfile recomputeProfile;
+
     DocumentP();
 
     void addRecomputeLog(const char* why, App::DocumentObject* obj)
@@ -124,6 +133,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<LockableBase(std::mutex)> lock(recomputeLogMutex);
         _RecomputeLog.emplace(returnCode->Which,
                               std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error, true);
@@ -593,14 +593,28 @@ PyObject* RestoreError::getPyExceptionType() const
 # include <stdexcept>
 # include <iostream>
 # include <csignal>
+# include <mutex>
+
+namespace
+{
+// The handler is process wide, so instances on several threads share it: the first one
+// installs it and the last one restores the previous handler
+std::mutex signalMutex;
+int signalUsers = 0;
+struct sigaction oldSignalAction {};  // NOLINT (keep struct)
+}  // namespace
 
 SignalException::SignalException()
 {
-    memset(&new_action, 0, sizeof(new_action));
+    std::lock_guard<std::mutex> lock(signalMutex);
+    if (signalUsers++ > 0) {
+        return;
+    }
+    struct sigaction new_action {};  // NOLINT (keep struct)
     new_action.sa_handler = throw_signal;
     sigemptyset(&new_action.sa_mask);
     new_action.sa_flags = 0;
-    ok = (sigaction(SIGSEGV, &new_action, &old_action) < 0);
+    sigaction(SIGSEGV, &new_action, &oldSignalAction);
 # ifdef _DEBUG
     std::cout << "Set new signal handler" << std::endl;
 # endif
@@ -608,7 +622,11 @@ SignalException::SignalException()
 
 SignalException::~SignalException()
 {
-    sigaction(SIGSEGV, &old_action, nullptr);
+    std::lock_guard<std::mutex> lock(signalMutex);
+    if (--signalUsers > 0) {
+        return;
+    }
+    sigaction(SIGSEGV, &oldSignalAction, nullptr);
 # ifdef _DEBUG
     std::cout << "Restore old signal handler" << std::endl;
 # endif
@@ -555,12 +555,13 @@ public:
     SignalException();
     ~SignalException();
 
+    SignalException(const SignalException&) = delete;
+    SignalException(SignalException&&) = delete;
+    SignalException& operator=(const SignalException&) = delete;
+    SignalException& operator=(SignalException&&) = delete;
+
 private:
     static void throw_signal(int signum);
-
-    struct sigaction new_action {};  // NOLINT (keep struct)
-    struct sigaction old_action {};  // NOLINT (keep struct)
-    bool ok {false};
 };
 #endif
 
@@ -23,6 +23,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <chrono>
 #include <sstream>
 #include <boost/regex.hpp>
 
@@ -42,6 +43,55 @@ unsigned int format2_len = 1024;
 
 using namespace Base;
 
+namespace
+{
+thread_local double* gilWaitTime = nullptr;
+
+template<typename Func>
+void acquireGIL(Func&& acquire)
+{
+    double* counter = gilWaitTime;
+    if (!counter) {
+        acquire();
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    acquire();
+    *counter += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+PyGILWaitTimer::PyGILWaitTimer(double& seconds)
+    : previous(gilWaitTime)
+{
+    gilWaitTime = &seconds;
+}
+
+PyGILWaitTimer::~PyGILWaitTimer()
+{
+    gilWaitTime = previous;
+}
+
+double* PyGILWaitTimer::current()
+{
+    return gilWaitTime;
+}
+
+PyGILStateLocker::PyGILStateLocker()
+{
+    acquireGIL([this] {
+        gstate = PyGILState_Ensure();  // NOLINT
+    });
+}
+
+PyGILStateRelease::~PyGILStateRelease()
+{
+    // grab the global interpreter lock again
+    acquireGIL([this] {
+        PyEval_RestoreThread(state);
+    });
+}
+
 PyException::PyException(const Py::Object& obj)
 {
     setMessage(obj.as_string());
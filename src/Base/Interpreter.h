@@ -173,6 +173,30 @@ private:
     long _exitCode;
 };
 
+/** Measures how long the current thread waits for the global interpreter lock
+ * While an instance exists, PyGILStateLocker and PyGILStateRelease add the time
+ * they block on acquiring the GIL in this thread to the given counter. Instances
+ * can be nested, only the innermost one is updated.
+ */
+class BaseExport PyGILWaitTimer
+{
+public:
+    /// Add the wait time of this thread to \a seconds
+    explicit PyGILWaitTimer(double& seconds);
+    ~PyGILWaitTimer();
+
+    PyGILWaitTimer(const PyGILWaitTimer&) = delete;
+    PyGILWaitTimer(PyGILWaitTimer&&) = delete;
+    PyGILWaitTimer& operator=(const PyGILWaitTimer&) = delete;
+    PyGILWaitTimer& operator=(PyGILWaitTimer&&) = delete;
+
+    /// The counter of the innermost timer of this thread, or null
+    static double* current();
+
+private:
+    double* previous;
+};
+
 /** If the application starts we release immediately the global interpreter lock
  * (GIL) once the Python interpreter is initialized, i.e. no thread -- including
  * the main thread doesn't hold the GIL. Thus, every thread must instantiate an
@@ -183,10 +207,7 @@ private:
 class BaseExport PyGILStateLocker
 {
 public:
-    PyGILStateLocker()
-    {
-        gstate = PyGILState_Ensure();  // NOLINT
-    }
+    PyGILStateLocker();
     ~PyGILStateLocker()
     {
         PyGILState_Release(gstate);
@@ -218,11 +239,7 @@ public:
         // release the global interpreter lock
         state = PyEval_SaveThread();  // NOLINT
     }
-    ~PyGILStateRelease()
-    {
-        // grab the global interpreter lock again
-        PyEval_RestoreThread(state);
-    }
+    ~PyGILStateRelease();
 
     PyGILStateRelease(const PyGILStateRelease&) = delete;
     PyGILStateRelease(PyGILStateRelease&&) = delete;
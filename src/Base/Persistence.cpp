@@ -75,9 +75,19 @@ void Persistence::Restore(XMLReader& /*reader*/)
 void Persistence::SaveDocFile(Writer& /*writer*/) const
 {}
 
+std::function<void(Writer&)> Persistence::getSaveDocFileJob(const Writer& /*writer*/) const
+{
+    return {};
+}
+
 void Persistence::RestoreDocFile(Reader& /*reader*/)
 {}
 
+std::function<std::function<void()>()> Persistence::getRestoreDocFileJob(Reader& /*reader*/)
+{
+    return {};
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "BaseClass.h"
 
 namespace Base
@@ -116,6 +118,15 @@ public:
      * ostream).
      */
     virtual void SaveDocFile(Writer& /*writer*/) const;
+    /** Returns a job that writes the file content of SaveDocFile() from another thread
+     * ZipWriter can serialize and compress several files at the same time. An object
+     * that supports this returns a function writing the same content as SaveDocFile().
+     * It is called once on a worker thread, so it must only use data captured when
+     * getSaveDocFileJob() is called and must not add files to the writer. The default
+     * implementation returns an empty function, i.e. SaveDocFile() is called on the
+     * saving thread.
+     */
+    virtual std::function<void(Writer&)> getSaveDocFileJob(const Writer& writer) const;
     /** This method is used to restore large amounts of data from a file
      * In this method you simply stream in your SaveDocFile() saved data.
      * Again you have to apply for the call of this method in the Restore() call:
@@ -146,6 +157,15 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader& /*reader*/);
+    /** Returns a job that parses the file content of RestoreDocFile() on another thread
+     * XMLReader can restore several files at the same time. An object that supports
+     * this reads the raw data of its file from \a reader, which is positioned like in
+     * RestoreDocFile(), and returns a job parsing it. The job is called once on a worker
+     * thread and returns a function that applies the result to the object. The latter is
+     * called on the restoring thread in the order the files were added. The default
+     * implementation returns an empty function, i.e. RestoreDocFile() is called instead.
+     */
+    virtual std::function<std::function<void()>()> getRestoreDocFileJob(Reader& reader);
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
     /// Replaces all characters with '_' that are not allowed in XML
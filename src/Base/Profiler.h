@@ -22,8 +22,55 @@
  ***************************************************************************/
 
 #ifdef TRACY_ENABLE
+# include <string>
+# include <utility>
 # include <tracy/Tracy.hpp>
+
+namespace Base
+{
+/// Names the document object that the zones opened on this thread during its lifetime work for
+class ProfilerObject
+{
+public:
+    explicit ProfilerObject(std::string name)
+        : name(std::move(name))
+        , previous(current)
+    {
+        current = this;
+    }
+    ~ProfilerObject()
+    {
+        current = previous;
+    }
+    ProfilerObject(const ProfilerObject&) = delete;
+    ProfilerObject& operator=(const ProfilerObject&) = delete;
+
+    /// Returns the name of the innermost object of this thread, or nullptr
+    static const std::string* currentName()
+    {
+        return current ? &current->name : nullptr;
+    }
+
+private:
+    std::string name;
+    ProfilerObject* previous;
+    inline static thread_local ProfilerObject* current = nullptr;
+};
+}  // namespace Base
+
+// Sets the object of the enclosing scope, the argument is only evaluated with Tracy. Use it at
+// most once per scope.
+# define ZoneObject(x) Base::ProfilerObject profilerObject(x)
+// Sets the text of the current zone to the name of the object set with ZoneObject()
+# define ZoneTextObject \
+    do { \
+        if (const std::string* profilerName = Base::ProfilerObject::currentName()) { \
+            ZoneText(profilerName->c_str(), profilerName->size()); \
+        } \
+    } while (false)
 #else
+# define ZoneObject(x)
+# define ZoneTextObject
 # define TracyNoop
 
 # define ZoneNamed(x, y)
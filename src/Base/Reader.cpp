@@ -22,7 +22,11 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <iostream>
 #include <string>
@@ -41,6 +45,7 @@
 #include "Persistence.h"
 #include "Sequencer.h"
 #include "Stream.h"
+#include "ThreadPool.h"
 #include "XMLTools.h"
 
 #ifdef _MSC_VER
@@ -52,6 +57,97 @@
 using namespace std;
 using namespace XERCES_CPP_NAMESPACE;
 
+namespace
+{
+// Runs the restore jobs of XMLReader::readFiles() on a thread pool and applies
+// their results in the order the files were read
+class ConcurrentRestore
+{
+public:
+    using Job = std::function<std::function<void()>()>;
+    using Failure = std::function<void(const std::string&, const std::string&, std::size_t)>;
+
+    ConcurrentRestore(std::size_t threads, Failure failure)
+        // limit the number of files held in memory
+        : window(2 * threads)
+        , failure(std::move(failure))
+        , pool(threads)
+    {}
+
+    void submit(const std::string& fileName, const zipios::ConstEntryPointer& entry, Job job)
+    {
+        auto file = std::make_shared<File>();
+        file->fileName = fileName;
+        file->entry = entry->toString();
+        file->size = entry->getSize();
+        file->job = std::move(job);
+        pending.push_back(file);
+        pool.submit([this, file] {
+            run(file);
+        });
+        apply(window);
+    }
+
+    /// Apply the results until at most \a keep files are pending
+    void apply(std::size_t keep)
+    {
+        while (pending.size() > keep) {
+            auto file = pending.front();
+            pending.pop_front();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finished.wait(lock, [&file] {
+                    return file->done;
+                });
+            }
+            try {
+                if (file->error) {
+                    std::rethrow_exception(file->error);
+                }
+                file->result();
+            }
+            catch (...) {
+                failure(file->fileName, file->entry, file->size);
+            }
+        }
+    }
+
+private:
+    struct File
+    {
+        std::string fileName;
+        std::string entry;
+        std::size_t size {0};
+        Job job;
+        std::function<void()> result;
+        std::exception_ptr error;
+        bool done {false};
+    };
+
+    void run(const std::shared_ptr<File>& file)
+    {
+        try {
+            file->result = file->job();
+            file->job = nullptr;
+        }
+        catch (...) {
+            file->error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        file->done = true;
+        finished.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::deque<std::shared_ptr<File>> pending;
+    std::size_t window;
+    Failure failure;
+    // declared last so that running jobs are finished before anything they use is destroyed
+    Base::ThreadPool pool;
+};
+}  // namespace
+
 
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Constructors and Destructor
@@ -455,6 +551,27 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // project file was created without GUI
         return;
     }
+    auto failed = [this](const std::string& fileName, const std::string& entry, std::size_t size) {
+        // For any exception we just continue with the next file.
+        // It doesn't matter if the last reader has read more or
+        // less data than the file size would allow.
+        // All what we need to do is to notify the user about the
+        // failure.
+        if (size == 0) {
+            Base::Console().log("Skipped empty embedded file: %s\n", entry.c_str());
+        }
+        else {
+            Base::Console().error("Reading failed from embedded file: %s\n", entry.c_str());
+            FailedFiles.push_back(fileName);
+        }
+    };
+
+    std::unique_ptr<ConcurrentRestore> concurrent;
+    const std::size_t threads = Threads == 0 ? ThreadPool::hardwareConcurrency() : Threads;
+    if (threads > 1 && FileList.size() > 1) {
+        concurrent = std::make_unique<ConcurrentRestore>(threads, failed);
+    }
+
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it != FileList.end()) {
@@ -469,28 +586,27 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         if (jt != FileList.end()) {
             try {
                 Base::Reader reader(zipstream, jt->FileName, FileVersion);
-                jt->Object->RestoreDocFile(reader);
-                if (reader.getLocalReader()) {
-                    reader.getLocalReader()->readFiles(zipstream);
+                ConcurrentRestore::Job job;
+                if (concurrent) {
+                    job = jt->Object->getRestoreDocFileJob(reader);
                 }
-            }
-            catch (...) {
-                // For any exception we just continue with the next file.
-                // It doesn't matter if the last reader has read more or
-                // less data than the file size would allow.
-                // All what we need to do is to notify the user about the
-                // failure.
-                if (entry->getSize() == 0) {
-                    Base::Console().log("Skipped empty embedded file: %s\n", entry->toString().c_str());
+                if (job) {
+                    concurrent->submit(jt->FileName, entry, std::move(job));
                 }
                 else {
-                    Base::Console().error(
-                        "Reading failed from embedded file: %s\n",
-                        entry->toString().c_str()
-                    );
-                    FailedFiles.push_back(jt->FileName);
+                    // the results of the earlier files must be applied first
+                    if (concurrent) {
+                        concurrent->apply(0);
+                    }
+                    jt->Object->RestoreDocFile(reader);
+                    if (reader.getLocalReader()) {
+                        reader.getLocalReader()->readFiles(zipstream);
+                    }
                 }
             }
+            catch (...) {
+                failed(jt->FileName, entry->toString(), entry->getSize());
+            }
             // Go to the next registered file name
             it = jt + 1;
         }
@@ -506,6 +622,10 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
             break;
         }
     }
+
+    if (concurrent) {
+        concurrent->apply(0);
+    }
 }
 
 const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object)
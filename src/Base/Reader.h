@@ -277,6 +277,20 @@ public:
     const char* addFile(const char* Name, Base::Persistence* Object);
     /// process the requested file writes
     void readFiles(zipios::ZipInputStream& zipstream) const;
+    /** Set the number of threads used by readFiles()
+     * With more than one thread the files of objects that provide a job with
+     * Persistence::getRestoreDocFileJob() are parsed on a thread pool, all other files
+     * are restored on the calling thread. 0 means one thread per hardware thread, the
+     * default 1 restores the files one after the other.
+     */
+    void setThreads(std::size_t threads)
+    {
+        Threads = threads;
+    }
+    std::size_t getThreads() const
+    {
+        return Threads;
+    }
     /// Returns whether reader has any registered filenames
     bool hasFilenames() const;
     /// returns true if reading the file \a filename has failed
@@ -391,6 +405,7 @@ public:
 
 private:
     mutable std::vector<std::string> FailedFiles;
+    std::size_t Threads {1};
 
     std::bitset<32> StatusBits;
 
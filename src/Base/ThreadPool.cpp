@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                   *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+using namespace Base;
+
+namespace
+{
+// The pool and worker index the current thread belongs to, if any
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local std::size_t currentWorker = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t threads)
+{
+    if (threads == 0) {
+        threads = hardwareConcurrency();
+    }
+
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    this->threads.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        this->threads.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+std::size_t ThreadPool::hardwareConcurrency()
+{
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+std::size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+void ThreadPool::submit(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (currentPool == this) {
+            // keep work spawned by a task local to its worker
+            auto& worker = *workers[currentWorker];
+            std::lock_guard<std::mutex> workerLock(worker.mutex);
+            worker.tasks.push_front(std::move(task));
+        }
+        else {
+            auto& worker = *workers[nextWorker++ % workers.size()];
+            std::lock_guard<std::mutex> workerLock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+        ++queued;
+        ++pending;
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    tasksDone.wait(lock, [this] {
+        return pending == 0;
+    });
+}
+
+bool ThreadPool::popTask(std::size_t index, Task& task)
+{
+    auto& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::stealTask(std::size_t index, Task& task)
+{
+    for (std::size_t i = 1; i < workers.size(); ++i) {
+        auto& victim = *workers[(index + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(std::size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    for (;;) {
+        Task task;
+        if (popTask(index, task) || stealTask(index, task)) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --queued;
+            }
+
+            try {
+                task();
+            }
+            catch (...) {
+                // tasks are expected to handle their own errors
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                tasksDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        taskAvailable.wait(lock, [this] {
+            return stop || queued > 0;
+        });
+        if (stop && queued == 0) {
+            break;
+        }
+    }
+
+    currentPool = nullptr;
+}
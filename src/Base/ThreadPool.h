@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                   *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BASE_THREADPOOL_H
+#define BASE_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef FC_GLOBAL_H
+# include <FCGlobal.h>
+#endif
+
+namespace Base
+{
+
+/**
+ * Small work-stealing thread pool.
+ *
+ * Every worker owns a task deque. Tasks submitted from outside the pool are
+ * distributed round-robin over the workers, tasks submitted from inside a
+ * running task are pushed to the front of the current worker's deque. An idle
+ * worker first pops from the front of its own deque and then steals from the
+ * back of the other workers' deques.
+ *
+ * The pool is meant for coarse-grained jobs such as recomputing a document
+ * object or compressing a file entry. Tasks must not throw: an exception
+ * leaving a task is swallowed so that it cannot terminate the worker.
+ */
+class BaseExport ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /// Create a pool with \a threads workers, 0 means one per hardware thread.
+    explicit ThreadPool(std::size_t threads = 0);
+    /// Waits for all pending tasks and joins the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /// Queue a task for execution on one of the workers.
+    void submit(Task task);
+    /// Block until every submitted task has finished.
+    void wait();
+    /// Number of worker threads.
+    std::size_t size() const;
+
+    /// Number of hardware threads, at least 1.
+    static std::size_t hardwareConcurrency();
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(std::size_t index);
+    bool popTask(std::size_t index, Task& task);
+    bool stealTask(std::size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable tasksDone;
+    std::atomic<std::size_t> nextWorker {0};
+    std::size_t queued {0};
+    std::size_t pending {0};
+    bool stop {false};
+};
+
+}  // namespace Base
+
+#endif  // BASE_THREADPOOL_H
@@ -23,7 +23,11 @@
  ***************************************************************************/
 
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <string>
@@ -38,14 +42,71 @@
 #include "Exception.h"
 #include "FileInfo.h"
 #include "Persistence.h"
+#include "Profiler.h"
 #include "Stream.h"
+#include "ThreadPool.h"
 #include "Tools.h"
 
 #include <boost/iostreams/filtering_stream.hpp>
 #include <zipios++/zipinputstream.h>
+#include <zlib.h>
 
 using namespace Base;
 
+namespace
+{
+// Writer serializing a single file entry into memory
+class EntryWriter: public StringWriter
+{
+public:
+    EntryWriter(const Writer& parent, const std::string& fileName)
+    {
+        setForceXML(parent.isForceXML());
+        setFileVersion(parent.getFileVersion());
+        setModes(parent.getModes());
+        ObjectName = fileName;
+        Stream().imbue(std::locale::classic());
+        Stream().precision(std::numeric_limits<double>::digits10 + 1);
+        Stream().setf(std::ios::fixed, std::ios::floatfield);
+    }
+};
+
+uint32_t crc32Of(const std::string& data)
+{
+    const auto* input = reinterpret_cast<const Bytef*>(data.data());  // NOLINT
+    uLong crc = crc32(0L, Z_NULL, 0);
+    return static_cast<uint32_t>(crc32(crc, input, static_cast<uInt>(data.size())));
+}
+
+uint32_t adler32Of(const std::string& data)
+{
+    const auto* input = reinterpret_cast<const Bytef*>(data.data());  // NOLINT
+    uLong adler = adler32(0L, Z_NULL, 0);
+    return static_cast<uint32_t>(adler32(adler, input, static_cast<uInt>(data.size())));
+}
+
+// Deflate data the way zipios does
+void compressEntry(const std::string& data, std::string& compressed, int level)
+{
+    const auto* input = reinterpret_cast<const Bytef*>(data.data());  // NOLINT
+    z_stream zs {};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw Base::RuntimeError("Failed to initialize zlib");
+    }
+    compressed.resize(deflateBound(&zs, static_cast<uLong>(data.size())));
+    zs.next_in = const_cast<Bytef*>(input);  // NOLINT
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(compressed.data());  // NOLINT
+    zs.avail_out = static_cast<uInt>(compressed.size());
+    int res = deflate(&zs, Z_FINISH);
+    deflateEnd(&zs);
+    if (res != Z_STREAM_END) {
+        throw Base::RuntimeError("Failed to compress file entry");
+    }
+    compressed.resize(zs.total_out);
+}
+}  // namespace
+
 // boost iostream filter to escape ']]>' in text file saved into CDATA section.
 // It does not check if the character is valid utf8 or not.
 struct cdata_filter
@@ -366,13 +427,27 @@ void ZipWriter::putNextEntry(const char* file, const char* obj)
     Writer::checkErrNo();
 }
 
+const ZipEntryCache::Entry* ZipEntryCache::find(const std::string& fileName) const
+{
+    auto it = entries.find(fileName);
+    return it != entries.end() ? &it->second : nullptr;
+}
+
 void ZipWriter::writeFiles()
 {
+    std::size_t threads = Threads == 0 ? ThreadPool::hardwareConcurrency() : Threads;
+    if ((threads > 1 && FileList.size() > 1) || StoreThreshold > 0 || Cache) {
+        writeFilesBuffered();
+        return;
+    }
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList[index];
+        ZoneScopedN("ZipWriter entry");
+        ZoneText(entry.FileName.c_str(), entry.FileName.size());
         putNextEntry(entry.FileName.c_str());
         indent = 0;
         indBuf[0] = 0;
@@ -381,6 +456,158 @@ void ZipWriter::writeFiles()
     }
 }
 
+void ZipWriter::writeFilesBuffered()
+{
+    struct Entry
+    {
+        std::string fileName;
+        std::unique_ptr<EntryWriter> writer;
+        std::function<void(Writer&)> job;
+        std::string data;
+        std::string compressed;
+        // compressed data of the unchanged file in the cache
+        const std::string* reused {nullptr};
+        zipios::StorageMethod method {zipios::DEFLATED};
+        uint32_t crc {0};
+        uint32_t adler {0};
+        std::exception_ptr error;
+        bool done {false};
+    };
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::deque<std::shared_ptr<Entry>> pending;
+    // limit the number of entries held in memory
+    const std::size_t threads = Threads == 0 ? ThreadPool::hardwareConcurrency() : Threads;
+    const std::size_t window = 2 * threads;
+    const int level = Level;
+    const std::size_t storeThreshold = StoreThreshold;
+    const ZipEntryCache* cache = Cache.get();
+    // the cache is only updated once all files are written
+    std::unordered_map<std::string, ZipEntryCache::Entry> cached;
+
+    auto run = [&mutex, &finished, level, storeThreshold, cache](
+                   const std::shared_ptr<Entry>& entry
+               ) {
+        try {
+            if (entry->job) {
+                ZoneScopedN("ZipWriter entry");
+                ZoneText(entry->fileName.c_str(), entry->fileName.size());
+                entry->job(*entry->writer);
+                entry->data = entry->writer->getString();
+                entry->writer.reset();
+            }
+            entry->crc = crc32Of(entry->data);
+            const ZipEntryCache::Entry* old = cache ? cache->find(entry->fileName) : nullptr;
+            if (old) {
+                entry->adler = adler32Of(entry->data);
+            }
+            if (old && old->size == entry->data.size() && old->crc == entry->crc
+                && old->adler == entry->adler) {
+                entry->reused = &old->compressed;
+            }
+            else if (storeThreshold > 0 && entry->data.size() >= storeThreshold) {
+                entry->method = zipios::STORED;
+            }
+            else {
+                compressEntry(entry->data, entry->compressed, level);
+                if (cache) {
+                    entry->adler = adler32Of(entry->data);
+                }
+            }
+        }
+        catch (...) {
+            entry->error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        entry->done = true;
+        finished.notify_all();
+    };
+
+    auto flush = [&](std::size_t keep) {
+        while (pending.size() > keep) {
+            auto entry = pending.front();
+            pending.pop_front();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finished.wait(lock, [&entry] {
+                    return entry->done;
+                });
+            }
+            if (entry->error) {
+                std::rethrow_exception(entry->error);
+            }
+            const std::string* data = &entry->compressed;
+            if (entry->method == zipios::STORED) {
+                data = &entry->data;
+            }
+            else if (entry->reused) {
+                data = entry->reused;
+            }
+            Writer::putNextEntry(entry->fileName.c_str());
+            ZipStream.putRawEntry(entry->fileName,
+                                  entry->method,
+                                  data->data(),
+                                  static_cast<uint32_t>(data->size()),
+                                  static_cast<uint32_t>(entry->data.size()),
+                                  entry->crc);
+            Writer::checkErrNo();
+            if (cache && entry->method == zipios::DEFLATED) {
+                auto& item = cached[entry->fileName];
+                item.size = static_cast<uint32_t>(entry->data.size());
+                item.crc = entry->crc;
+                item.adler = entry->adler;
+                item.compressed = entry->reused ? *entry->reused : std::move(entry->compressed);
+            }
+        }
+    };
+
+    // declared last so that pending jobs are finished before anything they use is destroyed
+    ThreadPool pool(threads);
+
+    // use a while loop because it is possible that while
+    // processing the files new ones can be added
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry file = FileList[index];
+        auto entry = std::make_shared<Entry>();
+        entry->fileName = file.FileName;
+        entry->job = file.Object->getSaveDocFileJob(*this);
+        if (entry->job) {
+            entry->writer = std::make_unique<EntryWriter>(*this, file.FileName);
+        }
+        else {
+            ZoneScopedN("ZipWriter entry");
+            ZoneText(file.FileName.c_str(), file.FileName.size());
+            EntryWriter buffer(*this, file.FileName);
+            Writer::putNextEntry(file.FileName.c_str());
+            indent = 0;
+            indBuf[0] = 0;
+            EntryStream = &buffer.Stream();
+            try {
+                file.Object->SaveDocFile(*this);
+            }
+            catch (...) {
+                EntryStream = nullptr;
+                throw;
+            }
+            EntryStream = nullptr;
+            entry->data = buffer.getString();
+        }
+        pending.push_back(entry);
+        pool.submit([&run, entry] {
+            run(entry);
+        });
+        flush(window);
+        index++;
+    }
+    flush(0);
+
+    if (Cache) {
+        Cache->entries.swap(cached);
+    }
+}
+
 ZipWriter::~ZipWriter()
 {
     ZipStream.close();
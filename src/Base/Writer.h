@@ -25,9 +25,11 @@
 #pragma once
 
 
+#include <cstdint>
 #include <set>
 #include <string>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -209,6 +211,47 @@ private:
 };
 
 
+/** Compressed files of a previously written archive
+ * ZipWriter reuses the compressed data of a file whose content didn't change since the
+ * last archive written with the same cache, e.g. the previous auto-recovery file. Files
+ * are identified by their name and compared by size and the CRC-32 and Adler-32 checksums
+ * of their content. So the content is still serialized, but not compressed again.
+ * Files that are stored uncompressed are not kept.
+ */
+class BaseExport ZipEntryCache
+{
+public:
+    struct Entry
+    {
+        std::uint32_t size {0};
+        std::uint32_t crc {0};
+        std::uint32_t adler {0};
+        std::string compressed;
+    };
+
+    /// Returns the entry of \a fileName, or null if there is none
+    const Entry* find(const std::string& fileName) const;
+    /// Adds or replaces the entry of \a fileName
+    void insert(const std::string& fileName, Entry entry)
+    {
+        entries[fileName] = std::move(entry);
+    }
+    /// Number of cached files
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+    void clear()
+    {
+        entries.clear();
+    }
+
+private:
+    friend class ZipWriter;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+
 /** The ZipWriter class
  * This is an important helper class implementation for the store and retrieval system
  * of persistent objects in FreeCAD.
@@ -226,11 +269,17 @@ public:
 
     std::ostream& Stream() override
     {
+        if (EntryStream) {
+            return *EntryStream;
+        }
         return ZipStream;
     }
 
     const std::ostream& Stream() const override
     {
+        if (EntryStream) {
+            return *EntryStream;
+        }
         return ZipStream;
     }
 
@@ -241,16 +290,57 @@ public:
     void setLevel(int level)
     {
         ZipStream.setLevel(level);
+        Level = level;
     }
     void putNextEntry(const char* filename, const char* objName = nullptr) override;
 
+    /** Set the number of threads used by writeFiles()
+     * With more than one thread the files are serialized and compressed on a thread
+     * pool and then written to the archive in the order they were added. Files whose
+     * object doesn't provide a job with Persistence::getSaveDocFileJob() are still
+     * serialized on the calling thread, but compressed on the pool. 0 means one thread
+     * per hardware thread, the default 1 writes the files one after the other.
+     */
+    void setThreads(std::size_t threads)
+    {
+        Threads = threads;
+    }
+    std::size_t getThreads() const
+    {
+        return Threads;
+    }
+    /** Store files of at least \a size bytes uncompressed
+     * Compressing large binary files such as binary BReps takes most of the time of a save
+     * while hardly making them smaller. The default 0 compresses all files.
+     */
+    void setStoreThreshold(std::size_t size)
+    {
+        StoreThreshold = size;
+    }
+    std::size_t getStoreThreshold() const
+    {
+        return StoreThreshold;
+    }
+    /// Reuse unchanged files from \a cache, which is updated with the written files
+    void setEntryCache(std::shared_ptr<ZipEntryCache> cache)
+    {
+        Cache = std::move(cache);
+    }
+
     ZipWriter(const ZipWriter&) = delete;
     ZipWriter(ZipWriter&&) = delete;
     ZipWriter& operator=(const ZipWriter&) = delete;
     ZipWriter& operator=(ZipWriter&&) = delete;
 
 private:
+    void writeFilesBuffered();
+
     zipios::ZipOutputStream ZipStream;
+    std::ostream* EntryStream {nullptr};
+    int Level {6};
+    std::size_t Threads {1};
+    std::size_t StoreThreshold {0};
+    std::shared_ptr<ZipEntryCache> Cache;
 };
 
 /** The StringWriter class
@@ -84,6 +84,14 @@
     FC_DEFAULT_COPY(Class) \
     FC_DEFAULT_MOVE(Class)
 
+// Compiles a function whose loops vectorize additionally for AVX2, the best version is picked
+// at load time. Only GCC on x86-64 Linux supports this.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#  define FC_SIMD_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#  define FC_SIMD_CLONES
+#endif
+
 #include <QtCore.h>
 #ifndef HAVE_Q_DISABLE_COPY_MOVE
 #define Q_DISABLE_COPY_MOVE FC_DISABLE_COPY_MOVE
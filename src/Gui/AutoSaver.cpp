@@ -20,6 +20,8 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QTimer>
 #include <QThread>
@@ -182,6 +184,12 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
     options.compressed = this->compressed;
     options.saveBinaryBrep = !this->compressed || hGrp->GetBool("SaveBinaryBrep", true);
     options.saveThumbnail = false;
+    // Large files, e.g. binary BReps, are stored uncompressed and unchanged files aren't
+    // compressed again
+    options.storeThreshold = static_cast<std::size_t>(
+        std::max<long>(hGrp->GetInt("AutoSaveStoreThreshold", 1024), 0)
+    ) * 1024;
+    options.reuseUnchangedFiles = hGrp->GetBool("AutoSaveReuseUnchangedFiles", true);
 
     Gui::WaitCursor wc;
     getMainWindow()->showMessage(tr("Wait until the auto-recovery file has been saved…"), 5000);
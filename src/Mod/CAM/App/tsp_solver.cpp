@@ -26,6 +26,8 @@
 #include <limits>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <deque>
 #include <Base/Precision.h>
 
 namespace
@@ -65,441 +67,1146 @@ double distSquared(const TSPPoint& a, const TSPPoint& b)
 }
 
 /**
- * @brief Core TSP solver implementation using nearest neighbor + iterative improvement
+ * @brief Time and pass budget of the solver
  *
- * Algorithm steps:
- * 1. Add temporary start/end points if specified
- * 2. Build initial route using nearest neighbor heuristic
- * 3. Optimize route with 2-opt and relocation moves
- * 4. Remove temporary points and map back to original indices
+ * The time limit counts from the start of the solver. Building the initial route of a large
+ * input checks the time limit after each point. The improvement loops ask for another pass
+ * before each sweep over the route and check the time limit while sweeping. Once the budget
+ * is used up they stop and keep the current route.
+ */
+class Budget
+{
+public:
+    explicit Budget(const TSPOptions& options)
+        : maxPasses(options.maxIterations)
+        , limited(options.timeLimit > 0.0)
+    {
+        if (limited) {
+            auto limit = std::chrono::duration<double>(options.timeLimit);
+            deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(limit);
+        }
+    }
+
+    /// Starts another improvement pass, returns false once the budget is used up
+    bool nextPass()
+    {
+        ++passes;
+        if (limited && !timeUp) {
+            timeUp = Clock::now() >= deadline;
+        }
+        return (maxPasses <= 0 || passes <= maxPasses) && !timeUp;
+    }
+
+    /// Returns true once the time limit has passed, the clock is only read every few calls
+    bool expired()
+    {
+        if (limited && !timeUp && (++calls % 64) == 0) {
+            timeUp = Clock::now() >= deadline;
+        }
+        return timeUp;
+    }
+
+    /// Returns true once the time limit has passed, the clock is read right away
+    bool timeIsUp()
+    {
+        if (limited && !timeUp) {
+            timeUp = Clock::now() >= deadline;
+        }
+        return timeUp;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point deadline;
+    int maxPasses;
+    int passes = 0;
+    unsigned calls = 0;
+    bool limited;
+    bool timeUp = false;
+};
+
+/**
+ * @brief k-d tree over a set of points for nearest neighbor queries
  *
- * @param points Input points to visit
- * @param startPoint Optional starting location constraint
- * @param endPoint Optional ending location constraint
- * @return Vector of indices representing optimized visit order
+ * The tree splits the points at the median of their wider extent, so it adapts to clustered
+ * input where a uniform grid ends up with most points in a few cells. Entries at the same
+ * position share one site of the tree, so coincident points are only looked at once per query.
+ * Searches descend into the nearer child first and skip subtrees that can't contain anything
+ * within the bound given by the caller. Entries can be removed, which is used to find the
+ * nearest unvisited entry while building the initial route.
  */
-std::vector<int> solve_impl(
-    const std::vector<TSPPoint>& points,
-    const TSPPoint* startPoint,
-    const TSPPoint* endPoint
-)
+class PointTree
 {
-    // ========================================================================
-    // STEP 1: Prepare point set with temporary start/end markers
-    // ========================================================================
-    // We insert temporary points to enforce start/end constraints.
-    // These will be removed after optimization and won't appear in final result.
-    std::vector<TSPPoint> pts = points;
-    int tempStartIdx = -1, tempEndIdx = -1;
+public:
+    /**
+     * @param positions Location of every entry
+     * @param entries Indices into positions of the entries to add to the tree, entries at the
+     * same position are reported in this order
+     */
+    PointTree(const std::vector<TSPPoint>& positions, const std::vector<int>& entries)
+        : siteOf(positions.size(), -1)
+        , members(entries)
+        , live(entries.size())
+    {
+        // Group the entries by position
+        std::stable_sort(members.begin(), members.end(), [&positions](int a, int b) {
+            const TSPPoint& p = positions[a];
+            const TSPPoint& q = positions[b];
+            return p.x < q.x || (p.x == q.x && p.y < q.y);
+        });
+        for (int i = 0; i < static_cast<int>(members.size()); ++i) {
+            const TSPPoint& p = positions[members[i]];
+            if (sites.empty() || sites.back().x != p.x || sites.back().y != p.y) {
+                sites.push_back({p.x, p.y, i, i, 0, -1});
+            }
+            ++sites.back().end;
+            ++sites.back().live;
+            siteOf[members[i]] = static_cast<int>(sites.size()) - 1;
+        }
 
-    if (startPoint) {
-        // Insert user-specified start point at beginning
-        pts.insert(pts.begin(), TSPPoint(startPoint->x, startPoint->y));
-        tempStartIdx = 0;
+        order.resize(sites.size());
+        for (size_t s = 0; s < sites.size(); ++s) {
+            order[s] = static_cast<int>(s);
+        }
+        if (!sites.empty()) {
+            nodes.reserve(2 * sites.size() / LeafSize + 1);
+            build(0, static_cast<int>(sites.size()), -1);
+        }
     }
-    else if (!pts.empty()) {
-        // No start specified: duplicate first point as anchor
-        pts.insert(pts.begin(), TSPPoint(pts[0].x, pts[0].y));
-        tempStartIdx = 0;
+
+    /// Number of entries in the tree
+    size_t size() const
+    {
+        return live;
     }
 
-    if (endPoint) {
-        // Add user-specified end point at the end
-        pts.push_back(TSPPoint(endPoint->x, endPoint->y));
-        tempEndIdx = static_cast<int>(pts.size()) - 1;
+    /// Returns the entries still in the tree, nearby entries come one after the other
+    std::vector<int> entries() const
+    {
+        std::vector<int> result;
+        result.reserve(live);
+        for (int s : order) {
+            for (int i = sites[s].head; i < sites[s].end; ++i) {
+                if (siteOf[members[i]] >= 0) {
+                    result.push_back(members[i]);
+                }
+            }
+        }
+        return result;
     }
 
-    // ========================================================================
-    // STEP 2: Build initial route using Nearest Neighbor algorithm
-    // ========================================================================
-    // Greedy approach: always visit the closest unvisited point next.
-    // This gives a decent initial solution quickly (O(n²) complexity).
-    //
-    // Tie-breaking rule:
-    // - If distances are within ±0.1, prefer point with y-value closer to start
-    // - This provides deterministic results when points are nearly equidistant
-    std::vector<int> route;
-    std::vector<bool> visited(pts.size(), false);
-    route.push_back(0);  // Start from temp start point (index 0)
-    visited[0] = true;
+    /// Removes an entry, entries not in the tree are ignored
+    void remove(int entry)
+    {
+        int s = siteOf[entry];
+        if (s < 0) {
+            return;
+        }
+        siteOf[entry] = -1;
+        --live;
+        Site& site = sites[s];
+        while (site.head < site.end && siteOf[members[site.head]] < 0) {
+            ++site.head;
+        }
+        if (--site.live == 0) {
+            for (int n = site.leaf; n >= 0; n = nodes[n].parent) {
+                --nodes[n].live;
+            }
+        }
+    }
 
-    for (size_t step = 1; step < pts.size(); ++step) {
-        double minDist = std::numeric_limits<double>::max();
-        int next = -1;
-        double nextYDiff = std::numeric_limits<double>::max();
+    /**
+     * @brief Visits the positions around a point, nearer subtrees first
+     *
+     * Of the entries at the same position only the first one still in the tree is visited.
+     *
+     * @param p Query point
+     * @param visit Called with each entry and its squared distance to p
+     * @param bound Returns the squared distance beyond which the caller isn't interested
+     */
+    template<typename Visit, typename Bound>
+    void search(const TSPPoint& p, Visit visit, Bound bound) const
+    {
+        if (live == 0) {
+            return;
+        }
+        walk(0, p, [&](const Site& site, double d) { visit(members[site.head], d); }, bound);
+    }
 
-        // Find nearest unvisited neighbor
-        for (size_t i = 0; i < pts.size(); ++i) {
-            if (!visited[i]) {
-                // Use squared distance for speed (no sqrt needed for comparison)
-                double d = distSquared(pts[route.back()], pts[i]);
-                double yDiff = std::abs(pts[route.front()].y - pts[i].y);
+    /// Returns up to count entries nearest to p, nearest first, skipping exclude
+    std::vector<int> nearest(const TSPPoint& p, size_t count, int exclude) const
+    {
+        std::vector<std::pair<double, int>> best;  // max-heap on the distance
+        best.reserve(count + 1);
+        auto full = [&](double d) {
+            return best.size() >= count && d >= best.front().first;
+        };
+        if (live > 0 && count > 0) {
+            walk(
+                0,
+                p,
+                [&](const Site& site, double d) {
+                    for (int i = site.head; i < site.end && !full(d); ++i) {
+                        int e = members[i];
+                        if (e == exclude || siteOf[e] < 0) {
+                            continue;
+                        }
+                        if (best.size() == count) {
+                            std::pop_heap(best.begin(), best.end());
+                            best.pop_back();
+                        }
+                        best.emplace_back(d, e);
+                        std::push_heap(best.begin(), best.end());
+                    }
+                },
+                [&]() {
+                    return best.size() < count ? std::numeric_limits<double>::max()
+                                               : best.front().first;
+                }
+            );
+        }
+        std::sort_heap(best.begin(), best.end());
+        std::vector<int> result;
+        result.reserve(best.size());
+        for (const auto& [d, e] : best) {
+            result.push_back(e);
+        }
+        return result;
+    }
 
-                // Tie-breaking logic:
-                if (d > minDist + 0.1) {
-                    continue;  // Clearly farther, skip
+private:
+    static constexpr int LeafSize = 8;
+
+    // The entries at one position are members[head] to members[end - 1], removed ones included
+    struct Site
+    {
+        double x;
+        double y;
+        int head;
+        int end;
+        int live;  // Number of entries still in the tree
+        int leaf;  // Node holding the site
+    };
+
+    struct Node
+    {
+        double minX = 0.0;
+        double minY = 0.0;
+        double maxX = 0.0;
+        double maxY = 0.0;
+        int left = -1;  // Leaves have no children
+        int right = -1;
+        int parent = -1;
+        int begin = 0;  // Sites of the subtree in order
+        int end = 0;
+        int live = 0;   // Number of sites with entries still in the tree
+    };
+
+    int build(int begin, int end, int parent)
+    {
+        int index = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+        Node node;
+        node.minX = node.minY = std::numeric_limits<double>::max();
+        node.maxX = node.maxY = -std::numeric_limits<double>::max();
+        for (int i = begin; i < end; ++i) {
+            const Site& site = sites[order[i]];
+            node.minX = std::min(node.minX, site.x);
+            node.minY = std::min(node.minY, site.y);
+            node.maxX = std::max(node.maxX, site.x);
+            node.maxY = std::max(node.maxY, site.y);
+        }
+        node.parent = parent;
+        node.begin = begin;
+        node.end = end;
+        node.live = end - begin;
+
+        if (end - begin <= LeafSize) {
+            for (int i = begin; i < end; ++i) {
+                sites[order[i]].leaf = index;
+            }
+        }
+        else {
+            bool splitX = node.maxX - node.minX >= node.maxY - node.minY;
+            int mid = begin + (end - begin) / 2;
+            std::nth_element(
+                order.begin() + begin,
+                order.begin() + mid,
+                order.begin() + end,
+                [this, splitX](int a, int b) {
+                    return splitX ? sites[a].x < sites[b].x : sites[a].y < sites[b].y;
                 }
-                else if (d < minDist - 0.1) {
-                    // Clearly closer, use it
-                    minDist = d;
-                    next = static_cast<int>(i);
-                    nextYDiff = yDiff;
+            );
+            node.left = build(begin, mid, index);
+            node.right = build(mid, end, index);
+        }
+        nodes[index] = node;
+        return index;
+    }
+
+    static double boxDistSquared(const Node& node, const TSPPoint& p)
+    {
+        double dx = std::max({node.minX - p.x, 0.0, p.x - node.maxX});
+        double dy = std::max({node.minY - p.y, 0.0, p.y - node.maxY});
+        return dx * dx + dy * dy;
+    }
+
+    template<typename Visit, typename Bound>
+    void walk(int index, const TSPPoint& p, const Visit& visit, const Bound& bound) const
+    {
+        const Node& node = nodes[index];
+        if (node.live == 0 || boxDistSquared(node, p) > bound()) {
+            return;
+        }
+        if (node.left < 0) {
+            for (int i = node.begin; i < node.end; ++i) {
+                const Site& site = sites[order[i]];
+                if (site.live > 0) {
+                    double dx = site.x - p.x;
+                    double dy = site.y - p.y;
+                    visit(site, dx * dx + dy * dy);
                 }
-                else if (yDiff < nextYDiff) {
-                    // Tie: prefer point closer to start in Y-axis
-                    minDist = d;
-                    next = static_cast<int>(i);
-                    nextYDiff = yDiff;
+            }
+            return;
+        }
+        int first = node.left;
+        int second = node.right;
+        if (boxDistSquared(nodes[second], p) < boxDistSquared(nodes[first], p)) {
+            std::swap(first, second);
+        }
+        walk(first, p, visit, bound);
+        walk(second, p, visit, bound);
+    }
+
+    std::vector<int> siteOf;   // Site of each entry, -1 if not in the tree
+    std::vector<int> members;  // Entries sorted by site
+    std::vector<Site> sites;
+    std::vector<int> order;    // Sites sorted by node
+    std::vector<Node> nodes;   // The root comes first
+    size_t live;
+};
+
+/**
+ * @brief Work queue and route edits shared by the local searches on neighbor lists
+ *
+ * Instead of trying all pairs of route positions, a move is only tried if it creates an edge
+ * towards one of the nearest neighbors of an element. Elements whose surroundings changed are
+ * put back into a work queue, so that the search converges after a few passes even on large
+ * inputs.
+ *
+ * The route holds the ids of the elements. The first element of the route stays in place, so
+ * does the last one if it is fixed.
+ */
+class RouteSearch
+{
+public:
+    void run(Budget& budget)
+    {
+        for (int node : route) {
+            activate(node);
+        }
+        size_t processed = 0;
+        if (!budget.nextPass()) {
+            return;
+        }
+        while (!queue.empty()) {
+            if (++processed > route.size()) {
+                processed = 1;
+                if (!budget.nextPass()) {
+                    break;
                 }
             }
+            else if (budget.expired()) {
+                break;
+            }
+            int node = queue.front();
+            queue.pop_front();
+            queued[node] = 0;
+            if (improve(node)) {
+                activate(node);
+            }
         }
+    }
 
-        if (next == -1) {
-            break;  // No more unvisited points
+protected:
+    RouteSearch(std::vector<int>& route, size_t ids, bool fixedEnd)
+        : route(route)
+        , position(ids, -1)
+        , queued(ids, 0)
+        , size(static_cast<int>(route.size()))
+        , lastMovable(fixedEnd ? size - 2 : size - 1)
+    {
+        for (int i = 0; i < size; ++i) {
+            position[route[i]] = i;
         }
-        route.push_back(next);
-        visited[next] = true;
     }
+    virtual ~RouteSearch() = default;
 
-    // Ensure temporary end point is at the end of route
-    if (tempEndIdx != -1 && route.back() != tempEndIdx) {
-        auto it = std::find(route.begin(), route.end(), tempEndIdx);
-        if (it != route.end()) {
-            route.erase(it);
+    /// Tries the moves around node, returns true if the route was changed
+    virtual bool improve(int node) = 0;
+
+    void activate(int node)
+    {
+        if (node >= 0 && !queued[node]) {
+            queued[node] = 1;
+            queue.push_back(node);
         }
-        route.push_back(tempEndIdx);
     }
 
-    // ========================================================================
-    // STEP 3: Iterative improvement using 2-Opt and Relocation
-    // ========================================================================
-    // Repeatedly apply local optimizations until no improvement is possible.
-    // This typically converges quickly (a few iterations) to a near-optimal solution.
-    //
-    // Two optimization techniques:
-    // 1. 2-Opt: Reverse segments of the route to eliminate crossing paths
-    // 2. Relocation: Move individual points to better positions in the route
-    //
-    // For open routes (no endPoint), additional optimizations are applied that
-    // allow reversing/relocating segments to the end of the route.
-    size_t limitReorderI = route.size() - 2;
-    if (tempEndIdx != -1) {
-        limitReorderI -= 1;
+    // Reverses the route between the positions first and last (inclusive)
+    void reverse(int first, int last)
+    {
+        std::reverse(route.begin() + first, route.begin() + last + 1);
+        for (int i = first; i <= last; ++i) {
+            position[route[i]] = i;
+        }
     }
-    size_t limitReorderJ = route.size();
-    size_t limitRelocationI = route.size() - 1;
-    size_t limitRelocationJ = route.size() - 1;
-    int lastImprovementAtStep = 0;
 
-    while (true) {
+    // Moves the section starting at first behind the element at position after
+    void moveSection(int first, int length, int after, bool reversed)
+    {
+        auto begin = route.begin();
+        int from = first;
+        int to = after;
+        int target = after - length + 1;
+        if (after < first) {
+            std::rotate(begin + after + 1, begin + first, begin + first + length);
+            from = after + 1;
+            to = first + length - 1;
+            target = after + 1;
+        }
+        else {
+            std::rotate(begin + first, begin + first + length, begin + after + 1);
+        }
+        if (reversed) {
+            std::reverse(begin + target, begin + target + length);
+        }
+        for (int i = from; i <= to; ++i) {
+            position[route[i]] = i;
+        }
+    }
 
-        // --- 2-Opt Optimization ---
-        // Try reversing every possible segment of the route.
-        // If reversing segment [i+1...j-1] reduces total distance, keep it.
-        //
-        // Example: Route A-B-C-D-E becomes A-D-C-B-E if reversing B-C-D is better
-        if (lastImprovementAtStep == 1) {
-            break;
+    std::vector<int>& route;
+    std::vector<int> position;  // Route position of each element
+    std::deque<int> queue;
+    std::vector<char> queued;
+    int size;
+    int lastMovable;  // Last route position a move may change
+};
+
+/**
+ * @brief Local search on a route of points restricted to the nearest neighbors of each point
+ *
+ * Two kinds of moves are used:
+ * - 2-Opt: reverse a section of the route, replacing two edges
+ * - Or-opt: move a section of up to three points, possibly reversed, to another place
+ */
+class NeighbourSearch: public RouteSearch
+{
+public:
+    NeighbourSearch(
+        const std::vector<TSPPoint>& pts,
+        std::vector<int>& route,
+        bool fixedEnd,
+        size_t neighbours
+    )
+        : RouteSearch(route, pts.size(), fixedEnd)
+        , pts(pts)
+        , candidates(pts.size())
+    {
+        std::vector<int> entries(route.begin(), route.end());
+        PointTree tree(pts, entries);
+        for (int node : route) {
+            candidates[node] = tree.nearest(pts[node], neighbours, node);
         }
-        bool reorderFound = true;
-        while (reorderFound) {
-            reorderFound = false;
-            for (size_t i = 0; i < limitReorderI; ++i) {
-                double subRouteLengthCurrentPart = dist(pts[route[i]], pts[route[i + 1]]);
+    }
 
-                for (size_t j = i + 3; j < limitReorderJ; ++j) {
-                    // Current edges: i→(i+1) and (j-1)→j
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j - 1]], pts[route[j]]);
+private:
+    double d(int a, int b) const
+    {
+        return dist(pts[a], pts[b]);
+    }
 
-                    // New edges after reversal: (i+1)→j and i→(j-1)
-                    // Add epsilon to prevent cycles from floating point errors
-                    double newLen = dist(pts[route[i + 1]], pts[route[j]])
-                        + dist(pts[route[i]], pts[route[j - 1]]) + Base::Precision::Confusion();
+    bool improve(int node) override
+    {
+        return twoOpt(node) || orOpt(node);
+    }
 
-                    if (newLen < curLen) {
-                        // Reverse the segment between i+1 and j (exclusive)
-                        std::reverse(route.begin() + i + 1, route.begin() + j);
-                        subRouteLengthCurrentPart = dist(pts[route[i]], pts[route[i + 1]]);
-                        reorderFound = true;
-                        lastImprovementAtStep = 1;
+    bool twoOpt(int a)
+    {
+        const double eps = Base::Precision::Confusion();
+        int i = position[a];
+
+        // Replace the edge to the successor b by an edge to a neighbor c
+        if (i + 1 < size) {
+            int b = route[i + 1];
+            double dab = d(a, b);
+            for (int c : candidates[a]) {
+                double dac = d(a, c);
+                if (dac + eps >= dab) {
+                    break;
+                }
+                int j = position[c];
+                if (j > i + 1 && j <= lastMovable) {
+                    // Reverse b...c, an open route may end with c
+                    int e = j + 1 < size ? route[j + 1] : -1;
+                    double gain = dab - dac + (e >= 0 ? d(c, e) - d(b, e) : 0.0);
+                    if (gain > eps) {
+                        reverse(i + 1, j);
+                        activate(b);
+                        activate(c);
+                        activate(e);
+                        return true;
                     }
                 }
+                else if (j + 1 < i) {
+                    // Reverse e...a
+                    int e = route[j + 1];
+                    double gain = d(c, e) + dab - dac - d(e, b);
+                    if (gain > eps) {
+                        reverse(j + 1, i);
+                        activate(b);
+                        activate(c);
+                        activate(e);
+                        return true;
+                    }
+                }
+            }
+        }
 
-                // Open route optimization: can reverse from i to end if no endpoint constraint
-                if (tempEndIdx == -1) {
-                    double curLen = dist(pts[route[i]], pts[route[i + 1]]);
-                    double newLen = dist(pts[route[i]], pts[route[limitReorderJ - 1]])
-                        + Base::Precision::Confusion();
-
-                    if (newLen < curLen) {
-                        // Reverse the order of points after i-th to the last point
-                        std::reverse(route.begin() + i + 1, route.begin() + limitReorderJ);
-                        reorderFound = true;
-                        lastImprovementAtStep = 1;
+        // Replace the edge to the predecessor p by an edge to a neighbor c
+        if (i >= 1) {
+            int p = route[i - 1];
+            double dpa = d(p, a);
+            for (int c : candidates[a]) {
+                double dac = d(a, c);
+                if (dac + eps >= dpa) {
+                    break;
+                }
+                int j = position[c];
+                if (j >= 1 && j + 1 < i) {
+                    // Reverse c...p
+                    int q = route[j - 1];
+                    double gain = d(q, c) + dpa - d(q, p) - dac;
+                    if (gain > eps) {
+                        reverse(j, i - 1);
+                        activate(p);
+                        activate(c);
+                        activate(q);
+                        return true;
+                    }
+                }
+                else if (j > i + 1) {
+                    // Reverse a...q
+                    int q = route[j - 1];
+                    double gain = dpa + d(q, c) - d(p, q) - dac;
+                    if (gain > eps) {
+                        reverse(i, j - 1);
+                        activate(p);
+                        activate(c);
+                        activate(q);
+                        return true;
                     }
                 }
             }
         }
+        return false;
+    }
 
-        // --- Relocation Optimization ---
-        // Try moving each point to a different position in the route.
-        // If moving point i to position j improves the route, do it.
-        if (lastImprovementAtStep == 2) {
-            break;
+    bool orOpt(int node)
+    {
+        int i = position[node];
+        for (int length = 1; length <= 3; ++length) {
+            if (tryMoveSection(i, length)
+                || (length > 1 && tryMoveSection(i - length + 1, length))) {
+                return true;
+            }
         }
-        bool relocateFound = true;
-        while (relocateFound) {
-            relocateFound = false;
-            for (size_t i = 1; i < limitRelocationI; ++i) {
-                double subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
-                    + dist(pts[route[i]], pts[route[i + 1]]);
-                double subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
-                    + Base::Precision::Confusion();
+        return false;
+    }
 
-                // Try moving point i backward (to positions before i)
-                for (size_t j = 0; j + 2 < i; ++j) {
-                    // Current cost: edges around point i and edge j→(j+1)
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j]], pts[route[j + 1]]);
+    // Tries to move the section of length points starting at first next to a neighbor
+    bool tryMoveSection(int first, int length)
+    {
+        const double eps = Base::Precision::Confusion();
+        int last = first + length - 1;
+        if (first < 1 || last > lastMovable) {
+            return false;
+        }
+        int s = route[first];
+        int e = route[last];
+        int p = route[first - 1];
+        int n = last + 1 < size ? route[last + 1] : -1;
+        double removeGain = d(p, s) + (n >= 0 ? d(e, n) - d(p, n) : 0.0);
+        if (removeGain <= eps) {
+            return false;
+        }
 
-                    // New cost: bypass i, insert i after j
-                    double newLen = subRouteLengthNewPart + dist(pts[route[j]], pts[route[i]])
-                        + dist(pts[route[i]], pts[route[j + 1]]);
+        for (int end : {s, e}) {
+            for (int c : candidates[end]) {
+                if (d(end, c) >= removeGain) {
+                    break;
+                }
+                int k = position[c];
+                if (k >= first && k <= last) {
+                    continue;
+                }
+                // Insert between c and its predecessor or successor
+                for (int after : {k - 1, k}) {
+                    if (after < 0 || after == first - 1 || (after >= first && after <= last)
+                        || after > lastMovable) {
+                        continue;
+                    }
+                    int u = route[after];
+                    int v = after + 1 < size ? route[after + 1] : -1;
+                    double edge = v >= 0 ? d(u, v) : 0.0;
+                    double forward = d(u, s) + (v >= 0 ? d(e, v) : 0.0) - edge;
+                    double backward = d(u, e) + (v >= 0 ? d(s, v) : 0.0) - edge;
+                    bool reversed = backward < forward;
+                    if (removeGain - std::min(forward, backward) > eps) {
+                        moveSection(first, length, after, reversed);
+                        activate(s);
+                        activate(e);
+                        activate(p);
+                        activate(n);
+                        activate(u);
+                        activate(v);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
 
-                    if (newLen < curLen) {
-                        // Move point i to position after j
-                        int node = route[i];
-                        route.erase(route.begin() + i);
-                        route.insert(route.begin() + j + 1, node);
-                        subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
-                            + dist(pts[route[i]], pts[route[i + 1]]);
-                        subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
-                            + Base::Precision::Confusion();
-                        relocateFound = true;
-                        lastImprovementAtStep = 2;
-                    }
-                }
-
-                // Try moving point i forward (to positions after i)
-                for (size_t j = i + 1; j < limitRelocationJ; ++j) {
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j]], pts[route[j + 1]]);
+    const std::vector<TSPPoint>& pts;
+    std::vector<std::vector<int>> candidates;  // Nearest neighbors of each point
+};
 
-                    double newLen = subRouteLengthNewPart + dist(pts[route[j]], pts[route[i]])
-                        + dist(pts[route[i]], pts[route[j + 1]]);
-
-                    if (newLen < curLen) {
-                        int node = route[i];
-                        route.erase(route.begin() + i);
-                        route.insert(route.begin() + j, node);
-                        subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
-                            + dist(pts[route[i]], pts[route[i + 1]]);
-                        subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
-                            + Base::Precision::Confusion();
-                        relocateFound = true;
-                        lastImprovementAtStep = 2;
-                    }
+/**
+ * @brief Build and improve a route using a k-d tree and neighbor lists
+ *
+ * Used for large inputs, where comparing all pairs of route positions takes too long.
+ * The first point is the start of the route. If fixedEnd is set, the last point is the end of
+ * the route. If the time limit passes while the route is built, the remaining points are
+ * appended in the order of the tree and the route isn't improved.
+ *
+ * @param pts Points to visit, including the temporary start/end points
+ * @param fixedEnd Whether the last point has to stay at the end
+ * @param options Number of candidates per point
+ * @param budget Limits of the solver
+ * @return Route as indices into pts
+ */
+std::vector<int> buildRouteWithNeighbours(
+    const std::vector<TSPPoint>& pts,
+    bool fixedEnd,
+    const TSPOptions& options,
+    Budget& budget
+)
+{
+    const int count = static_cast<int>(pts.size());
+    const int last = fixedEnd ? count - 1 : count;
+
+    // Nearest neighbor route using the same tie-breaking rule as the exhaustive search. The end
+    // point doesn't take part and is appended at the end.
+    std::vector<int> entries;
+    entries.reserve(count);
+    for (int i = 1; i < last; ++i) {
+        entries.push_back(i);
+    }
+    std::vector<int> route;
+    route.reserve(count);
+    route.push_back(0);
+
+    PointTree tree(pts, entries);
+    while (tree.size() > 0) {
+        if (budget.expired()) {
+            std::vector<int> rest = tree.entries();
+            route.insert(route.end(), rest.begin(), rest.end());
+            break;
+        }
+        const TSPPoint& current = pts[route.back()];
+        double minDist = std::numeric_limits<double>::max();
+        int next = -1;
+        double nextYDiff = std::numeric_limits<double>::max();
+        tree.search(
+            current,
+            [&](int i, double d) {
+                double yDiff = std::abs(pts[route.front()].y - pts[i].y);
+                if (d > minDist + 0.1) {
+                    return;
                 }
-            }
-
-            // Open route optimization: can relocate the last point anywhere
-            if (tempEndIdx == -1) {
-                double subRouteLengthCurrentPart
-                    = dist(pts[route[route.size() - 2]], pts[route[route.size() - 1]]);
-
-                for (size_t j = 0; j + 2 < route.size(); ++j) {
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j]], pts[route[j + 1]]);
-
-                    double newLen = dist(pts[route[j]], pts[route[route.size() - 1]])
-                        + dist(pts[route[route.size() - 1]], pts[route[j + 1]])
-                        + Base::Precision::Confusion();
-
-                    if (newLen < curLen) {
-                        // Relocate the last point after j-th point
-                        int node = route[route.size() - 1];
-                        route.erase(route.begin() + route.size() - 1);
-                        route.insert(route.begin() + j + 1, node);
-                        subRouteLengthCurrentPart
-                            = dist(pts[route[route.size() - 2]], pts[route[route.size() - 1]]);
-                        relocateFound = true;
-                        lastImprovementAtStep = 2;
-                    }
+                if (d < minDist - 0.1 || yDiff < nextYDiff) {
+                    minDist = d;
+                    next = i;
+                    nextYDiff = yDiff;
                 }
-            }
-        }
-
-        if (lastImprovementAtStep == 0) {
-            break;  // No additional improvements could be made
-        }
+            },
+            [&]() { return minDist + 0.1; }
+        );
+        route.push_back(next);
+        tree.remove(next);
     }
-
-    // ========================================================================
-    // STEP 4: Remove temporary start/end points
-    // ========================================================================
-    // The temporary markers served their purpose during optimization.
-    // Now remove them so they don't appear in the final result.
-    if (tempEndIdx != -1 && !route.empty() && route.back() == tempEndIdx) {
-        route.pop_back();
+    if (fixedEnd) {
+        route.push_back(count - 1);
     }
-    if (tempStartIdx != -1 && !route.empty() && route.front() == tempStartIdx) {
-        route.erase(route.begin());
+    if (budget.timeIsUp()) {
+        return route;
     }
 
-    // ========================================================================
-    // STEP 5: Map route indices back to original point array
-    // ========================================================================
-    // Since we inserted a temp start point at index 0, all subsequent indices
-    // are offset by 1. Adjust them back to match the original points array.
-    std::vector<int> result;
-    for (int idx : route) {
-        // Adjust for temp start offset
-        if (tempStartIdx != -1) {
-            --idx;
-        }
-        // Only include valid indices from the original points array
-        if (idx >= 0 && idx < static_cast<int>(points.size())) {
-            result.push_back(idx);
-        }
-    }
-    return result;
+    size_t neighbours = static_cast<size_t>(std::max(options.neighbours, 1));
+    NeighbourSearch search(pts, route, fixedEnd, neighbours);
+    search.run(budget);
+    return route;
 }
-}  // namespace
 
 /**
- * @brief Solve the Traveling Salesperson Problem using 2-opt algorithm
+ * @brief Append the tunnels to the route in nearest neighbor order using a k-d tree
  *
- * This implementation handles optional start and end point constraints:
- * - If startPoint is provided, the path will begin at the point closest to startPoint
- * - If endPoint is provided, the path will end at the point closest to endPoint
- * - If both are provided, the path will respect both constraints while optimizing the middle path
- * - The algorithm ensures all points are visited exactly once
+ * Same result as the exhaustive nearest neighbor search of solveTunnels, up to ties, but
+ * without scanning all remaining tunnels for each step. If the time limit passes, the remaining
+ * tunnels are appended unflipped in the order of the tree.
  */
-
-
-std::vector<int> TSPSolver::solve(
-    const std::vector<TSPPoint>& points,
-    const TSPPoint* startPoint,
-    const TSPPoint* endPoint
+void appendNearestTunnels(
+    std::vector<TSPTunnel>& route,
+    std::vector<TSPTunnel>& tunnels,
+    bool allowFlipping,
+    Budget& budget
 )
 {
-    return solve_impl(points, startPoint, endPoint);
+    // Entry 2 * i is the start of the i-th tunnel, entry 2 * i + 1 its end if it can be flipped.
+    // The starts come first, so that they are preferred at the same position.
+    std::vector<TSPPoint> positions;
+    std::vector<int> entries;
+    positions.reserve(2 * tunnels.size());
+    entries.reserve(2 * tunnels.size());
+    for (size_t i = 0; i < tunnels.size(); ++i) {
+        positions.emplace_back(tunnels[i].startX, tunnels[i].startY);
+        positions.emplace_back(tunnels[i].endX, tunnels[i].endY);
+        entries.push_back(static_cast<int>(2 * i));
+    }
+    for (size_t i = 0; i < tunnels.size(); ++i) {
+        if (allowFlipping && tunnels[i].isOpen) {
+            entries.push_back(static_cast<int>(2 * i + 1));
+        }
+    }
+
+    PointTree tree(positions, entries);
+    while (tree.size() > 0) {
+        if (budget.expired()) {
+            std::vector<char> added(tunnels.size(), 0);
+            for (int e : tree.entries()) {
+                if (!added[e / 2]) {
+                    added[e / 2] = 1;
+                    route.push_back(tunnels[e / 2]);
+                }
+            }
+            break;
+        }
+        TSPPoint current(route.back().endX, route.back().endY);
+        double costCurrent = std::numeric_limits<double>::max();
+        int nearest = -1;
+        tree.search(
+            current,
+            [&](int e, double cost) {
+                // Prefer the normal orientation and the lower index on ties
+                bool tie = cost == costCurrent
+                    && (e % 2 < nearest % 2 || (e % 2 == nearest % 2 && e < nearest));
+                if (cost < costCurrent || tie) {
+                    costCurrent = cost;
+                    nearest = e;
+                }
+            },
+            [&]() { return costCurrent; }
+        );
+
+        TSPTunnel& tunnel = tunnels[nearest / 2];
+        if (nearest % 2 == 1) {
+            tunnel.flipped = !tunnel.flipped;
+            std::swap(tunnel.startX, tunnel.endX);
+            std::swap(tunnel.startY, tunnel.endY);
+        }
+        route.push_back(tunnel);
+        tree.remove(nearest - nearest % 2);
+        tree.remove(nearest - nearest % 2 + 1);
+    }
 }
 
-std::vector<TSPTunnel> TSPSolver::solveTunnels(
-    std::vector<TSPTunnel> tunnels,
-    bool allowFlipping,
-    const TSPPoint* routeStartPoint,
-    const TSPPoint* routeEndPoint
-)
+/**
+ * @brief Local search on a route of tunnels restricted to the nearest neighbors of each end
+ *
+ * The edge from a tunnel to the next one runs from the end of the first to the start of the
+ * second tunnel. The candidates of a tunnel end are the tunnel ends closest to it, so a move is
+ * only tried if it creates an edge between nearby tunnel ends. These moves are used:
+ * - Flip: reverse a single open tunnel (only if flipping is allowed)
+ * - 2-Opt: reverse a section of the route and flip its open tunnels (only if flipping is allowed)
+ * - Relocation: move a section of up to three tunnels to another place
+ *
+ * The tunnels are changed in place and the route holds their indices.
+ */
+class TunnelSearch: public RouteSearch
 {
-    if (tunnels.empty()) {
-        return tunnels;
+public:
+    TunnelSearch(
+        std::vector<TSPTunnel>& tunnels,
+        std::vector<int>& route,
+        bool fixedEnd,
+        bool allowFlipping,
+        size_t neighbours
+    )
+        : RouteSearch(route, tunnels.size(), fixedEnd)
+        , tunnels(tunnels)
+        , turned(tunnels.size(), 0)
+        , candidates(2 * tunnels.size())
+        , allowFlipping(allowFlipping)
+    {
+        // Entry 2 * i is the start of the i-th tunnel, entry 2 * i + 1 its end
+        std::vector<int> entries(2 * tunnels.size());
+        for (size_t i = 0; i < tunnels.size(); ++i) {
+            ends.emplace_back(tunnels[i].startX, tunnels[i].startY);
+            ends.emplace_back(tunnels[i].endX, tunnels[i].endY);
+            entries[2 * i] = static_cast<int>(2 * i);
+            entries[2 * i + 1] = static_cast<int>(2 * i + 1);
+        }
+        PointTree tree(ends, entries);
+        for (int e : entries) {
+            // The other end of the same tunnel is no candidate
+            candidates[e] = tree.nearest(ends[e], neighbours + 1, e);
+            auto other = std::find(candidates[e].begin(), candidates[e].end(), e ^ 1);
+            if (other != candidates[e].end()) {
+                candidates[e].erase(other);
+            }
+            else if (candidates[e].size() > neighbours) {
+                candidates[e].pop_back();
+            }
+        }
     }
 
-    // Set original indices
-    for (size_t i = 0; i < tunnels.size(); ++i) {
-        tunnels[i].index = static_cast<int>(i);
+private:
+    // Entry of the current start and end of a tunnel
+    int startOf(int t) const
+    {
+        return 2 * t + turned[t];
+    }
+    int endOf(int t) const
+    {
+        return 2 * t + 1 - turned[t];
     }
 
-    // STEP 1: Add the routeStartPoint (will be deleted at the end)
-    if (routeStartPoint) {
-        tunnels.insert(
-            tunnels.begin(),
-            TSPTunnel(routeStartPoint->x, routeStartPoint->y, routeStartPoint->x, routeStartPoint->y, false)
-        );
+    double d(int entryA, int entryB) const
+    {
+        return dist(ends[entryA], ends[entryB]);
     }
-    else {
-        tunnels.insert(tunnels.begin(), TSPTunnel(0.0, 0.0, 0.0, 0.0, false));
+
+    // Length of the edge from tunnel a to tunnel b
+    double edge(int a, int b) const
+    {
+        return d(endOf(a), startOf(b));
     }
 
-    // STEP 2: Apply nearest neighbor algorithm
-    std::vector<TSPTunnel> potentialNeighbours(tunnels.begin() + 1, tunnels.end());
-    std::vector<TSPTunnel> route;
-    route.push_back(tunnels[0]);
+    bool improve(int node) override
+    {
+        return (allowFlipping && (flip(node) || twoOpt(node))) || relocate(node);
+    }
 
-    while (!potentialNeighbours.empty()) {
-        double costCurrent = std::numeric_limits<double>::max();
-        bool toBeFlipped = false;
-        auto nearestNeighbour = potentialNeighbours.begin();
+    void turn(int t)
+    {
+        TSPTunnel& tunnel = tunnels[t];
+        tunnel.flipped = !tunnel.flipped;
+        std::swap(tunnel.startX, tunnel.endX);
+        std::swap(tunnel.startY, tunnel.endY);
+        turned[t] ^= 1;
+    }
 
-        // Check normal orientation
-        for (auto it = potentialNeighbours.begin(); it != potentialNeighbours.end(); ++it) {
-            double dx = route.back().endX - it->startX;
-            double dy = route.back().endY - it->startY;
-            double costNew = dx * dx + dy * dy;
+    // Whether reversing the section keeps the edges inside, i.e. the tunnels that can't be
+    // flipped start and end at the same place
+    bool canReverse(int first, int last) const
+    {
+        for (int i = first; i <= last; ++i) {
+            const TSPTunnel& tunnel = tunnels[route[i]];
+            if (!tunnel.isOpen && (tunnel.startX != tunnel.endX || tunnel.startY != tunnel.endY)) {
+                return false;
+            }
+        }
+        return true;
+    }
 
-            if (costNew < costCurrent) {
-                costCurrent = costNew;
-                toBeFlipped = false;
-                nearestNeighbour = it;
+    // Reverses the route between the positions first and last and flips the open tunnels there
+    void reverseTunnels(int first, int last)
+    {
+        reverse(first, last);
+        for (int i = first; i <= last; ++i) {
+            if (tunnels[route[i]].isOpen) {
+                turn(route[i]);
             }
         }
+    }
 
-        // Check flipped orientation if allowed
-        if (allowFlipping) {
-            for (auto it = potentialNeighbours.begin(); it != potentialNeighbours.end(); ++it) {
-                if (it->isOpen) {
-                    double dx = route.back().endX - it->endX;
-                    double dy = route.back().endY - it->endY;
-                    double costNew = dx * dx + dy * dy;
+    bool flip(int a)
+    {
+        const double eps = Base::Precision::Confusion();
+        int i = position[a];
+        if (!tunnels[a].isOpen || i < 1 || i > lastMovable) {
+            return false;
+        }
+        int p = route[i - 1];
+        int n = i + 1 < size ? route[i + 1] : -1;
+        double current = edge(p, a) + (n >= 0 ? edge(a, n) : 0.0);
+        double flipped = d(endOf(p), endOf(a)) + (n >= 0 ? d(startOf(a), startOf(n)) : 0.0);
+        if (current - flipped > eps) {
+            turn(a);
+            activate(p);
+            activate(n);
+            return true;
+        }
+        return false;
+    }
 
-                    if (costNew < costCurrent) {
-                        costCurrent = costNew;
-                        toBeFlipped = true;
-                        nearestNeighbour = it;
+    bool twoOpt(int a)
+    {
+        const double eps = Base::Precision::Confusion();
+        int i = position[a];
+
+        // Replace the edge to the successor b by an edge from the end of a to the end of c
+        if (i + 1 < size) {
+            int b = route[i + 1];
+            double dab = edge(a, b);
+            for (int x : candidates[endOf(a)]) {
+                double dac = d(endOf(a), x);
+                if (dac + eps >= dab) {
+                    break;
+                }
+                int c = x / 2;
+                int j = position[c];
+                if (x != endOf(c)) {
+                    continue;
+                }
+                if (j > i + 1 && j <= lastMovable) {
+                    // Reverse b...c, an open route may end with c
+                    int e = j + 1 < size ? route[j + 1] : -1;
+                    double gain = dab - dac
+                        + (e >= 0 ? edge(c, e) - d(startOf(b), startOf(e)) : 0.0);
+                    if (gain > eps && canReverse(i + 1, j)) {
+                        reverseTunnels(i + 1, j);
+                        activate(b);
+                        activate(c);
+                        activate(e);
+                        return true;
+                    }
+                }
+                else if (j + 1 < i && i <= lastMovable) {
+                    // Reverse f...a
+                    int f = route[j + 1];
+                    double gain = edge(c, f) + dab - dac - d(startOf(f), startOf(b));
+                    if (gain > eps && canReverse(j + 1, i)) {
+                        reverseTunnels(j + 1, i);
+                        activate(b);
+                        activate(c);
+                        activate(f);
+                        return true;
                     }
                 }
             }
         }
 
-        // Apply flipping if needed
-        if (toBeFlipped) {
-            nearestNeighbour->flipped = !nearestNeighbour->flipped;
-            std::swap(nearestNeighbour->startX, nearestNeighbour->endX);
-            std::swap(nearestNeighbour->startY, nearestNeighbour->endY);
+        // Replace the edge from the predecessor p by an edge from the start of c to the start of a
+        if (i >= 1) {
+            int p = route[i - 1];
+            double dpa = edge(p, a);
+            for (int x : candidates[startOf(a)]) {
+                double dac = d(startOf(a), x);
+                if (dac + eps >= dpa) {
+                    break;
+                }
+                int c = x / 2;
+                int j = position[c];
+                if (x != startOf(c)) {
+                    continue;
+                }
+                if (j >= 1 && j + 1 < i) {
+                    // Reverse c...p
+                    int q = route[j - 1];
+                    double gain = edge(q, c) + dpa - d(endOf(q), endOf(p)) - dac;
+                    if (gain > eps && canReverse(j, i - 1)) {
+                        reverseTunnels(j, i - 1);
+                        activate(p);
+                        activate(c);
+                        activate(q);
+                        return true;
+                    }
+                }
+                else if (j > i + 1 && j - 1 <= lastMovable) {
+                    // Reverse a...q
+                    int q = route[j - 1];
+                    double gain = dpa + edge(q, c) - d(endOf(p), endOf(q)) - dac;
+                    if (gain > eps && canReverse(i, j - 1)) {
+                        reverseTunnels(i, j - 1);
+                        activate(p);
+                        activate(c);
+                        activate(q);
+                        return true;
+                    }
+                }
+            }
         }
-
-        route.push_back(*nearestNeighbour);
-        potentialNeighbours.erase(nearestNeighbour);
-    }
-
-    // STEP 3: Add the routeEndPoint (will be deleted at the end)
-    if (routeEndPoint) {
-        route.push_back(
-            TSPTunnel(routeEndPoint->x, routeEndPoint->y, routeEndPoint->x, routeEndPoint->y, false)
-        );
+        return false;
     }
 
-    // STEP 4: Additional improvement of the route
-    size_t limitReorderI = route.size() - 2;
-    if (routeEndPoint) {
-        limitReorderI -= 1;
+    bool relocate(int a)
+    {
+        int i = position[a];
+        for (int length = 1; length <= 3; ++length) {
+            if (tryMoveSection(i, length)
+                || (length > 1 && tryMoveSection(i - length + 1, length))) {
+                return true;
+            }
+        }
+        return false;
     }
-    size_t limitReorderJ = route.size();
-    size_t limitFlipI = route.size() - 1;
-    size_t limitRelocationI = route.size() - 1;
-    size_t limitRelocationJ = route.size() - 1;
-    int lastImprovementAtStep = 0;
 
-    while (true) {
+    // Tries to move the section of length tunnels starting at first after a tunnel whose end is
+    // close to the start of the section, or before a tunnel whose start is close to its end
+    bool tryMoveSection(int first, int length)
+    {
+        const double eps = Base::Precision::Confusion();
+        int last = first + length - 1;
+        if (first < 1 || last > lastMovable) {
+            return false;
+        }
+        int s = route[first];
+        int e = route[last];
+        int p = route[first - 1];
+        int n = last + 1 < size ? route[last + 1] : -1;
+        double removeGain = edge(p, s) + (n >= 0 ? edge(e, n) - edge(p, n) : 0.0);
+        if (removeGain <= eps) {
+            return false;
+        }
 
-        if (allowFlipping) {
-            // STEP 4.1: Apply 2-opt
-            if (lastImprovementAtStep == 1) {
+        auto insertAfter = [&](int k) {
+            if (k < 0 || k == first - 1 || (k >= first && k <= last) || k > lastMovable) {
+                return false;
+            }
+            int u = route[k];
+            int v = k + 1 < size ? route[k + 1] : -1;
+            double addCost = edge(u, s) + (v >= 0 ? edge(e, v) - edge(u, v) : 0.0);
+            if (removeGain - addCost <= eps) {
+                return false;
+            }
+            moveSection(first, length, k, false);
+            activate(s);
+            activate(e);
+            activate(p);
+            activate(n);
+            activate(u);
+            activate(v);
+            return true;
+        };
+
+        for (int x : candidates[startOf(s)]) {
+            if (d(startOf(s), x) >= removeGain) {
                 break;
             }
-            bool improvementFound = true;
-            while (improvementFound) {
-                improvementFound = false;
-                for (size_t i = 0; i < limitReorderI; ++i) {
-                    double subRouteLengthCurrentPart = std::sqrt(
-                        std::pow(route[i].endX - route[i + 1].startX, 2)
-                        + std::pow(route[i].endY - route[i + 1].startY, 2)
-                    );
-                    for (size_t j = i + 3; j < limitReorderJ; ++j) {
-                        double subRouteLengthCurrent = subRouteLengthCurrentPart;
+            int c = x / 2;
+            if (x == endOf(c) && insertAfter(position[c])) {
+                return true;
+            }
+        }
+        for (int x : candidates[endOf(e)]) {
+            if (d(endOf(e), x) >= removeGain) {
+                break;
+            }
+            int c = x / 2;
+            if (x == startOf(c) && insertAfter(position[c] - 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<TSPTunnel>& tunnels;
+    std::vector<TSPPoint> ends;                // Start and end of each tunnel as given
+    std::vector<char> turned;                  // Whether a tunnel was flipped by the search
+    std::vector<std::vector<int>> candidates;  // Nearest tunnel ends of each tunnel end
+    bool allowFlipping;
+};
+
+/**
+ * @brief Improve a route of tunnels using neighbor lists of the tunnel ends
+ *
+ * Used for large tunnel sets, where comparing all pairs of route positions takes too long.
+ *
+ * @param route Tunnels including the temporary start/end tunnels
+ * @param allowFlipping Whether tunnels can be reversed
+ * @param fixedEnd Whether the last tunnel has to stay at the end
+ * @param options Number of candidates per tunnel end
+ * @param budget Limits of the solver
+ */
+void improveTunnelsWithNeighbours(
+    std::vector<TSPTunnel>& route,
+    bool allowFlipping,
+    bool fixedEnd,
+    const TSPOptions& options,
+    Budget& budget
+)
+{
+    std::vector<int> order(route.size());
+    for (size_t i = 0; i < route.size(); ++i) {
+        order[i] = static_cast<int>(i);
+    }
+    std::vector<TSPTunnel> tunnels = route;
+    size_t neighbours = static_cast<size_t>(std::max(options.neighbours, 1));
+    TunnelSearch search(tunnels, order, fixedEnd, allowFlipping, neighbours);
+    search.run(budget);
+    for (size_t i = 0; i < order.size(); ++i) {
+        route[i] = tunnels[order[i]];
+    }
+}
+
+/**
+ * @brief Improve a route of tunnels by comparing all pairs of route positions
+ *
+ * Applies 2-opt and flipping (if allowed) and relocation until none of them finds an
+ * improvement.
+ *
+ * @param route Tunnels including the temporary start/end tunnels
+ * @param allowFlipping Whether tunnels can be reversed
+ * @param fixedEnd Whether the last tunnel has to stay at the end
+ * @param budget Limits of the improvement phase
+ */
+void improveTunnelsExhaustive(
+    std::vector<TSPTunnel>& route,
+    bool allowFlipping,
+    bool fixedEnd,
+    Budget& budget
+)
+{
+    size_t limitReorderI = route.size() - 2;
+    if (fixedEnd) {
+        limitReorderI -= 1;
+    }
+    size_t limitReorderJ = route.size();
+    size_t limitFlipI = route.size() - 1;
+    size_t limitRelocationI = route.size() - 1;
+    size_t limitRelocationJ = route.size() - 1;
+    int lastImprovementAtStep = 0;
+
+    while (true) {
+
+        if (allowFlipping) {
+            // STEP 4.1: Apply 2-opt
+            if (lastImprovementAtStep == 1) {
+                break;
+            }
+            bool improvementFound = true;
+            while (improvementFound && budget.nextPass()) {
+                improvementFound = false;
+                for (size_t i = 0; i < limitReorderI && !budget.expired(); ++i) {
+                    double subRouteLengthCurrentPart = std::sqrt(
+                        std::pow(route[i].endX - route[i + 1].startX, 2)
+                        + std::pow(route[i].endY - route[i + 1].startY, 2)
+                    );
+                    for (size_t j = i + 3; j < limitReorderJ; ++j) {
+                        double subRouteLengthCurrent = subRouteLengthCurrentPart;
                         subRouteLengthCurrent += std::sqrt(
                             std::pow(route[j - 1].endX - route[j].startX, 2)
                             + std::pow(route[j - 1].endY - route[j].startY, 2)
@@ -533,7 +1240,7 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
                             lastImprovementAtStep = 1;
                         }
                     }
-                    if (!routeEndPoint) {
+                    if (!fixedEnd) {
                         double subRouteLengthCurrent = std::sqrt(
                             std::pow(route[i].endX - route[i + 1].startX, 2)
                             + std::pow(route[i].endY - route[i + 1].startY, 2)
@@ -566,9 +1273,9 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
                 break;
             }
             improvementFound = true;
-            while (improvementFound) {
+            while (improvementFound && budget.nextPass()) {
                 improvementFound = false;
-                for (size_t i = 1; i < limitFlipI; ++i) {
+                for (size_t i = 1; i < limitFlipI && !budget.expired(); ++i) {
                     if (route[i].isOpen) {
                         double subRouteLengthCurrent = std::sqrt(
                             std::pow(route[i - 1].endX - route[i].startX, 2)
@@ -599,7 +1306,7 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
                         }
                     }
                 }
-                if (!routeEndPoint) {
+                if (!fixedEnd) {
                     if (route[route.size() - 1].isOpen) {
                         double subRouteLengthCurrent = std::sqrt(
                             std::pow(route[route.size() - 2].endX - route[route.size() - 1].startX, 2)
@@ -628,9 +1335,9 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
             break;
         }
         bool improvementFound = true;
-        while (improvementFound) {
+        while (improvementFound && budget.nextPass()) {
             improvementFound = false;
-            for (size_t i = 1; i < limitRelocationI; ++i) {
+            for (size_t i = 1; i < limitRelocationI && !budget.expired(); ++i) {
                 double subRouteLengthCurrentPart = std::sqrt(
                     std::pow(route[i - 1].endX - route[i].startX, 2)
                     + std::pow(route[i - 1].endY - route[i].startY, 2)
@@ -723,7 +1430,7 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
                     }
                 }
             }
-            if (!routeEndPoint) {
+            if (!fixedEnd) {
                 double subRouteLengthCurrentPart = std::sqrt(
                     std::pow(route[route.size() - 2].endX - route[route.size() - 1].startX, 2)
                     + std::pow(route[route.size() - 2].endY - route[route.size() - 1].startY, 2)
@@ -763,6 +1470,466 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
             break;  // No additional improvements could be made
         }
     }
+}
+
+/**
+ * @brief Build and improve a route by comparing all pairs of route positions
+ *
+ * The first point is the start of the route. If tempEndIdx is set, that point is moved to the
+ * end of the route and stays there.
+ *
+ * @param pts Points to visit, including the temporary start/end points
+ * @param tempEndIdx Index of the temporary end point or -1
+ * @param budget Limits of the improvement phase
+ * @return Route as indices into pts
+ */
+std::vector<int> buildRouteExhaustive(
+    const std::vector<TSPPoint>& pts,
+    int tempEndIdx,
+    Budget& budget
+)
+{
+    // ========================================================================
+    // STEP 2: Build initial route using Nearest Neighbor algorithm
+    // ========================================================================
+    // Greedy approach: always visit the closest unvisited point next.
+    // This gives a decent initial solution quickly (O(n²) complexity).
+    //
+    // Tie-breaking rule:
+    // - If distances are within ±0.1, prefer point with y-value closer to start
+    // - This provides deterministic results when points are nearly equidistant
+    std::vector<int> route;
+    std::vector<bool> visited(pts.size(), false);
+    route.push_back(0);  // Start from temp start point (index 0)
+    visited[0] = true;
+
+    for (size_t step = 1; step < pts.size(); ++step) {
+        double minDist = std::numeric_limits<double>::max();
+        int next = -1;
+        double nextYDiff = std::numeric_limits<double>::max();
+
+        // Find nearest unvisited neighbor
+        for (size_t i = 0; i < pts.size(); ++i) {
+            if (!visited[i]) {
+                // Use squared distance for speed (no sqrt needed for comparison)
+                double d = distSquared(pts[route.back()], pts[i]);
+                double yDiff = std::abs(pts[route.front()].y - pts[i].y);
+
+                // Tie-breaking logic:
+                if (d > minDist + 0.1) {
+                    continue;  // Clearly farther, skip
+                }
+                else if (d < minDist - 0.1) {
+                    // Clearly closer, use it
+                    minDist = d;
+                    next = static_cast<int>(i);
+                    nextYDiff = yDiff;
+                }
+                else if (yDiff < nextYDiff) {
+                    // Tie: prefer point closer to start in Y-axis
+                    minDist = d;
+                    next = static_cast<int>(i);
+                    nextYDiff = yDiff;
+                }
+            }
+        }
+
+        if (next == -1) {
+            break;  // No more unvisited points
+        }
+        route.push_back(next);
+        visited[next] = true;
+    }
+
+    // Ensure temporary end point is at the end of route
+    if (tempEndIdx != -1 && route.back() != tempEndIdx) {
+        auto it = std::find(route.begin(), route.end(), tempEndIdx);
+        if (it != route.end()) {
+            route.erase(it);
+        }
+        route.push_back(tempEndIdx);
+    }
+
+    // ========================================================================
+    // STEP 3: Iterative improvement using 2-Opt and Relocation
+    // ========================================================================
+    // Repeatedly apply local optimizations until no improvement is possible.
+    // This typically converges quickly (a few iterations) to a near-optimal solution.
+    //
+    // Two optimization techniques:
+    // 1. 2-Opt: Reverse segments of the route to eliminate crossing paths
+    // 2. Relocation: Move individual points to better positions in the route
+    //
+    // For open routes (no endPoint), additional optimizations are applied that
+    // allow reversing/relocating segments to the end of the route.
+    size_t limitReorderI = route.size() - 2;
+    if (tempEndIdx != -1) {
+        limitReorderI -= 1;
+    }
+    size_t limitReorderJ = route.size();
+    size_t limitRelocationI = route.size() - 1;
+    size_t limitRelocationJ = route.size() - 1;
+    int lastImprovementAtStep = 0;
+
+    while (true) {
+
+        // --- 2-Opt Optimization ---
+        // Try reversing every possible segment of the route.
+        // If reversing segment [i+1...j-1] reduces total distance, keep it.
+        //
+        // Example: Route A-B-C-D-E becomes A-D-C-B-E if reversing B-C-D is better
+        if (lastImprovementAtStep == 1) {
+            break;
+        }
+        bool reorderFound = true;
+        while (reorderFound && budget.nextPass()) {
+            reorderFound = false;
+            for (size_t i = 0; i < limitReorderI && !budget.expired(); ++i) {
+                double subRouteLengthCurrentPart = dist(pts[route[i]], pts[route[i + 1]]);
+
+                for (size_t j = i + 3; j < limitReorderJ; ++j) {
+                    // Current edges: i→(i+1) and (j-1)→j
+                    double curLen = subRouteLengthCurrentPart
+                        + dist(pts[route[j - 1]], pts[route[j]]);
+
+                    // New edges after reversal: (i+1)→j and i→(j-1)
+                    // Add epsilon to prevent cycles from floating point errors
+                    double newLen = dist(pts[route[i + 1]], pts[route[j]])
+                        + dist(pts[route[i]], pts[route[j - 1]]) + Base::Precision::Confusion();
+
+                    if (newLen < curLen) {
+                        // Reverse the segment between i+1 and j (exclusive)
+                        std::reverse(route.begin() + i + 1, route.begin() + j);
+                        subRouteLengthCurrentPart = dist(pts[route[i]], pts[route[i + 1]]);
+                        reorderFound = true;
+                        lastImprovementAtStep = 1;
+                    }
+                }
+
+                // Open route optimization: can reverse from i to end if no endpoint constraint
+                if (tempEndIdx == -1) {
+                    double curLen = dist(pts[route[i]], pts[route[i + 1]]);
+                    double newLen = dist(pts[route[i]], pts[route[limitReorderJ - 1]])
+                        + Base::Precision::Confusion();
+
+                    if (newLen < curLen) {
+                        // Reverse the order of points after i-th to the last point
+                        std::reverse(route.begin() + i + 1, route.begin() + limitReorderJ);
+                        reorderFound = true;
+                        lastImprovementAtStep = 1;
+                    }
+                }
+            }
+        }
+
+        // --- Relocation Optimization ---
+        // Try moving each point to a different position in the route.
+        // If moving point i to position j improves the route, do it.
+        if (lastImprovementAtStep == 2) {
+            break;
+        }
+        bool relocateFound = true;
+        while (relocateFound && budget.nextPass()) {
+            relocateFound = false;
+            for (size_t i = 1; i < limitRelocationI && !budget.expired(); ++i) {
+                double subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
+                    + dist(pts[route[i]], pts[route[i + 1]]);
+                double subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
+                    + Base::Precision::Confusion();
+
+                // Try moving point i backward (to positions before i)
+                for (size_t j = 0; j + 2 < i; ++j) {
+                    // Current cost: edges around point i and edge j→(j+1)
+                    double curLen = subRouteLengthCurrentPart
+                        + dist(pts[route[j]], pts[route[j + 1]]);
+
+                    // New cost: bypass i, insert i after j
+                    double newLen = subRouteLengthNewPart + dist(pts[route[j]], pts[route[i]])
+                        + dist(pts[route[i]], pts[route[j + 1]]);
+
+                    if (newLen < curLen) {
+                        // Move point i to position after j
+                        int node = route[i];
+                        route.erase(route.begin() + i);
+                        route.insert(route.begin() + j + 1, node);
+                        subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
+                            + dist(pts[route[i]], pts[route[i + 1]]);
+                        subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
+                            + Base::Precision::Confusion();
+                        relocateFound = true;
+                        lastImprovementAtStep = 2;
+                    }
+                }
+
+                // Try moving point i forward (to positions after i)
+                for (size_t j = i + 1; j < limitRelocationJ; ++j) {
+                    double curLen = subRouteLengthCurrentPart
+                        + dist(pts[route[j]], pts[route[j + 1]]);
+
+                    double newLen = subRouteLengthNewPart + dist(pts[route[j]], pts[route[i]])
+                        + dist(pts[route[i]], pts[route[j + 1]]);
+
+                    if (newLen < curLen) {
+                        int node = route[i];
+                        route.erase(route.begin() + i);
+                        route.insert(route.begin() + j, node);
+                        subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
+                            + dist(pts[route[i]], pts[route[i + 1]]);
+                        subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
+                            + Base::Precision::Confusion();
+                        relocateFound = true;
+                        lastImprovementAtStep = 2;
+                    }
+                }
+            }
+
+            // Open route optimization: can relocate the last point anywhere
+            if (tempEndIdx == -1) {
+                double subRouteLengthCurrentPart
+                    = dist(pts[route[route.size() - 2]], pts[route[route.size() - 1]]);
+
+                for (size_t j = 0; j + 2 < route.size(); ++j) {
+                    double curLen = subRouteLengthCurrentPart
+                        + dist(pts[route[j]], pts[route[j + 1]]);
+
+                    double newLen = dist(pts[route[j]], pts[route[route.size() - 1]])
+                        + dist(pts[route[route.size() - 1]], pts[route[j + 1]])
+                        + Base::Precision::Confusion();
+
+                    if (newLen < curLen) {
+                        // Relocate the last point after j-th point
+                        int node = route[route.size() - 1];
+                        route.erase(route.begin() + route.size() - 1);
+                        route.insert(route.begin() + j + 1, node);
+                        subRouteLengthCurrentPart
+                            = dist(pts[route[route.size() - 2]], pts[route[route.size() - 1]]);
+                        relocateFound = true;
+                        lastImprovementAtStep = 2;
+                    }
+                }
+            }
+        }
+
+        if (lastImprovementAtStep == 0) {
+            break;  // No additional improvements could be made
+        }
+    }
+    return route;
+}
+
+/**
+ * @brief Core TSP solver implementation using nearest neighbor + iterative improvement
+ *
+ * Algorithm steps:
+ * 1. Add temporary start/end points if specified
+ * 2. Build initial route using nearest neighbor heuristic
+ * 3. Optimize route with 2-opt and relocation (or Or-opt) moves
+ * 4. Remove temporary points and map back to original indices
+ *
+ * @param points Input points to visit
+ * @param startPoint Optional starting location constraint
+ * @param endPoint Optional ending location constraint
+ * @param options Search strategy and budget
+ * @return Vector of indices representing optimized visit order
+ */
+std::vector<int> solve_impl(
+    const std::vector<TSPPoint>& points,
+    const TSPPoint* startPoint,
+    const TSPPoint* endPoint,
+    const TSPOptions& options
+)
+{
+    // ========================================================================
+    // STEP 1: Prepare point set with temporary start/end markers
+    // ========================================================================
+    // We insert temporary points to enforce start/end constraints.
+    // These will be removed after optimization and won't appear in final result.
+    std::vector<TSPPoint> pts = points;
+    int tempStartIdx = -1, tempEndIdx = -1;
+
+    if (startPoint) {
+        // Insert user-specified start point at beginning
+        pts.insert(pts.begin(), TSPPoint(startPoint->x, startPoint->y));
+        tempStartIdx = 0;
+    }
+    else if (!pts.empty()) {
+        // No start specified: duplicate first point as anchor
+        pts.insert(pts.begin(), TSPPoint(pts[0].x, pts[0].y));
+        tempStartIdx = 0;
+    }
+
+    if (endPoint) {
+        // Add user-specified end point at the end
+        pts.push_back(TSPPoint(endPoint->x, endPoint->y));
+        tempEndIdx = static_cast<int>(pts.size()) - 1;
+    }
+
+    // ========================================================================
+    // STEP 2 and 3: Build the initial route and improve it
+    // ========================================================================
+    // Small inputs compare all pairs of route positions. Large inputs use a k-d tree and
+    // only try moves towards the nearest neighbors of each point.
+    Budget budget(options);
+    std::vector<int> route = points.size() > options.exhaustiveLimit
+        ? buildRouteWithNeighbours(pts, tempEndIdx != -1, options, budget)
+        : buildRouteExhaustive(pts, tempEndIdx, budget);
+
+    // ========================================================================
+    // STEP 4: Remove temporary start/end points
+    // ========================================================================
+    // The temporary markers served their purpose during optimization.
+    // Now remove them so they don't appear in the final result.
+    if (tempEndIdx != -1 && !route.empty() && route.back() == tempEndIdx) {
+        route.pop_back();
+    }
+    if (tempStartIdx != -1 && !route.empty() && route.front() == tempStartIdx) {
+        route.erase(route.begin());
+    }
+
+    // ========================================================================
+    // STEP 5: Map route indices back to original point array
+    // ========================================================================
+    // Since we inserted a temp start point at index 0, all subsequent indices
+    // are offset by 1. Adjust them back to match the original points array.
+    std::vector<int> result;
+    for (int idx : route) {
+        // Adjust for temp start offset
+        if (tempStartIdx != -1) {
+            --idx;
+        }
+        // Only include valid indices from the original points array
+        if (idx >= 0 && idx < static_cast<int>(points.size())) {
+            result.push_back(idx);
+        }
+    }
+    return result;
+}
+}  // namespace
+
+/**
+ * @brief Solve the Traveling Salesperson Problem using 2-opt algorithm
+ *
+ * This implementation handles optional start and end point constraints:
+ * - If startPoint is provided, the path will begin at the point closest to startPoint
+ * - If endPoint is provided, the path will end at the point closest to endPoint
+ * - If both are provided, the path will respect both constraints while optimizing the middle path
+ * - The algorithm ensures all points are visited exactly once
+ */
+
+
+std::vector<int> TSPSolver::solve(
+    const std::vector<TSPPoint>& points,
+    const TSPPoint* startPoint,
+    const TSPPoint* endPoint,
+    const TSPOptions& options
+)
+{
+    return solve_impl(points, startPoint, endPoint, options);
+}
+
+std::vector<TSPTunnel> TSPSolver::solveTunnels(
+    std::vector<TSPTunnel> tunnels,
+    bool allowFlipping,
+    const TSPPoint* routeStartPoint,
+    const TSPPoint* routeEndPoint,
+    const TSPOptions& options
+)
+{
+    if (tunnels.empty()) {
+        return tunnels;
+    }
+    Budget budget(options);
+
+    // Set original indices
+    for (size_t i = 0; i < tunnels.size(); ++i) {
+        tunnels[i].index = static_cast<int>(i);
+    }
+
+    // STEP 1: Add the routeStartPoint (will be deleted at the end)
+    if (routeStartPoint) {
+        tunnels.insert(
+            tunnels.begin(),
+            TSPTunnel(routeStartPoint->x, routeStartPoint->y, routeStartPoint->x, routeStartPoint->y, false)
+        );
+    }
+    else {
+        tunnels.insert(tunnels.begin(), TSPTunnel(0.0, 0.0, 0.0, 0.0, false));
+    }
+
+    // STEP 2: Apply nearest neighbor algorithm
+    std::vector<TSPTunnel> potentialNeighbours(tunnels.begin() + 1, tunnels.end());
+    std::vector<TSPTunnel> route;
+    route.push_back(tunnels[0]);
+
+    bool large = potentialNeighbours.size() > options.exhaustiveLimit;
+    if (large) {
+        appendNearestTunnels(route, potentialNeighbours, allowFlipping, budget);
+        potentialNeighbours.clear();
+    }
+
+    while (!potentialNeighbours.empty()) {
+        double costCurrent = std::numeric_limits<double>::max();
+        bool toBeFlipped = false;
+        auto nearestNeighbour = potentialNeighbours.begin();
+
+        // Check normal orientation
+        for (auto it = potentialNeighbours.begin(); it != potentialNeighbours.end(); ++it) {
+            double dx = route.back().endX - it->startX;
+            double dy = route.back().endY - it->startY;
+            double costNew = dx * dx + dy * dy;
+
+            if (costNew < costCurrent) {
+                costCurrent = costNew;
+                toBeFlipped = false;
+                nearestNeighbour = it;
+            }
+        }
+
+        // Check flipped orientation if allowed
+        if (allowFlipping) {
+            for (auto it = potentialNeighbours.begin(); it != potentialNeighbours.end(); ++it) {
+                if (it->isOpen) {
+                    double dx = route.back().endX - it->endX;
+                    double dy = route.back().endY - it->endY;
+                    double costNew = dx * dx + dy * dy;
+
+                    if (costNew < costCurrent) {
+                        costCurrent = costNew;
+                        toBeFlipped = true;
+                        nearestNeighbour = it;
+                    }
+                }
+            }
+        }
+
+        // Apply flipping if needed
+        if (toBeFlipped) {
+            nearestNeighbour->flipped = !nearestNeighbour->flipped;
+            std::swap(nearestNeighbour->startX, nearestNeighbour->endX);
+            std::swap(nearestNeighbour->startY, nearestNeighbour->endY);
+        }
+
+        route.push_back(*nearestNeighbour);
+        potentialNeighbours.erase(nearestNeighbour);
+    }
+
+    // STEP 3: Add the routeEndPoint (will be deleted at the end)
+    if (routeEndPoint) {
+        route.push_back(
+            TSPTunnel(routeEndPoint->x, routeEndPoint->y, routeEndPoint->x, routeEndPoint->y, false)
+        );
+    }
+
+    // STEP 4: Additional improvement of the route. Large tunnel sets only try moves towards the
+    // nearest neighbours of each tunnel end.
+    if (large) {
+        if (!budget.timeIsUp()) {
+            improveTunnelsWithNeighbours(route, allowFlipping, routeEndPoint, options, budget);
+        }
+    }
+    else {
+        improveTunnelsExhaustive(route, allowFlipping, routeEndPoint, budget);
+    }
 
     // STEP 5: Delete temporary start and end point
     if (!route.empty()) {
@@ -26,6 +26,7 @@
 #include <utility>
 #include <limits>
 #include <cmath>
+#include <cstddef>
 
 struct TSPPoint
 {
@@ -72,6 +73,21 @@ struct TSPPair
     {}
 };
 
+// Tuning and limits of the solvers
+// Inputs with up to exhaustiveLimit elements are improved by comparing all pairs of route
+// positions. Larger point sets build their route with a k-d tree and only try moves towards
+// the nearest neighbours of each point (2-Opt and Or-opt), large tunnel sets likewise only
+// try flip, 2-Opt and relocation moves towards the nearest tunnel ends. Once the time limit
+// is reached, the remaining elements are appended in tree order and the best route found so
+// far is returned.
+struct TSPOptions
+{
+    double timeLimit = 0.0;         // Time budget of the solver in seconds, 0 = none
+    int maxIterations = 0;          // Maximum number of improvement passes, 0 = none
+    int neighbours = 10;            // Number of candidates per point of the neighbour search
+    size_t exhaustiveLimit = 1000;  // Larger inputs use a k-d tree
+};
+
 class TSPSolver
 {
 public:
@@ -81,7 +97,8 @@ public:
     static std::vector<int> solve(
         const std::vector<TSPPoint>& points,
         const TSPPoint* startPoint = nullptr,
-        const TSPPoint* endPoint = nullptr
+        const TSPPoint* endPoint = nullptr,
+        const TSPOptions& options = {}
     );
 
     // Solves TSP for tunnels (path segments with entry/exit points)
@@ -91,7 +108,8 @@ public:
         std::vector<TSPTunnel> tunnels,
         bool allowFlipping = false,
         const TSPPoint* routeStartPoint = nullptr,
-        const TSPPoint* routeEndPoint = nullptr
+        const TSPPoint* routeEndPoint = nullptr,
+        const TSPOptions& options = {}
     );
 
     // Solves TSP for pairs (each element has a primary and alternative entry point)
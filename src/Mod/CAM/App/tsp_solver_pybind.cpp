@@ -27,10 +27,25 @@
 
 namespace py = pybind11;
 
+namespace
+{
+TSPOptions makeOptions(double timeLimit, int maxIterations, int neighbours)
+{
+    TSPOptions options;
+    options.timeLimit = timeLimit;
+    options.maxIterations = maxIterations;
+    options.neighbours = neighbours;
+    return options;
+}
+}  // namespace
+
 std::vector<int> tspSolvePy(
     const std::vector<std::pair<double, double>>& points,
     const py::object& startPoint = py::none(),
-    const py::object& endPoint = py::none()
+    const py::object& endPoint = py::none(),
+    double timeLimit = 0.0,
+    int maxIterations = 0,
+    int neighbours = 10
 )
 {
     std::vector<TSPPoint> pts;
@@ -94,7 +109,8 @@ std::vector<int> tspSolvePy(
         }
     }
 
-    return TSPSolver::solve(pts, pStartPoint, pEndPoint);
+    auto options = makeOptions(timeLimit, maxIterations, neighbours);
+    return TSPSolver::solve(pts, pStartPoint, pEndPoint, options);
 }
 
 // Python wrapper for solvePairs function
@@ -196,7 +212,9 @@ std::vector<py::dict> tspSolveTunnelsPy(
     const std::vector<py::dict>& tunnels,
     bool allowFlipping = false,
     const py::object& routeStartPoint = py::none(),
-    const py::object& routeEndPoint = py::none()
+    const py::object& routeEndPoint = py::none(),
+    double timeLimit = 0.0,
+    int maxIterations = 0
 )
 {
     std::vector<TSPTunnel> cppTunnels;
@@ -268,7 +286,9 @@ std::vector<py::dict> tspSolveTunnelsPy(
     }
 
     // Solve the tunnel TSP
-    auto result = TSPSolver::solveTunnels(cppTunnels, allowFlipping, pStartPoint, pEndPoint);
+    auto options = makeOptions(timeLimit, maxIterations, TSPOptions().neighbours);
+    auto result
+        = TSPSolver::solveTunnels(cppTunnels, allowFlipping, pStartPoint, pEndPoint, options);
 
     // Convert result back to Python dictionaries, preserving extra keys from input
     std::vector<py::dict> pyResult;
@@ -299,12 +319,20 @@ PYBIND11_MODULE(tsp_solver, m)
         py::arg("points"),
         py::arg("startPoint") = py::none(),
         py::arg("endPoint") = py::none(),
+        py::arg("timeLimit") = 0.0,
+        py::arg("maxIterations") = 0,
+        py::arg("neighbours") = 10,
         "Solve TSP for a list of (x, y) points using 2-Opt, returns visit order.\n"
+        "Large point sets use a k-d tree and only try 2-Opt and Or-opt moves towards the\n"
+        "nearest neighbours of each point.\n"
         "Optional arguments:\n"
         "- startPoint: Optional [x, y] point where the path should start (closest point will be "
         "chosen)\n"
         "- endPoint: Optional [x, y] point where the path should end (closest point will be "
-        "chosen)"
+        "chosen)\n"
+        "- timeLimit: Time budget in seconds, improving the route stops once it is used up\n"
+        "- maxIterations: Maximum number of improvement passes, 0 for no limit\n"
+        "- neighbours: Number of nearest neighbours tried per point on large point sets"
     );
 
     m.def(
@@ -314,12 +342,18 @@ PYBIND11_MODULE(tsp_solver, m)
         py::arg("allowFlipping") = false,
         py::arg("routeStartPoint") = py::none(),
         py::arg("routeEndPoint") = py::none(),
+        py::arg("timeLimit") = 0.0,
+        py::arg("maxIterations") = 0,
         "Solve TSP for tunnels (path segments with entry/exit points).\n"
+        "Large tunnel sets use a k-d tree and only try flip, 2-Opt and relocation moves\n"
+        "towards the nearest tunnel ends.\n"
         "Arguments:\n"
         "- tunnels: List of dictionaries with keys: startX, startY, endX, endY, isOpen (optional)\n"
         "- allowFlipping: Whether tunnels can be reversed (entry becomes exit)\n"
         "- routeStartPoint: Optional [x, y] point where route should start\n"
         "- routeEndPoint: Optional [x, y] point where route should end\n"
+        "- timeLimit: Time budget in seconds, improving the route stops once it is used up\n"
+        "- maxIterations: Maximum number of improvement passes, 0 for no limit\n"
         "Returns: List of tunnel dictionaries in optimized order with flipped status"
     );
 
@@ -23,6 +23,7 @@
 
 import FreeCAD
 import math
+import random
 import tsp_solver
 import PathScripts.PathUtils as PathUtils
 from CAMTests.PathTestUtils import PathTestBase
@@ -633,6 +634,84 @@ class TestTSPSolver(PathTestBase):
             self.assertRoughly(pair["xAlt"], pair["x"])
             self.assertRoughly(pair["yAlt"], pair["y"])
 
+    def test_19_large_point_set(self):
+        """Test the neighbour search used for large point sets on a shuffled grid of holes."""
+        points = [(x * 2.0, y * 2.0) for x in range(60) for y in range(50)]
+        random.Random(1).shuffle(points)
+
+        route = tsp_solver.solve(points, startPoint=[-1, -1])
+
+        self.assertEqual(len(route), len(points))
+        self.assertEqual(set(route), set(range(len(points))))
+        self.assertEqual(points[route[0]], (0.0, 0.0))
+        # The shortest route visits neighbouring holes only, 2 apart
+        length = sum(
+            math.dist(points[route[i]], points[route[i + 1]]) for i in range(len(route) - 1)
+        )
+        self.assertLess(length, 1.05 * 2.0 * (len(points) - 1))
+
+    def test_20_budget(self):
+        """Test that a used up budget still returns a complete route."""
+        points = [(x * 2.0, y * 2.0) for x in range(60) for y in range(50)]
+        random.Random(2).shuffle(points)
+
+        for kwargs in ({"maxIterations": 1}, {"timeLimit": 1e-6}, {"neighbours": 1}):
+            route = tsp_solver.solve(points, endPoint=[200, 200], **kwargs)
+            self.assertEqual(len(route), len(points))
+            self.assertEqual(set(route), set(range(len(points))))
+
+        tunnels = [
+            {"startX": x, "startY": 0, "endX": x + 1, "endY": 1} for x in range(0, 4000, 2)
+        ]
+        result = tsp_solver.solveTunnels(tunnels, allowFlipping=True, timeLimit=1e-6)
+        self.assertEqual(sorted(t["index"] for t in result), list(range(len(tunnels))))
+
+    def test_21_clustered_points(self):
+        """Test large point sets with far apart clusters and coincident points."""
+        rng = random.Random(3)
+        points = [(rng.random(), rng.random()) for _ in range(1500)]
+        points += [(1000 + rng.random(), 1000 + rng.random()) for _ in range(1500)]
+        points += [(500.0, 500.0)] * 1000
+        rng.shuffle(points)
+
+        route = tsp_solver.solve(points, startPoint=[-1, -1])
+
+        self.assertEqual(len(route), len(points))
+        self.assertEqual(set(route), set(range(len(points))))
+        # Each cluster is visited in one go, coincident points one after another
+        jumps = sum(
+            1
+            for i in range(len(route) - 1)
+            if math.dist(points[route[i]], points[route[i + 1]]) > 100
+        )
+        self.assertEqual(jumps, 2)
+
+    def test_22_large_tunnel_set(self):
+        """Test the neighbour search used for large tunnel sets on shuffled rows of slots."""
+        rng = random.Random(4)
+        tunnels = []
+        for y in range(40):
+            for x in range(0, 60, 2):
+                if rng.random() < 0.5:
+                    tunnels.append({"startX": x, "startY": y, "endX": x + 1, "endY": y})
+                else:
+                    tunnels.append({"startX": x + 1, "startY": y, "endX": x, "endY": y})
+        rng.shuffle(tunnels)
+
+        result = tsp_solver.solveTunnels(tunnels, allowFlipping=True, routeStartPoint=[-1, 0])
+
+        self.assertEqual(sorted(t["index"] for t in result), list(range(len(tunnels))))
+        # The shortest route links each slot to its neighbour in the row, 1 apart
+        travel = math.dist((-1, 0), (result[0]["startX"], result[0]["startY"]))
+        travel += sum(
+            math.dist(
+                (result[i]["endX"], result[i]["endY"]),
+                (result[i + 1]["startX"], result[i + 1]["startY"]),
+            )
+            for i in range(len(result) - 1)
+        )
+        self.assertLess(travel, 1.1 * len(tunnels))
+
 
 if __name__ == "__main__":
     import unittest
@@ -23,15 +23,23 @@
  ***************************************************************************/
 
 #include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <array>
 #include <numeric>
 #include <limits>
 
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_Triangle.hxx>
 #include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <gp_Pnt.hxx>
 
@@ -45,11 +53,15 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/CompactKernel.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/TriangleDistance.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 #include <Mod/Points/App/PointsFeature.h>
 #include <Mod/Points/App/PointsGrid.h>
 
@@ -283,6 +295,19 @@ private:
 };
 }  // namespace Inspection
 
+void InspectNominalGeometry::getDistances(
+    const std::vector<Base::Vector3f>& points,
+    std::vector<float>& distances
+) const
+{
+    distances.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        distances[i] = getDistance(points[i]);
+    }
+}
+
+// ----------------------------------------------------------------
+
 InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset)
     : _mesh(rMesh.getKernel())
 {
@@ -290,30 +315,16 @@ InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offs
     _clTrf = rMesh.getTransform();
     _bApply = _clTrf != tmp;
 
-    // Max. limit of grid elements
-    float fMaxGridElements = 8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen
-        = (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(_mesh).GetAverageEdgeLength();
-
-    // We want to avoid to get too small grid elements otherwise building up the grid structure
-    // would take too much time and memory. Having quite a dense grid speeds up more the following
-    // algorithms extremely. Due to the issue above it's always a compromise between speed and
-    // memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
-
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
+    // Unlike a grid the hierarchy needs no tuning of a cell size and keeps fast where
+    // small and large facets are mixed. It is built over the transformed facets.
+    _pBVH = new MeshCore::MeshFacetBVH(_mesh, _clTrf);
+    _box = _pBVH->GetBoundBox();
     _box.Enlarge(offset);
 }
 
 InspectNominalMesh::~InspectNominalMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
 }
 
 float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
@@ -322,29 +333,19 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
         return std::numeric_limits<float>::max();  // must be inside bbox
     }
 
-    std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
+    Base::Vector3f nearest;
+    MeshCore::FacetIndex index {};
+    if (!_pBVH->NearestFacetToPoint(point, std::numeric_limits<float>::max(), nearest, index)) {
+        return std::numeric_limits<float>::max();
     }
 
-    float fMinDist = std::numeric_limits<float>::max();
-    bool positive = true;
-    for (unsigned long it : indices) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
-
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
+    MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(index);
+    if (_bApply) {
+        geomFace.Transform(_clTrf);
     }
 
+    float fMinDist = Base::Distance(point, nearest);
+    bool positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
     if (!positive) {
         fMinDist = -fMinDist;
     }
@@ -400,41 +401,113 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
     }
 
     std::set<unsigned long> indices;
-#if 0  // a point in a neighbour grid can be nearer
-    std::vector<unsigned long> elements;
-    _pGrid->GetElements(point, elements);
-    indices.insert(elements.begin(), elements.end());
-#else
     unsigned long ulX, ulY, ulZ;
     _pGrid->Position(point, ulX, ulY, ulZ);
-    unsigned long ulLevel = 0;
-    while (indices.empty() && ulLevel <= max_level) {
-        _pGrid->GetHull(ulX, ulY, ulZ, ulLevel++, indices);
-    }
-    if (indices.empty() || ulLevel == 1) {
-        _pGrid->GetHull(ulX, ulY, ulZ, ulLevel, indices);
+    getFacets(ulX, ulY, ulZ, indices);
+
+    MeshCore::MeshNearestFacetSearch search(point, std::numeric_limits<float>::max());
+    for (unsigned long it : indices) {
+        search.AddFacet(getFacet(it), it);
     }
-#endif
 
     float fMinDist = std::numeric_limits<float>::max();
-    bool positive = true;
-    for (unsigned long it : indices) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
+    unsigned long facet = search.NearestFacet(fMinDist);
+    if (facet != MeshCore::FACET_INDEX_MAX) {
+        MeshCore::MeshGeomFacet geomFace = getFacet(facet);
+        if (point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) <= 0) {
+            fMinDist = -fMinDist;
         }
+    }
+    return fMinDist;
+}
 
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
+void InspectNominalFastMesh::getDistances(
+    const std::vector<Base::Vector3f>& points,
+    std::vector<float>& distances
+) const
+{
+    distances.assign(points.size(), std::numeric_limits<float>::max());
+
+    // sort the points by grid element
+    using Element = std::array<unsigned long, 3>;
+    std::vector<std::pair<Element, std::size_t>> elements;
+    elements.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (_box.IsInBox(points[i])) {
+            Element elem {};
+            _pGrid->Position(points[i], elem[0], elem[1], elem[2]);
+            elements.emplace_back(elem, i);
         }
     }
+    std::sort(elements.begin(), elements.end());
 
-    if (!positive) {
-        fMinDist = -fMinDist;
+    // all points of an element have the same facets around them
+    MeshCore::MeshFacetBatch batch;
+    std::set<unsigned long> indices;
+    std::vector<Base::Vector3f> pnts;
+    std::vector<float> dists;
+    std::vector<MeshCore::FacetIndex> facets;
+    for (std::size_t begin = 0; begin < elements.size();) {
+        const Element& elem = elements[begin].first;
+        std::size_t end = begin + 1;
+        while (end < elements.size() && elements[end].first == elem) {
+            end++;
+        }
+
+        indices.clear();
+        getFacets(elem[0], elem[1], elem[2], indices);
+        batch.Clear();
+        for (unsigned long it : indices) {
+            batch.AddFacet(getFacet(it), it);
+        }
+
+        pnts.clear();
+        for (std::size_t i = begin; i < end; i++) {
+            pnts.push_back(points[elements[i].second]);
+        }
+        dists.assign(pnts.size(), std::numeric_limits<float>::max());
+        facets.assign(pnts.size(), MeshCore::FACET_INDEX_MAX);
+        batch.NearestFacets(pnts.data(), pnts.size(), dists.data(), facets.data());
+
+        for (std::size_t i = 0; i < pnts.size(); i++) {
+            float fDist = dists[i];
+            if (facets[i] != MeshCore::FACET_INDEX_MAX) {
+                MeshCore::MeshGeomFacet geomFace = getFacet(facets[i]);
+                if (pnts[i].DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) <= 0) {
+                    fDist = -fDist;
+                }
+            }
+            distances[elements[begin + i].second] = fDist;
+        }
+
+        begin = end;
     }
-    return fMinDist;
+}
+
+void InspectNominalFastMesh::getFacets(
+    unsigned long ulX,
+    unsigned long ulY,
+    unsigned long ulZ,
+    std::set<unsigned long>& indices
+) const
+{
+    // a point in a neighbour grid can be nearer
+    unsigned long ulLevel = 0;
+    while (indices.empty() && ulLevel <= max_level) {
+        _pGrid->GetHull(ulX, ulY, ulZ, ulLevel++, indices);
+    }
+    if (indices.empty() || ulLevel == 1) {
+        _pGrid->GetHull(ulX, ulY, ulZ, ulLevel, indices);
+    }
+}
+
+MeshCore::MeshGeomFacet InspectNominalFastMesh::getFacet(unsigned long index) const
+{
+    MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(index);
+    if (_bApply) {
+        geomFace.Transform(_clTrf);
+    }
+    return geomFace;
 }
 
 // ----------------------------------------------------------------
@@ -474,48 +547,321 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
-    : _rShape(shape)
+struct InspectNominalShape::Tessellation
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
+    std::vector<TopoDS_Face> faces;
+    /// Faces that could not be triangulated and edges and vertices outside of any face, the
+    /// exact distance to them is always computed
+    std::vector<TopoDS_Shape> untessellated;
+    /// Only the facets are read once the search structure is built
+    std::unique_ptr<MeshCore::MeshCompactKernel> mesh;
+    /// The index of the face of each facet
+    std::vector<int> faceOfFacet;
+    std::unique_ptr<MeshCore::MeshFacetBVH> bvh;
+    float deflection {0.0F};
+};
+
+/// Holds the OCC algorithms for the exact distance, which must not be shared between threads
+class InspectNominalShape::Evaluator
+{
+public:
+    explicit Evaluator(std::size_t numShapes)
+        : solvers(numShapes)
+    {}
+
+    /// Returns the distance algorithm for \a shape
+    BRepExtrema_DistShapeShape& getSolver(const TopoDS_Shape& shape)
+    {
+        return loaded(shapeSolver, shape);
+    }
+    /// Returns the distance algorithm for the sub-shape with the index \a index
+    BRepExtrema_DistShapeShape& getSolver(std::size_t index, const TopoDS_Shape& shape)
+    {
+        return loaded(solvers[index], shape);
+    }
+
+    bool isInsideSolid(const TopoDS_Shape& solid, const gp_Pnt& pnt3d)
+    {
+        const Standard_Real tol = 0.001;
+        if (!classifier) {
+            classifier = std::make_unique<BRepClass3d_SolidClassifier>(solid);
+        }
+        classifier->Perform(pnt3d, tol);
+        return (classifier->State() == TopAbs_IN);
+    }
+
+    static bool isBelowFace(const BRepExtrema_DistShapeShape& distss, const gp_Pnt& pnt3d)
+    {
+        // check if the distance was computed from a face
+        for (Standard_Integer index = 1; index <= distss.NbSolution(); index++) {
+            if (distss.SupportTypeShape1(index) == BRepExtrema_IsInFace) {
+                TopoDS_Shape face = distss.SupportOnShape1(index);
+                Standard_Real u, v;
+                distss.ParOnFaceS1(index, u, v);
+                BRepGProp_Face props(TopoDS::Face(face));
+                gp_Vec normal;
+                gp_Pnt center;
+                props.Normal(u, v, center, normal);
+                gp_Vec dir(center, pnt3d);
+                Standard_Real scalar = normal.Dot(dir);
+                if (scalar < 0) {
+                    return true;
+                }
+                break;
+            }
+        }
+
+        return false;
+    }
 
+private:
+    static BRepExtrema_DistShapeShape& loaded(
+        std::unique_ptr<BRepExtrema_DistShapeShape>& solver,
+        const TopoDS_Shape& shape
+    )
+    {
+        if (!solver) {
+            solver = std::make_unique<BRepExtrema_DistShapeShape>();
+            solver->LoadS1(shape);
+        }
+        return *solver;
+    }
+
+private:
+    std::unique_ptr<BRepExtrema_DistShapeShape> shapeSolver;
+    std::vector<std::unique_ptr<BRepExtrema_DistShapeShape>> solvers;
+    std::unique_ptr<BRepClass3d_SolidClassifier> classifier;
+};
+
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float offset, float band)
+    : _rShape(shape)
+    , _shell(std::make_unique<TopoDS_Shape>(shape))
+    , _band(band > 0.0F ? band : offset)
+{
     // When having a solid then use its shell because otherwise the distance
     // for inner points will always be zero
     if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
         TopExp_Explorer xp;
         xp.Init(_rShape, TopAbs_SHELL);
         if (xp.More()) {
-            distss->LoadS1(xp.Current());
+            *_shell = xp.Current();
             isSolid = true;
         }
     }
-    // distss->SetDeflection(radius);
+
+    tessellate();
 }
 
-InspectNominalShape::~InspectNominalShape()
+InspectNominalShape::~InspectNominalShape() = default;
+
+void InspectNominalShape::tessellate()
 {
-    delete distss;
+    if (_rShape.IsNull()) {
+        return;
+    }
+
+    // Mesh a copy because otherwise the fine triangulation replaces the one of the displayed shape
+    BRepBuilderAPI_Copy copy(_rShape, Standard_False);
+    TopoDS_Shape shape = copy.Shape();
+    Standard_Real deflection = Part::Tools::getDeflection(shape, 0.05);
+    BRepMesh_IncrementalMesh aMesh(shape, deflection, Standard_False, 0.1, Standard_True);
+
+    auto tessellation = std::make_unique<Tessellation>();
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    TopTools_IndexedMapOfShape mapOfFaces;
+    TopExp::MapShapes(shape, TopAbs_FACE, mapOfFaces);
+    for (int i = 1; i <= mapOfFaces.Extent(); i++) {
+        const TopoDS_Face& face = TopoDS::Face(mapOfFaces(i));
+        std::vector<gp_Pnt> nodes;
+        std::vector<Poly_Triangle> triangles;
+        if (!Part::Tools::getTriangulation(face, nodes, triangles) || triangles.empty()) {
+            tessellation->untessellated.push_back(face);
+            continue;
+        }
+
+        int index = static_cast<int>(tessellation->faces.size());
+        tessellation->faces.push_back(face);
+        MeshCore::PointIndex offset = points.size();
+        for (const auto& node : nodes) {
+            points.emplace_back(float(node.X()), float(node.Y()), float(node.Z()));
+        }
+        for (const auto& triangle : triangles) {
+            Standard_Integer n1, n2, n3;
+            triangle.Get(n1, n2, n3);
+            facets.emplace_back(offset + n1, offset + n2, offset + n3);
+            tessellation->faceOfFacet.push_back(index);
+        }
+    }
+
+    // without faces the exact distance to the shape is computed
+    if (facets.empty()) {
+        return;
+    }
+
+    // loose edges and vertices have no facets either
+    TopTools_IndexedDataMapOfShapeListOfShape edgeFaces;
+    TopExp::MapShapesAndAncestors(shape, TopAbs_EDGE, TopAbs_FACE, edgeFaces);
+    for (int i = 1; i <= edgeFaces.Extent(); i++) {
+        if (edgeFaces(i).IsEmpty()) {
+            tessellation->untessellated.push_back(edgeFaces.FindKey(i));
+        }
+    }
+    TopTools_IndexedDataMapOfShapeListOfShape vertexEdges;
+    TopExp::MapShapesAndAncestors(shape, TopAbs_VERTEX, TopAbs_EDGE, vertexEdges);
+    for (int i = 1; i <= vertexEdges.Extent(); i++) {
+        if (vertexEdges(i).IsEmpty()) {
+            tessellation->untessellated.push_back(vertexEdges.FindKey(i));
+        }
+    }
+
+    MeshCore::MeshKernel mesh;
+    mesh.Adopt(points, facets);
+    tessellation->bvh = std::make_unique<MeshCore::MeshFacetBVH>(mesh);
+    tessellation->mesh = std::make_unique<MeshCore::MeshCompactKernel>(mesh);
+    tessellation->deflection = float(deflection);
+    _tessellation = std::move(tessellation);
+}
+
+std::unique_ptr<InspectNominalShape::Evaluator> InspectNominalShape::takeEvaluator() const
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_evaluators.empty()) {
+            std::unique_ptr<Evaluator> evaluator = std::move(_evaluators.back());
+            _evaluators.pop_back();
+            return evaluator;
+        }
+    }
+    return std::make_unique<Evaluator>(
+        _tessellation ? _tessellation->faces.size() + _tessellation->untessellated.size() : 0
+    );
+}
+
+void InspectNominalShape::returnEvaluator(std::unique_ptr<Evaluator> evaluator) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _evaluators.push_back(std::move(evaluator));
+}
+
+void InspectNominalShape::getFaces(
+    const Base::Vector3f& point,
+    float radius,
+    std::vector<int>& faces
+) const
+{
+    std::vector<MeshCore::FacetIndex> facets;
+    _tessellation->bvh->Search(
+        [&point, radius](const Base::BoundBox3f& box) {
+            Base::BoundBox3f search = box;
+            search.Enlarge(radius);
+            return search.IsInBox(point);
+        },
+        facets
+    );
+
+    for (MeshCore::FacetIndex index : facets) {
+        if (_tessellation->mesh->GetFacet(index).DistanceToPoint(point) <= radius) {
+            faces.push_back(_tessellation->faceOfFacet[index]);
+        }
+    }
+    std::sort(faces.begin(), faces.end());
+    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
+{
+    std::unique_ptr<Evaluator> evaluator = takeEvaluator();
+    float distance = getDistance(point, *evaluator);
+    returnEvaluator(std::move(evaluator));
+    return distance;
+}
+
+void InspectNominalShape::getDistances(
+    const std::vector<Base::Vector3f>& points,
+    std::vector<float>& distances
+) const
+{
+    // one evaluator serves all points, so that the pool is only locked once per call
+    std::unique_ptr<Evaluator> evaluator = takeEvaluator();
+    distances.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        distances[i] = getDistance(points[i], *evaluator);
+    }
+    returnEvaluator(std::move(evaluator));
+}
+
+float InspectNominalShape::getDistance(const Base::Vector3f& point, Evaluator& evaluator) const
+{
+    if (!_tessellation) {
+        return getExactDistance(point, {}, evaluator);
+    }
+
+    Base::Vector3f nearest;
+    MeshCore::FacetIndex index {};
+    const float maxDist = std::numeric_limits<float>::max();
+    if (!_tessellation->bvh->NearestFacetToPoint(point, maxDist, nearest, index)) {
+        return std::numeric_limits<float>::max();
+    }
+
+    // the tessellation deviates from the faces by at most the deflection
+    float deflection = _tessellation->deflection;
+    float fMinDist = Base::Distance(point, nearest);
+    if (fMinDist > _band + deflection && _tessellation->untessellated.empty()) {
+        MeshCore::MeshGeomFacet geomFace = _tessellation->mesh->GetFacet(index);
+        bool positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
+        return positive ? fMinDist : -fMinDist;
+    }
+
+    // only the faces that may be nearer than the nearest facet need to be checked
+    std::vector<int> faces;
+    getFaces(point, fMinDist + 2.0F * deflection, faces);
+    return getExactDistance(point, faces, evaluator);
+}
+
+float InspectNominalShape::getExactDistance(
+    const Base::Vector3f& point,
+    const std::vector<int>& faces,
+    Evaluator& evaluator
+) const
 {
     gp_Pnt pnt3d(point.x, point.y, point.z);
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
 
     float fMinDist = std::numeric_limits<float>::max();
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
+    BRepExtrema_DistShapeShape* nearest = nullptr;
+    auto check = [&](BRepExtrema_DistShapeShape& distss) {
+        distss.LoadS2(mkVert.Vertex());
+        if (distss.Perform() && distss.NbSolution() > 0 && distss.Value() < fMinDist) {
+            fMinDist = (float)distss.Value();
+            nearest = &distss;
+        }
+    };
+
+    if (faces.empty()) {
+        check(evaluator.getSolver(*_shell));
+    }
+    for (int face : faces) {
+        check(evaluator.getSolver(face, _tessellation->faces[face]));
+    }
+    if (_tessellation) {
+        // the facets tell nothing about the distance to these
+        std::size_t index = _tessellation->faces.size();
+        for (const TopoDS_Shape& sub : _tessellation->untessellated) {
+            check(evaluator.getSolver(index++, sub));
+        }
+    }
+
+    if (nearest) {
         // the shape is a solid, check if the vertex is inside
         if (isSolid) {
-            if (isInsideSolid(pnt3d)) {
+            if (evaluator.isInsideSolid(_rShape, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
         else if (fMinDist > 0) {
             // check if the distance was computed from a face
-            if (isBelowFace(pnt3d)) {
+            if (Evaluator::isBelowFace(*nearest, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
@@ -523,39 +869,6 @@ float InspectNominalShape::getDistance(const Base::Vector3f& point) const
     return fMinDist;
 }
 
-bool InspectNominalShape::isInsideSolid(const gp_Pnt& pnt3d) const
-{
-    const Standard_Real tol = 0.001;
-    BRepClass3d_SolidClassifier classifier(_rShape);
-    classifier.Perform(pnt3d, tol);
-    return (classifier.State() == TopAbs_IN);
-}
-
-bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
-{
-    // check if the distance was computed from a face
-    for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-        if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-            TopoDS_Shape face = distss->SupportOnShape1(index);
-            Standard_Real u, v;
-            distss->ParOnFaceS1(index, u, v);
-            // gp_Pnt pnt = distss->PointOnShape1(index);
-            BRepGProp_Face props(TopoDS::Face(face));
-            gp_Vec normal;
-            gp_Pnt center;
-            props.Normal(u, v, center, normal);
-            gp_Vec dir(center, pnt3d);
-            Standard_Real scalar = normal.Dot(dir);
-            if (scalar < 0) {
-                return true;
-            }
-            break;
-        }
-    }
-
-    return false;
-}
-
 // ----------------------------------------------------------------
 
 TYPESYSTEM_SOURCE(Inspection::PropertyDistanceList, App::PropertyLists)
@@ -767,6 +1080,7 @@ Feature::Feature()
 {
     ADD_PROPERTY(SearchRadius, (0.05));
     ADD_PROPERTY(Thickness, (0.0));
+    ADD_PROPERTY(ToleranceBand, (0.0));
     ADD_PROPERTY(Actual, (nullptr));
     ADD_PROPERTY(Nominals, (nullptr));
     ADD_PROPERTY(Distances, (0.0));
@@ -782,6 +1096,9 @@ short Feature::mustExecute() const
     if (Thickness.isTouched()) {
         return 1;
     }
+    if (ToleranceBand.isTouched()) {
+        return 1;
+    }
     if (Actual.isTouched()) {
         return 1;
     }
@@ -833,9 +1150,9 @@ App::DocumentObjectExecReturn* Feature::execute()
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
-            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
+            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue(),
+                                              this->ToleranceBand.getValue());
         }
 
         if (nominal) {
@@ -901,47 +1218,63 @@ App::DocumentObjectExecReturn* Feature::execute()
 #else
     unsigned long count = actual->countPoints();
     std::vector<float> vals(count);
-    std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index) {
+    // the points are inspected in chunks so that the nominals can handle nearby points together
+    const unsigned long chunkSize = 1024;
+    std::function<DistanceInspectionRMS(unsigned long)> fMap = [&](unsigned long begin) {
         DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
+        unsigned long end = std::min(begin + chunkSize, count);
+        std::vector<Base::Vector3f> pnts;
+        pnts.reserve(end - begin);
+        for (unsigned long index = begin; index < end; index++) {
+            pnts.push_back(actual->getPoint(index));
+        }
 
-        float fMinDist = std::numeric_limits<float>::max();
+        std::vector<float> minDists(pnts.size(), std::numeric_limits<float>::max());
+        std::vector<float> dists;
         for (auto it : inspectNominal) {
-            float fDist = it->getDistance(pnt);
-            if (fabs(fDist) < fabs(fMinDist)) {
-                fMinDist = fDist;
+            it->getDistances(pnts, dists);
+            for (std::size_t i = 0; i < pnts.size(); i++) {
+                if (fabs(dists[i]) < fabs(minDists[i])) {
+                    minDists[i] = dists[i];
+                }
             }
         }
 
-        if (fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = std::numeric_limits<float>::max();
-        }
-        else if (-fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = -std::numeric_limits<float>::max();
-        }
-        else {
-            res.m_sumsq += static_cast<double>(fMinDist) * static_cast<double>(fMinDist);
-            res.m_numv++;
-        }
+        for (std::size_t i = 0; i < pnts.size(); i++) {
+            float fMinDist = minDists[i];
+            if (fMinDist > this->SearchRadius.getValue()) {
+                fMinDist = std::numeric_limits<float>::max();
+            }
+            else if (-fMinDist > this->SearchRadius.getValue()) {
+                fMinDist = -std::numeric_limits<float>::max();
+            }
+            else {
+                res.m_sumsq += static_cast<double>(fMinDist) * static_cast<double>(fMinDist);
+                res.m_numv++;
+            }
 
-        vals[index] = fMinDist;
+            vals[begin + i] = fMinDist;
+        }
         return res;
     };
 
+    // Build vector of the first indices of the chunks
+    std::vector<unsigned long> chunks;
+    for (unsigned long index = 0; index < count; index += chunkSize) {
+        chunks.push_back(index);
+    }
+
     DistanceInspectionRMS res;
 
     if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
         // Perform map-reduce operation : compute distances and update sum of squares for RMS
         // computation
         QFuture<DistanceInspectionRMS> future
-            = QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
+            = QtConcurrent::mappedReduced(chunks, fMap, &DistanceInspectionRMS::operator+=);
         // Setup progress bar
         Base::SequencerLauncher seq("Inspecting...", 100);
         unsigned int currentStep = 0;
-        const unsigned int steps = static_cast<unsigned int>(actual->countPoints());
+        const unsigned int steps = static_cast<unsigned int>(chunks.size());
         QFutureWatcher<DistanceInspectionRMS> watcher;
         QObject::connect(
             &watcher,
@@ -975,8 +1308,8 @@ App::DocumentObjectExecReturn* Feature::execute()
         str << "Inspecting " << this->Label.getValue() << "…";
         Base::SequencerLauncher seq(str.str().c_str(), count);
 
-        for (unsigned int i = 0; i < count; i++) {
-            res += fMap(i);
+        for (unsigned long index : chunks) {
+            res += fMap(index);
         }
     }
 
@@ -24,6 +24,11 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -32,12 +37,12 @@
 
 
 class TopoDS_Shape;
-class BRepExtrema_DistShapeShape;
-class gp_Pnt;
 
 namespace MeshCore
 {
 class MeshKernel;
+class MeshFacetBVH;
+class MeshGeomFacet;
 class MeshGrid;
 }  // namespace MeshCore
 
@@ -115,6 +120,12 @@ public:
     InspectNominalGeometry() = default;
     virtual ~InspectNominalGeometry() = default;
     virtual float getDistance(const Base::Vector3f&) const = 0;
+    /** Calculates the distances of all \a points at once. Geometries that can share work
+     * between nearby points override it, by default getDistance() is called for each point. */
+    virtual void getDistances(
+        const std::vector<Base::Vector3f>& points,
+        std::vector<float>& distances
+    ) const;
 };
 
 class InspectionExport InspectNominalMesh: public InspectNominalGeometry
@@ -126,7 +137,7 @@ public:
 
 private:
     const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
     bool _bApply;
     Base::Matrix4D _clTrf;
@@ -138,6 +149,21 @@ public:
     InspectNominalFastMesh(const Mesh::MeshObject& rMesh, float offset);
     ~InspectNominalFastMesh() override;
     float getDistance(const Base::Vector3f&) const override;
+    /** Groups the points by grid element and tests the facets around an element against all
+     * of its points at once. */
+    void getDistances(
+        const std::vector<Base::Vector3f>& points,
+        std::vector<float>& distances
+    ) const override;
+
+private:
+    void getFacets(
+        unsigned long ulX,
+        unsigned long ulY,
+        unsigned long ulZ,
+        std::set<unsigned long>& indices
+    ) const;
+    MeshCore::MeshGeomFacet getFacet(unsigned long index) const;
 
 protected:
     const MeshCore::MeshKernel& _mesh;
@@ -160,21 +186,52 @@ private:
     Points::PointsGrid* _pGrid;
 };
 
+/** Calculates the distance to a shape in two stages.
+ *
+ * A fine tessellation of the faces with a bounding volume hierarchy gives an
+ * approximate distance and the faces near a point. Only if the approximate
+ * distance lies within the tolerance band the exact distance is computed, and
+ * only to these faces. Each call of getDistances() takes an evaluator for the
+ * exact distances from a pool for all of its points, so that the distances can
+ * be computed concurrently.
+ */
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
 {
 public:
-    InspectNominalShape(const TopoDS_Shape&, float offset);
+    /** \a band is the distance up to which the exact distance is computed, 0 means \a offset.
+     * Shapes without faces are always evaluated exactly.
+     */
+    InspectNominalShape(const TopoDS_Shape&, float offset, float band = 0.0F);
     ~InspectNominalShape() override;
     float getDistance(const Base::Vector3f&) const override;
+    void getDistances(
+        const std::vector<Base::Vector3f>& points,
+        std::vector<float>& distances
+    ) const override;
 
 private:
-    bool isInsideSolid(const gp_Pnt&) const;
-    bool isBelowFace(const gp_Pnt&) const;
+    struct Tessellation;
+    class Evaluator;
+
+    void tessellate();
+    std::unique_ptr<Evaluator> takeEvaluator() const;
+    void returnEvaluator(std::unique_ptr<Evaluator>) const;
+    float getDistance(const Base::Vector3f&, Evaluator&) const;
+    float getExactDistance(
+        const Base::Vector3f&,
+        const std::vector<int>& faces,
+        Evaluator&
+    ) const;
+    void getFaces(const Base::Vector3f&, float radius, std::vector<int>& faces) const;
 
 private:
-    BRepExtrema_DistShapeShape* distss;
     const TopoDS_Shape& _rShape;
+    std::unique_ptr<TopoDS_Shape> _shell;
+    std::unique_ptr<Tessellation> _tessellation;
+    float _band;
     bool isSolid {false};
+    mutable std::mutex _mutex;
+    mutable std::vector<std::unique_ptr<Evaluator>> _evaluators;  // the unused evaluators
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
@@ -253,6 +310,8 @@ public:
     //@{
     App::PropertyFloat SearchRadius;
     App::PropertyFloat Thickness;
+    /// Distance up to which the distance to a shape is computed exactly, 0 means SearchRadius
+    App::PropertyFloat ToleranceBand;
     App::PropertyLink Actual;
     App::PropertyLinkList Nominals;
     PropertyDistanceList Distances;
@@ -27,15 +27,25 @@
 #include <FCConfig.h>
 
 // STL
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <thread>
 
 // OCC
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_Triangle.hxx>
 #include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <gp_Pnt.hxx>
 
 // boost
@@ -31,9 +31,11 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Elements.h"
 #include "Grid.h"
 #include "Iterator.h"
+#include "TriangleDistance.h"
 #include "Triangulation.h"
 
 
@@ -150,6 +152,17 @@ bool MeshAlgorithm::NearestFacetOnRay(
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay(
+    const Base::Vector3f& rclPt,
+    const Base::Vector3f& rclDir,
+    const MeshFacetBVH& rclBVH,
+    Base::Vector3f& rclRes,
+    FacetIndex& rulFacet
+) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay(
     const Base::Vector3f& rclPt,
     const Base::Vector3f& rclDir,
@@ -1506,15 +1519,19 @@ bool MeshAlgorithm::NearestPointFromPoint(
     }
 
     // calc each facet
-    float fMinDist = std::numeric_limits<float>::max();
-    FacetIndex ulInd = FACET_INDEX_MAX;
-    MeshFacetIterator pF(_rclMesh);
-    for (pF.Init(); pF.More(); pF.Next()) {
-        float fDist = pF->DistanceToPoint(rclPt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
-            ulInd = pF.Position();
-        }
+    const MeshPointArray& rclPAry = _rclMesh._aclPointArray;
+    const MeshFacetArray& rclFAry = _rclMesh._aclFacetArray;
+    MeshNearestFacetSearch clSearch(rclPt, std::numeric_limits<float>::max());
+    for (std::size_t i = 0; i < rclFAry.size(); i++) {
+        const PointIndex* pulIdx = rclFAry[i]._aulPoints;
+        clSearch.AddFacet(rclPAry[pulIdx[0]], rclPAry[pulIdx[1]], rclPAry[pulIdx[2]], i);
+    }
+
+    float fMinDist {};
+    FacetIndex ulInd = clSearch.NearestFacet(fMinDist);
+    if (ulInd == FACET_INDEX_MAX) {
+        // the distances are not finite
+        return false;
     }
 
     MeshGeomFacet rclSFacet = _rclMesh.GetFacet(ulInd);
@@ -1544,6 +1561,21 @@ bool MeshAlgorithm::NearestPointFromPoint(
     return true;
 }
 
+bool MeshAlgorithm::NearestPointFromPoint(
+    const Base::Vector3f& rclPt,
+    const MeshFacetBVH& rclBVH,
+    FacetIndex& rclResFacetIndex,
+    Base::Vector3f& rclResPoint
+) const
+{
+    return rclBVH.NearestFacetToPoint(
+        rclPt,
+        std::numeric_limits<float>::max(),
+        rclResPoint,
+        rclResFacetIndex
+    );
+}
+
 bool MeshAlgorithm::NearestPointFromPoint(
     const Base::Vector3f& rclPt,
     const MeshFacetGrid& rclGrid,
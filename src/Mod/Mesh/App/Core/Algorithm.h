@@ -46,6 +46,7 @@ namespace MeshCore
 class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
+class MeshFacetBVH;
 class MeshFacetGrid;
 class MeshFacetArray;
 class MeshRefPointToFacets;
@@ -106,6 +107,22 @@ public:
         Base::Vector3f& rclRes,
         FacetIndex& rulFacet
     ) const;
+    /**
+     * Searches for the nearest facet to the ray defined by
+     * (\a rclPt, \a rclDir).
+     * The point \a rclRes holds the intersection point with the ray and the
+     * nearest facet with index \a rulFacet.
+     * \note This method uses the bounding volume hierarchy \a rclBVH which,
+     * unlike a grid, keeps fast for meshes with a very uneven facet density.
+     * Only facets in front of \a rclPt are found.
+     */
+    bool NearestFacetOnRay(
+        const Base::Vector3f& rclPt,
+        const Base::Vector3f& rclDir,
+        const MeshFacetBVH& rclBVH,
+        Base::Vector3f& rclRes,
+        FacetIndex& rulFacet
+    ) const;
     /**
      * Searches for the nearest facet to the ray defined by
      * (\a rclPt, \a rclDir).
@@ -395,6 +412,12 @@ public:
         FacetIndex& rclResFacetIndex,
         Base::Vector3f& rclResPoint
     ) const;
+    bool NearestPointFromPoint(
+        const Base::Vector3f& rclPt,
+        const MeshFacetBVH& rclBVH,
+        FacetIndex& rclResFacetIndex,
+        Base::Vector3f& rclResPoint
+    ) const;
     bool NearestPointFromPoint(
         const Base::Vector3f& rclPt,
         const MeshFacetGrid& rclGrid,
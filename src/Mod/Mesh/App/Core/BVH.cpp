@@ -0,0 +1,732 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <thread>
+
+#include "BVH.h"
+#include "Elements.h"
+#include "MeshKernel.h"
+#include "TriangleDistance.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+constexpr int LeafSize = 4;
+constexpr int NumBins = 12;
+// Below this depth nodes are split in the middle so that the depth stays bounded
+constexpr int MaxSAHDepth = 48;
+// Small nodes are split in the middle so that the leaves get filled
+constexpr std::size_t MinSAHCount = 4 * LeafSize;
+// Smaller subtrees are not worth a thread of their own
+constexpr std::size_t MinParallelCount = 16384;
+constexpr int StackSize = 128;
+constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+struct Node
+{
+    float bmin[3];
+    float bmax[3];
+    uint32_t index;  // the right child of an inner node or the block of a leaf
+    uint32_t count;  // the number of facets of a leaf, 0 for inner nodes
+};
+
+// The facets of a leaf in structure-of-arrays layout so that they can be tested at once.
+// Unused lanes are degenerate and never hit by a ray.
+struct Block
+{
+    TriangleLanes<LeafSize> tri;
+    FacetIndex facet[LeafSize];
+};
+
+// The primitives are reordered while building so that they are always read in sequence
+struct Primitive
+{
+    float bmin[3];
+    float bmax[3];
+    float center[3];
+    uint32_t facet;
+};
+
+struct Bounds
+{
+    float bmin[3] {Infinity, Infinity, Infinity};
+    float bmax[3] {-Infinity, -Infinity, -Infinity};
+
+    void add(const float* pmin, const float* pmax)
+    {
+        for (int i = 0; i < 3; i++) {
+            bmin[i] = std::min(bmin[i], pmin[i]);
+            bmax[i] = std::max(bmax[i], pmax[i]);
+        }
+    }
+    float halfArea() const
+    {
+        if (bmin[0] > bmax[0]) {
+            return 0.0F;
+        }
+        float dx = bmax[0] - bmin[0];
+        float dy = bmax[1] - bmin[1];
+        float dz = bmax[2] - bmin[2];
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+struct Bin
+{
+    Bounds bounds;
+    std::size_t count {0};
+};
+
+// Returns the entry distance of the ray into the box or infinity if it misses the box
+inline float rayBox(const Node& node, const float* org, const float* inv, float tmax)
+{
+    float tmin = 0.0F;
+    for (int i = 0; i < 3; i++) {
+        float t1 = (node.bmin[i] - org[i]) * inv[i];
+        float t2 = (node.bmax[i] - org[i]) * inv[i];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+    }
+    return tmin <= tmax ? tmin : Infinity;
+}
+
+inline float boxDistance(const Node& node, const float* pnt)
+{
+    float dist = 0.0F;
+    for (int i = 0; i < 3; i++) {
+        float delta = std::max({node.bmin[i] - pnt[i], 0.0F, pnt[i] - node.bmax[i]});
+        dist += delta * delta;
+    }
+    return dist;
+}
+
+// Double-sided Moeller-Trumbore test of the ray against all lanes of a block
+inline int rayBlock(const Block& block, const float* org, const float* dir, float& tbest)
+{
+    const TriangleLanes<LeafSize>& tri = block.tri;
+    float tl[LeafSize];
+    for (int i = 0; i < LeafSize; i++) {
+        float e1x = tri.e1[0][i], e1y = tri.e1[1][i], e1z = tri.e1[2][i];
+        float e2x = tri.e2[0][i], e2y = tri.e2[1][i], e2z = tri.e2[2][i];
+        float px = dir[1] * e2z - dir[2] * e2y;
+        float py = dir[2] * e2x - dir[0] * e2z;
+        float pz = dir[0] * e2y - dir[1] * e2x;
+        float det = e1x * px + e1y * py + e1z * pz;
+        float inv = 1.0F / det;
+        float tx = org[0] - tri.v0[0][i];
+        float ty = org[1] - tri.v0[1][i];
+        float tz = org[2] - tri.v0[2][i];
+        float u = (tx * px + ty * py + tz * pz) * inv;
+        float qx = ty * e1z - tz * e1y;
+        float qy = tz * e1x - tx * e1z;
+        float qz = tx * e1y - ty * e1x;
+        float v = (dir[0] * qx + dir[1] * qy + dir[2] * qz) * inv;
+        float t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+        bool hit = det != 0.0F && u >= 0.0F && v >= 0.0F && u + v <= 1.0F && t >= 0.0F;
+        tl[i] = hit ? t : Infinity;
+    }
+
+    int lane = -1;
+    for (int i = 0; i < LeafSize; i++) {
+        if (tl[i] < tbest) {
+            tbest = tl[i];
+            lane = i;
+        }
+    }
+    return lane;
+}
+
+// Closest point on the triangle (a, a + ab, a + ac), see Ericson, Real-Time Collision Detection
+Base::Vector3f closestPoint(
+    const Base::Vector3f& p,
+    const Base::Vector3f& a,
+    const Base::Vector3f& ab,
+    const Base::Vector3f& ac
+)
+{
+    Base::Vector3f ap = p - a;
+    float d1 = ab * ap;
+    float d2 = ac * ap;
+    if (d1 <= 0.0F && d2 <= 0.0F) {
+        return a;
+    }
+
+    Base::Vector3f bp = ap - ab;
+    float d3 = ab * bp;
+    float d4 = ac * bp;
+    if (d3 >= 0.0F && d4 <= d3) {
+        return a + ab;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0F && d1 >= 0.0F && d3 <= 0.0F) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    Base::Vector3f cp = ap - ac;
+    float d5 = ab * cp;
+    float d6 = ac * cp;
+    if (d6 >= 0.0F && d5 <= d6) {
+        return a + ac;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0F && d2 >= 0.0F && d6 <= 0.0F) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0F && (d4 - d3) >= 0.0F && (d5 - d6) >= 0.0F) {
+        return a + ab + (ac - ab) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    float denom = va + vb + vc;
+    if (denom == 0.0F) {
+        // degenerated facet
+        return a;
+    }
+    return a + ab * (vb / denom) + ac * (vc / denom);
+}
+
+// Builds the hierarchy in depth-first order, i.e. the left child of an inner node directly
+// follows its parent. Large right subtrees are built concurrently.
+class Builder
+{
+public:
+    Builder(
+        const std::vector<Base::Vector3f>& corners,
+        std::vector<Primitive>& prims,
+        int parallelDepth
+    )
+        : corners(corners)
+        , prims(prims)
+        , parallelDepth(parallelDepth)
+    {}
+
+    void build(std::size_t begin, std::size_t end, int depth)
+    {
+        std::size_t nodeIndex = nodes.size();
+        nodes.emplace_back();
+
+        Bounds bounds;
+        Bounds centers;
+        for (std::size_t i = begin; i < end; i++) {
+            const Primitive& prim = prims[i];
+            bounds.add(prim.bmin, prim.bmax);
+            centers.add(prim.center, prim.center);
+        }
+        std::copy(bounds.bmin, bounds.bmin + 3, nodes[nodeIndex].bmin);
+        std::copy(bounds.bmax, bounds.bmax + 3, nodes[nodeIndex].bmax);
+
+        std::size_t count = end - begin;
+        if (count <= LeafSize) {
+            makeLeaf(nodeIndex, begin, end);
+            return;
+        }
+
+        bool useSAH = depth < MaxSAHDepth && count > MinSAHCount;
+        std::size_t mid = useSAH ? splitSAH(begin, end, centers) : end;
+        if (mid == begin || mid == end) {
+            mid = splitMiddle(begin, end, centers);
+        }
+
+        nodes[nodeIndex].count = 0;
+        if (depth < parallelDepth && count >= MinParallelCount) {
+            // the two sides use disjoint ranges of the primitives
+            Builder right(corners, prims, parallelDepth);
+            auto future = std::async(std::launch::async, [&right, mid, end, depth]() {
+                right.build(mid, end, depth + 1);
+            });
+            build(begin, mid, depth + 1);
+            future.get();
+            append(nodeIndex, right);
+        }
+        else {
+            build(begin, mid, depth + 1);
+            nodes[nodeIndex].index = static_cast<uint32_t>(nodes.size());
+            build(mid, end, depth + 1);
+        }
+    }
+
+    std::vector<Node> nodes;
+    std::vector<Block> blocks;
+
+private:
+    // Appends the subtree built by \a right as right child of the node \a nodeIndex
+    void append(std::size_t nodeIndex, const Builder& right)
+    {
+        auto nodeOffset = static_cast<uint32_t>(nodes.size());
+        auto blockOffset = static_cast<uint32_t>(blocks.size());
+        nodes[nodeIndex].index = nodeOffset;
+        for (Node node : right.nodes) {
+            node.index += node.count > 0 ? blockOffset : nodeOffset;
+            nodes.push_back(node);
+        }
+        blocks.insert(blocks.end(), right.blocks.begin(), right.blocks.end());
+    }
+
+    std::size_t splitSAH(std::size_t begin, std::size_t end, const Bounds& centers)
+    {
+        // bin the primitives along all three axes in a single pass
+        std::array<std::array<Bin, NumBins>, 3> bins;
+        std::array<float, 3> scale {};
+        for (int axis = 0; axis < 3; axis++) {
+            float extent = centers.bmax[axis] - centers.bmin[axis];
+            scale[axis] = extent > 0.0F ? NumBins / extent : 0.0F;
+        }
+        for (std::size_t i = begin; i < end; i++) {
+            const Primitive& prim = prims[i];
+            for (int axis = 0; axis < 3; axis++) {
+                Bin& bin = bins[axis][binIndex(prim.center[axis], centers.bmin[axis], scale[axis])];
+                bin.bounds.add(prim.bmin, prim.bmax);
+                bin.count++;
+            }
+        }
+
+        float bestCost = Infinity;
+        int bestAxis = -1;
+        int bestBin = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            if (scale[axis] == 0.0F) {
+                continue;
+            }
+
+            // sweep from the right to get the cost of the right sides
+            std::array<float, NumBins> rightCost {};
+            Bounds right;
+            std::size_t rightCount = 0;
+            for (int i = NumBins - 1; i > 0; i--) {
+                right.add(bins[axis][i].bounds.bmin, bins[axis][i].bounds.bmax);
+                rightCount += bins[axis][i].count;
+                rightCost[i] = right.halfArea() * float(rightCount);
+            }
+
+            Bounds left;
+            std::size_t leftCount = 0;
+            for (int i = 0; i < NumBins - 1; i++) {
+                left.add(bins[axis][i].bounds.bmin, bins[axis][i].bounds.bmax);
+                leftCount += bins[axis][i].count;
+                float cost = left.halfArea() * float(leftCount) + rightCost[i + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i;
+                }
+            }
+        }
+
+        if (bestAxis < 0) {
+            return begin;
+        }
+
+        float minimum = centers.bmin[bestAxis];
+        float factor = scale[bestAxis];
+        auto it = std::partition(
+            prims.begin() + begin,
+            prims.begin() + end,
+            [&](const Primitive& prim) {
+                return binIndex(prim.center[bestAxis], minimum, factor) <= bestBin;
+            }
+        );
+        return static_cast<std::size_t>(it - prims.begin());
+    }
+
+    std::size_t splitMiddle(std::size_t begin, std::size_t end, const Bounds& centers)
+    {
+        int axis = 0;
+        float extent = centers.bmax[0] - centers.bmin[0];
+        for (int i = 1; i < 3; i++) {
+            if (centers.bmax[i] - centers.bmin[i] > extent) {
+                extent = centers.bmax[i] - centers.bmin[i];
+                axis = i;
+            }
+        }
+
+        // keep the left side a multiple of the leaf size
+        std::size_t count = end - begin;
+        std::size_t mid = begin + LeafSize * ((count + 2 * LeafSize - 1) / (2 * LeafSize));
+        std::nth_element(
+            prims.begin() + begin,
+            prims.begin() + mid,
+            prims.begin() + end,
+            [axis](const Primitive& a, const Primitive& b) {
+                return a.center[axis] < b.center[axis];
+            }
+        );
+        return mid;
+    }
+
+    static int binIndex(float value, float minimum, float scale)
+    {
+        int bin = static_cast<int>((value - minimum) * scale);
+        return std::clamp(bin, 0, NumBins - 1);
+    }
+
+    void makeLeaf(std::size_t nodeIndex, std::size_t begin, std::size_t end)
+    {
+        Block block {};
+        for (int lane = 0; lane < LeafSize; lane++) {
+            block.facet[lane] = FACET_INDEX_MAX;
+        }
+        for (std::size_t i = begin; i < end; i++) {
+            int lane = static_cast<int>(i - begin);
+            uint32_t facet = prims[i].facet;
+            block.tri.set(lane, corners[3 * facet], corners[3 * facet + 1], corners[3 * facet + 2]);
+            block.facet[lane] = facet;
+        }
+
+        nodes[nodeIndex].index = static_cast<uint32_t>(blocks.size());
+        nodes[nodeIndex].count = static_cast<uint32_t>(end - begin);
+        blocks.push_back(block);
+    }
+
+    const std::vector<Base::Vector3f>& corners;
+    std::vector<Primitive>& prims;
+    int parallelDepth;
+};
+
+}  // namespace
+
+class MeshFacetBVH::Private
+{
+public:
+    explicit Private(std::vector<Base::Vector3f>&& points)
+    {
+        numFacets = points.size() / 3;
+        std::vector<Primitive> prims(numFacets);
+        for (std::size_t i = 0; i < numFacets; i++) {
+            Primitive& prim = prims[i];
+            const Base::Vector3f& p0 = points[3 * i];
+            const Base::Vector3f& p1 = points[3 * i + 1];
+            const Base::Vector3f& p2 = points[3 * i + 2];
+            for (unsigned short j = 0; j < 3; j++) {
+                prim.bmin[j] = std::min({p0[j], p1[j], p2[j]});
+                prim.bmax[j] = std::max({p0[j], p1[j], p2[j]});
+                prim.center[j] = 0.5F * (prim.bmin[j] + prim.bmax[j]);
+            }
+            prim.facet = static_cast<uint32_t>(i);
+        }
+
+        // every level of parallel subtrees doubles the number of threads
+        unsigned int threads = std::thread::hardware_concurrency();
+        int parallelDepth = 0;
+        while (threads > 1) {
+            threads /= 2;
+            parallelDepth++;
+        }
+
+        Builder builder(points, prims, parallelDepth);
+        builder.nodes.reserve(2 * numFacets / LeafSize + 1);
+        builder.blocks.reserve(numFacets / 2 + 1);
+        if (numFacets > 0) {
+            builder.build(0, numFacets, 0);
+        }
+
+        nodes = std::move(builder.nodes);
+        blocks = std::move(builder.blocks);
+    }
+
+    static void getFacet(
+        const Block& block,
+        int lane,
+        Base::Vector3f& v0,
+        Base::Vector3f& e1,
+        Base::Vector3f& e2
+    )
+    {
+        const TriangleLanes<LeafSize>& tri = block.tri;
+        v0.Set(tri.v0[0][lane], tri.v0[1][lane], tri.v0[2][lane]);
+        e1.Set(tri.e1[0][lane], tri.e1[1][lane], tri.e1[2][lane]);
+        e2.Set(tri.e2[0][lane], tri.e2[1][lane], tri.e2[2][lane]);
+    }
+
+    void getFacetBox(const Block& block, int lane, Base::BoundBox3f& box) const
+    {
+        box = Base::BoundBox3f();
+        Base::Vector3f v0, e1, e2;
+        getFacet(block, lane, v0, e1, e2);
+        box.Add(v0);
+        box.Add(v0 + e1);
+        box.Add(v0 + e2);
+    }
+
+    std::vector<Node> nodes;
+    std::vector<Block> blocks;
+    std::size_t numFacets {0};
+};
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh)
+{
+    const MeshPointArray& points = mesh.GetPoints();
+    const MeshFacetArray& facets = mesh.GetFacets();
+    std::vector<Base::Vector3f> corners;
+    corners.reserve(3 * facets.size());
+    for (const auto& facet : facets) {
+        for (PointIndex index : facet._aulPoints) {
+            corners.push_back(points[index]);
+        }
+    }
+
+    d = new Private(std::move(corners));
+}
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat)
+{
+    const MeshPointArray& points = mesh.GetPoints();
+    const MeshFacetArray& facets = mesh.GetFacets();
+    std::vector<Base::Vector3f> corners;
+    corners.reserve(3 * facets.size());
+    for (const auto& facet : facets) {
+        for (PointIndex index : facet._aulPoints) {
+            corners.push_back(mat * points[index]);
+        }
+    }
+
+    d = new Private(std::move(corners));
+}
+
+MeshFacetBVH::~MeshFacetBVH()
+{
+    delete d;
+}
+
+std::size_t MeshFacetBVH::CountFacets() const
+{
+    return d->numFacets;
+}
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    if (d->nodes.empty()) {
+        return Base::BoundBox3f();
+    }
+
+    const Node& root = d->nodes.front();
+    return Base::BoundBox3f(
+        root.bmin[0],
+        root.bmin[1],
+        root.bmin[2],
+        root.bmax[0],
+        root.bmax[1],
+        root.bmax[2]
+    );
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(
+    const Base::Vector3f& rclPt,
+    const Base::Vector3f& rclDir,
+    Base::Vector3f& rclRes,
+    FacetIndex& rulFacet
+) const
+{
+    if (d->nodes.empty()) {
+        return false;
+    }
+
+    const float org[3] = {rclPt.x, rclPt.y, rclPt.z};
+    const float dir[3] = {rclDir.x, rclDir.y, rclDir.z};
+    const float inv[3] = {1.0F / rclDir.x, 1.0F / rclDir.y, 1.0F / rclDir.z};
+    const std::vector<Node>& nodes = d->nodes;
+
+    float tbest = Infinity;
+    FacetIndex facet = FACET_INDEX_MAX;
+
+    std::array<std::pair<uint32_t, float>, StackSize> stack;
+    int top = 0;
+    float troot = rayBox(nodes[0], org, inv, tbest);
+    if (troot < Infinity) {
+        stack[top++] = {0, troot};
+    }
+
+    while (top > 0) {
+        auto [index, tnear] = stack[--top];
+        if (tnear > tbest) {
+            continue;
+        }
+
+        const Node& node = nodes[index];
+        if (node.count > 0) {
+            const Block& block = d->blocks[node.index];
+            int lane = rayBlock(block, org, dir, tbest);
+            if (lane >= 0) {
+                facet = block.facet[lane];
+            }
+            continue;
+        }
+
+        // visit the nearer child first
+        uint32_t left = index + 1;
+        uint32_t right = node.index;
+        float tleft = rayBox(nodes[left], org, inv, tbest);
+        float tright = rayBox(nodes[right], org, inv, tbest);
+        if (tleft > tright) {
+            std::swap(left, right);
+            std::swap(tleft, tright);
+        }
+        if (tright < Infinity) {
+            stack[top++] = {right, tright};
+        }
+        if (tleft < Infinity) {
+            stack[top++] = {left, tleft};
+        }
+    }
+
+    if (facet == FACET_INDEX_MAX) {
+        return false;
+    }
+
+    rclRes = rclPt + tbest * rclDir;
+    rulFacet = facet;
+    return true;
+}
+
+bool MeshFacetBVH::NearestFacetToPoint(
+    const Base::Vector3f& rclPt,
+    float fMaxDist,
+    Base::Vector3f& rclRes,
+    FacetIndex& rulFacet
+) const
+{
+    if (d->nodes.empty()) {
+        return false;
+    }
+
+    const float pnt[3] = {rclPt.x, rclPt.y, rclPt.z};
+    const std::vector<Node>& nodes = d->nodes;
+
+    float best = fMaxDist < std::numeric_limits<float>::max() ? fMaxDist * fMaxDist : Infinity;
+    const Block* bestBlock = nullptr;
+    int bestLane = 0;
+    float dist2[LeafSize];
+
+    std::array<std::pair<uint32_t, float>, StackSize> stack;
+    int top = 0;
+    stack[top++] = {0, boxDistance(nodes[0], pnt)};
+
+    while (top > 0) {
+        auto [index, dist] = stack[--top];
+        if (dist > best) {
+            continue;
+        }
+
+        const Node& node = nodes[index];
+        if (node.count > 0) {
+            // only the nearest point of the best facet is computed at the end
+            const Block& block = d->blocks[node.index];
+            block.tri.distance2(pnt, dist2);
+            for (int lane = 0; lane < static_cast<int>(node.count); lane++) {
+                if (dist2[lane] <= best) {
+                    best = dist2[lane];
+                    bestBlock = &block;
+                    bestLane = lane;
+                }
+            }
+            continue;
+        }
+
+        // visit the nearer child first
+        uint32_t left = index + 1;
+        uint32_t right = node.index;
+        float dleft = boxDistance(nodes[left], pnt);
+        float dright = boxDistance(nodes[right], pnt);
+        if (dleft > dright) {
+            std::swap(left, right);
+            std::swap(dleft, dright);
+        }
+        if (dright <= best) {
+            stack[top++] = {right, dright};
+        }
+        if (dleft <= best) {
+            stack[top++] = {left, dleft};
+        }
+    }
+
+    if (!bestBlock) {
+        return false;
+    }
+
+    Base::Vector3f v0, e1, e2;
+    Private::getFacet(*bestBlock, bestLane, v0, e1, e2);
+    rclRes = closestPoint(rclPt, v0, e1, e2);
+    rulFacet = bestBlock->facet[bestLane];
+    return true;
+}
+
+void MeshFacetBVH::Search(
+    const std::function<bool(const Base::BoundBox3f&)>& test,
+    std::vector<FacetIndex>& raulFacets
+) const
+{
+    if (d->nodes.empty()) {
+        return;
+    }
+
+    const std::vector<Node>& nodes = d->nodes;
+    std::array<uint32_t, StackSize> stack;
+    int top = 0;
+    stack[top++] = 0;
+
+    Base::BoundBox3f box;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        box = Base::BoundBox3f(
+            node.bmin[0],
+            node.bmin[1],
+            node.bmin[2],
+            node.bmax[0],
+            node.bmax[1],
+            node.bmax[2]
+        );
+        if (!test(box)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            const Block& block = d->blocks[node.index];
+            for (uint32_t lane = 0; lane < node.count; lane++) {
+                d->getFacetBox(block, static_cast<int>(lane), box);
+                if (test(box)) {
+                    raulFacets.push_back(block.facet[lane]);
+                }
+            }
+            continue;
+        }
+
+        uint32_t index = static_cast<uint32_t>(&node - nodes.data());
+        stack[top++] = node.index;
+        stack[top++] = index + 1;
+    }
+}
+
+void MeshFacetBVH::Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const
+{
+    Search([&rclBB](const Base::BoundBox3f& box) { return box && rclBB; }, raulFacets);
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh.
+ *
+ * Unlike MeshFacetGrid its cells adapt to the facets, so that ray and nearest point queries
+ * keep their speed on meshes with a very uneven facet density, e.g. scans where fine details
+ * lie next to huge flat facets. The hierarchy is built with the surface area heuristic and
+ * every leaf holds up to four facets which are tested at once.
+ *
+ * The hierarchy is a snapshot of the mesh: it must be rebuilt after the mesh has changed.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// Builds the hierarchy over the facets of \a mesh.
+    explicit MeshFacetBVH(const MeshKernel& mesh);
+    /// Builds the hierarchy over the facets of \a mesh transformed by \a mat.
+    MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat);
+    ~MeshFacetBVH();
+
+    MeshFacetBVH(const MeshFacetBVH&) = delete;
+    MeshFacetBVH(MeshFacetBVH&&) = delete;
+    MeshFacetBVH& operator=(const MeshFacetBVH&) = delete;
+    MeshFacetBVH& operator=(MeshFacetBVH&&) = delete;
+
+    /// Returns the number of facets.
+    std::size_t CountFacets() const;
+    /// Returns the bounding box of all facets.
+    Base::BoundBox3f GetBoundBox() const;
+
+    /**
+     * Searches for the first facet hit by the ray starting at \a rclPt in direction \a rclDir.
+     * Only intersections in front of \a rclPt count. On success \a rclRes holds the intersection
+     * point and \a rulFacet the index of the facet.
+     */
+    bool NearestFacetOnRay(
+        const Base::Vector3f& rclPt,
+        const Base::Vector3f& rclDir,
+        Base::Vector3f& rclRes,
+        FacetIndex& rulFacet
+    ) const;
+    /**
+     * Searches for the facet nearest to \a rclPt with a distance not higher than \a fMaxDist.
+     * On success \a rclRes holds the nearest point on the facet and \a rulFacet its index.
+     */
+    bool NearestFacetToPoint(
+        const Base::Vector3f& rclPt,
+        float fMaxDist,
+        Base::Vector3f& rclRes,
+        FacetIndex& rulFacet
+    ) const;
+    /**
+     * Collects the facets whose bounding box passes \a test. The test is first applied to the
+     * boxes of the hierarchy, so it must also pass for a box that encloses a passing box.
+     */
+    void Search(
+        const std::function<bool(const Base::BoundBox3f&)>& test,
+        std::vector<FacetIndex>& raulFacets
+    ) const;
+    /// Collects the facets whose bounding box intersects \a rclBB.
+    void Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const;
+
+private:
+    class Private;
+    Private* d;
+};
+
+}  // namespace MeshCore
@@ -24,6 +24,8 @@
 
 
 #include <algorithm>
+#include <cstring>
+#include <numeric>
 
 
 #include <Base/Exception.h>
@@ -298,19 +300,20 @@ struct MeshFastBuilder::Private
         {
             return x != rhs.x || y != rhs.y || z != rhs.z;
         }
-        bool operator<(const Vertex& rhs) const
+        uint32_t hash() const
         {
-            if (x != rhs.x) {
-                return x < rhs.x;
-            }
-            if (y != rhs.y) {
-                return y < rhs.y;
-            }
-            if (z != rhs.z) {
-                return z < rhs.z;
-            }
-
-            return false;
+            // adding zero turns -0 into +0 because both compare equal
+            uint64_t h = bits(x + 0.0F) * 0x9E3779B97F4A7C15ULL;
+            h ^= bits(y + 0.0F) * 0xC2B2AE3D27D4EB4FULL;
+            h ^= bits(z + 0.0F) * 0x165667B19E3779F9ULL;
+            h ^= h >> 29;
+            return static_cast<uint32_t>(h >> 32);
+        }
+        static uint64_t bits(float value)
+        {
+            uint32_t val {};
+            std::memcpy(&val, &value, sizeof(val));
+            return val;
         }
     };
 
@@ -355,45 +358,109 @@ void MeshFastBuilder::AddFacet(const MeshGeomFacet& facetPoints)
     }
 }
 
-void MeshFastBuilder::Finish()
+void MeshFastBuilder::AddFacets(const char* data, size_type ctFacets, std::size_t stride)
 {
     using size_type = QVector<Private::Vertex>::size_type;
     QVector<Private::Vertex>& verts = p->verts;
-    size_type ulCtPts = verts.size();
-    for (size_type i = 0; i < ulCtPts; ++i) {
-        verts[i].i = i;
-    }
-
-    // std::sort(verts.begin(), verts.end());
-    int threads = int(std::thread::hardware_concurrency());
-    MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<>(), threads);
-
-    QVector<FacetIndex> indices(ulCtPts);
+    size_type offset = verts.size();
+    verts.resize(offset + 3 * ctFacets);
+
+    Private::Vertex* dest = verts.data() + offset;
+    MeshCore::parallel_chunks(ctFacets, 0x4000, [=](std::size_t begin, std::size_t end) {
+        float coords[9];
+        for (std::size_t i = begin; i < end; i++) {
+            std::memcpy(coords, data + i * stride, sizeof(coords));
+            for (std::size_t j = 0; j < 3; j++) {
+                const float* pnt = coords + 3 * j;
+                dest[3 * i + j] = Private::Vertex(pnt[0], pnt[1], pnt[2]);
+            }
+        }
+    });
+}
 
-    size_type vertex_count = 0;
-    for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
-        if (!vertex_count || *v != verts[vertex_count - 1]) {
-            verts[vertex_count++] = *v;
+void MeshFastBuilder::Finish()
+{
+    QVector<Private::Vertex>& verts = p->verts;
+    std::size_t ulCtPts = static_cast<std::size_t>(verts.size());
+    Private::Vertex* data = verts.data();
+
+    // To find equal points in parallel they are distributed over buckets by their hash value
+    // and each bucket gets its own hash table. Afterwards the member 'i' of a vertex refers to
+    // the first vertex with the same coordinates.
+    constexpr int bucketBits = 6;
+    constexpr std::size_t numBuckets = std::size_t(1) << bucketBits;
+    std::vector<uint32_t> hashes(ulCtPts);
+    auto hashPoints = [&hashes, data](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            hashes[i] = data[i].hash();
         }
+    };
+    MeshCore::parallel_chunks(ulCtPts, 0x10000, hashPoints);
 
-        indices[v->i] = static_cast<FacetIndex>(vertex_count - 1);
+    std::vector<std::size_t> offsets(numBuckets + 1);
+    for (uint32_t hash : hashes) {
+        offsets[(hash >> (32 - bucketBits)) + 1]++;
     }
-
-    size_type ulCt = verts.size() / 3;
-    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
-    for (size_type i = 0; i < ulCt; ++i) {
-        rFacets[static_cast<size_t>(i)]._aulPoints[0] = indices[3 * i];
-        rFacets[static_cast<size_t>(i)]._aulPoints[1] = indices[3 * i + 1];
-        rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3 * i + 2];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_type> order(ulCtPts);
+    std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < ulCtPts; ++i) {
+        order[pos[hashes[i] >> (32 - bucketBits)]++] = static_cast<size_type>(i);
     }
 
-    verts.resize(vertex_count);
+    auto weldPoints = [&](std::size_t begin, std::size_t end) {
+        std::vector<size_type> table;
+        for (std::size_t bucket = begin; bucket < end; ++bucket) {
+            std::size_t count = offsets[bucket + 1] - offsets[bucket];
+            std::size_t mask = 1;
+            while (mask < 2 * count) {
+                mask <<= 1;
+            }
+            mask -= 1;
+            table.assign(mask + 1, -1);
+
+            for (std::size_t k = offsets[bucket]; k < offsets[bucket + 1]; ++k) {
+                size_type index = order[k];
+                Private::Vertex& v = data[index];
+                std::size_t slot = hashes[index] & mask;
+                while (table[slot] >= 0 && v != data[table[slot]]) {
+                    slot = (slot + 1) & mask;
+                }
+                if (table[slot] < 0) {
+                    table[slot] = index;
+                }
+                v.i = table[slot];
+            }
+        }
+    };
+    MeshCore::parallel_chunks(numBuckets, 1, weldPoints);
 
+    // the points keep the order of their first occurrence
+    std::vector<PointIndex> indices(ulCtPts);
     MeshPointArray rPoints;
-    rPoints.reserve(static_cast<size_t>(vertex_count));
-    for (const auto& v : verts) {
-        rPoints.push_back(MeshPoint(v.x, v.y, v.z));
+    rPoints.reserve(ulCtPts / 6);
+    for (std::size_t i = 0; i < ulCtPts; ++i) {
+        const Private::Vertex& v = data[i];
+        if (static_cast<std::size_t>(v.i) == i) {
+            indices[i] = static_cast<PointIndex>(rPoints.size());
+            rPoints.push_back(MeshPoint(v.x, v.y, v.z));
+        }
+        else {
+            indices[i] = indices[v.i];
+        }
     }
 
+    std::size_t ulCt = ulCtPts / 3;
+    MeshFacetArray rFacets(ulCt);
+    const PointIndex* index = indices.data();
+    MeshCore::parallel_chunks(ulCt, 0x4000, [&rFacets, index](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            rFacets[i]._aulPoints[0] = index[3 * i];
+            rFacets[i]._aulPoints[1] = index[3 * i + 1];
+            rFacets[i]._aulPoints[2] = index[3 * i + 2];
+        }
+    });
+
+    verts.clear();
     _meshKernel.Adopt(rPoints, rFacets, true);
 }
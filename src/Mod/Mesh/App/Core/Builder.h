@@ -221,6 +221,10 @@ public:
     /** Add new facet
      */
     void AddFacet(const MeshGeomFacet& facetPoints);
+    /** Add \a ctFacets facets at once. The corner points of the i-th facet are stored as nine
+     * consecutive floats at \a data + i * \a stride. The facets are copied in parallel.
+     */
+    void AddFacets(const char* data, size_type ctFacets, std::size_t stride);
 
     /** Finishes building up the mesh structure. Must be done after adding facets.
      */
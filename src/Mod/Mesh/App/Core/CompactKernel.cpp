@@ -0,0 +1,413 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include <Base/Exception.h>
+
+#include "CompactKernel.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+#include "Visitor.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+constexpr float QuantizeMax = 65535.0F;
+constexpr std::uint32_t NoNeighbour = std::numeric_limits<std::uint32_t>::max();
+
+struct EdgeRecord
+{
+    std::uint64_t key;
+    std::uint32_t facet;
+    std::uint32_t side;
+};
+
+inline std::size_t BlockCount(std::size_t count)
+{
+    return (count + 63) / 64;
+}
+
+}  // namespace
+
+MeshCompactKernel::MeshCompactKernel(const MeshKernel& mesh, bool quantize)
+{
+    const MeshPointArray& points = mesh.GetPoints();
+    const MeshFacetArray& facets = mesh.GetFacets();
+    if (points.size() >= NoNeighbour || facets.size() >= NoNeighbour) {
+        throw Base::ValueError("Mesh too large for a compact kernel");
+    }
+
+    _numPoints = points.size();
+    _boundBox = mesh.GetBoundBox();
+
+    if (quantize && _numPoints > 0) {
+        _scale.x = (_boundBox.MaxX - _boundBox.MinX) / QuantizeMax;
+        _scale.y = (_boundBox.MaxY - _boundBox.MinY) / QuantizeMax;
+        _scale.z = (_boundBox.MaxZ - _boundBox.MinZ) / QuantizeMax;
+        auto encode = [](float value, float min, float scale) {
+            if (scale <= 0.0F) {
+                return std::uint16_t(0);
+            }
+            float q = std::round((value - min) / scale);
+            return static_cast<std::uint16_t>(std::clamp(q, 0.0F, QuantizeMax));
+        };
+
+        _quantized.reserve(3 * _numPoints);
+        for (const auto& pnt : points) {
+            _quantized.push_back(encode(pnt.x, _boundBox.MinX, _scale.x));
+            _quantized.push_back(encode(pnt.y, _boundBox.MinY, _scale.y));
+            _quantized.push_back(encode(pnt.z, _boundBox.MinZ, _scale.z));
+        }
+    }
+    else {
+        _coords.reserve(3 * _numPoints);
+        for (const auto& pnt : points) {
+            _coords.push_back(pnt.x);
+            _coords.push_back(pnt.y);
+            _coords.push_back(pnt.z);
+        }
+    }
+
+    _points.reserve(3 * facets.size());
+    for (const auto& facet : facets) {
+        for (PointIndex index : facet._aulPoints) {
+            _points.push_back(static_cast<std::uint32_t>(index));
+        }
+    }
+}
+
+MeshCompactKernel::~MeshCompactKernel() = default;
+
+std::size_t MeshCompactKernel::GetMemSize() const
+{
+    std::size_t size = sizeof(MeshCompactKernel);
+    size += _coords.capacity() * sizeof(float);
+    size += _quantized.capacity() * sizeof(std::uint16_t);
+    size += _points.capacity() * sizeof(std::uint32_t);
+    size += _neighbours.capacity() * sizeof(std::uint32_t);
+    for (const auto& bits : _pointFlags) {
+        size += bits.capacity() * sizeof(std::uint64_t);
+    }
+    for (const auto& bits : _facetFlags) {
+        size += bits.capacity() * sizeof(std::uint64_t);
+    }
+    return size;
+}
+
+MeshPoint MeshCompactKernel::GetPoint(PointIndex index) const
+{
+    MeshPoint point;
+    if (IsQuantized()) {
+        const std::uint16_t* coord = &_quantized[3 * index];
+        point.x = _boundBox.MinX + float(coord[0]) * _scale.x;
+        point.y = _boundBox.MinY + float(coord[1]) * _scale.y;
+        point.z = _boundBox.MinZ + float(coord[2]) * _scale.z;
+    }
+    else {
+        const float* coord = &_coords[3 * index];
+        point.Set(coord[0], coord[1], coord[2]);
+    }
+    point._ucFlag = GetFlags(_pointFlags, index);
+    return point;
+}
+
+MeshGeomFacet MeshCompactKernel::GetFacet(FacetIndex index) const
+{
+    MeshGeomFacet facet;
+    for (int i = 0; i < 3; i++) {
+        facet._aclPoints[i] = GetPoint(_points[3 * index + i]);
+    }
+    facet.CalcNormal();
+    facet._ucFlag = GetFlags(_facetFlags, index);
+    return facet;
+}
+
+MeshFacet MeshCompactKernel::GetTopoFacet(FacetIndex index) const
+{
+    MeshFacet facet;
+    GetFacetPoints(index, facet._aulPoints[0], facet._aulPoints[1], facet._aulPoints[2]);
+    GetFacetNeighbours(
+        index,
+        facet._aulNeighbours[0],
+        facet._aulNeighbours[1],
+        facet._aulNeighbours[2]
+    );
+    facet._ucFlag = GetFlags(_facetFlags, index);
+    return facet;
+}
+
+void MeshCompactKernel::GetFacetPoints(
+    FacetIndex index,
+    PointIndex& p0,
+    PointIndex& p1,
+    PointIndex& p2
+) const
+{
+    const std::uint32_t* pnts = &_points[3 * index];
+    p0 = pnts[0];
+    p1 = pnts[1];
+    p2 = pnts[2];
+}
+
+void MeshCompactKernel::GetFacetNeighbours(
+    FacetIndex index,
+    FacetIndex& n0,
+    FacetIndex& n1,
+    FacetIndex& n2
+) const
+{
+    std::call_once(_neighboursBuilt, [this] { BuildNeighbours(); });
+
+    auto convert = [](std::uint32_t value) {
+        return value == NoNeighbour ? FACET_INDEX_MAX : FacetIndex(value);
+    };
+    const std::uint32_t* nbrs = &_neighbours[3 * index];
+    n0 = convert(nbrs[0]);
+    n1 = convert(nbrs[1]);
+    n2 = convert(nbrs[2]);
+}
+
+void MeshCompactKernel::BuildNeighbours() const
+{
+    // same as MeshKernel::RebuildNeighbours(): an edge gets neighbours only if it is shared by
+    // exactly two facets
+    std::size_t numFacets = CountFacets();
+    std::vector<EdgeRecord> edges;
+    edges.reserve(3 * numFacets);
+    for (std::size_t index = 0; index < numFacets; index++) {
+        for (std::uint32_t side = 0; side < 3; side++) {
+            std::uint64_t p0 = _points[3 * index + side];
+            std::uint64_t p1 = _points[3 * index + (side + 1) % 3];
+            EdgeRecord item {};
+            item.key = (std::min(p0, p1) << 32) | std::max(p0, p1);
+            item.facet = static_cast<std::uint32_t>(index);
+            item.side = side;
+            edges.push_back(item);
+        }
+    }
+
+    int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_sort(
+        edges.begin(),
+        edges.end(),
+        [](const EdgeRecord& e1, const EdgeRecord& e2) { return e1.key < e2.key; },
+        threads
+    );
+
+    _neighbours.assign(3 * numFacets, NoNeighbour);
+    for (std::size_t i = 0; i < edges.size();) {
+        std::size_t j = i + 1;
+        while (j < edges.size() && edges[j].key == edges[i].key) {
+            j++;
+        }
+
+        if (j - i == 2) {
+            const EdgeRecord& e0 = edges[i];
+            const EdgeRecord& e1 = edges[i + 1];
+            _neighbours[3 * e0.facet + e0.side] = e1.facet;
+            _neighbours[3 * e1.facet + e1.side] = e0.facet;
+        }
+        i = j;
+    }
+}
+
+bool MeshCompactKernel::IsFlag(const FlagArrays& arrays, std::size_t index, unsigned char flag)
+{
+    std::uint64_t mask = std::uint64_t(1) << (index % 64);
+    for (unsigned int bits = flag; bits != 0; bits &= bits - 1) {
+        const auto& array = arrays[std::countr_zero(bits)];
+        if (array.empty() || (array[index / 64] & mask) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshCompactKernel::SetFlag(
+    FlagArrays& arrays,
+    std::size_t count,
+    std::size_t index,
+    unsigned char flag,
+    bool on
+)
+{
+    std::uint64_t mask = std::uint64_t(1) << (index % 64);
+    for (unsigned int bits = flag; bits != 0; bits &= bits - 1) {
+        auto& array = arrays[std::countr_zero(bits)];
+        if (on) {
+            if (array.empty()) {
+                array.resize(BlockCount(count));
+            }
+            array[index / 64] |= mask;
+        }
+        else if (!array.empty()) {
+            array[index / 64] &= ~mask;
+        }
+    }
+}
+
+unsigned char MeshCompactKernel::GetFlags(const FlagArrays& arrays, std::size_t index)
+{
+    unsigned char flags = 0;
+    std::uint64_t mask = std::uint64_t(1) << (index % 64);
+    for (std::size_t bit = 0; bit < arrays.size(); bit++) {
+        if (!arrays[bit].empty() && (arrays[bit][index / 64] & mask) != 0) {
+            flags |= static_cast<unsigned char>(1U << bit);
+        }
+    }
+    return flags;
+}
+
+bool MeshCompactKernel::IsPointFlag(PointIndex index, MeshPoint::TFlagType flag) const
+{
+    return IsFlag(_pointFlags, index, static_cast<unsigned char>(flag));
+}
+
+void MeshCompactKernel::SetPointFlag(PointIndex index, MeshPoint::TFlagType flag) const
+{
+    SetFlag(_pointFlags, _numPoints, index, static_cast<unsigned char>(flag), true);
+}
+
+void MeshCompactKernel::ResetPointFlag(PointIndex index, MeshPoint::TFlagType flag) const
+{
+    SetFlag(_pointFlags, _numPoints, index, static_cast<unsigned char>(flag), false);
+}
+
+void MeshCompactKernel::ResetPointFlags(MeshPoint::TFlagType flag) const
+{
+    for (unsigned int bits = flag; bits != 0; bits &= bits - 1) {
+        auto& array = _pointFlags[std::countr_zero(bits)];
+        array.clear();
+        array.shrink_to_fit();
+    }
+}
+
+bool MeshCompactKernel::IsFacetFlag(FacetIndex index, MeshFacet::TFlagType flag) const
+{
+    return IsFlag(_facetFlags, index, static_cast<unsigned char>(flag));
+}
+
+void MeshCompactKernel::SetFacetFlag(FacetIndex index, MeshFacet::TFlagType flag) const
+{
+    SetFlag(_facetFlags, CountFacets(), index, static_cast<unsigned char>(flag), true);
+}
+
+void MeshCompactKernel::ResetFacetFlag(FacetIndex index, MeshFacet::TFlagType flag) const
+{
+    SetFlag(_facetFlags, CountFacets(), index, static_cast<unsigned char>(flag), false);
+}
+
+void MeshCompactKernel::ResetFacetFlags(MeshFacet::TFlagType flag) const
+{
+    for (unsigned int bits = flag; bits != 0; bits &= bits - 1) {
+        auto& array = _facetFlags[std::countr_zero(bits)];
+        array.clear();
+        array.shrink_to_fit();
+    }
+}
+
+unsigned long MeshCompactKernel::VisitNeighbourFacets(
+    MeshFacetVisitor& visitor,
+    FacetIndex startFacet
+) const
+{
+    unsigned long visited = 0;
+    unsigned long level = 0;
+    unsigned long count = CountFacets();
+    std::vector<FacetIndex> currentLevel;
+    std::vector<FacetIndex> nextLevel;
+
+    if (startFacet >= count) {
+        return 0;
+    }
+
+    // pick up start point
+    currentLevel.push_back(startFacet);
+    SetFacetFlag(startFacet, MeshFacet::VISIT);
+
+    // as long as free neighbours
+    while (!currentLevel.empty()) {
+        // visit all neighbours of the current level
+        for (FacetIndex current : currentLevel) {
+            MeshFacet currFacet = GetTopoFacet(current);
+
+            // visit all neighbours of the current level if not yet done
+            for (unsigned short i = 0; i < 3; i++) {
+                FacetIndex j = currFacet._aulNeighbours[i];
+                if (j == FACET_INDEX_MAX || j >= count) {
+                    continue;  // no neighbour facet
+                }
+
+                MeshFacet nbFacet = GetTopoFacet(j);
+                if (!visitor.AllowVisit(nbFacet, currFacet, j, level, i)) {
+                    continue;
+                }
+                if (nbFacet.IsFlag(MeshFacet::VISIT)) {
+                    continue;  // neighbour facet already visited
+                }
+
+                // visit and mark
+                visited++;
+                nextLevel.push_back(j);
+                SetFacetFlag(j, MeshFacet::VISIT);
+                nbFacet.SetFlag(MeshFacet::VISIT);
+
+                if (!visitor.Visit(nbFacet, currFacet, j, level)) {
+                    return visited;
+                }
+            }
+        }
+
+        currentLevel.swap(nextLevel);
+        nextLevel.clear();
+        level++;
+    }
+
+    return visited;
+}
+
+void MeshCompactKernel::CopyTo(MeshKernel& mesh) const
+{
+    MeshPointArray points;
+    points.reserve(_numPoints);
+    for (std::size_t index = 0; index < _numPoints; index++) {
+        points.push_back(GetPoint(index));
+    }
+
+    std::size_t numFacets = CountFacets();
+    MeshFacetArray facets;
+    facets.reserve(numFacets);
+    for (std::size_t index = 0; index < numFacets; index++) {
+        facets.push_back(GetTopoFacet(index));
+    }
+
+    mesh.Adopt(points, facets, false);
+}
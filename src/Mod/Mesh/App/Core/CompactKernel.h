@@ -0,0 +1,411 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Elements.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+class MeshFacetVisitor;
+
+/**
+ * The MeshCompactKernel class is a read-mostly copy of a mesh kernel that needs a fraction of
+ * its memory.
+ *
+ * A facet is stored as three 32-bit point indices and a point as its coordinates, optionally
+ * quantized to 16 bits per coordinate within the bounding box. The neighbours of the facets are
+ * only computed when they are needed first, and each flag is kept in its own bit array that is
+ * allocated when the flag is set first. Properties are not kept.
+ *
+ * The geometry cannot be changed, use CopyTo() to get a modifiable mesh kernel.
+ * \note Like MeshKernel the flags are not thread-safe, whereas the neighbours can be requested
+ * from several threads.
+ */
+class MeshExport MeshCompactKernel
+{
+public:
+    /**
+     * Copies \a mesh. With \a quantize the coordinates are stored as 16-bit integers, which moves
+     * a point by at most half of GetResolution() per coordinate.
+     * \throws Base::ValueError if the mesh has too many points for 32-bit indices
+     */
+    explicit MeshCompactKernel(const MeshKernel& mesh, bool quantize = false);
+    ~MeshCompactKernel();
+
+    MeshCompactKernel(const MeshCompactKernel&) = delete;
+    MeshCompactKernel(MeshCompactKernel&&) = delete;
+    MeshCompactKernel& operator=(const MeshCompactKernel&) = delete;
+    MeshCompactKernel& operator=(MeshCompactKernel&&) = delete;
+
+    /** @name Geometry */
+    //@{
+    /// Returns the number of points
+    unsigned long CountPoints() const
+    {
+        return static_cast<unsigned long>(_numPoints);
+    }
+    /// Returns the number of facets
+    unsigned long CountFacets() const
+    {
+        return static_cast<unsigned long>(_points.size() / 3);
+    }
+    /// Returns the number of required memory in bytes
+    std::size_t GetMemSize() const;
+    /// Returns the bounding box
+    const Base::BoundBox3f& GetBoundBox() const
+    {
+        return _boundBox;
+    }
+    /// Checks whether the coordinates are quantized
+    bool IsQuantized() const
+    {
+        return !_quantized.empty();
+    }
+    /// Returns the quantization step per coordinate, zero if not quantized
+    Base::Vector3f GetResolution() const
+    {
+        return _scale;
+    }
+    /// Returns the point with the index \a index and its flags
+    MeshPoint GetPoint(PointIndex index) const;
+    /// Returns the geometric facet with the index \a index
+    MeshGeomFacet GetFacet(FacetIndex index) const;
+    /// Returns the topologic facet with the index \a index, its neighbours and flags
+    MeshFacet GetTopoFacet(FacetIndex index) const;
+    /// Returns the point indices of the facet with the index \a index
+    void GetFacetPoints(FacetIndex index, PointIndex& p0, PointIndex& p1, PointIndex& p2) const;
+    /// Returns the neighbour indices of the facet with the index \a index
+    void GetFacetNeighbours(FacetIndex index, FacetIndex& n0, FacetIndex& n1, FacetIndex& n2) const;
+    //@}
+
+    /** @name Flags */
+    //@{
+    bool IsPointFlag(PointIndex index, MeshPoint::TFlagType flag) const;
+    void SetPointFlag(PointIndex index, MeshPoint::TFlagType flag) const;
+    void ResetPointFlag(PointIndex index, MeshPoint::TFlagType flag) const;
+    /// Resets \a flag of all points
+    void ResetPointFlags(MeshPoint::TFlagType flag) const;
+    bool IsFacetFlag(FacetIndex index, MeshFacet::TFlagType flag) const;
+    void SetFacetFlag(FacetIndex index, MeshFacet::TFlagType flag) const;
+    void ResetFacetFlag(FacetIndex index, MeshFacet::TFlagType flag) const;
+    /// Resets \a flag of all facets
+    void ResetFacetFlags(MeshFacet::TFlagType flag) const;
+    //@}
+
+    /**
+     * Visits the facets around the facet \a startFacet like MeshKernel::VisitNeighbourFacets().
+     * The facets handed over to \a visitor are temporary copies.
+     */
+    unsigned long VisitNeighbourFacets(MeshFacetVisitor& visitor, FacetIndex startFacet) const;
+
+    /// Copies the points and facets to \a mesh
+    void CopyTo(MeshKernel& mesh) const;
+
+private:
+    using FlagArrays = std::array<std::vector<std::uint64_t>, 8>;
+
+    static bool IsFlag(const FlagArrays& arrays, std::size_t index, unsigned char flag);
+    static void SetFlag(
+        FlagArrays& arrays,
+        std::size_t count,
+        std::size_t index,
+        unsigned char flag,
+        bool on
+    );
+    static unsigned char GetFlags(const FlagArrays& arrays, std::size_t index);
+    void BuildNeighbours() const;
+
+private:
+    std::size_t _numPoints {0};
+    std::vector<float> _coords;             // three coordinates per point if not quantized
+    std::vector<std::uint16_t> _quantized;  // three coordinates per point if quantized
+    std::vector<std::uint32_t> _points;     // three point indices per facet
+    Base::BoundBox3f _boundBox;
+    Base::Vector3f _scale;
+
+    mutable std::vector<std::uint32_t> _neighbours;  // three neighbours per facet, built lazily
+    mutable std::once_flag _neighboursBuilt;
+    mutable FlagArrays _pointFlags;
+    mutable FlagArrays _facetFlags;
+};
+
+/**
+ * The MeshCompactFacetIterator iterates over the facets of a MeshCompactKernel like
+ * MeshFacetIterator does over the facets of a MeshKernel.
+ * \note This class is not thread-safe.
+ */
+class MeshExport MeshCompactFacetIterator
+{
+public:
+    explicit MeshCompactFacetIterator(const MeshCompactKernel& mesh, FacetIndex pos = 0)
+        : _mesh(mesh)
+        , _pos(pos)
+    {}
+
+    /** @name Access methods */
+    //@{
+    /// Access to the element the iterator points to.
+    const MeshGeomFacet& operator*()
+    {
+        return Dereference();
+    }
+    /// Access to the element the iterator points to.
+    const MeshGeomFacet* operator->()
+    {
+        return &Dereference();
+    }
+    /// Increments the iterator.
+    const MeshCompactFacetIterator& operator++()
+    {
+        ++_pos;
+        return *this;
+    }
+    /// Decrements the iterator.
+    const MeshCompactFacetIterator& operator--()
+    {
+        --_pos;
+        return *this;
+    }
+    /// Checks if the iterators points to the same element.
+    bool operator==(const MeshCompactFacetIterator& iter) const
+    {
+        return _pos == iter._pos;
+    }
+    /// Sets the iterator to the beginning of the array.
+    void Begin()
+    {
+        _pos = 0;
+    }
+    /// Sets the iterator to the end of the array.
+    void End()
+    {
+        _pos = _mesh.CountFacets();
+    }
+    /// Returns the current position of the iterator in the array.
+    FacetIndex Position() const
+    {
+        return _pos;
+    }
+    /// Checks if the end is already reached.
+    bool EndReached() const
+    {
+        return _pos >= _mesh.CountFacets();
+    }
+    /// Sets the iterator to the beginning of the array.
+    void Init()
+    {
+        Begin();
+    }
+    /// Checks if the end is not yet reached.
+    bool More() const
+    {
+        return !EndReached();
+    }
+    /// Increments the iterator.
+    void Next()
+    {
+        operator++();
+    }
+    /// Sets the iterator to a given position.
+    bool Set(FacetIndex index)
+    {
+        if (index < _mesh.CountFacets()) {
+            _pos = index;
+            return true;
+        }
+        return false;
+    }
+    /// Returns the topologic facet.
+    MeshFacet GetIndices() const
+    {
+        return _mesh.GetTopoFacet(_pos);
+    }
+    /// Checks if the iterator points to a valid element inside the array.
+    bool IsValid() const
+    {
+        return _pos < _mesh.CountFacets();
+    }
+    //@}
+
+    /** @name Flag state */
+    //@{
+    void SetFlag(MeshFacet::TFlagType flag) const
+    {
+        _mesh.SetFacetFlag(_pos, flag);
+    }
+    void ResetFlag(MeshFacet::TFlagType flag) const
+    {
+        _mesh.ResetFacetFlag(_pos, flag);
+    }
+    bool IsFlag(MeshFacet::TFlagType flag) const
+    {
+        return _mesh.IsFacetFlag(_pos, flag);
+    }
+    //@}
+
+private:
+    const MeshGeomFacet& Dereference()
+    {
+        _facet = _mesh.GetFacet(_pos);
+        return _facet;
+    }
+
+    const MeshCompactKernel& _mesh;
+    FacetIndex _pos;
+    MeshGeomFacet _facet;
+};
+
+/**
+ * The MeshCompactPointIterator iterates over the points of a MeshCompactKernel like
+ * MeshPointIterator does over the points of a MeshKernel.
+ * \note This class is not thread-safe.
+ */
+class MeshExport MeshCompactPointIterator
+{
+public:
+    explicit MeshCompactPointIterator(const MeshCompactKernel& mesh, PointIndex pos = 0)
+        : _mesh(mesh)
+        , _pos(pos)
+    {}
+
+    /** @name Access methods */
+    //@{
+    /// Access to the element the iterator points to.
+    const MeshPoint& operator*()
+    {
+        return Dereference();
+    }
+    /// Access to the element the iterator points to.
+    const MeshPoint* operator->()
+    {
+        return &Dereference();
+    }
+    /// Increments the iterator.
+    const MeshCompactPointIterator& operator++()
+    {
+        ++_pos;
+        return *this;
+    }
+    /// Decrements the iterator.
+    const MeshCompactPointIterator& operator--()
+    {
+        --_pos;
+        return *this;
+    }
+    /// Checks if the iterators points to the same element.
+    bool operator==(const MeshCompactPointIterator& iter) const
+    {
+        return _pos == iter._pos;
+    }
+    /// Sets the iterator to the beginning of the array.
+    void Begin()
+    {
+        _pos = 0;
+    }
+    /// Sets the iterator to the end of the array.
+    void End()
+    {
+        _pos = _mesh.CountPoints();
+    }
+    /// Returns the current position of the iterator in the array.
+    PointIndex Position() const
+    {
+        return _pos;
+    }
+    /// Checks if the end is already reached.
+    bool EndReached() const
+    {
+        return _pos >= _mesh.CountPoints();
+    }
+    /// Sets the iterator to the beginning of the array.
+    void Init()
+    {
+        Begin();
+    }
+    /// Checks if the end is not yet reached.
+    bool More() const
+    {
+        return !EndReached();
+    }
+    /// Increments the iterator.
+    void Next()
+    {
+        operator++();
+    }
+    /// Sets the iterator to a given position.
+    bool Set(PointIndex index)
+    {
+        if (index < _mesh.CountPoints()) {
+            _pos = index;
+            return true;
+        }
+        return false;
+    }
+    /// Checks if the iterator points to a valid element inside the array.
+    bool IsValid() const
+    {
+        return _pos < _mesh.CountPoints();
+    }
+    //@}
+
+    /** @name Flag state */
+    //@{
+    void SetFlag(MeshPoint::TFlagType flag) const
+    {
+        _mesh.SetPointFlag(_pos, flag);
+    }
+    void ResetFlag(MeshPoint::TFlagType flag) const
+    {
+        _mesh.ResetPointFlag(_pos, flag);
+    }
+    bool IsFlag(MeshPoint::TFlagType flag) const
+    {
+        return _mesh.IsPointFlag(_pos, flag);
+    }
+    //@}
+
+private:
+    const MeshPoint& Dereference()
+    {
+        _point = _mesh.GetPoint(_pos);
+        return _point;
+    }
+
+    const MeshCompactKernel& _mesh;
+    PointIndex _pos;
+    MeshPoint _point;
+};
+
+}  // namespace MeshCore
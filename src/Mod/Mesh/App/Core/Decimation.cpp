@@ -22,15 +22,133 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
 
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
+namespace
+{
+// Flags of the points that must not be removed
+enum PointFlag : char
+{
+    KeepPoint = 1,   // on a crease
+    SharedPoint = 2  // shared by two parts
+};
+
+// Adds the facets order[begin, end) to the decimation, the points with one of the flags of \a
+// mask are locked
+void addFacets(
+    Simplify& alg,
+    const MeshKernel& kernel,
+    const std::vector<FacetIndex>& order,
+    std::size_t begin,
+    std::size_t end,
+    const std::vector<char>& flags,
+    char mask
+)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+
+    std::vector<PointIndex> ids;
+    ids.reserve(3 * (end - begin));
+    for (std::size_t i = begin; i < end; i++) {
+        const MeshFacet& face = facets[order[i]];
+        ids.insert(ids.end(), std::begin(face._aulPoints), std::end(face._aulPoints));
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    alg.vertices.reserve(ids.size());
+    for (PointIndex id : ids) {
+        Simplify::Vertex v;
+        v.tstart = 0;
+        v.tcount = 0;
+        v.border = 0;
+        v.p = points[id];
+        v.locked = (flags[id] & mask) != 0 ? 1 : 0;
+        v.id = static_cast<int>(id);
+        alg.vertices.push_back(v);
+    }
+
+    alg.triangles.reserve(end - begin);
+    for (std::size_t i = begin; i < end; i++) {
+        Simplify::Triangle t;
+        t.deleted = 0;
+        t.dirty = 0;
+        for (double& j : t.err) {
+            j = 0.0;
+        }
+        for (int j = 0; j < 3; j++) {
+            auto it = std::lower_bound(ids.begin(), ids.end(), facets[order[i]]._aulPoints[j]);
+            t.v[j] = static_cast<int>(it - ids.begin());
+        }
+        alg.triangles.push_back(t);
+    }
+}
+
+// Splits the facets into parts of about the same size by halving along the longest axis
+std::vector<std::size_t> splitFacets(
+    const MeshKernel& kernel,
+    std::vector<FacetIndex>& order,
+    std::size_t numParts
+)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+    auto center = [&](FacetIndex index) {
+        const MeshFacet& face = facets[index];
+        return points[face._aulPoints[0]] + points[face._aulPoints[1]]
+            + points[face._aulPoints[2]];
+    };
+
+    std::vector<std::size_t> bounds {0, order.size()};
+    while (bounds.size() <= numParts) {
+        std::size_t numRanges = bounds.size() - 1;
+        std::vector<std::size_t> next(2 * numRanges + 1);
+        parallel_chunks(numRanges, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t k = first; k < last; k++) {
+                auto begin = order.begin() + static_cast<std::ptrdiff_t>(bounds[k]);
+                auto end = order.begin() + static_cast<std::ptrdiff_t>(bounds[k + 1]);
+                Base::BoundBox3f box;
+                for (auto it = begin; it != end; ++it) {
+                    box.Add(center(*it));
+                }
+
+                unsigned short axis = 0;
+                if (box.LengthY() > box.LengthX() && box.LengthY() >= box.LengthZ()) {
+                    axis = 1;
+                }
+                else if (box.LengthZ() > box.LengthX() && box.LengthZ() > box.LengthY()) {
+                    axis = 2;
+                }
+
+                auto mid = begin + (end - begin) / 2;
+                std::nth_element(begin, mid, end, [&](FacetIndex f1, FacetIndex f2) {
+                    return center(f1)[axis] < center(f2)[axis];
+                });
+                next[2 * k + 1] = static_cast<std::size_t>(mid - order.begin());
+                next[2 * k + 2] = bounds[k + 1];
+            }
+        });
+        bounds.swap(next);
+    }
+
+    return bounds;
+}
+}  // namespace
+
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
     : myKernel(mesh)
 {}
@@ -154,3 +272,177 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+bool MeshSimplify::simplify(const Parameters& params)
+{
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    std::size_t numFacets = facets.size();
+    if (numFacets == 0 || (params.targetSize > 0 && params.targetSize >= numFacets)) {
+        return true;
+    }
+
+    // lock the points of creases
+    std::vector<char> flags(points.size(), 0);
+    if (params.creaseAngle > 0.0F) {
+        float cosAngle = std::cos(params.creaseAngle);
+        for (std::size_t i = 0; i < numFacets; i++) {
+            const MeshFacet& face = facets[i];
+            Base::Vector3f normal = myKernel.GetFacet(face).GetNormal();
+            for (int j = 0; j < 3; j++) {
+                FacetIndex neighbour = face._aulNeighbours[j];
+                if (neighbour == FACET_INDEX_MAX || neighbour < i) {
+                    continue;
+                }
+                if (normal * myKernel.GetFacet(neighbour).GetNormal() < cosAngle) {
+                    flags[face._aulPoints[j]] |= KeepPoint;
+                    flags[face._aulPoints[(j + 1) % 3]] |= KeepPoint;
+                }
+            }
+        }
+    }
+
+    // the quadric error is the sum of the squared distances to the planes of the facets
+    double maxError = std::numeric_limits<double>::max();
+    if (params.maxError < std::numeric_limits<float>::max()) {
+        maxError = static_cast<double>(params.maxError) * static_cast<double>(params.maxError);
+    }
+
+    auto targetOf = [&](std::size_t count) {
+        return static_cast<int>(params.targetSize * count / numFacets);
+    };
+
+    std::vector<FacetIndex> order(numFacets);
+    std::iota(order.begin(), order.end(), FacetIndex(0));
+
+    // The number of parts depends on the mesh only, so that the result is the same on all
+    // machines. Points on the borders of the parts are locked and only removed when the
+    // decimated parts are joined.
+    const std::size_t maxParts = 256;
+    std::size_t numParts = 1;
+    while (params.partitionSize > 0 && numParts < maxParts
+           && numFacets / (2 * numParts) >= params.partitionSize) {
+        numParts *= 2;
+    }
+
+    Simplify alg;
+    alg.lock_border = params.keepBorders;
+    alg.max_error = maxError;
+
+    float partsProgress = 0.0F;
+    if (numParts == 1) {
+        addFacets(alg, myKernel, order, 0, numFacets, flags, KeepPoint);
+    }
+    else {
+        std::vector<std::size_t> bounds = splitFacets(myKernel, order, numParts);
+
+        std::vector<int> owner(points.size(), -1);
+        for (std::size_t part = 0; part < numParts; part++) {
+            for (std::size_t i = bounds[part]; i < bounds[part + 1]; i++) {
+                for (PointIndex id : facets[order[i]]._aulPoints) {
+                    if (owner[id] < 0) {
+                        owner[id] = static_cast<int>(part);
+                    }
+                    else if (owner[id] != static_cast<int>(part)) {
+                        flags[id] |= SharedPoint;
+                    }
+                }
+            }
+        }
+        owner.clear();
+        owner.shrink_to_fit();
+
+        std::vector<Simplify> parts(numParts);
+        std::size_t numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+        partsProgress = 0.8F;
+        for (std::size_t first = 0; first < numParts; first += numThreads) {
+            std::size_t count = std::min(numThreads, numParts - first);
+            parallel_chunks(count, 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t part = first + begin; part < first + end; part++) {
+                    Simplify& partAlg = parts[part];
+                    std::size_t partBegin = bounds[part];
+                    std::size_t partEnd = bounds[part + 1];
+                    char mask = KeepPoint | SharedPoint;
+                    addFacets(partAlg, myKernel, order, partBegin, partEnd, flags, mask);
+                    partAlg.lock_border = params.keepBorders;
+                    partAlg.max_error = maxError;
+                    partAlg.simplify_mesh(targetOf(partEnd - partBegin), 0.0);
+                }
+            });
+
+            float done = partsProgress * static_cast<float>(first + count)
+                / static_cast<float>(numParts);
+            if (params.progress && !params.progress(done)) {
+                return false;
+            }
+        }
+
+        // join the parts, a shared point gets the quadrics of all its parts
+        std::unordered_map<int, int> sharedPoints;
+        for (Simplify& part : parts) {
+            std::vector<int> index(part.vertices.size());
+            for (std::size_t i = 0; i < part.vertices.size(); i++) {
+                Simplify::Vertex v = part.vertices[i];
+                v.tstart = 0;
+                v.tcount = 0;
+                v.border = 0;
+                if (v.locked) {
+                    auto it = sharedPoints.try_emplace(v.id, static_cast<int>(alg.vertices.size()));
+                    if (!it.second) {
+                        alg.vertices[it.first->second].q += v.q;
+                        index[i] = it.first->second;
+                        continue;
+                    }
+                    v.locked = (flags[v.id] & KeepPoint) != 0 ? 1 : 0;
+                }
+                index[i] = static_cast<int>(alg.vertices.size());
+                alg.vertices.push_back(v);
+            }
+
+            for (Simplify::Triangle t : part.triangles) {
+                t.deleted = 0;
+                t.dirty = 0;
+                for (int& j : t.v) {
+                    j = index[j];
+                }
+                alg.triangles.push_back(t);
+            }
+
+            part = Simplify();
+        }
+
+        // keep the quadrics of the parts
+        alg.init_quadrics = false;
+    }
+
+    // decimate the whole mesh or the seams of the parts
+    if (params.progress) {
+        alg.progress = [&](double done) {
+            float value = partsProgress + (1.0F - partsProgress) * static_cast<float>(done);
+            return params.progress(std::min(value, 1.0F));
+        };
+    }
+    alg.simplify_mesh(targetOf(numFacets), 0.0);
+    if (alg.canceled) {
+        return false;
+    }
+
+    MeshPointArray new_points;
+    new_points.reserve(alg.vertices.size());
+    for (const auto& vertex : alg.vertices) {
+        new_points.push_back(vertex.p);
+    }
+
+    MeshFacetArray new_facets;
+    new_facets.reserve(alg.triangles.size());
+    for (const auto& triangle : alg.triangles) {
+        MeshFacet face;
+        face._aulPoints[0] = triangle.v[0];
+        face._aulPoints[1] = triangle.v[1];
+        face._aulPoints[2] = triangle.v[2];
+        new_facets.push_back(face);
+    }
+
+    myKernel.Adopt(new_points, new_facets, true);
+    return true;
+}
@@ -25,6 +25,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <limits>
+
 #include <Mod/Mesh/MeshGlobal.h>
 
 namespace MeshCore
@@ -34,9 +38,29 @@ class MeshKernel;
 class MeshExport MeshSimplify
 {
 public:
+    struct Parameters
+    {
+        /// The number of facets to reach, with zero only the maximum error stops the decimation
+        std::size_t targetSize {0};
+        /// The maximum distance of a moved point to the planes of the original facets around it
+        float maxError {std::numeric_limits<float>::max()};
+        /// Keeps the points of open borders
+        bool keepBorders {false};
+        /// Keeps the points of edges whose facet normals enclose a greater angle (in radian),
+        /// zero keeps no creases
+        float creaseAngle {0.0F};
+        /// Meshes with more facets are split into parts of this size that are decimated in
+        /// parallel, the points the parts share are only removed when joining them
+        std::size_t partitionSize {100000};
+        /// Called with the done fraction in [0, 1], returning false cancels the decimation
+        std::function<bool(float)> progress;
+    };
+
     explicit MeshSimplify(MeshKernel&);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /// Returns false if the decimation was canceled, the mesh is unchanged then
+    bool simplify(const Parameters& params);
 
 private:
     MeshKernel& myKernel;
@@ -24,6 +24,8 @@
 
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 
@@ -32,6 +34,7 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Evaluation.h"
 #include "Functional.h"
 #include "Grid.h"
@@ -602,79 +605,9 @@ bool MeshFixSingleFacet::Fixup()
 
 bool MeshEvalSelfIntersection::Evaluate()
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
-                }
-            }
-        }
-    }
-
-    return true;
+    std::vector<std::pair<FacetIndex, FacetIndex>> intersection;
+    SearchIntersections(intersection, true);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -707,77 +640,92 @@ void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection
 ) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
+    SearchIntersections(intersection, false);
+}
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
+void MeshEvalSelfIntersection::SearchIntersections(
+    std::vector<std::pair<FacetIndex, FacetIndex>>& intersection,
+    bool onlyFirst
+) const
+{
+    // Unlike a grid the hierarchy keeps the number of candidates small even if
+    // small and large facets are mixed
+    MeshFacetBVH bvh(_rclMesh);
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
-        }
+    std::size_t countFacets = rFaces.size();
 
-        MeshGeomFacet facet1, facet2;
+    std::mutex mutex;
+    std::atomic<bool> found(false);
+    auto search = [&](std::size_t begin, std::size_t end) {
+        std::vector<std::pair<FacetIndex, FacetIndex>> pairs;
+        std::vector<FacetIndex> candidates;
         Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
+        for (std::size_t index = begin; index < end; index++) {
+            if (onlyFirst && found) {
+                break;
+            }
+
+            auto it = FacetIndex(index);
+            MeshGeomFacet facet1 = _rclMesh.GetFacet(it);
+            const MeshFacet& rface1 = rFaces[it];
+            candidates.clear();
+            bvh.Inside(facet1.GetBoundBox(), candidates);
+            std::sort(candidates.begin(), candidates.end());
+
+            // every pair is only checked by the facet with the lower index
+            for (auto jt = std::upper_bound(candidates.begin(), candidates.end(), it);
+                 jt != candidates.end();
+                 ++jt) {
                 // If the facets share a common vertex we do not check for self-intersections
                 // because they could but usually do not intersect each other and the algorithm
                 // below would detect false-positives, otherwise
                 const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
+                if (rface1.HasPoint(rface2._aulPoints[0]) || rface1.HasPoint(rface2._aulPoints[1])
+                    || rface1.HasPoint(rface2._aulPoints[2])) {
                     continue;  // ignore facets sharing a common vertex
                 }
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
+                MeshGeomFacet facet2 = _rclMesh.GetFacet(*jt);
+                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
+                if (ret == 2) {
+                    pairs.emplace_back(it, *jt);
+                    if (onlyFirst) {
+                        found = true;
+                        break;
                     }
                 }
             }
         }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        intersection.insert(intersection.end(), pairs.begin(), pairs.end());
+    };
+
+    // The blocks are checked one after another so that the progress can be reported
+    // and the user can cancel the search
+    const std::size_t numBlocks = 100;
+    const std::size_t minBlockSize = 4096;
+    std::size_t blockSize = std::max((countFacets + numBlocks - 1) / numBlocks, minBlockSize);
+    std::size_t start = intersection.size();
+    Base::SequencerLauncher seq(
+        "Checking for self-intersections...",
+        (countFacets + blockSize - 1) / blockSize
+    );
+    for (std::size_t begin = 0; begin < countFacets; begin += blockSize) {
+        std::size_t end = std::min(begin + blockSize, countFacets);
+        parallel_chunks(end - begin, 256, [&](std::size_t first, std::size_t last) {
+            search(begin + first, begin + last);
+        });
+
+        if (onlyFirst && found) {
+            break;
+        }
+        // Evaluate() is used by callers that don't expect an AbortException
+        seq.next(!onlyFirst);
     }
+
+    // the chunks finish in any order
+    std::sort(intersection.begin() + static_cast<std::ptrdiff_t>(start), intersection.end());
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
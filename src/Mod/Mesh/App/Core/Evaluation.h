@@ -330,15 +330,26 @@ public:
     explicit MeshEvalSelfIntersection(const MeshKernel& rclB)
         : MeshEvaluation(rclB)
     {}
-    /// Evaluate the mesh and return if true if there are self intersections
+    /// Evaluate the mesh and return false if there are self intersections, cannot be cancelled
     bool Evaluate() override;
     /// collect all intersection lines
     void GetIntersections(
         const std::vector<std::pair<FacetIndex, FacetIndex>>&,
         std::vector<std::pair<Base::Vector3f, Base::Vector3f>>&
     ) const;
-    /// collect the index of all facets with self intersections
+    /** Collect the sorted index pairs of all facets with self intersections, the lower index
+     * comes first.
+     * \throws Base::AbortException if the user cancels the search
+     */
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
+
+private:
+    /**
+     * Searches for pairs of intersecting facets on all available cores. Progress is reported
+     * between blocks of facets. If \a onlyFirst is true the search stops as soon as an
+     * intersection is found, otherwise the user can cancel it.
+     */
+    void SearchIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&, bool onlyFirst) const;
 };
 
 /**
@@ -26,6 +26,8 @@
 
 #include <algorithm>
 #include <future>
+#include <thread>
+#include <vector>
 
 
 namespace MeshCore
@@ -61,4 +63,40 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/** Splits the range [0, count) into at most \a threads chunks but not into
+ * chunks smaller than \a grain, and calls \a func(begin, end) for each chunk
+ * concurrently. An exception thrown by \a func is passed to the caller.
+ */
+template<class Func>
+static void parallel_chunks(std::size_t count, std::size_t grain, std::size_t threads, Func func)
+{
+    threads = std::max<std::size_t>(threads, 1);
+    std::size_t chunks = std::min(threads, (count + grain - 1) / std::max<std::size_t>(grain, 1));
+    if (chunks < 2) {
+        if (count > 0) {
+            func(std::size_t(0), count);
+        }
+        return;
+    }
+
+    std::size_t step = (count + chunks - 1) / chunks;
+    std::vector<std::future<void>> futures;
+    for (std::size_t begin = step; begin < count; begin += step) {
+        std::size_t end = std::min(begin + step, count);
+        futures.push_back(std::async(std::launch::async, func, begin, end));
+    }
+    func(std::size_t(0), step);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+/** Same as above with one chunk per hardware thread.
+ */
+template<class Func>
+static void parallel_chunks(std::size_t count, std::size_t grain, Func func)
+{
+    parallel_chunks(count, grain, std::thread::hardware_concurrency(), func);
+}
+
 }  // namespace MeshCore
@@ -31,6 +31,7 @@
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
+#include "TriangleDistance.h"
 
 
 using namespace MeshCore;
@@ -894,11 +895,8 @@ unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt)
 unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt, float fMaxSearchArea) const
 {
     std::vector<ElementIndex> aulFacets;
-    ElementIndex ulFacetInd = ELEMENT_INDEX_MAX;
     float fMinDist = fMaxSearchArea;
 
-    MeshAlgorithm clFTool(*_pclMesh);
-
     Base::BoundBox3f clBB(
         rclPt.x - fMaxSearchArea,
         rclPt.y - fMaxSearchArea,
@@ -910,16 +908,15 @@ unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt,
 
     Inside(clBB, aulFacets, rclPt, fMaxSearchArea, true);
 
+    const MeshPointArray& rPoints = _pclMesh->GetPoints();
+    const MeshFacetArray& rFacets = _pclMesh->GetFacets();
+    MeshNearestFacetSearch clSearch(rclPt, fMinDist);
     for (ElementIndex facet : aulFacets) {
-        float fDist {};
-
-        if (clFTool.Distance(rclPt, facet, fMinDist, fDist)) {
-            fMinDist = fDist;
-            ulFacetInd = facet;
-        }
+        const PointIndex* pulIdx = rFacets[facet]._aulPoints;
+        clSearch.AddFacet(rPoints[pulIdx[0]], rPoints[pulIdx[1]], rPoints[pulIdx[2]], facet);
     }
 
-    return ulFacetInd;
+    return clSearch.NearestFacet(fMinDist);
 }
 
 void MeshFacetGrid::SearchNearestFacetInHull(
@@ -1029,12 +1026,19 @@ void MeshFacetGrid::SearchNearestFacetInGrid(
 ) const
 {
     const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
+    const MeshPointArray& rPoints = _pclMesh->GetPoints();
+    const MeshFacetArray& rFacets = _pclMesh->GetFacets();
+    MeshNearestFacetSearch clSearch(rclPt, rfMinDist);
     for (ElementIndex pI : rclSet) {
-        float fDist = _pclMesh->GetFacet(pI).DistanceToPoint(rclPt);
-        if (fDist < rfMinDist) {
-            rfMinDist = fDist;
-            rulFacetInd = pI;
-        }
+        const PointIndex* pulIdx = rFacets[pI]._aulPoints;
+        clSearch.AddFacet(rPoints[pulIdx[0]], rPoints[pulIdx[1]], rPoints[pulIdx[2]], pI);
+    }
+
+    float fDist {};
+    FacetIndex ulFacet = clSearch.NearestFacet(fDist);
+    if (ulFacet != FACET_INDEX_MAX) {
+        rfMinDist = fDist;
+        rulFacetInd = ulFacet;
     }
 }
 
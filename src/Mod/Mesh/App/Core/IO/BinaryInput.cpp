@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <istream>
+
+#include <QFile>
+#include <QString>
+
+#include "BinaryInput.h"
+
+
+using namespace MeshCore;
+
+BinaryInput::BinaryInput() = default;
+
+BinaryInput::~BinaryInput() = default;
+
+std::uint64_t BinaryInput::available(std::istream& input)
+{
+    std::streambuf* buf = input.rdbuf();
+    if (!buf || !input) {
+        return 0;
+    }
+
+    std::streamoff curr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    std::streamoff end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+    if (curr < 0 || end < 0) {
+        return 0;
+    }
+
+    buf->pubseekoff(curr, std::ios::beg, std::ios::in);
+    return static_cast<std::uint64_t>(end - curr);
+}
+
+bool BinaryInput::open(std::istream& input, std::uint64_t size, const char* filename)
+{
+    std::streambuf* buf = input.rdbuf();
+    if (!buf || available(input) < size) {
+        return false;
+    }
+
+    std::streamoff offset = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    if (filename && map(filename, static_cast<std::uint64_t>(offset), size)) {
+        buf->pubseekoff(offset + static_cast<std::streamoff>(size), std::ios::beg, std::ios::in);
+        return true;
+    }
+
+    buffer.resize(size);
+    if (!input.read(buffer.data(), static_cast<std::streamsize>(size))) {
+        buffer.clear();
+        return false;
+    }
+
+    ptr = buffer.data();
+    len = size;
+    return true;
+}
+
+bool BinaryInput::map(const char* filename, std::uint64_t offset, std::uint64_t size)
+{
+    if (size == 0) {
+        return false;
+    }
+
+    file = std::make_unique<QFile>(QString::fromUtf8(filename));
+    if (!file->open(QIODevice::ReadOnly)) {
+        file.reset();
+        return false;
+    }
+
+    // the stream may read from another file than the one given
+    if (static_cast<std::uint64_t>(file->size()) < offset + size) {
+        file.reset();
+        return false;
+    }
+
+    uchar* mem = file->map(static_cast<qint64>(offset), static_cast<qint64>(size));
+    if (!mem) {
+        file.reset();
+        return false;
+    }
+
+    ptr = reinterpret_cast<const char*>(mem);  // NOLINT
+    len = size;
+    return true;
+}
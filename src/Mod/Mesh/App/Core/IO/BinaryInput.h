@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include <Base/Swap.h>
+#include <Mod/Mesh/MeshGlobal.h>
+
+class QFile;
+
+namespace MeshCore
+{
+
+/** Contiguous, read-only view of the body of a binary mesh file.
+ *
+ * If the name of the file the stream reads from is known the body is
+ * memory-mapped, otherwise it is read from the stream with a single call.
+ * Either way the records can then be decoded in parallel.
+ */
+class MeshExport BinaryInput
+{
+public:
+    BinaryInput();
+    ~BinaryInput();
+
+    BinaryInput(const BinaryInput&) = delete;
+    BinaryInput(BinaryInput&&) = delete;
+    BinaryInput& operator=(const BinaryInput&) = delete;
+    BinaryInput& operator=(BinaryInput&&) = delete;
+
+    /** Provides \a size bytes from the current position of \a input.
+     * \param filename the file \a input reads from or null if unknown
+     * \return false if there are less than \a size bytes left. On success the
+     * stream is positioned behind the bytes.
+     */
+    bool open(std::istream& input, std::uint64_t size, const char* filename = nullptr);
+    /// Returns the number of bytes from the current position to the end of \a input
+    static std::uint64_t available(std::istream& input);
+
+    const char* data() const
+    {
+        return ptr;
+    }
+    std::uint64_t size() const
+    {
+        return len;
+    }
+
+    /// Returns the value at \a pos, \a swap reverses its byte order
+    template<typename T>
+    static T value(const char* pos, bool swap)
+    {
+        T val;
+        std::memcpy(&val, pos, sizeof(T));
+        if (swap) {
+            Base::SwapEndian<T>(val);
+        }
+        return val;
+    }
+
+private:
+    bool map(const char* filename, std::uint64_t offset, std::uint64_t size);
+
+    std::unique_ptr<QFile> file;
+    std::vector<char> buffer;
+    const char* ptr {nullptr};
+    std::uint64_t len {0};
+};
+
+}  // namespace MeshCore
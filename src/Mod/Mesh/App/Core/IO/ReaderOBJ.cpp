@@ -22,12 +22,15 @@
  *                                                                         *
  ***************************************************************************/
 
-#include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
+#include <array>
 #include <istream>
 #include <map>
+#include <thread>
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Color.h>
@@ -36,6 +39,7 @@
 #include <Base/Tools.h>
 
 #include "ReaderOBJ.h"
+#include "TextInput.h"
 
 
 using namespace MeshCore;
@@ -43,49 +47,203 @@ using namespace MeshCore;
 namespace
 {
 
-class ReaderOBJImp
+// Smaller ranges are not worth a thread of their own
+constexpr std::size_t MinRangeSize = 1 << 20;
+constexpr std::size_t MaxTokens = 13;
+
+// A face of a range of lines. If the bit of a point index is set in 'relative' the index is
+// counted from the number of points read before the range.
+struct FaceOBJ
+{
+    std::array<int64_t, 3> points;
+    uint8_t relative;
+};
+
+// A change of the group, material library or material before the facet 'facet' of a range
+struct EventOBJ
+{
+    enum class Type
+    {
+        Group,
+        Library,
+        UseMaterial
+    };
+
+    Type type;
+    std::size_t facet;
+    std::string name;
+};
+
+// Parses a range of lines independent of the lines before
+class ReaderOBJChunk
 {
 public:
-    using string_list = std::vector<std::string>;
+    using token_list = std::array<std::string_view, MaxTokens>;
 
-    explicit ReaderOBJImp(Material* material)
-        : _material {material}
-    {}
+    void Load(std::string_view text)
+    {
+        TextInput::forEachLine(text, [this](std::string_view line) { LoadLine(line); });
+    }
 
-    void Load(const std::string& line)
+private:
+    void LoadLine(std::string_view line)
     {
-        if (Ignore(line)) {
+        token_list tokens;
+        std::size_t num = TextInput::tokenize(line, " /\t", tokens);
+        if (num < 2 || num > MaxTokens) {
             return;
         }
 
-        boost::char_separator<char> sep(" /\t");
-        boost::tokenizer<boost::char_separator<char>> tokens(line, sep);
-        token_results.assign(tokens.begin(), tokens.end());
-        if (token_results.size() < 2) {
-            return;
+        // NOLINTBEGIN
+        if (tokens[0] == "v" && (num == 4 || num == 7)) {
+            LoadVertex(tokens, num);
+        }
+        else if (tokens[0] == "f" && (num == 4 || num == 7 || num == 10)) {
+            LoadFace(tokens, 3, (num - 1) / 3);
+        }
+        else if (tokens[0] == "f" && (num == 5 || num == 9 || num == 13)) {
+            LoadFace(tokens, 4, (num - 1) / 4);
+        }
+        else if (num == 2) {
+            LoadName(tokens);
+        }
+        // NOLINTEND
+    }
+
+    void LoadVertex(const token_list& tokens, std::size_t num)
+    {
+        // a missing point would shift the indices of all following faces
+        std::array<float, 6> values {};  // NOLINT
+        for (std::size_t i = 1; i < num; i++) {
+            if (!TextInput::number(tokens[i], values[i - 1])) {
+                valid = false;
+                return;
+            }
+        }
+
+        points.emplace_back(Base::Vector3f(values[0], values[1], values[2]));
+        if (num == 7) {  // NOLINT
+            // NOLINTBEGIN
+            float r = values[3];
+            float g = values[4];
+            float b = values[5];
+            if (r > 1.0F || g > 1.0F || b > 1.0F) {
+                r /= 255.0F;
+                g /= 255.0F;
+                b /= 255.0F;
+            }
+            // NOLINTEND
+
+            Base::Color c(r, g, b);
+            unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
+            points.back().SetProperty(prop);
+            vertexColors = true;
+        }
+    }
+
+    void LoadFace(const token_list& tokens, std::size_t corners, std::size_t stride)
+    {
+        std::array<int64_t, 4> index {};
+        uint8_t relative = 0;
+        for (std::size_t i = 0; i < corners; i++) {
+            int value {};
+            if (!TextInput::number(tokens[1 + i * stride], value)) {
+                return;
+            }
+            if (value > 0) {
+                index[i] = value - 1;
+            }
+            else {
+                index[i] = value + static_cast<int64_t>(points.size());
+                relative |= static_cast<uint8_t>(1U << i);
+            }
         }
 
-        if (MatchVertex(token_results)) {
-            LoadVertex(token_results);
+        auto corner = [&](std::size_t i) {
+            return std::make_pair(index[i], (relative >> i) & 1U);
+        };
+        AddFace(corner(0), corner(1), corner(2));
+        if (corners == 4) {
+            AddFace(corner(2), corner(3), corner(0));
         }
-        else if (MatchVertexWithColor(token_results)) {
-            LoadVertexWithColor(token_results);
+    }
+
+    void AddFace(
+        std::pair<int64_t, unsigned> p0,
+        std::pair<int64_t, unsigned> p1,
+        std::pair<int64_t, unsigned> p2
+    )
+    {
+        FaceOBJ face {};
+        face.points = {p0.first, p1.first, p2.first};
+        face.relative = static_cast<uint8_t>(p0.second | (p1.second << 1) | (p2.second << 2));
+        faces.push_back(face);
+    }
+
+    void LoadName(const token_list& tokens)
+    {
+        EventOBJ event {EventOBJ::Type::Group, faces.size(), {}};
+        if (tokens[0] == "g") {
+            event.type = EventOBJ::Type::Group;
         }
-        else if (MatchGroup(token_results)) {
-            LoadGroup(token_results);
+        else if (tokens[0] == "mtllib") {
+            event.type = EventOBJ::Type::Library;
         }
-        else if (MatchLibrary(token_results)) {
-            LoadLibrary(token_results);
+        else if (tokens[0] == "usemtl") {
+            event.type = EventOBJ::Type::UseMaterial;
         }
-        else if (MatchUseMaterial(token_results)) {
-            LoadUseMaterial(token_results);
+        else {
+            return;
         }
-        else if (MatchFace(token_results)) {
-            LoadFace(token_results);
+
+        event.name = Base::Tools::escapedUnicodeToUtf8(std::string(tokens[1]));
+        events.push_back(std::move(event));
+    }
+
+public:
+    // NOLINTBEGIN
+    MeshPointArray points;
+    std::vector<FaceOBJ> faces;
+    std::vector<EventOBJ> events;
+    bool vertexColors = false;
+    /// false if a vertex line has a coordinate that is not a number
+    bool valid = true;
+    // NOLINTEND
+};
+
+// Merges the ranges in the order of the file and keeps track of groups and materials
+class ReaderOBJImp
+{
+public:
+    explicit ReaderOBJImp(Material* material)
+        : _material {material}
+    {}
+
+    void Append(const ReaderOBJChunk& chunk)
+    {
+        auto offset = static_cast<int64_t>(meshPoints.size());
+        meshPoints.insert(meshPoints.end(), chunk.points.begin(), chunk.points.end());
+        if (chunk.vertexColors) {
+            rgb_value = MeshIO::PER_VERTEX;
         }
-        else if (MatchQuad(token_results)) {
-            LoadQuad(token_results);
+
+        std::size_t facet = 0;
+        for (const auto& event : chunk.events) {
+            AddFaces(chunk, offset, facet, event.facet);
+            facet = event.facet;
+            switch (event.type) {
+                case EventOBJ::Type::Group:
+                    LoadGroup(event.name);
+                    break;
+                case EventOBJ::Type::Library:
+                    LoadLibrary(event.name);
+                    break;
+                case EventOBJ::Type::UseMaterial:
+                    LoadUseMaterial(event.name);
+                    break;
+            }
         }
+        AddFaces(chunk, offset, facet, chunk.faces.size());
     }
 
     void SetupMaterial()
@@ -121,177 +279,28 @@ public:
     }
 
 private:
-    bool Ignore(const std::string& line) const
-    {
-        // clang-format off
-        return boost::starts_with(line, "vn ") ||
-               boost::starts_with(line, "vt ") ||
-               boost::starts_with(line, "s ") ||
-               boost::starts_with(line, "o ") ||
-               boost::starts_with(line, "#");
-        // clang-format on
-    }
-
-    bool MatchVertex(const string_list& tokens) const
-    {
-        return tokens[0] == "v" && tokens.size() == 4;
-    }
-
-    void LoadVertex(const string_list& tokens)
-    {
-        float x = std::stof(tokens[1]);
-        float y = std::stof(tokens[2]);
-        float z = std::stof(tokens[3]);
-        meshPoints.push_back(MeshPoint(Base::Vector3f(x, y, z)));
-    }
-
-    bool MatchVertexWithColor(const string_list& tokens) const
-    {
-        return tokens[0] == "v" && tokens.size() == 7;  // NOLINT
-    }
-
-    void LoadVertexWithColor(const string_list& tokens)
-    {
-        LoadVertex(tokens);
-
-        // NOLINTBEGIN
-        float r = std::stof(tokens[4]);
-        float g = std::stof(tokens[5]);
-        float b = std::stof(tokens[6]);
-        if (r > 1.0F || g > 1.0F || b > 1.0F) {
-            r /= 255.0F;
-            g /= 255.0F;
-            b /= 255.0F;
-        }
-        // NOLINTEND
-
-        SetVertexColor(Base::Color(r, g, b));
-    }
-
-    void SetVertexColor(const Base::Color& c)
-    {
-        unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-        meshPoints.back().SetProperty(prop);
-        rgb_value = MeshIO::PER_VERTEX;
-    }
-
-    bool MatchGroup(const string_list& tokens) const
-    {
-        return tokens[0] == "g" && tokens.size() == 2;
-    }
-
-    void LoadGroup(const string_list& tokens)
+    void LoadGroup(const std::string& name)
     {
         new_segment = true;
-        groupName = Base::Tools::escapedUnicodeToUtf8(tokens[1]);
-    }
-
-    bool MatchLibrary(const string_list& tokens) const
-    {
-        return tokens[0] == "mtllib" && tokens.size() == 2;
+        groupName = name;
     }
 
-    void LoadLibrary(const string_list& tokens)
+    void LoadLibrary(const std::string& name)
     {
         if (_material) {
-            _material->library = Base::Tools::escapedUnicodeToUtf8(tokens[1]);
+            _material->library = name;
         }
     }
 
-    bool MatchUseMaterial(const string_list& tokens) const
-    {
-        return tokens[0] == "usemtl" && tokens.size() == 2;
-    }
-
-    void LoadUseMaterial(const string_list& tokens)
+    void LoadUseMaterial(const std::string& name)
     {
         if (!materialName.empty()) {
             _materialNames.emplace_back(materialName, countMaterialFacets);
         }
-        materialName = Base::Tools::escapedUnicodeToUtf8(tokens[1]);
+        materialName = name;
         countMaterialFacets = 0;
     }
 
-    bool MatchFace(const string_list& tokens) const
-    {
-        // NOLINTBEGIN
-        const auto num = tokens.size();
-        return tokens[0] == "f" && (num == 4 || num == 7 || num == 10);
-        // NOLINTEND
-    }
-
-    void LoadFace(const string_list& tokens)
-    {
-        StartNewSegment();
-
-        // NOLINTBEGIN
-        int index1 = 1;
-        int index2 = 2;
-        int index3 = 3;
-        if (tokens.size() == 7) {
-            index2 = 3;
-            index3 = 5;
-        }
-        else if (tokens.size() == 10) {
-            index2 = 4;
-            index3 = 7;
-        }
-        // NOLINTEND
-
-        // 3-vertex face
-        int i1 = std::stoi(tokens[index1]);
-        i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-        int i2 = std::stoi(tokens[index2]);
-        i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-        int i3 = std::stoi(tokens[index3]);
-        i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-
-        AddFace(i1, i2, i3);
-    }
-
-    bool MatchQuad(const string_list& tokens) const
-    {
-        // NOLINTBEGIN
-        const auto num = tokens.size();
-        return tokens[0] == "f" && (num == 5 || num == 9 || num == 13);
-        // NOLINTEND
-    }
-
-    void LoadQuad(const string_list& tokens)
-    {
-        StartNewSegment();
-
-        // NOLINTBEGIN
-        int index1 = 1;
-        int index2 = 2;
-        int index3 = 3;
-        int index4 = 4;
-        if (tokens.size() == 9) {
-            index2 = 3;
-            index3 = 5;
-            index4 = 7;
-        }
-        else if (tokens.size() == 13) {
-            index2 = 4;
-            index3 = 7;
-            index4 = 10;
-        }
-        // NOLINTEND
-
-        // 4-vertex face
-        int i1 = std::stoi(tokens[index1]);
-        i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-        int i2 = std::stoi(tokens[index2]);
-        i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-        int i3 = std::stoi(tokens[index3]);
-        i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-        int i4 = std::stoi(tokens[index4]);
-        i4 = i4 > 0 ? i4 - 1 : i4 + static_cast<int>(meshPoints.size());
-
-        AddFace(i1, i2, i3);
-        AddFace(i3, i4, i1);
-    }
-
     void StartNewSegment()
     {
         // starts a new segment
@@ -305,13 +314,34 @@ private:
         }
     }
 
-    void AddFace(int i, int j, int k)
+    // Adds the faces [begin, end) of the chunk whose points are appended at 'offset'
+    void AddFaces(const ReaderOBJChunk& chunk, int64_t offset, std::size_t begin, std::size_t end)
     {
-        MeshFacet item;
-        item.SetVertices(i, j, k);
-        item.SetProperty(segment);
-        meshFacets.push_back(item);
-        countMaterialFacets++;
+        if (begin == end) {
+            return;
+        }
+
+        StartNewSegment();
+        for (std::size_t i = begin; i < end; i++) {
+            const FaceOBJ& face = chunk.faces[i];
+            std::array<PointIndex, 3> index {};
+            for (std::size_t j = 0; j < 3; j++) {
+                int64_t value = face.points[j];
+                if ((face.relative >> j) & 1U) {
+                    value += offset;
+                }
+                // an index out of range is removed with its facet later
+                index[j] = value < 0 ? POINT_INDEX_MAX : static_cast<PointIndex>(value);
+            }
+
+            MeshFacet item;
+            item._aulPoints[0] = index[0];
+            item._aulPoints[1] = index[1];
+            item._aulPoints[2] = index[2];
+            item.SetProperty(segment);
+            meshFacets.push_back(item);
+        }
+        countMaterialFacets += end - begin;
     }
 
 public:
@@ -326,8 +356,12 @@ public:
         return _materialNames;
     }
 
+    const std::vector<std::string>& GetGroupNames() const
+    {
+        return _groupNames;
+    }
+
 private:
-    string_list token_results;
     MeshIO::Binding rgb_value = MeshIO::OVERALL;
     unsigned long countMaterialFacets = 0;
     unsigned long segment = 0;
@@ -365,14 +399,28 @@ bool ReaderOBJ::Load(std::istream& str)
         return false;
     }
 
+    // The lines of a block are parsed in parallel ranges that are merged in the order of the file
     ReaderOBJImp reader(_material);
-    std::string line;
-    while (std::getline(str, line)) {
-        boost::trim(line);
-        reader.Load(line);
+    TextInput input(str);
+    std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    while (input.next()) {
+        std::vector<std::string_view> ranges = input.split(threads, MinRangeSize);
+        std::vector<ReaderOBJChunk> chunks(ranges.size());
+        MeshCore::parallel_chunks(ranges.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                chunks[i].Load(ranges[i]);
+            }
+        });
+        for (const auto& chunk : chunks) {
+            if (!chunk.valid) {
+                return false;
+            }
+            reader.Append(chunk);
+        }
     }
     reader.SetupMaterial();
     _materialNames = reader.GetMaterialNames();
+    _groupNames = reader.GetGroupNames();
 
     _kernel.Clear();  // remove all data before
 
@@ -21,15 +21,18 @@
  *                                                                         *
  **************************************************************************/
 
+#include <atomic>
 #include <boost/lexical_cast.hpp>
 #include <istream>
 
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Stream.h>
 #include <Base/Tools.h>
 
+#include "BinaryInput.h"
 #include "ReaderPLY.h"
 
 
@@ -366,6 +369,11 @@ bool ReaderPLY::VerifyColorProperty()
 }
 
 bool ReaderPLY::Load(std::istream& input)
+{
+    return Load(input, nullptr);
+}
+
+bool ReaderPLY::Load(std::istream& input, const char* filename)
 {
     if (!CheckHeader(input)) {
         return false;
@@ -385,7 +393,7 @@ bool ReaderPLY::Load(std::istream& input)
 
     // clang-format off
     return format == ascii ? LoadAscii(input)
-                           : LoadBinary(input);
+                           : LoadBinary(input, filename);
     // clang-format on
 }
 
@@ -639,8 +647,152 @@ bool ReaderPLY::ReadFaces(Base::InputStream& is)
     return true;
 }
 
-bool ReaderPLY::LoadBinary(std::istream& input)
+std::size_t ReaderPLY::sizeOf(Number number)
+{
+    switch (number) {
+        case int8:
+        case uint8:
+            return 1;
+        case int16:
+        case uint16:
+            return 2;
+        case int32:
+        case uint32:
+        case float32:
+            return 4;
+        case float64:
+            return 8;
+    }
+
+    return 0;
+}
+
+float ReaderPLY::valueOf(const char* data, Number number, bool swap)
+{
+    switch (number) {
+        case int8:
+            return static_cast<float>(BinaryInput::value<int8_t>(data, swap));
+        case uint8:
+            return static_cast<float>(BinaryInput::value<uint8_t>(data, swap));
+        case int16:
+            return static_cast<float>(BinaryInput::value<int16_t>(data, swap));
+        case uint16:
+            return static_cast<float>(BinaryInput::value<uint16_t>(data, swap));
+        case int32:
+            return static_cast<float>(BinaryInput::value<int32_t>(data, swap));
+        case uint32:
+            return static_cast<float>(BinaryInput::value<uint32_t>(data, swap));
+        case float32:
+            return BinaryInput::value<float>(data, swap);
+        case float64:
+            return static_cast<float>(BinaryInput::value<double>(data, swap));
+    }
+
+    return 0.0F;
+}
+
+bool ReaderPLY::ReadBinaryBody(std::istream& input, const char* filename)
+{
+    // Only faces with three indices and without list properties have a fixed record size
+    std::size_t faceSize = sizeof(unsigned char) + 3 * sizeof(uint32_t);
+    for (auto it : face_props) {
+        if (it == float32 || it == float64) {
+            return false;
+        }
+        faceSize += sizeOf(it);
+    }
+
+    std::size_t vertexSize = 0;
+    for (const auto& it : vertex_props) {
+        vertexSize += sizeOf(it.second);
+    }
+
+    std::uint64_t available = BinaryInput::available(input);
+    if (v_count > available / vertexSize
+        || f_count > (available - v_count * vertexSize) / faceSize) {
+        return false;
+    }
+
+    std::streamoff start = input.tellg();
+    if (start < 0) {
+        return false;
+    }
+
+    BinaryInput body;
+    if (!body.open(input, v_count * vertexSize + f_count * faceSize, filename)) {
+        input.clear();
+        input.seekg(start);
+        return false;
+    }
+
+    bool swap = (format == binary_big_endian);
+    bool colors = _material && _material->binding == MeshIO::PER_VERTEX;
+    meshPoints.resize(v_count);
+    if (colors) {
+        _material->diffuseColor.resize(v_count);
+    }
+
+    const char* vertexData = body.data();
+    parallel_chunks(v_count, 0x4000, [&, vertexData](std::size_t begin, std::size_t end) {
+        PropertyArray prop_values {};
+        for (std::size_t i = begin; i < end; i++) {
+            const char* data = vertexData + i * vertexSize;
+            for (const auto& it : vertex_props) {
+                prop_values[it.first] = valueOf(data, it.second, swap);
+                data += sizeOf(it.second);
+            }
+
+            meshPoints[i].Set(prop_values[coord_x], prop_values[coord_y], prop_values[coord_z]);
+            if (colors) {
+                // NOLINTBEGIN
+                float r = (prop_values[color_r]) / 255.0F;
+                float g = (prop_values[color_g]) / 255.0F;
+                float b = (prop_values[color_b]) / 255.0F;
+                // NOLINTEND
+                _material->diffuseColor[i].set(r, g, b);
+            }
+        }
+    });
+
+    // Facets with an index out of range are removed by CleanupMesh()
+    std::atomic<bool> triangles {true};
+    meshFacets.resize(f_count);
+    const char* faceData = vertexData + v_count * vertexSize;
+    parallel_chunks(f_count, 0x4000, [&, faceData](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const char* data = faceData + i * faceSize;
+            if (static_cast<unsigned char>(data[0]) != 3) {
+                triangles = false;
+                return;
+            }
+            MeshFacet& facet = meshFacets[i];
+            facet._aulPoints[0] = BinaryInput::value<uint32_t>(data + 1, swap);
+            facet._aulPoints[1] = BinaryInput::value<uint32_t>(data + 5, swap);
+            facet._aulPoints[2] = BinaryInput::value<uint32_t>(data + 9, swap);
+        }
+    });
+
+    if (!triangles) {
+        meshPoints.clear();
+        meshFacets.clear();
+        if (colors) {
+            _material->diffuseColor.clear();
+        }
+        input.clear();
+        input.seekg(start);
+        return false;
+    }
+
+    return true;
+}
+
+bool ReaderPLY::LoadBinary(std::istream& input, const char* filename)
 {
+    if (ReadBinaryBody(input, filename)) {
+        CleanupMesh();
+        return true;
+    }
+
     Base::InputStream is(input);
     if (format == binary_little_endian) {
         is.setByteOrder(Base::Stream::LittleEndian);
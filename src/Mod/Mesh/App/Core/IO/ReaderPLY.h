@@ -52,6 +52,12 @@ public:
      * \return true on success and false otherwise
      */
     bool Load(std::istream& input);
+    /*!
+     * \brief Load the mesh from the input stream that reads from \a filename.
+     * A binary body is memory-mapped from the file and decoded in parallel.
+     * \return true on success and false otherwise
+     */
+    bool Load(std::istream& input, const char* filename);
 
 private:
     bool CheckHeader(std::istream& input) const;
@@ -68,7 +74,8 @@ private:
     bool ReadVertexes(Base::InputStream& is);
     bool ReadFaces(Base::InputStream& is);
     bool LoadAscii(std::istream& input);
-    bool LoadBinary(std::istream& input);
+    bool LoadBinary(std::istream& input, const char* filename);
+    bool ReadBinaryBody(std::istream& input, const char* filename);
     void CleanupMesh();
 
 private:
@@ -100,6 +107,9 @@ private:
         float64
     };
 
+    static std::size_t sizeOf(Number number);
+    static float valueOf(const char* data, Number number, bool swap);
+
     struct PropertyComp
     {
         using argument_type_1st = std::pair<Property, int>;
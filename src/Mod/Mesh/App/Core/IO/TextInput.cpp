@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <istream>
+#include <string>
+#include <version>
+
+#include "TextInput.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// std::from_chars() doesn't accept a leading plus sign
+std::string_view withoutPlus(std::string_view token)
+{
+    if (token.size() > 1 && token.front() == '+') {
+        token.remove_prefix(1);
+    }
+    return token;
+}
+
+}  // namespace
+
+TextInput::TextInput(std::istream& input, std::size_t blockSize)
+    : input(input)
+    , blockSize(std::max<std::size_t>(blockSize, 1))
+{}
+
+bool TextInput::next()
+{
+    // keep the incomplete line at the end of the previous block
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(blockEnd));
+    blockEnd = 0;
+
+    // a line may be longer than a block
+    std::size_t searchFrom = 0;
+    while (input) {
+        std::size_t size = buffer.size();
+        buffer.resize(size + blockSize);
+        input.read(buffer.data() + size, static_cast<std::streamsize>(blockSize));
+        buffer.resize(size + static_cast<std::size_t>(input.gcount()));
+
+        auto it = std::find(buffer.rbegin(), buffer.rend() - searchFrom, '\n');
+        if (it != buffer.rend() - searchFrom) {
+            blockEnd = static_cast<std::size_t>(buffer.rend() - it);
+            return true;
+        }
+        searchFrom = buffer.size();
+    }
+
+    // the last line of the file
+    blockEnd = buffer.size();
+    return blockEnd > 0;
+}
+
+std::vector<std::string_view> TextInput::split(std::size_t count, std::size_t minSize) const
+{
+    std::string_view text = block();
+    std::vector<std::string_view> ranges;
+    std::size_t step = std::max(text.size() / std::max<std::size_t>(count, 1) + 1, minSize);
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = text.find('\n', std::min(begin + step, text.size()) - 1);
+        end = end == std::string_view::npos ? text.size() : end + 1;
+        ranges.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return ranges;
+}
+
+bool TextInput::number(std::string_view token, float& value)
+{
+    token = withoutPlus(token);
+    const char* end = token.data() + token.size();
+#if defined(__cpp_lib_to_chars)
+    auto [ptr, ec] = std::from_chars(token.data(), end, value);
+    if (ec == std::errc::result_out_of_range && ptr == end) {
+        // like strtof() underflow gives zero and overflow gives infinity
+        value = std::strtof(std::string(token).c_str(), nullptr);
+        return true;
+    }
+    return ec == std::errc() && ptr == end;
+#else
+    // some standard libraries can't parse floating point numbers with std::from_chars()
+    std::string str(token);
+    char* ptr = nullptr;
+    value = std::strtof(str.c_str(), &ptr);
+    return !str.empty() && ptr == str.c_str() + str.size();
+#endif
+}
+
+bool TextInput::number(std::string_view token, int& value)
+{
+    token = withoutPlus(token);
+    const char* end = token.data() + token.size();
+    auto [ptr, ec] = std::from_chars(token.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
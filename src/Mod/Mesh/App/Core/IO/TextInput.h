@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+
+namespace MeshCore
+{
+
+/** Reads a text file in large blocks that end at a line break.
+ *
+ * Each block is split into ranges of whole lines that can be parsed in
+ * parallel, and only one block of the file is kept in memory at a time.
+ */
+class MeshExport TextInput
+{
+public:
+    static constexpr std::size_t DefaultBlockSize = std::size_t(1) << 26;
+
+    explicit TextInput(std::istream& input, std::size_t blockSize = DefaultBlockSize);
+
+    /// Reads the next block and returns false if the end of the stream is reached
+    bool next();
+    /// Returns the current block
+    std::string_view block() const
+    {
+        return {buffer.data(), blockEnd};
+    }
+    /// Splits the current block at line breaks into at most \a count ranges of at least
+    /// \a minSize bytes
+    std::vector<std::string_view> split(std::size_t count, std::size_t minSize) const;
+
+    /// Calls \a func for each line of \a text without the line break
+    template<typename Func>
+    static void forEachLine(std::string_view text, Func&& func)
+    {
+        while (!text.empty()) {
+            std::size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            func(line);
+            if (end == std::string_view::npos) {
+                break;
+            }
+            text.remove_prefix(end + 1);
+        }
+    }
+
+    /** Splits \a line at any of the characters of \a separators and ignores empty tokens.
+     * \return the number of tokens of which only the first N are stored in \a tokens
+     */
+    template<std::size_t N>
+    static std::size_t tokenize(
+        std::string_view line,
+        std::string_view separators,
+        std::array<std::string_view, N>& tokens
+    )
+    {
+        std::size_t count = 0;
+        std::size_t pos = line.find_first_not_of(separators);
+        while (pos != std::string_view::npos) {
+            std::size_t end = line.find_first_of(separators, pos);
+            if (count < N) {
+                tokens[count] = line.substr(pos, end - pos);
+            }
+            count++;
+            pos = line.find_first_not_of(separators, end);
+        }
+        return count;
+    }
+
+    /** Parses \a token as a number, returns false if it is not a number as a whole.
+     * A float that is out of range is rounded like strtof() does it.
+     */
+    static bool number(std::string_view token, float& value);
+    static bool number(std::string_view token, int& value);
+
+private:
+    std::istream& input;
+    std::size_t blockSize;
+    std::vector<char> buffer;
+    std::size_t blockEnd {0};
+};
+
+}  // namespace MeshCore
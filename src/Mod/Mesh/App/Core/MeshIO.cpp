@@ -25,9 +25,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
+#include <thread>
 
 
 #include <boost/algorithm/string.hpp>
@@ -36,9 +38,11 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 
+#include "IO/BinaryInput.h"
 #include "IO/Reader3MF.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/ReaderPLY.h"
+#include "IO/TextInput.h"
 #include "IO/Writer3MF.h"
 #include "IO/WriterInventor.h"
 #include "IO/WriterOBJ.h"
@@ -47,6 +51,7 @@
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Base/Placement.h>
+#include <Base/Profiler.h>
 #include <Base/Reader.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
@@ -58,6 +63,7 @@
 #include "Builder.h"
 #include "Definitions.h"
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -65,6 +71,38 @@
 
 using namespace MeshCore;
 
+namespace
+{
+
+// Smaller ranges are not worth a thread of their own
+constexpr std::size_t MinRangeSize = 1 << 20;
+
+// Appends the coordinates of the 'vertex' lines of an ASCII STL file to 'coords'. Returns false
+// if a coordinate is not a number, because a missing vertex would mix up the following facets.
+bool ReadAsciiSTLVertices(std::string_view text, std::vector<float>& coords)
+{
+    bool valid = true;
+    TextInput::forEachLine(text, [&coords, &valid](std::string_view line) {
+        std::array<std::string_view, 4> tokens;
+        if (!valid || TextInput::tokenize(line, " \t", tokens) != tokens.size()
+            || !boost::iequals(tokens[0], "vertex")) {
+            return;
+        }
+
+        std::array<float, 3> point {};
+        for (std::size_t i = 0; i < point.size(); i++) {
+            if (!TextInput::number(tokens[i + 1], point[i])) {
+                valid = false;
+                return;
+            }
+        }
+        coords.insert(coords.end(), point.begin(), point.end());
+    });
+    return valid;
+}
+
+}  // namespace
+
 namespace MeshCore
 {
 
@@ -222,6 +260,9 @@ MeshIO::Format MeshInput::getFormat(const char* FileName)
 
 bool MeshInput::LoadAny(const char* FileName)
 {
+    ZoneScoped;
+    ZoneText(FileName, std::strlen(FileName));
+
     // ask for read permission
     Base::FileInfo fi(FileName);
     if (!fi.exists() || !fi.isFile()) {
@@ -241,7 +282,7 @@ bool MeshInput::LoadAny(const char* FileName)
     // read file
     bool ok = false;
     if (fi.hasExtension({"stl", "ast"})) {
-        ok = LoadSTL(str);
+        ok = LoadSTL(str, FileName);
     }
     else if (fi.hasExtension("iv")) {
         ok = LoadInventor(str);
@@ -271,12 +312,13 @@ bool MeshInput::LoadAny(const char* FileName)
         ok = LoadOFF(str);
     }
     else if (fi.hasExtension("ply")) {
-        ok = LoadPLY(str);
+        ok = LoadPLY(str, FileName);
     }
     else {
         throw Base::FileException("File extension not supported", FileName);
     }
 
+    TracyPlot("Loaded mesh facets", static_cast<int64_t>(_rclMesh.CountFacets()));
     return ok;
 }
 
@@ -316,6 +358,11 @@ bool MeshInput::LoadFormat(std::istream& input, MeshIO::Format fmt)
  * Therefore the file header gets checked to decide if the file is binary or not.
  */
 bool MeshInput::LoadSTL(std::istream& input)
+{
+    return LoadSTL(input, nullptr);
+}
+
+bool MeshInput::LoadSTL(std::istream& input, const char* filename)
 {
     char szBuf[200];
 
@@ -352,7 +399,7 @@ bool MeshInput::LoadSTL(std::istream& input)
             && !strstr(szBuf, "VERTEX") && !strstr(szBuf, "ENDFACET") && !strstr(szBuf, "ENDLOOP")) {
             // probably binary STL
             buf->pubseekoff(0, std::ios::beg, std::ios::in);
-            return LoadBinarySTL(input);
+            return LoadBinarySTL(input, filename);
         }
 
         // Ascii STL
@@ -667,6 +714,12 @@ bool MeshInput::LoadPLY(std::istream& input)
     return reader.Load(input);
 }
 
+bool MeshInput::LoadPLY(std::istream& input, const char* filename)
+{
+    ReaderPLY reader(this->_rclMesh, this->_material);
+    return reader.Load(input, filename);
+}
+
 bool MeshInput::LoadMeshNode(std::istream& input)
 {
     boost::regex rx_p(
@@ -728,77 +781,39 @@ bool MeshInput::LoadMeshNode(std::istream& input)
 /** Loads an ASCII STL file. */
 bool MeshInput::LoadAsciiSTL(std::istream& input)
 {
-    boost::regex rx_p(
-        "^\\s*VERTEX\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$"
-    );
-    boost::regex rx_f(
-        "^\\s*FACET\\s+NORMAL\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$"
-    );
-    boost::cmatch what;
-
-    std::string line;
-    float fX {}, fY {}, fZ {};
-    unsigned long ulVertexCt {}, ulFacetCt {};
-    MeshGeomFacet clFacet;
-
     if (!input || input.bad()) {
         return false;
     }
 
-    std::streamoff ulSize = 0;
-    std::streambuf* buf = input.rdbuf();
-    ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
-    ulSize -= 20;
-
-    // count facets
-    while (std::getline(input, line)) {
-        boost::algorithm::to_upper(line);
-        if (line.find("ENDFACET") != std::string::npos) {
-            ulFacetCt++;
-        }
-        // prevent from reading EOF (as I don't know how to reread the file then)
-        if (input.tellg() > ulSize) {
-            break;
-        }
-        if (line.find("ENDSOLID") != std::string::npos) {
-            break;
-        }
-    }
-
-    // restart from the beginning
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
-
-#if 0
-    MeshBuilder builder(this->_rclMesh);
-#else
+    // Each three vertices form a facet, the facet normals are not needed. The vertices of a block
+    // are parsed in parallel ranges and an incomplete facet at the end is kept for the next block.
     MeshFastBuilder builder(this->_rclMesh);
-#endif
-    builder.Initialize(ulFacetCt);
-
-    ulVertexCt = 0;
-    while (std::getline(input, line)) {
-        boost::algorithm::to_upper(line);
-        if (boost::regex_match(line.c_str(), what, rx_f)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet.SetNormal(Base::Vector3f(fX, fY, fZ));
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet._aclPoints[ulVertexCt++].Set(fX, fY, fZ);
-            if (ulVertexCt == 3) {
-                ulVertexCt = 0;
-                builder.AddFacet(clFacet);
+    TextInput text(input);
+    std::vector<float> coords;
+    std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    while (text.next()) {
+        std::vector<std::string_view> ranges = text.split(threads, MinRangeSize);
+        std::vector<std::vector<float>> chunks(ranges.size());
+        std::vector<char> valid(ranges.size());
+        MeshCore::parallel_chunks(ranges.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                valid[i] = ReadAsciiSTLVertices(ranges[i], chunks[i]);
             }
+        });
+        if (std::find(valid.begin(), valid.end(), false) != valid.end()) {
+            return false;
+        }
+        for (const auto& chunk : chunks) {
+            coords.insert(coords.end(), chunk.begin(), chunk.end());
         }
+
+        std::size_t numFacets = coords.size() / 9;
+        builder.AddFacets(
+            reinterpret_cast<const char*>(coords.data()),  // NOLINT
+            static_cast<MeshFastBuilder::size_type>(numFacets),
+            9 * sizeof(float)
+        );
+        coords.erase(coords.begin(), coords.begin() + static_cast<std::ptrdiff_t>(9 * numFacets));
     }
 
     builder.Finish();
@@ -808,10 +823,14 @@ bool MeshInput::LoadAsciiSTL(std::istream& input)
 
 /** Loads a binary STL file. */
 bool MeshInput::LoadBinarySTL(std::istream& input)
+{
+    return LoadBinarySTL(input, nullptr);
+}
+
+/** Loads a binary STL file. */
+bool MeshInput::LoadBinarySTL(std::istream& input, const char* filename)
 {
     char szInfo[80];
-    Base::Vector3f clVects[4];
-    uint16_t usAtt = 0;
     uint32_t ulCt = 0;
 
     if (!input || input.bad()) {
@@ -844,24 +863,17 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
         return false;  // not a valid STL file
     }
 
-#if 0
-    MeshBuilder builder(this->_rclMesh);
-#else
-    MeshFastBuilder builder(this->_rclMesh);
-#endif
-    builder.Initialize(ulCt);
-
-    for (uint32_t i = 0; i < ulCt; i++) {
-        // read normal, points
-        input.read((char*)&clVects, sizeof(clVects));
-
-        std::swap(clVects[0], clVects[3]);
-        builder.AddFacet(clVects);
-
-        // overread 2 bytes attribute
-        input.read((char*)&usAtt, sizeof(usAtt));
+    // a facet record consists of the normal, the three points and 2 bytes attribute
+    constexpr std::size_t recordSize = 50;
+    constexpr std::size_t pointOffset = 12;
+    BinaryInput body;
+    if (!body.open(input, std::uint64_t(ulCt) * recordSize, filename)) {
+        return false;
     }
 
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Initialize(ulCt);
+    builder.AddFacets(body.data() + pointOffset, ulCt, recordSize);
     builder.Finish();
 
     return true;
@@ -128,10 +128,18 @@ public:
      * Therefore the file header gets checked to decide if the file is binary or not.
      */
     bool LoadSTL(std::istream& input);
+    /** Loads an STL file either in binary or ASCII format.
+     * The body of a binary file is memory-mapped from \a filename.
+     */
+    bool LoadSTL(std::istream& input, const char* filename);
     /** Loads an ASCII STL file. */
     bool LoadAsciiSTL(std::istream& input);
     /** Loads a binary STL file. */
     bool LoadBinarySTL(std::istream& input);
+    /** Loads a binary STL file. The facets are memory-mapped from \a filename if set
+     * and decoded in parallel.
+     */
+    bool LoadBinarySTL(std::istream& input, const char* filename);
     /** Loads an OBJ Mesh file. */
     bool LoadOBJ(std::istream& input);
     /** Loads an OBJ Mesh file. */
@@ -142,6 +150,8 @@ public:
     bool LoadOFF(std::istream& input);
     /** Loads a PLY Mesh file. */
     bool LoadPLY(std::istream& input);
+    /** Loads a PLY Mesh file. A binary body is memory-mapped from \a filename. */
+    bool LoadPLY(std::istream& input, const char* filename);
     /** Loads the mesh object from an XML file. */
     void LoadXML(Base::XMLReader& reader);
     /** Loads the mesh object from a 3MF file. */
@@ -24,11 +24,15 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <queue>
 #include <stdexcept>
+#include <zlib.h>
 
 
 #include <Base/Exception.h>
@@ -38,6 +42,7 @@
 #include "Algorithm.h"
 #include "Builder.h"
 #include "Evaluation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -46,6 +51,358 @@
 
 using namespace MeshCore;
 
+namespace
+{
+
+// Smaller ranges are not worth a thread of their own
+constexpr std::size_t MinChunkSize = 4096;
+
+constexpr uint32_t MeshMagic = 0xA0B0C0D0;
+constexpr uint32_t LegacyVersion = 0x010000;
+constexpr uint32_t NativeVersion = 0x020000;
+constexpr uint32_t OpenEdge = 0xffffffff;  // value to mark an open edge
+constexpr uint32_t CompressedData = 0x1;
+constexpr std::size_t CompressedBlockSize = std::size_t(1) << 22;
+
+// Header of the native format. It is followed by 'dataSize' bytes with the arrays of
+// NativeLayout, either as they are or split into compressed blocks.
+struct NativeHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+    uint32_t headerSize;
+    uint64_t countPoints;
+    uint64_t countFacets;
+    float boundBox[6];
+    uint64_t dataSize;
+};
+static_assert(sizeof(NativeHeader) == 64, "Unexpected padding");
+
+// Byte offsets of the arrays of the native format. Coordinates, point indices and neighbours
+// are 32-bit values, the flags are bytes and the end of the data is aligned to 8 bytes.
+struct NativeLayout
+{
+    NativeLayout(uint64_t countPoints, uint64_t countFacets)
+        : points(12 * countPoints)
+        , neighbours(points + 12 * countFacets)
+        , pointFlags(neighbours + 12 * countFacets)
+        , facetFlags(Align(pointFlags + countPoints))
+        , size(Align(facetFlags + countFacets))
+    {}
+
+    static uint64_t Align(uint64_t offset)
+    {
+        return (offset + 7) & ~uint64_t(7);
+    }
+
+    uint64_t coords {0};
+    uint64_t points;
+    uint64_t neighbours;
+    uint64_t pointFlags;
+    uint64_t facetFlags;
+    uint64_t size;
+};
+
+template<class T>
+T* ArrayAt(std::vector<char>& data, uint64_t offset)
+{
+    return reinterpret_cast<T*>(data.data() + offset);  // NOLINT
+}
+
+template<class T>
+const T* ArrayAt(const std::vector<char>& data, uint64_t offset)
+{
+    return reinterpret_cast<const T*>(data.data() + offset);  // NOLINT
+}
+
+// The table of the compressed sizes of the blocks is followed by the blocks
+std::vector<char> CompressBlocks(const std::vector<char>& data)
+{
+    std::size_t numBlocks = (data.size() + CompressedBlockSize - 1) / CompressedBlockSize;
+    std::vector<std::vector<char>> blocks(numBlocks);
+    MeshCore::parallel_chunks(numBlocks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t offset = i * CompressedBlockSize;
+            auto rawSize = static_cast<uLong>(std::min(CompressedBlockSize, data.size() - offset));
+            uLongf size = compressBound(rawSize);
+            blocks[i].resize(size);
+            if (compress2(
+                    reinterpret_cast<Bytef*>(blocks[i].data()),  // NOLINT
+                    &size,
+                    reinterpret_cast<const Bytef*>(data.data() + offset),  // NOLINT
+                    rawSize,
+                    Z_BEST_SPEED
+                )
+                != Z_OK) {
+                throw Base::RuntimeError("Compression of mesh data failed");
+            }
+            blocks[i].resize(size);
+        }
+    });
+
+    std::vector<char> result(NativeLayout::Align(numBlocks * sizeof(uint32_t)));
+    for (std::size_t i = 0; i < numBlocks; i++) {
+        ArrayAt<uint32_t>(result, 0)[i] = static_cast<uint32_t>(blocks[i].size());
+    }
+    for (const auto& block : blocks) {
+        result.insert(result.end(), block.begin(), block.end());
+    }
+    return result;
+}
+
+std::vector<char> UncompressBlocks(const std::vector<char>& stored, uint64_t size, bool swap)
+{
+    std::size_t numBlocks = (size + CompressedBlockSize - 1) / CompressedBlockSize;
+    uint64_t tableSize = NativeLayout::Align(numBlocks * sizeof(uint32_t));
+    if (tableSize > stored.size()) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    std::vector<uint64_t> offsets(numBlocks + 1, tableSize);
+    for (std::size_t i = 0; i < numBlocks; i++) {
+        uint32_t blockSize = ArrayAt<uint32_t>(stored, 0)[i];
+        if (swap) {
+            Base::SwapEndian(blockSize);
+        }
+        offsets[i + 1] = offsets[i] + blockSize;
+    }
+    if (offsets.back() != stored.size()) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    std::vector<char> data(size);
+    MeshCore::parallel_chunks(numBlocks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t offset = i * CompressedBlockSize;
+            uint64_t rawSize = std::min<uint64_t>(CompressedBlockSize, size - offset);
+            auto len = static_cast<uLongf>(rawSize);
+            if (uncompress(
+                    reinterpret_cast<Bytef*>(data.data() + offset),  // NOLINT
+                    &len,
+                    reinterpret_cast<const Bytef*>(stored.data() + offsets[i]),  // NOLINT
+                    static_cast<uLong>(offsets[i + 1] - offsets[i])
+                )
+                    != Z_OK
+                || len != rawSize) {
+                throw Base::BadFormatError("Invalid data structure");
+            }
+        }
+    });
+    return data;
+}
+
+std::vector<char> PackNative(const MeshPointArray& points, const MeshFacetArray& facets)
+{
+    NativeLayout layout(points.size(), facets.size());
+    std::vector<char> data(layout.size);
+
+    auto coords = ArrayAt<float>(data, layout.coords);
+    auto pointFlags = ArrayAt<uint8_t>(data, layout.pointFlags);
+    MeshCore::parallel_chunks(points.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            coords[3 * i] = points[i].x;
+            coords[3 * i + 1] = points[i].y;
+            coords[3 * i + 2] = points[i].z;
+            pointFlags[i] = points[i]._ucFlag;
+        }
+    });
+
+    auto pnts = ArrayAt<uint32_t>(data, layout.points);
+    auto nbrs = ArrayAt<uint32_t>(data, layout.neighbours);
+    auto facetFlags = ArrayAt<uint8_t>(data, layout.facetFlags);
+    MeshCore::parallel_chunks(facets.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[i];
+            for (int j = 0; j < 3; j++) {
+                pnts[3 * i + j] = static_cast<uint32_t>(facet._aulPoints[j]);
+                nbrs[3 * i + j] = facet._aulNeighbours[j] == FACET_INDEX_MAX
+                    ? OpenEdge
+                    : static_cast<uint32_t>(facet._aulNeighbours[j]);
+            }
+            facetFlags[i] = facet._ucFlag;
+        }
+    });
+
+    return data;
+}
+
+// zlib doesn't compress data by more than this factor
+constexpr uint64_t MaxCompressionRatio = 1032;
+
+// Upper bound of the stored size of 'size' bytes split into compressed blocks
+uint64_t CompressedBound(uint64_t size)
+{
+    uint64_t numBlocks = (size + CompressedBlockSize - 1) / CompressedBlockSize;
+    uint64_t overhead
+        = compressBound(static_cast<uLong>(CompressedBlockSize)) - CompressedBlockSize;
+    return NativeLayout::Align(numBlocks * sizeof(uint32_t)) + size + numBlocks * overhead;
+}
+
+// Reads 'size' bytes. If the stream can tell how much it holds, a larger size fails before
+// any memory is allocated. Otherwise the data is read in steps, so that the memory only grows
+// with the data that is actually there.
+std::vector<char> ReadData(std::istream& input, uint64_t size)
+{
+    uint64_t step = uint64_t(1) << 26;
+    std::streampos pos = input.tellg();
+    if (pos != std::streampos(-1)) {
+        if (input.seekg(0, std::ios::end)) {
+            std::streampos end = input.tellg();
+            if (!input.seekg(pos)) {
+                throw Base::BadFormatError("Reading from stream failed");
+            }
+            if (end != std::streampos(-1)) {
+                if (uint64_t(end - pos) < size) {
+                    throw Base::BadFormatError("Reading from stream failed");
+                }
+                step = size;
+            }
+        }
+        else {
+            // the stream can't seek, its position is unchanged
+            input.clear();
+        }
+    }
+
+    std::vector<char> data;
+    while (data.size() < size) {
+        std::size_t offset = data.size();
+        auto len = static_cast<std::size_t>(std::min(step, size - offset));
+        data.resize(offset + len);
+        input.read(data.data() + offset, std::streamsize(len));
+        if (input.gcount() != std::streamsize(len)) {
+            throw Base::BadFormatError("Reading from stream failed");
+        }
+    }
+    return data;
+}
+
+// Returns true if each neighbour refers back to the facet over the same edge
+bool ReadNative(
+    std::istream& input,
+    bool swap,
+    MeshPointArray& points,
+    MeshFacetArray& facets,
+    Base::BoundBox3f& boundBox
+)
+{
+    NativeHeader header {};
+    header.magic = MeshMagic;
+    header.version = NativeVersion;
+    auto rest = reinterpret_cast<char*>(&header.flags);  // NOLINT
+    input.read(rest, sizeof(NativeHeader) - offsetof(NativeHeader, flags));
+    if (swap) {
+        Base::SwapEndian(header.flags);
+        Base::SwapEndian(header.headerSize);
+        Base::SwapEndian(header.countPoints);
+        Base::SwapEndian(header.countFacets);
+        for (float& value : header.boundBox) {
+            Base::SwapEndian(value);
+        }
+        Base::SwapEndian(header.dataSize);
+    }
+
+    // 32-bit indices are stored and the sizes must fit. The size of the data is checked against
+    // the counts before anything is allocated, compressed data can only be that much smaller.
+    bool compressed = (header.flags & CompressedData) != 0;
+    NativeLayout layout(header.countPoints, header.countFacets);
+    if (!input || header.headerSize < sizeof(NativeHeader) || header.countPoints >= OpenEdge
+        || header.countFacets >= OpenEdge || (!compressed && header.dataSize != layout.size)
+        || (compressed
+            && (header.dataSize > CompressedBound(layout.size)
+                || layout.size > MaxCompressionRatio * header.dataSize))) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+    input.ignore(std::streamsize(header.headerSize - sizeof(NativeHeader)));
+
+    std::vector<char> data = ReadData(input, header.dataSize);
+    if (compressed) {
+        data = UncompressBlocks(data, layout.size, swap);
+    }
+
+    if (swap) {
+        auto words = ArrayAt<uint32_t>(data, 0);
+        MeshCore::parallel_chunks(
+            layout.pointFlags / sizeof(uint32_t),
+            MinChunkSize,
+            [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    Base::SwapEndian(words[i]);
+                }
+            }
+        );
+    }
+
+    std::size_t numPoints = header.countPoints;
+    std::size_t numFacets = header.countFacets;
+    points.resize(numPoints);
+    facets.resize(numFacets);
+
+    auto coords = ArrayAt<const float>(data, layout.coords);
+    auto pointFlags = ArrayAt<const uint8_t>(data, layout.pointFlags);
+    MeshCore::parallel_chunks(numPoints, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            points[i].Set(coords[3 * i], coords[3 * i + 1], coords[3 * i + 2]);
+            points[i]._ucFlag = pointFlags[i];
+        }
+    });
+
+    std::atomic<bool> consistent {true};
+    auto pnts = ArrayAt<const uint32_t>(data, layout.points);
+    auto nbrs = ArrayAt<const uint32_t>(data, layout.neighbours);
+    auto facetFlags = ArrayAt<const uint8_t>(data, layout.facetFlags);
+    MeshCore::parallel_chunks(numFacets, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        bool valid = true;
+        for (std::size_t i = begin; i < end; i++) {
+            MeshFacet& facet = facets[i];
+            for (std::size_t j = 0; j < 3; j++) {
+                uint32_t index = pnts[3 * i + j];
+                uint32_t neighbour = nbrs[3 * i + j];
+                if (index >= numPoints || (neighbour >= numFacets && neighbour != OpenEdge)) {
+                    throw Base::BadFormatError("Invalid data structure");
+                }
+
+                facet._aulPoints[j] = index;
+                if (neighbour == OpenEdge) {
+                    facet._aulNeighbours[j] = FACET_INDEX_MAX;
+                    continue;
+                }
+
+                facet._aulNeighbours[j] = neighbour;
+                // the orientation of the neighbour may differ
+                uint32_t next = pnts[3 * i + (j + 1) % 3];
+                const uint32_t* other = pnts + 3 * std::size_t(neighbour);
+                const uint32_t* otherNbrs = nbrs + 3 * std::size_t(neighbour);
+                bool found = false;
+                for (std::size_t k = 0; k < 3; k++) {
+                    uint32_t q0 = other[k];
+                    uint32_t q1 = other[(k + 1) % 3];
+                    if (otherNbrs[k] == i
+                        && ((q0 == next && q1 == index) || (q0 == index && q1 == next))) {
+                        found = true;
+                    }
+                }
+                valid = valid && found;
+            }
+            facet._ucFlag = facetFlags[i];
+        }
+        if (!valid) {
+            consistent = false;
+        }
+    });
+
+    boundBox.MinX = header.boundBox[0];
+    boundBox.MaxX = header.boundBox[1];
+    boundBox.MinY = header.boundBox[2];
+    boundBox.MaxY = header.boundBox[3];
+    boundBox.MinZ = header.boundBox[4];
+    boundBox.MaxZ = header.boundBox[5];
+    return consistent;
+}
+
+}  // namespace
+
 MeshKernel::MeshKernel()
 {
     _clBoundBox.SetVoid();
@@ -896,8 +1253,8 @@ void MeshKernel::Write(std::ostream& rclOut) const
     Base::OutputStream str(rclOut);
 
     // Write a header with a "magic number" and a version
-    str << static_cast<uint32_t>(0xA0B0C0D0);
-    str << static_cast<uint32_t>(0x010000);
+    str << MeshMagic;
+    str << LegacyVersion;
 
     char szInfo[257];  // needs an additional byte for zero-termination
     strcpy(
@@ -930,12 +1287,44 @@ void MeshKernel::Write(std::ostream& rclOut) const
     str << _clBoundBox.MinZ << _clBoundBox.MaxZ;
 }
 
-void MeshKernel::Read(std::istream& rclIn)
+void MeshKernel::WriteNative(std::ostream& rclOut, bool compress) const
 {
-    if (!rclIn || rclIn.bad()) {
+    if (!rclOut || rclOut.bad()) {
         return;
     }
 
+    // Write a header with a "magic number" and a version
+    NativeHeader header {};
+    header.magic = MeshMagic;
+    header.version = NativeVersion;
+    header.flags = compress ? CompressedData : 0;
+    header.headerSize = sizeof(NativeHeader);
+    header.countPoints = CountPoints();
+    header.countFacets = CountFacets();
+    header.boundBox[0] = _clBoundBox.MinX;
+    header.boundBox[1] = _clBoundBox.MaxX;
+    header.boundBox[2] = _clBoundBox.MinY;
+    header.boundBox[3] = _clBoundBox.MaxY;
+    header.boundBox[4] = _clBoundBox.MinZ;
+    header.boundBox[5] = _clBoundBox.MaxZ;
+
+    // write the data
+    std::vector<char> data = PackNative(_aclPointArray, _aclFacetArray);
+    if (compress) {
+        data = CompressBlocks(data);
+    }
+    header.dataSize = data.size();
+
+    rclOut.write(reinterpret_cast<const char*>(&header), sizeof(NativeHeader));  // NOLINT
+    rclOut.write(data.data(), std::streamsize(data.size()));
+}
+
+bool MeshKernel::Read(std::istream& rclIn)
+{
+    if (!rclIn || rclIn.bad()) {
+        return false;
+    }
+
     // get header
     Base::InputStream str(rclIn);
 
@@ -946,14 +1335,38 @@ void MeshKernel::Read(std::istream& rclIn)
     Base::SwapEndian(swap_magic);
     swap_version = version;
     Base::SwapEndian(swap_version);
-    uint32_t open_edge = 0xffffffff;  // value to mark an open edge
+    uint32_t open_edge = OpenEdge;
+
+    // the native format in the byte order of this or of another machine
+    bool native = magic == MeshMagic && version == NativeVersion;
+    if (native || (swap_magic == MeshMagic && swap_version == NativeVersion)) {
+        MeshPointArray pointArray;
+        MeshFacetArray facetArray;
+        Base::BoundBox3f boundBox;
+        bool consistent = false;
+        try {
+            consistent = ReadNative(rclIn, !native, pointArray, facetArray, boundBox);
+        }
+        catch (const std::bad_alloc&) {
+            throw Base::BadFormatError("Reading from stream failed");
+        }
+        catch (const std::length_error&) {
+            throw Base::BadFormatError("Reading from stream failed");
+        }
+
+        // If we reach this block no exception occurred and we can safely assign the mesh
+        _aclPointArray.swap(pointArray);
+        _aclFacetArray.swap(facetArray);
+        _clBoundBox = boundBox;
+        return consistent;
+    }
 
     // is it the new or old format?
     bool new_format = false;
-    if (magic == 0xA0B0C0D0 && version == 0x010000) {
+    if (magic == MeshMagic && version == LegacyVersion) {
         new_format = true;
     }
-    else if (swap_magic == 0xA0B0C0D0 && swap_version == 0x010000) {
+    else if (swap_magic == MeshMagic && swap_version == LegacyVersion) {
         new_format = true;
         str.setByteOrder(Base::Stream::BigEndian);
     }
@@ -1117,6 +1530,8 @@ void MeshKernel::Read(std::istream& rclIn)
         _aclPointArray.swap(pointArray);
         _aclFacetArray.swap(facetArray);
     }
+
+    return false;
 }
 
 void MeshKernel::operator*=(const Base::Matrix4D& rclMat)
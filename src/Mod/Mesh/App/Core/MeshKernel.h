@@ -78,9 +78,22 @@ public:
 
     /** @name I/O methods */
     //@{
-    /// Binary streaming of data
+    /// Binary streaming of data in the format that all versions can read
     void Write(std::ostream& rclOut) const;
-    void Read(std::istream& rclIn);
+    /**
+     * Binary streaming of data in the native format. The points, facets, neighbours and flags
+     * are written as contiguous arrays in the byte order of this machine that can be read in
+     * one go. With \a compress the arrays are written as zlib-compressed blocks.
+     * \note Versions before the introduction of this format can't read it.
+     */
+    void WriteNative(std::ostream& rclOut, bool compress = false) const;
+    /**
+     * Reads the data written by Write() or WriteNative().
+     * Returns true if the neighbours of the facets have been verified while reading, which is
+     * only done for the native format.
+     * \throws Base::BadFormatError if the data is invalid
+     */
+    bool Read(std::istream& rclIn);
     //@}
 
     /** @name Querying */
@@ -28,6 +28,7 @@
 #include <map>
 
 
+#include "BVH.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -148,12 +149,6 @@ bool MeshProjection::projectLineOnMesh(
     std::vector<Base::Vector3f>& polyline
 )
 {
-    Base::Vector3f dir(v2 - v1);
-    Base::Vector3f base(v1), normal(vd % dir);
-    normal.Normalize();
-    dir.Normalize();
-
-
     std::vector<FacetIndex> facets;
 
     // special case: start and endpoint inside same facet
@@ -172,6 +167,70 @@ bool MeshProjection::projectLineOnMesh(
         }
     }
 
+    return cutFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnMesh(
+    const MeshFacetBVH& bvh,
+    const Base::Vector3f& v1,
+    FacetIndex f1,
+    const Base::Vector3f& v2,
+    FacetIndex f2,
+    const Base::Vector3f& vd,
+    std::vector<Base::Vector3f>& polyline
+)
+{
+    std::vector<FacetIndex> facets;
+
+    // special case: start and endpoint inside same facet
+    if (f1 == f2) {
+        polyline.push_back(v1);
+        polyline.push_back(v2);
+        return true;
+    }
+
+    Base::Vector3f dir(v2 - v1);
+    Base::Vector3f normal(vd % dir);
+    normal.Normalize();
+    float len = dir.Length();
+    dir.Normalize();
+
+    // A box of the hierarchy must be kept if any facet box inside could pass
+    // bboxInsideRectangle: it must cut the plane and lie close enough to the
+    // segment along its direction.
+    float smin = v1 * dir;
+    float smax = smin + len;
+    auto test = [&](const Base::BoundBox3f& box) {
+        if (!box.IsCutPlane(v1, normal)) {
+            return false;
+        }
+        float center = box.GetCenter() * dir;
+        float extent = 0.5F
+            * (std::fabs(dir.x) * box.LengthX() + std::fabs(dir.y) * box.LengthY()
+               + std::fabs(dir.z) * box.LengthZ());
+        float tolerance = 0.5F * box.CalcDiagonalLength();
+        return center + extent + tolerance >= smin && center - extent - tolerance <= smax;
+    };
+
+    bvh.Search(test, facets);
+    return cutFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::cutFacets(
+    std::vector<FacetIndex>& facets,
+    const Base::Vector3f& v1,
+    FacetIndex f1,
+    const Base::Vector3f& v2,
+    FacetIndex f2,
+    const Base::Vector3f& vd,
+    std::vector<Base::Vector3f>& polyline
+) const
+{
+    Base::Vector3f dir(v2 - v1);
+    Base::Vector3f base(v1), normal(vd % dir);
+    normal.Normalize();
+    dir.Normalize();
+
     std::sort(facets.begin(), facets.end());
     facets.erase(std::unique(facets.begin(), facets.end()), facets.end());
 
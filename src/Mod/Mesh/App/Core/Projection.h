@@ -40,6 +40,7 @@ class TopoDS_Shape;
 namespace MeshCore
 {
 
+class MeshFacetBVH;
 class MeshFacetGrid;
 class MeshKernel;
 class MeshGeomFacet;
@@ -58,6 +59,15 @@ public:
         const Base::Vector3f& view,
         std::vector<Base::Vector3f>& polyline
     );
+    bool projectLineOnMesh(
+        const MeshFacetBVH& bvh,
+        const Base::Vector3f& p1,
+        FacetIndex f1,
+        const Base::Vector3f& p2,
+        FacetIndex f2,
+        const Base::Vector3f& view,
+        std::vector<Base::Vector3f>& polyline
+    );
 
 protected:
     bool bboxInsideRectangle(
@@ -77,6 +87,15 @@ protected:
         const Base::Vector3f& endPoint,
         std::vector<Base::Vector3f>& polyline
     ) const;
+    bool cutFacets(
+        std::vector<FacetIndex>& facets,
+        const Base::Vector3f& p1,
+        FacetIndex f1,
+        const Base::Vector3f& p2,
+        FacetIndex f2,
+        const Base::Vector3f& view,
+        std::vector<Base::Vector3f>& polyline
+    ) const;
 
 private:
     const MeshKernel& kernel;
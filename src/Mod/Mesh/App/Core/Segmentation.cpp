@@ -23,15 +23,74 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Segmentation.h"
 
 using namespace MeshCore;
 
+namespace
+{
+// Smaller ranges are not worth a thread of their own
+constexpr std::size_t MinChunkSize = 4096;
+
+// Concurrent union-find that always links the larger root to the smaller one. So, no cycles
+// can occur and the root of a set is its smallest index.
+class UnionFind
+{
+public:
+    explicit UnionFind(std::size_t count)
+        : parent(count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t Find(std::size_t index)
+    {
+        for (;;) {
+            std::size_t next = parent[index].load();
+            if (next == index) {
+                return index;
+            }
+            // path halving, it doesn't matter if another thread was faster
+            std::size_t grand = parent[next].load();
+            if (grand != next) {
+                parent[index].compare_exchange_weak(next, grand);
+            }
+            index = grand;
+        }
+    }
+
+    void Unite(std::size_t index1, std::size_t index2)
+    {
+        for (;;) {
+            index1 = Find(index1);
+            index2 = Find(index2);
+            if (index1 == index2) {
+                return;
+            }
+            if (index1 < index2) {
+                std::swap(index1, index2);
+            }
+            std::size_t root = index1;
+            if (parent[index1].compare_exchange_strong(root, index2)) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::vector<std::atomic<std::size_t>> parent;
+};
+}  // namespace
+
 void MeshSurfaceSegment::Initialize(FacetIndex)
 {}
 
@@ -576,6 +635,11 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        if (it->HasFixedTest()) {
+            FindFixedSegments(*it, resetVisited);
+            continue;
+        }
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
@@ -617,3 +681,114 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         }
     }
 }
+
+void MeshSegmentAlgorithm::FindFixedSegments(
+    MeshSurfaceSegment& segm,
+    std::vector<FacetIndex>& resetVisited
+) const
+{
+    // This gives the same segments as the facet visitor in FindSegments(). As the test of a facet
+    // doesn't depend on the segment the facets that pass the test and are connected form fixed
+    // components. A start facet that passes the test gets its component, a start facet that
+    // doesn't gets the components of its neighbours that are still free.
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    std::size_t count = facets.size();
+
+    // test all free facets
+    std::vector<char> passed(count, 0);
+    std::vector<char> initial(count, 0);
+    MeshCore::parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            if (!facets[index].IsFlag(MeshFacet::VISIT)) {
+                passed[index] = segm.TestFacet(facets[index]) ? 1 : 0;
+                initial[index] = segm.TestInitialFacet(index) ? 1 : 0;
+            }
+        }
+    });
+
+    // connect the neighbours that passed
+    UnionFind sets(count);
+    MeshCore::parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            if (!passed[index]) {
+                continue;
+            }
+            for (FacetIndex nb : facets[index]._aulNeighbours) {
+                if (nb < count && nb != index && passed[nb]) {
+                    sets.Unite(index, nb);
+                }
+            }
+        }
+    });
+
+    std::vector<FacetIndex> roots(count);
+    MeshCore::parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            roots[index] = passed[index] ? sets.Find(index) : index;
+        }
+    });
+
+    // sort the facets by their components
+    std::vector<FacetIndex> offsets(count + 1, 0);
+    for (std::size_t index = 0; index < count; index++) {
+        if (passed[index]) {
+            offsets[roots[index] + 1]++;
+        }
+    }
+    for (std::size_t index = 0; index < count; index++) {
+        offsets[index + 1] += offsets[index];
+    }
+    std::vector<FacetIndex> members(offsets[count]);
+    std::vector<FacetIndex> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t index = 0; index < count; index++) {
+        if (passed[index]) {
+            members[fill[roots[index]]++] = index;
+        }
+    }
+
+    std::vector<char> taken(count, 0);
+    auto addComponent = [&](FacetIndex index, FacetIndex start, std::vector<FacetIndex>& indices) {
+        FacetIndex root = roots[index];
+        if (taken[root]) {
+            return;
+        }
+        taken[root] = 1;
+        for (FacetIndex pos = offsets[root]; pos < offsets[root + 1]; pos++) {
+            FacetIndex member = members[pos];
+            facets[member].SetFlag(MeshFacet::VISIT);
+            if (member != start) {
+                indices.push_back(member);
+            }
+        }
+    };
+
+    for (FacetIndex start = 0; start < count; start++) {
+        if (facets[start].IsFlag(MeshFacet::VISIT)) {
+            continue;
+        }
+
+        facets[start].SetFlag(MeshFacet::VISIT);
+        std::vector<FacetIndex> indices;
+        if (initial[start]) {
+            indices.push_back(start);
+        }
+        if (passed[start]) {
+            addComponent(start, start, indices);
+        }
+        else {
+            for (FacetIndex nb : facets[start]._aulNeighbours) {
+                if (nb < count && passed[nb]) {
+                    addComponent(nb, start, indices);
+                }
+            }
+        }
+
+        // add or discard the segment
+        if (indices.size() <= 1) {
+            resetVisited.push_back(start);
+        }
+        else {
+            segm.AddSegment(indices);
+        }
+    }
+}
@@ -56,6 +56,14 @@ public:
 
     virtual bool TestFacet(const MeshFacet& rclFacet) const = 0;
     virtual const char* GetType() const = 0;
+    /** Checks whether TestFacet() and TestInitialFacet() only depend on the facet and not on the
+     * facets added so far. Then they must be safe to call from several threads, and
+     * MeshSegmentAlgorithm grows the segments all at once.
+     */
+    virtual bool HasFixedTest() const
+    {
+        return false;
+    }
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
@@ -134,6 +142,11 @@ public:
     virtual float Fit() = 0;
     virtual float GetDistanceToSurface(const Base::Vector3f&) const = 0;
     virtual std::vector<float> Parameters() const = 0;
+    /// Checks whether the surface is predefined and thus not changed by added triangles
+    virtual bool IsFixed() const
+    {
+        return false;
+    }
 };
 
 class MeshExport PlaneSurfaceFit: public AbstractSurfaceFit
@@ -159,6 +172,10 @@ public:
     float Fit() override;
     float GetDistanceToSurface(const Base::Vector3f&) const override;
     std::vector<float> Parameters() const override;
+    bool IsFixed() const override
+    {
+        return fitter == nullptr;
+    }
 
 private:
     Base::Vector3f basepoint;
@@ -189,6 +206,10 @@ public:
     float Fit() override;
     float GetDistanceToSurface(const Base::Vector3f&) const override;
     std::vector<float> Parameters() const override;
+    bool IsFixed() const override
+    {
+        return fitter == nullptr;
+    }
 
 private:
     Base::Vector3f basepoint;
@@ -220,6 +241,10 @@ public:
     float Fit() override;
     float GetDistanceToSurface(const Base::Vector3f&) const override;
     std::vector<float> Parameters() const override;
+    bool IsFixed() const override
+    {
+        return fitter == nullptr;
+    }
 
 private:
     Base::Vector3f center;
@@ -250,6 +275,10 @@ public:
     {
         return fitter->GetType();
     }
+    bool HasFixedTest() const override
+    {
+        return fitter->IsFixed();
+    }
     void Initialize(FacetIndex) override;
     bool TestInitialFacet(FacetIndex) const override;
     void AddFacet(const MeshFacet& face) override;
@@ -273,6 +302,10 @@ public:
     {
         return info.at(pos);
     }
+    bool HasFixedTest() const override
+    {
+        return true;
+    }
 
 private:
     const std::vector<CurvatureInfo>& info;
@@ -399,8 +432,15 @@ public:
     explicit MeshSegmentAlgorithm(const MeshKernel& kernel)
         : myKernel(kernel)
     {}
+    /** Grows the segments from the not yet visited facets. A facet that has been added to a
+     * segment is not tested by the following segments. Segments with a fixed test are grown at
+     * once in parallel, in this case the facets of a segment may come in another order.
+     */
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
 
+private:
+    void FindFixedSegments(MeshSurfaceSegment&, std::vector<FacetIndex>& resetVisited) const;
+
 private:
     const MeshKernel& myKernel;
 };
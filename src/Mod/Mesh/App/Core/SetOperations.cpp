@@ -23,17 +23,25 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <future>
 #include <ios>
+#include <mutex>
+#include <set>
+#include <thread>
 
 
 #include <Base/Builder3D.h>
 #include <Base/Sequencer.h>
 
 #include "Algorithm.h"
+#include "BVH.h"
 #include "Builder.h"
 #include "Definitions.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "SetOperations.h"
@@ -59,6 +67,14 @@ SetOperations::SetOperations(
     , _minDistanceToPoint(minDistanceToPoint)
 {}
 
+std::size_t SetOperations::GetThreads() const
+{
+    if (_maxThreads > 0) {
+        return _maxThreads;
+    }
+    return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
 void SetOperations::Do()
 {
     _minDistanceToPoint = 0.000001F;
@@ -70,11 +86,11 @@ void SetOperations::Do()
     // _builder.clear();
 
     // Base::Sequencer().next();
-    std::set<FacetIndex> facetsCuttingEdge0, facetsCuttingEdge1;
+    std::vector<bool> facetsCuttingEdge0, facetsCuttingEdge1;
     Cut(facetsCuttingEdge0, facetsCuttingEdge1);
 
     // no intersection curve of the meshes found
-    if (facetsCuttingEdge0.empty() || facetsCuttingEdge1.empty()) {
+    if (_facet2points[0].empty() || _facet2points[1].empty()) {
         switch (_operationType) {
             case Union: {
                 _resultMesh = _cutMesh0;
@@ -99,13 +115,13 @@ void SetOperations::Do()
     }
 
     for (auto i = 0UL; i < _cutMesh0.CountFacets(); i++) {
-        if (facetsCuttingEdge0.find(i) == facetsCuttingEdge0.end()) {
+        if (!facetsCuttingEdge0[i]) {
             _newMeshFacets[0].push_back(_cutMesh0.GetFacet(i));
         }
     }
 
     for (auto i = 0UL; i < _cutMesh1.CountFacets(); i++) {
-        if (facetsCuttingEdge1.find(i) == facetsCuttingEdge1.end()) {
+        if (!facetsCuttingEdge1[i]) {
             _newMeshFacets[1].push_back(_cutMesh1.GetFacet(i));
         }
     }
@@ -144,10 +160,22 @@ void SetOperations::Do()
             break;
     }
 
+    // the meshes are created one after another as MeshBuilder reports its progress
+    MeshKernel mesh0, mesh1;
     // Base::Sequencer().next();
-    CollectFacets(0, mult0);
+    CreateMesh(0, mesh0);
+    CreateMesh(1, mesh1);
+
     // Base::Sequencer().next();
-    CollectFacets(1, mult1);
+    if (GetThreads() > 1) {
+        auto future = std::async(std::launch::async, [&]() { CollectFacets(mesh1, 1, mult1); });
+        CollectFacets(mesh0, 0, mult0);
+        future.get();
+    }
+    else {
+        CollectFacets(mesh0, 0, mult0);
+        CollectFacets(mesh1, 1, mult1);
+    }
 
     std::vector<MeshGeomFacet> facets;
 
@@ -173,118 +201,127 @@ void SetOperations::Do()
     MeshDefinitions::SetMinPointDistance(saveMinMeshDistance);
 }
 
-void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1)
+void SetOperations::Cut(
+    std::vector<bool>& facetsCuttingEdge0,
+    std::vector<bool>& facetsCuttingEdge1
+)
 {
-    MeshFacetGrid grid1(_cutMesh0, 20);
-    MeshFacetGrid grid2(_cutMesh1, 20);
-
-    unsigned long ctGx1 {}, ctGy1 {}, ctGz1 {};
-    grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
-
-    for (auto gx1 = 0UL; gx1 < ctGx1; gx1++) {
-        for (auto gy1 = 0UL; gy1 < ctGy1; gy1++) {
-            for (auto gz1 = 0UL; gz1 < ctGz1; gz1++) {
-                if (grid1.GetCtElements(gx1, gy1, gz1) > 0) {
-                    std::vector<FacetIndex> vecFacets2;
-                    grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-
-                    if (!vecFacets2.empty()) {
-                        std::set<FacetIndex> vecFacets1;
-                        grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-
-                        std::set<FacetIndex>::iterator it1;
-                        for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1) {
-                            FacetIndex fidx1 = *it1;
-                            MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-
-                            std::vector<FacetIndex>::iterator it2;
-                            for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2) {
-                                FacetIndex fidx2 = *it2;
-                                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                                MeshPoint p0, p1;
-
-                                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                                if (isect > 0) {
-                                    // optimize cut line if distance to nearest point is too small
-                                    float minDist1 = _minDistanceToPoint,
-                                          minDist2 = _minDistanceToPoint;
-                                    MeshPoint np0 = p0, np1 = p1;
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f1._aclPoints[i] - p0).Length();
-                                        float d2 = (f1._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f1._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            p1 = f1._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    // optimize cut line if distance to nearest point is too small
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f2._aclPoints[i] - p0).Length();
-                                        float d2 = (f2._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f2._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            np1 = f2._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    MeshPoint mp0 = np0;
-                                    MeshPoint mp1 = np1;
-
-                                    if (mp0 != mp1) {
-                                        facetsCuttingEdge0.insert(fidx1);
-                                        facetsCuttingEdge1.insert(fidx2);
-
-                                        _cutPoints.insert(mp0);
-                                        _cutPoints.insert(mp1);
-
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit0
-                                            = _cutPoints.insert(mp0);
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit1
-                                            = _cutPoints.insert(mp1);
-
-                                        _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                                        _facet2points[0][fidx1].push_back(pit0.first);
-                                        _facet2points[0][fidx1].push_back(pit1.first);
-                                        _facet2points[1][fidx2].push_back(pit0.first);
-                                        _facet2points[1][fidx2].push_back(pit1.first);
-                                    }
-                                    else {
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit
-                                            = _cutPoints.insert(mp0);
-
-                                        // do not insert a facet when only one corner point cuts the
-                                        // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
-                                        // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge0.insert(fidx1);
-                                            _facet2points[0][fidx1].push_back(pit.first);
-                                        }
-
-                                        // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
-                                        // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge1.insert(fidx2);
-                                            _facet2points[1][fidx2].push_back(pit.first);
-                                        }
-                                    }
-                                }
-                            }
+    MeshFacetBVH bvh(_cutMesh1);
+
+    // the sections are computed in parallel ranges of facets of mesh 1 and then merged in the
+    // order of the ranges, so that the cut points get the same indices with any number of threads
+    std::vector<std::pair<std::size_t, std::vector<Section>>> ranges;
+    std::mutex mutex;
+    std::size_t numFacets = _cutMesh0.CountFacets();
+    parallel_chunks(numFacets, 256, GetThreads(), [&](std::size_t begin, std::size_t end) {
+        std::vector<Section> sections;
+        std::vector<FacetIndex> vecFacets2;
+        for (std::size_t fidx1 = begin; fidx1 < end; fidx1++) {
+            MeshGeomFacet f1 = _cutMesh0.GetFacet(fidx1);
+            vecFacets2.clear();
+            bvh.Inside(f1.GetBoundBox(), vecFacets2);
+            std::sort(vecFacets2.begin(), vecFacets2.end());
+
+            for (FacetIndex fidx2 : vecFacets2) {
+                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
+
+                MeshPoint p0, p1;
+
+                int isect = f1.IntersectWithFacet(f2, p0, p1);
+                if (isect > 0) {
+                    // optimize cut line if distance to nearest point is too small
+                    float minDist1 = _minDistanceToPoint, minDist2 = _minDistanceToPoint;
+                    MeshPoint np0 = p0, np1 = p1;
+                    for (int i = 0; i < 3; i++)  // NOLINT
+                    {
+                        float d1 = (f1._aclPoints[i] - p0).Length();
+                        float d2 = (f1._aclPoints[i] - p1).Length();
+                        if (d1 < minDist1) {
+                            minDist1 = d1;
+                            np0 = f1._aclPoints[i];
+                        }
+                        if (d2 < minDist2) {
+                            minDist2 = d2;
+                            p1 = f1._aclPoints[i];
                         }
+                    }  // for (int i = 0; i < 3; i++)
+
+                    // optimize cut line if distance to nearest point is too small
+                    for (int i = 0; i < 3; i++)  // NOLINT
+                    {
+                        float d1 = (f2._aclPoints[i] - p0).Length();
+                        float d2 = (f2._aclPoints[i] - p1).Length();
+                        if (d1 < minDist1) {
+                            minDist1 = d1;
+                            np0 = f2._aclPoints[i];
+                        }
+                        if (d2 < minDist2) {
+                            minDist2 = d2;
+                            np1 = f2._aclPoints[i];
+                        }
+                    }  // for (int i = 0; i < 3; i++)
+
+                    sections.push_back({fidx1, fidx2, np0, np1});
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        ranges.emplace_back(begin, std::move(sections));
+    });
+
+    std::sort(ranges.begin(), ranges.end(), [](const auto& range1, const auto& range2) {
+        return range1.first < range2.first;
+    });
+
+    facetsCuttingEdge0.assign(_cutMesh0.CountFacets(), false);
+    facetsCuttingEdge1.assign(_cutMesh1.CountFacets(), false);
+    for (const auto& range : ranges) {
+        for (const auto& section : range.second) {
+            const MeshPoint& mp0 = section.p0;
+            const MeshPoint& mp1 = section.p1;
+            FacetIndex fidx1 = section.facet0;
+            FacetIndex fidx2 = section.facet1;
+
+            if (mp0 != mp1) {
+                facetsCuttingEdge0[fidx1] = true;
+                facetsCuttingEdge1[fidx2] = true;
+
+                PointIndex pit0 = _cutPoints.Insert(mp0);
+                PointIndex pit1 = _cutPoints.Insert(mp1);
+
+                // both points may snap to the same cut point
+                if (pit0 != pit1) {
+                    EdgeInfo& info = _edges[EdgeKey(pit0, pit1)];
+                    info.pt1 = _cutPoints[std::min(pit0, pit1)];
+                    info.pt2 = _cutPoints[std::max(pit0, pit1)];
+                    if (info.pt2 < info.pt1) {
+                        std::swap(info.pt1, info.pt2);
                     }
                 }
+
+                _facet2points[0].emplace_back(fidx1, pit0);
+                _facet2points[0].emplace_back(fidx1, pit1);
+                _facet2points[1].emplace_back(fidx2, pit0);
+                _facet2points[1].emplace_back(fidx2, pit1);
+            }
+            else {
+                PointIndex pit = _cutPoints.Insert(mp0);
+
+                // do not insert a facet when only one corner point cuts the
+                // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
+                // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
+                {
+                    facetsCuttingEdge0[fidx1] = true;
+                    _facet2points[0].emplace_back(fidx1, pit);
+                }
+
+                // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
+                // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
+                {
+                    facetsCuttingEdge1[fidx2] = true;
+                    _facet2points[1].emplace_back(fidx2, pit);
+                }
             }
         }
     }
@@ -292,126 +329,167 @@ void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<Facet
 
 void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
 {
-    // Triangulate Mesh
-    std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator>>::iterator it1;
-    for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1) {
-        std::vector<Vector3f> points;
-        std::set<MeshPoint> pointsSet;
-
-        FacetIndex fidx = it1->first;
-        MeshGeomFacet f = cutMesh.GetFacet(fidx);
-
-        // if (side == 1)
-        //     _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0,
-        //     1, 1);
-
-        // facet corner points
-        // const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
-        for (int i = 0; i < 3; i++)  // NOLINT
-        {
-            pointsSet.insert(f._aclPoints[i]);
-            points.push_back(f._aclPoints[i]);
+    // group the cut points by facet, the cut points of a facet keep their order
+    std::vector<std::pair<FacetIndex, PointIndex>>& facet2points = _facet2points[side];
+    std::stable_sort(
+        facet2points.begin(),
+        facet2points.end(),
+        [](const auto& pair1, const auto& pair2) { return pair1.first < pair2.first; }
+    );
+
+    std::vector<std::size_t> groups;
+    for (std::size_t i = 0; i < facet2points.size(); i++) {
+        if (i == 0 || facet2points[i].first != facet2points[i - 1].first) {
+            groups.push_back(i);
         }
+    }
+    groups.push_back(facet2points.size());
 
-        // triangulated facets
-        std::list<std::set<MeshPoint>::iterator>::iterator it2;
-        for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
-            if (pointsSet.find(*(*it2)) == pointsSet.end()) {
-                pointsSet.insert(*(*it2));
-                points.push_back(*(*it2));
-            }
-        }
+    // Triangulate Mesh
+    std::size_t numGroups = groups.size() - 1;
+    std::vector<std::vector<MeshGeomFacet>> triangulations(numGroups);
+    parallel_chunks(numGroups, 64, GetThreads(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t g = begin; g < end; g++) {
+            std::vector<Vector3f> points;
+            std::set<MeshPoint> pointsSet;
 
-        Vector3f normal = f.GetNormal();
-        Vector3f base = points[0];
-        Vector3f dirX = points[1] - points[0];
-        dirX.Normalize();
-        Vector3f dirY = dirX % normal;
-
-        // project points to 2D plane
-        std::vector<Vector3f>::iterator it;
-        std::vector<Vector3f> vertices;
-        for (it = points.begin(); it != points.end(); ++it) {
-            Vector3f pv = *it;
-            pv.TransformToCoordinateSystem(base, dirX, dirY);
-            vertices.push_back(pv);
-        }
+            FacetIndex fidx = facet2points[groups[g]].first;
+            MeshGeomFacet f = cutMesh.GetFacet(fidx);
+
+            // if (side == 1)
+            //     _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3,
+            //     0, 1, 1);
+
+            // facet corner points
+            // const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
+            for (int i = 0; i < 3; i++)  // NOLINT
+            {
+                pointsSet.insert(f._aclPoints[i]);
+                points.push_back(f._aclPoints[i]);
+            }
 
-        DelaunayTriangulator tria;
-        tria.SetPolygon(vertices);
-        tria.TriangulatePolygon();
+            // triangulated facets
+            for (std::size_t i = groups[g]; i < groups[g + 1]; i++) {
+                const Base::Vector3f& pt = _cutPoints[facet2points[i].second];
+                if (pointsSet.find(pt) == pointsSet.end()) {
+                    pointsSet.insert(pt);
+                    points.push_back(pt);
+                }
+            }
 
-        std::vector<MeshFacet> facets = tria.GetFacets();
-        for (auto& it : facets) {
-            if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
-                || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
-                continue;
+            Vector3f normal = f.GetNormal();
+            Vector3f base = points[0];
+            Vector3f dirX = points[1] - points[0];
+            dirX.Normalize();
+            Vector3f dirY = dirX % normal;
+
+            // project points to 2D plane
+            std::vector<Vector3f>::iterator it;
+            std::vector<Vector3f> vertices;
+            for (it = points.begin(); it != points.end(); ++it) {
+                Vector3f pv = *it;
+                pv.TransformToCoordinateSystem(base, dirX, dirY);
+                vertices.push_back(pv);
             }
 
-            MeshGeomFacet facet(
-                points[it._aulPoints[0]],
-                points[it._aulPoints[1]],
-                points[it._aulPoints[2]]
-            );
+            DelaunayTriangulator tria;
+            tria.SetPolygon(vertices);
+            tria.TriangulatePolygon();
 
-            // if (side == 1)
-            //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
-            //  facet._aclPoints[2], true, 3, 0, 1, 1);
-
-            // if (facet.Area() < 0.0001f)
-            //{ // too small facet
-            //   continue;
-            // }
-
-            float dist0 = facet._aclPoints[0].DistanceToLine(
-                facet._aclPoints[1],
-                facet._aclPoints[1] - facet._aclPoints[2]
-            );
-            float dist1 = facet._aclPoints[1].DistanceToLine(
-                facet._aclPoints[0],
-                facet._aclPoints[0] - facet._aclPoints[2]
-            );
-            float dist2 = facet._aclPoints[2].DistanceToLine(
-                facet._aclPoints[0],
-                facet._aclPoints[0] - facet._aclPoints[1]
-            );
-
-            if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
-                || (dist2 < _minDistanceToPoint)) {
-                continue;
+            // the triangles come in the order of their addresses, so sort them to get the same
+            // result for each run
+            std::vector<MeshFacet> facets = tria.GetFacets();
+            for (auto& it : facets) {
+                auto first = std::min_element(std::begin(it._aulPoints), std::end(it._aulPoints));
+                std::rotate(std::begin(it._aulPoints), first, std::end(it._aulPoints));
             }
+            std::sort(facets.begin(), facets.end(), [](const MeshFacet& f1, const MeshFacet& f2) {
+                return std::lexicographical_compare(
+                    std::begin(f1._aulPoints),
+                    std::end(f1._aulPoints),
+                    std::begin(f2._aulPoints),
+                    std::end(f2._aulPoints)
+                );
+            });
+            for (auto& it : facets) {
+                if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
+                    || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
+                    continue;
+                }
 
-            // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-            // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-            // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+                MeshGeomFacet facet(
+                    points[it._aulPoints[0]],
+                    points[it._aulPoints[1]],
+                    points[it._aulPoints[2]]
+                );
 
-            // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
-            // _minDistanceToPoint))
-            //{
-            //   continue;
-            // }
+                // if (side == 1)
+                //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
+                //  facet._aclPoints[2], true, 3, 0, 1, 1);
+
+                // if (facet.Area() < 0.0001f)
+                //{ // too small facet
+                //   continue;
+                // }
+
+                float dist0 = facet._aclPoints[0].DistanceToLine(
+                    facet._aclPoints[1],
+                    facet._aclPoints[1] - facet._aclPoints[2]
+                );
+                float dist1 = facet._aclPoints[1].DistanceToLine(
+                    facet._aclPoints[0],
+                    facet._aclPoints[0] - facet._aclPoints[2]
+                );
+                float dist2 = facet._aclPoints[2].DistanceToLine(
+                    facet._aclPoints[0],
+                    facet._aclPoints[0] - facet._aclPoints[1]
+                );
+
+                if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
+                    || (dist2 < _minDistanceToPoint)) {
+                    continue;
+                }
+
+                // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
+                // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
+                // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+
+                // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
+                // _minDistanceToPoint))
+                //{
+                //   continue;
+                // }
 
-            facet.CalcNormal();
-            if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
-                std::swap(facet._aclPoints[0], facet._aclPoints[1]);
                 facet.CalcNormal();
-            }
+                if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
+                    std::swap(facet._aclPoints[0], facet._aclPoints[1]);
+                    facet.CalcNormal();
+                }
 
+                triangulations[g].push_back(facet);
+            }
+        }
+    });
 
+    // the facets are attached to the cut edges in the order of the facets
+    for (std::size_t g = 0; g < numGroups; g++) {
+        FacetIndex fidx = facet2points[groups[g]].first;
+        for (auto& facet : triangulations[g]) {
             for (int j = 0; j < 3; j++) {
-                auto eit = _edges.find(Edge(facet._aclPoints[j], facet._aclPoints[(j + 1) % 3]));
+                EdgeInfo* info = FindEdge(facet._aclPoints[j], facet._aclPoints[(j + 1) % 3]);
 
-                if (eit != _edges.end()) {
+                if (info) {
 
-                    if (eit->second.fcounter[side] < 2) {
+                    if (info->fcounter[side] < 2) {
                         // if (side == 0)
                         //    _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
                         //    facet._aclPoints[2], true, 3, 0, 1, 1);
 
-                        eit->second.facet[side] = fidx;
-                        eit->second.facets[side][eit->second.fcounter[side]] = facet;
-                        eit->second.fcounter[side]++;
-                        facet.SetFlag(MeshFacet::MARKED);  // set all facets connected to an edge: MARKED
+                        info->facet[side] = fidx;
+                        info->facets[side][info->fcounter[side]] = facet;
+                        info->fcounter[side]++;
+                        // set all facets connected to an edge: MARKED
+                        facet.SetFlag(MeshFacet::MARKED);
                     }
                 }
             }
@@ -421,15 +499,14 @@ void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
     }
 }
 
-void SetOperations::CollectFacets(int side, float mult)
+void SetOperations::CreateMesh(int side, MeshKernel& mesh) const
 {
     // float distSave = MeshDefinitions::_fMinPointDistance;
     // MeshDefinitions::SetMinPointDistance(1.0e-4f);
 
-    MeshKernel mesh;
     MeshBuilder mb(mesh);
     mb.Initialize(_newMeshFacets[side].size());
-    std::vector<MeshGeomFacet>::iterator it;
+    std::vector<MeshGeomFacet>::const_iterator it;
     for (it = _newMeshFacets[side].begin(); it != _newMeshFacets[side].end(); ++it) {
         // if (it->IsFlag(MeshFacet::MARKED))
         //{
@@ -440,6 +517,11 @@ void SetOperations::CollectFacets(int side, float mult)
     }
     mb.Finish();
 
+    // MeshDefinitions::SetMinPointDistance(distSave);
+}
+
+void SetOperations::CollectFacets(MeshKernel& mesh, int side, float mult)
+{
     MeshAlgorithm algo(mesh);
     algo.ResetFacetFlag(static_cast<MeshFacet::TFlagType>(MeshFacet::VISIT | MeshFacet::TMP0));
 
@@ -451,7 +533,7 @@ void SetOperations::CollectFacets(int side, float mult)
         if (!itf->IsFlag(MeshFacet::VISIT)) {  // Facet found, visit neighbours
             std::vector<FacetIndex> facets;
             facets.push_back(itf - rFacets.begin());  // add seed facet
-            CollectFacetVisitor visitor(mesh, facets, _edges, side, mult, _builder);
+            CollectFacetVisitor visitor(mesh, facets, *this, side, mult, _builder);
             mesh.VisitNeighbourFacets(visitor, itf - rFacets.begin());
 
             if (visitor._addFacets == 0) {  // mark all facets to add it to the result
@@ -466,21 +548,133 @@ void SetOperations::CollectFacets(int side, float mult)
             _facetsOf[side].push_back(mesh.GetFacet(*itf));
         }
     }
+}
 
-    // MeshDefinitions::SetMinPointDistance(distSave);
+std::uint64_t SetOperations::EdgeKey(PointIndex pt1, PointIndex pt2)
+{
+    // there are never 2^32 cut points
+    if (pt2 < pt1) {
+        std::swap(pt1, pt2);
+    }
+    return (static_cast<std::uint64_t>(pt1) << 32) | static_cast<std::uint64_t>(pt2);
+}
+
+SetOperations::EdgeInfo* SetOperations::FindEdge(
+    const Base::Vector3f& pt1,
+    const Base::Vector3f& pt2
+)
+{
+    return const_cast<EdgeInfo*>(static_cast<const SetOperations*>(this)->FindEdge(pt1, pt2));
+}
+
+const SetOperations::EdgeInfo* SetOperations::FindEdge(
+    const Base::Vector3f& pt1,
+    const Base::Vector3f& pt2
+) const
+{
+    PointIndex index1 = _cutPoints.Find(pt1);
+    PointIndex index2 = _cutPoints.Find(pt2);
+    if (index1 == POINT_INDEX_MAX || index2 == POINT_INDEX_MAX || index1 == index2) {
+        return nullptr;
+    }
+
+    auto it = _edges.find(EdgeKey(index1, index2));
+    return it != _edges.end() ? &it->second : nullptr;
+}
+
+std::size_t SetOperations::CutPoints::CellHash::operator()(const Cell& cell) const
+{
+    auto x = static_cast<std::uint64_t>(cell.x);
+    auto y = static_cast<std::uint64_t>(cell.y);
+    auto z = static_cast<std::uint64_t>(cell.z);
+    return static_cast<std::size_t>(
+        (x * 0x9E3779B97F4A7C15ULL) ^ (y * 0xC2B2AE3D27D4EB4FULL) ^ (z * 0x165667B19E3779F9ULL)
+    );
+}
+
+SetOperations::CutPoints::Cell SetOperations::CutPoints::GetCell(
+    const Base::Vector3f& pt,
+    double offset
+) const
+{
+    return {
+        static_cast<std::int64_t>(std::floor((static_cast<double>(pt.x) + offset) / _cellSize)),
+        static_cast<std::int64_t>(std::floor((static_cast<double>(pt.y) + offset) / _cellSize)),
+        static_cast<std::int64_t>(std::floor((static_cast<double>(pt.z) + offset) / _cellSize))
+    };
+}
+
+PointIndex SetOperations::CutPoints::Find(const Base::Vector3f& pt) const
+{
+    if (_points.empty()) {
+        return POINT_INDEX_MAX;
+    }
+
+    // like std::set<MeshPoint> return the first added point if there are several ones
+    Cell lo = GetCell(pt, -static_cast<double>(_tolerance));
+    Cell hi = GetCell(pt, static_cast<double>(_tolerance));
+    PointIndex index = POINT_INDEX_MAX;
+    for (std::int64_t x = lo.x; x <= hi.x; x++) {
+        for (std::int64_t y = lo.y; y <= hi.y; y++) {
+            for (std::int64_t z = lo.z; z <= hi.z; z++) {
+                auto it = _cells.find(Cell {x, y, z});
+                if (it == _cells.end()) {
+                    continue;
+                }
+                for (PointIndex i = it->second; i != POINT_INDEX_MAX; i = _next[i]) {
+                    const Base::Vector3f& p = _points[i];
+                    if (i < index && std::fabs(p.x - pt.x) < _tolerance
+                        && std::fabs(p.y - pt.y) < _tolerance
+                        && std::fabs(p.z - pt.z) < _tolerance) {
+                        index = i;
+                    }
+                }
+            }
+        }
+    }
+
+    return index;
+}
+
+PointIndex SetOperations::CutPoints::Insert(const Base::Vector3f& pt)
+{
+    if (_points.empty()) {
+        // same tolerance as the comparison operators of MeshPoint
+        _tolerance = MeshDefinitions::_fMinPointDistanceD1;
+        _cellSize = std::max(4.0 * static_cast<double>(_tolerance), 1.0e-6);
+    }
+    else {
+        PointIndex index = Find(pt);
+        if (index != POINT_INDEX_MAX) {
+            return index;
+        }
+    }
+
+    auto index = static_cast<PointIndex>(_points.size());
+    _points.push_back(pt);
+    auto it = _cells.try_emplace(GetCell(pt, 0.0), index);
+    if (it.second) {
+        _next.push_back(POINT_INDEX_MAX);
+    }
+    else {
+        _next.push_back(it.first->second);
+        it.first->second = index;
+    }
+
+    return index;
 }
 
 SetOperations::CollectFacetVisitor::CollectFacetVisitor(
     const MeshKernel& mesh,
     std::vector<FacetIndex>& facets,
-    std::map<Edge, EdgeInfo>& edges,
+    const SetOperations& setOp,
     int side,
     float mult,
     Base::Builder3D& builder
 )
     : _facets(facets)
     , _mesh(mesh)
-    , _edges(edges)
+    , _setOp(setOp)
     , _side(side)
     , _mult(mult)
     , _builder(builder)
@@ -515,24 +709,22 @@ bool SetOperations::CollectFacetVisitor::AllowVisit(
         // facet connected to an edge
         PointIndex pt0 = rclFrom._aulPoints[neighbourIndex],
                    pt1 = rclFrom._aulPoints[(neighbourIndex + 1) % 3];
-        Edge edge(_mesh.GetPoint(pt0), _mesh.GetPoint(pt1));
-
-        std::map<Edge, EdgeInfo>::iterator it = _edges.find(edge);
+        const EdgeInfo* info = _setOp.FindEdge(_mesh.GetPoint(pt0), _mesh.GetPoint(pt1));
 
-        if (it != _edges.end()) {
+        if (info) {
             if (_addFacets == -1) {
                 // determine if the facets should add or not only once
                 MeshGeomFacet facet = _mesh.GetFacet(rclFrom);               // triangulated facet
-                MeshGeomFacet facetOther = it->second.facets[1 - _side][0];  // triangulated facet
-                                                                             // from same edge and
-                                                                             // other mesh
+                MeshGeomFacet facetOther = info->facets[1 - _side][0];  // triangulated facet
+                                                                        // from same edge and
+                                                                        // other mesh
                 Vector3f normalOther = facetOther.GetNormal();
                 // Vector3f normal = facet.GetNormal();
 
-                Vector3f edgeDir = it->first.pt1 - it->first.pt2;
-                Vector3f ocDir = (edgeDir % (facet.GetGravityPoint() - it->first.pt1)) % edgeDir;
+                Vector3f edgeDir = info->pt1 - info->pt2;
+                Vector3f ocDir = (edgeDir % (facet.GetGravityPoint() - info->pt1)) % edgeDir;
                 ocDir.Normalize();
-                Vector3f ocDirOther = (edgeDir % (facetOther.GetGravityPoint() - it->first.pt1))
+                Vector3f ocDirOther = (edgeDir % (facetOther.GetGravityPoint() - info->pt1))
                     % edgeDir;
                 ocDirOther.Normalize();
 
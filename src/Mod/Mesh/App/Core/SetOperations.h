@@ -24,9 +24,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
-#include <map>
-#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <Base/Builder3D.h>
 
@@ -78,6 +79,11 @@ public:
      * polyline goes direct to the point
      */
     void Do();
+    /// Limits the number of threads used by Do(), 0 means one per hardware thread
+    void SetMaxThreads(std::size_t threads)
+    {
+        _maxThreads = threads;
+    }
 
 private:
     const MeshKernel& _cutMesh0;  /** Mesh for set operations source 1 */
@@ -85,71 +91,68 @@ private:
     MeshKernel& _resultMesh;      /** Result mesh */
     OperationType _operationType; /** Set Operation Type */
     float _minDistanceToPoint;    /** Minimal distance to facet corner points */
+    std::size_t _maxThreads {0};  /** Maximum number of threads, 0 for all */
 
 private:
-    // Helper class cutting edge to its two attached facets
-    class Edge
+    // Welds the points of the cut within the tolerance of MeshPoint::operator<
+    class CutPoints
     {
     public:
-        MeshPoint pt1, pt2;  // edge
-
-        Edge() = default;
-
-        Edge(MeshPoint p1, MeshPoint p2)
+        /// Returns the index of the point equal to \a pt and adds \a pt if there is none
+        PointIndex Insert(const Base::Vector3f& pt);
+        /// Returns the index of the point equal to \a pt or POINT_INDEX_MAX
+        PointIndex Find(const Base::Vector3f& pt) const;
+        const Base::Vector3f& operator[](PointIndex index) const
         {
-            if (p1 < p2) {
-                pt1 = p1;
-                pt2 = p2;
-            }
-            else {
-                pt2 = p1;
-                pt1 = p2;
-            }
+            return _points[index];
         }
 
-        bool operator==(const Edge& edge) const
+    private:
+        struct Cell
         {
-            return (pt1 == edge.pt1) && (pt2 == edge.pt2);
-        }
-
-        bool operator<(const Edge& edge) const
+            std::int64_t x, y, z;
+            bool operator==(const Cell& cell) const
+            {
+                return x == cell.x && y == cell.y && z == cell.z;
+            }
+        };
+        struct CellHash
         {
-            return (pt1 == edge.pt1) ? (pt2 < edge.pt2) : (pt1 < edge.pt1);
-        }
+            std::size_t operator()(const Cell& cell) const;
+        };
+
+        Cell GetCell(const Base::Vector3f& pt, double offset) const;
+
+        float _tolerance {0.0F};
+        double _cellSize {1.0};
+        std::vector<Base::Vector3f> _points;
+        std::vector<PointIndex> _next;  // next point in the same cell
+        std::unordered_map<Cell, PointIndex, CellHash> _cells;
     };
 
     class EdgeInfo
     {
     public:
+        MeshPoint pt1, pt2;          // end points of the cut edge
         int fcounter[2] {};          // counter of facets attacted to the edge
         MeshGeomFacet facets[2][2];  // Geom-Facets attached to the edge
         FacetIndex facet[2] {};      // underlying Facet-Index
     };
 
-    // class CollectFacetVisitor : public MeshFacetVisitor
-    //{
-    //   public:
-    //     std::vector<unsigned long> &_facets;
-    //     MeshKernel                 &_mesh;
-    //     std::map<Edge, EdgeInfo>   &_edges;
-    //     int                         _side;
-    //     float                       _mult;
-    //     int                         _addFacets; // 0: add facets to the result 1: do not add
-    //     facets to the result Base::Builder3D& _builder;
-
-    //    CollectFacetVisitor (MeshKernel& mesh, std::vector<unsigned long>& facets, std::map<Edge,
-    //    EdgeInfo>& edges, int side, float mult, Base::Builder3D& builder); bool Visit (MeshFacet
-    //    &rclFacet, const MeshFacet &rclFrom, unsigned long ulFInd, unsigned long ulLevel); bool
-    //    AllowVisit (MeshFacet& rclFacet, MeshFacet& rclFrom, unsigned long ulFInd, unsigned long
-    //    ulLevel, unsigned short neighbourIndex);
-    //};
+    // Cut line of a facet of mesh 1 with a facet of mesh 2
+    struct Section
+    {
+        FacetIndex facet0;
+        FacetIndex facet1;
+        MeshPoint p0, p1;
+    };
 
     class CollectFacetVisitor: public MeshFacetVisitor
     {
     public:
         std::vector<FacetIndex>& _facets;
         const MeshKernel& _mesh;
-        std::map<Edge, EdgeInfo>& _edges;
+        const SetOperations& _setOp;
         int _side;
         float _mult;
         int _addFacets {-1};  // 0: add facets to the result 1: do not add facets to the result
@@ -158,7 +161,7 @@ private:
         CollectFacetVisitor(
             const MeshKernel& mesh,
             std::vector<FacetIndex>& facets,
-            std::map<Edge, EdgeInfo>& edges,
+            const SetOperations& setOp,
             int side,
             float mult,
             Base::Builder3D& builder
@@ -179,25 +182,33 @@ private:
     };
 
     /** all points from cut */
-    std::set<MeshPoint> _cutPoints;
-    /** all edges */
-    std::map<Edge, EdgeInfo> _edges;
-    /** map from facet index to its cut points (mesh 1 and mesh 2) Key: Facet-Index  Value: List of
-     * iterators of set<MeshPoint> */
-    std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator>> _facet2points[2];
+    CutPoints _cutPoints;
+    /** all edges, the key is made of the indices of the cut points */
+    std::unordered_map<std::uint64_t, EdgeInfo> _edges;
+    /** pairs of facet index and cut point index (mesh 1 and mesh 2) */
+    std::vector<std::pair<FacetIndex, PointIndex>> _facet2points[2];
     /** Facets collected from region growing */
     std::vector<MeshGeomFacet> _facetsOf[2];
 
     std::vector<MeshGeomFacet> _newMeshFacets[2];
 
+    /** Returns the edge between the cut points \a pt1 and \a pt2 or null if there is none */
+    EdgeInfo* FindEdge(const Base::Vector3f& pt1, const Base::Vector3f& pt2);
+    const EdgeInfo* FindEdge(const Base::Vector3f& pt1, const Base::Vector3f& pt2) const;
+    static std::uint64_t EdgeKey(PointIndex pt1, PointIndex pt2);
+
     /** Cut mesh 1 with mesh 2 */
-    void Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1);
+    void Cut(std::vector<bool>& facetsCuttingEdge0, std::vector<bool>& facetsCuttingEdge1);
     /** Trianglute each facets cut with its cutting points */
     void TriangulateMesh(const MeshKernel& cutMesh, int side);
+    /** create the mesh of the facets of one side from which the facets are collected */
+    void CreateMesh(int side, MeshKernel& mesh) const;
     /** search facets for adding (with region growing) */
-    void CollectFacets(int side, float mult);
+    void CollectFacets(MeshKernel& mesh, int side, float mult);
     /** close gap in the mesh */
     void CloseGaps(MeshBuilder& meshBuilder);
+    /** the number of threads to use */
+    std::size_t GetThreads() const;
 
     /** visual debugger */
     Base::Builder3D _builder;
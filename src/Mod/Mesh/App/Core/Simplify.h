@@ -12,7 +12,10 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add locked vertices, a maximum error, a progress callback and the option to keep quadrics
 
+#include <functional>
+#include <limits>
 #include <vector>
 
 using vec3f = Base::Vector3f;
@@ -82,12 +85,22 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;int id=-1;};
     struct Ref { int tid,tvertex; };
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
     std::vector<Ref> refs;
 
+    // locked vertices are neither moved nor removed
+    bool lock_border = false;
+    // maximum quadric error of a collapse
+    double max_error = std::numeric_limits<double>::max();
+    // if false the quadrics of the vertices are taken as they are
+    bool init_quadrics = true;
+    // called with the done fraction, returning false stops the simplification
+    std::function<bool(double)> progress;
+    bool canceled = false;
+
     void simplify_mesh(int target_count, double tolerance, double aggressiveness=7);
 
 private:
@@ -136,6 +149,12 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
         if (triangle_count-deleted_triangles<=target_count)
             break;
 
+        if (progress && !progress(double(deleted_triangles)/double(std::max(triangle_count-target_count,1))))
+        {
+            canceled = true;
+            break;
+        }
+
         // update mesh once in a while
         if (iteration%5==0)
         {
@@ -196,9 +215,14 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     if (v0.border != v1.border)
                         continue;
 
+                    // Lock check
+                    if (v0.locked || v1.locked)
+                        continue;
+
                     // Compute vertex to collapse to
                     vec3f p;
-                    calculate_error(i0,i1,p);
+                    if (calculate_error(i0,i1,p) > max_error)
+                        continue;
 
                     deleted0.resize(v0.tcount); // normals temporarily
                     deleted1.resize(v1.tcount); // normals temporarily
@@ -343,8 +367,11 @@ void Simplify::update_mesh(int iteration)
     //
     if (iteration == 0)
     {
-        for (std::size_t i=0;i<vertices.size();++i)
-            vertices[i].q=SymmetricMatrix(0.0);
+        if (init_quadrics)
+        {
+            for (std::size_t i=0;i<vertices.size();++i)
+                vertices[i].q=SymmetricMatrix(0.0);
+        }
 
         for (std::size_t i=0;i<triangles.size();++i)
         {
@@ -355,6 +382,8 @@ void Simplify::update_mesh(int iteration)
             n = (p[1]-p[0]).Cross(p[2]-p[0]);
             n.Normalize();
             t.n=n;
+            if (!init_quadrics)
+                continue;
             for (std::size_t j=0;j<3;++j)
                 vertices[t.v[j]].q = vertices[t.v[j]].q+SymmetricMatrix(n.x,n.y,n.z,-n.Dot(p[0]));
         }
@@ -445,6 +474,14 @@ void Simplify::update_mesh(int iteration)
                     vertices[vids[j]].border=1;
             }
         }
+
+        if (lock_border)
+        {
+            for (std::size_t i=0;i<vertices.size();++i) {
+                if (vertices[i].border)
+                    vertices[i].locked=1;
+            }
+        }
     }
 }
 
@@ -476,6 +513,9 @@ void Simplify::compact_mesh()
         {
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
+            vertices[dst].q=vertices[i].q;
+            vertices[dst].locked=vertices[i].locked;
+            vertices[dst].id=vertices[i].id;
             dst++;
         }
     }
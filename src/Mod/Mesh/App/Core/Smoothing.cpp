@@ -23,12 +23,14 @@
  ***************************************************************************/
 
 #include <cmath>
-
+#include <functional>
+#include <thread>
 
 #include <Base/Tools.h>
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
@@ -36,6 +38,12 @@
 
 using namespace MeshCore;
 
+namespace
+{
+// Smaller ranges are not worth a thread of their own
+constexpr std::size_t MinChunkSize = 4096;
+}  // namespace
+
 
 AbstractSmoothing::AbstractSmoothing(MeshKernel& m)
     : kernel(m)
@@ -168,101 +176,131 @@ LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(
-    const MeshRefPointToPoints& vv_it,
-    const MeshRefPointToFacets& vf_it,
-    double stepsize
-)
+LaplaceSmoothing::Adjacency LaplaceSmoothing::BuildAdjacency() const
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
+    const MeshFacetArray& facets = kernel.GetFacets();
+    std::size_t numPoints = kernel.CountPoints();
+
+    // every facet adds its three edges in both directions, sorting and removing duplicates
+    // gives the neighbours of every point in ascending order like MeshRefPointToPoints
+    std::vector<std::pair<PointIndex, PointIndex>> edges(6 * facets.size());
+    MeshCore::parallel_chunks(facets.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const PointIndex* pts = facets[i]._aulPoints;
+            auto* edge = &edges[6 * i];
+            edge[0] = {pts[0], pts[1]};
+            edge[1] = {pts[0], pts[2]};
+            edge[2] = {pts[1], pts[0]};
+            edge[3] = {pts[1], pts[2]};
+            edge[4] = {pts[2], pts[0]};
+            edge[5] = {pts[2], pts[1]};
+        }
+    });
+
+    int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_sort(edges.begin(), edges.end(), std::less<>(), threads);
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    Adjacency adj;
+    adj.offsets.resize(numPoints + 1, 0);
+    adj.points.reserve(edges.size());
+    for (const auto& edge : edges) {
+        adj.offsets[edge.first + 1]++;
+        adj.points.push_back(edge.second);
+    }
+    for (std::size_t i = 0; i < numPoints; i++) {
+        adj.offsets[i + 1] += adj.offsets[i];
+    }
 
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
+    // the facets around a point, counted like MeshRefPointToFacets
+    std::vector<PointIndex> numFacets(numPoints, 0);
+    for (const auto& facet : facets) {
+        const PointIndex* pts = facet._aulPoints;
+        numFacets[pts[0]]++;
+        if (pts[1] != pts[0]) {
+            numFacets[pts[1]]++;
         }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
+        if (pts[2] != pts[0] && pts[2] != pts[1]) {
+            numFacets[pts[2]]++;
         }
+    }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+    adj.fixed.resize(numPoints);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        PointIndex count = adj.offsets[i + 1] - adj.offsets[i];
+        // a border point has one neighbour more than facets
+        adj.fixed[i] = count < 3 || (fixBorder && count != numFacets[i]);
+    }
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
-        }
+    return adj;
+}
 
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
+void LaplaceSmoothing::Umbrella(const Adjacency& adj, double stepsize)
+{
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<PointIndex>(0));
+    Umbrella(adj, stepsize, point_indices);
 }
 
 void LaplaceSmoothing::Umbrella(
-    const MeshRefPointToPoints& vv_it,
-    const MeshRefPointToFacets& vf_it,
+    const Adjacency& adj,
     double stepsize,
     const std::vector<PointIndex>& point_indices
 )
 {
+    // Jacobi step: the new positions only depend on the old ones so that the points can be
+    // handled in parallel
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
+    std::vector<Base::Vector3f> moved(point_indices.size());
+    std::size_t count = point_indices.size();
+    MeshCore::parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            PointIndex pos = point_indices[i];
+            const MeshPoint& pnt = points[pos];
+            if (adj.fixed[pos]) {
+                moved[i] = pnt;
+                continue;
+            }
 
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
+            PointIndex first = adj.offsets[pos];
+            PointIndex last = adj.offsets[pos + 1];
+            double w = 1.0 / double(last - first);
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+            double delx = 0.0, dely = 0.0, delz = 0.0;
+            for (PointIndex j = first; j < last; j++) {
+                const MeshPoint& nbr = points[adj.points[j]];
+                delx += w * static_cast<double>(nbr.x - pnt.x);
+                dely += w * static_cast<double>(nbr.y - pnt.y);
+                delz += w * static_cast<double>(nbr.z - pnt.z);
+            }
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
+            moved[i].x = static_cast<float>(static_cast<double>(pnt.x) + stepsize * delx);
+            moved[i].y = static_cast<float>(static_cast<double>(pnt.y) + stepsize * dely);
+            moved[i].z = static_cast<float>(static_cast<double>(pnt.z) + stepsize * delz);
         }
+    });
 
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
+    for (std::size_t i = 0; i < count; i++) {
+        const Base::Vector3f& pnt = moved[i];
+        kernel.SetPoint(point_indices[i], pnt.x, pnt.y, pnt.z);
     }
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    Adjacency adj = BuildAdjacency();
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        Umbrella(adj, lambda);
     }
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    Adjacency adj = BuildAdjacency();
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(adj, lambda, point_indices);
     }
 }
 
@@ -272,27 +310,25 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    Adjacency adj = BuildAdjacency();
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda());
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro));
+        Umbrella(adj, GetLambda());
+        Umbrella(adj, -(GetLambda() + micro));
     }
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    Adjacency adj = BuildAdjacency();
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda(), point_indices);
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro), point_indices);
+        Umbrella(adj, GetLambda(), point_indices);
+        Umbrella(adj, -(GetLambda() + micro), point_indices);
     }
 }
 
@@ -357,66 +393,81 @@ void MedianFilterSmoothing::UpdatePoints(
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
     const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
 
-    // Initialize the array with the real normals
-    std::vector<Base::Vector3d> faceNormals;
-    faceNormals.reserve(facets.size());
-    MeshCore::MeshFacetIterator iter(kernel);
-    for (iter.Init(); iter.More(); iter.Next()) {
-        faceNormals.emplace_back(Base::toVector<double>(iter->GetNormal()));
-    }
+    // Initialize the arrays with the real normals, the areas and centers
+    std::size_t numFacets = facets.size();
+    std::vector<Base::Vector3d> realNormals(numFacets);
+    std::vector<Base::Vector3d> centers(numFacets);
+    std::vector<double> areas(numFacets);
+    MeshCore::parallel_chunks(numFacets, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t pos = begin; pos < end; pos++) {
+            MeshCore::MeshGeomFacet face = kernel.GetFacet(pos);
+            realNormals[pos] = Base::toVector<double>(face.GetNormal());
+            centers[pos] = Base::toVector<double>(face.GetGravityPoint());
+            areas[pos] = face.Area();
+        }
+    });
 
     // Step 1: determine face normals
-    for (FacetIndex pos = 0; pos < facets.size(); pos++) {
-        iter.Set(pos);
-        Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
-        const MeshCore::MeshFacet& facet = facets[pos];
-
+    std::vector<Base::Vector3d> faceNormals(numFacets);
+    MeshCore::parallel_chunks(numFacets, MinChunkSize, [&](std::size_t begin, std::size_t end) {
         std::vector<AngleNormal> anglesWithFaces;
-        for (auto fi : cv) {
-            iter.Set(fi);
-            Base::Vector3d faceNormal = Base::toVector<double>(iter->GetNormal());
-            double angle = refNormal.GetAngle(faceNormal);
-
-            int absWeight = std::abs(weights);
-            if (absWeight > 1 && facet.IsNeighbour(fi)) {
-                if (weights < 0) {
-                    angle = -angle;
+        for (std::size_t pos = begin; pos < end; pos++) {
+            const Base::Vector3d& refNormal = realNormals[pos];
+            const std::set<FacetIndex>& cv = ff_it[pos];
+            const MeshCore::MeshFacet& facet = facets[pos];
+
+            anglesWithFaces.clear();
+            for (auto fi : cv) {
+                const Base::Vector3d& faceNormal = realNormals[fi];
+                double angle = refNormal.GetAngle(faceNormal);
+
+                int absWeight = std::abs(weights);
+                if (absWeight > 1 && facet.IsNeighbour(fi)) {
+                    if (weights < 0) {
+                        angle = -angle;
+                    }
+                    for (int i = 0; i < absWeight; i++) {
+                        anglesWithFaces.emplace_back(angle, faceNormal);
+                    }
                 }
-                for (int i = 0; i < absWeight; i++) {
+                else {
                     anglesWithFaces.emplace_back(angle, faceNormal);
                 }
             }
-            else {
-                anglesWithFaces.emplace_back(angle, faceNormal);
-            }
-        }
 
-        faceNormals[pos] = find_median(anglesWithFaces);
-    }
+            faceNormals[pos] = find_median(anglesWithFaces);
+        }
+    });
 
     // Step 2: move vertices
-    for (auto pos : point_indices) {
-        Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
-
-        double totalArea = 0.0;
-        Base::Vector3d totalvT;
-        for (auto it : cv) {
-            iter.Set(it);
-
-            double faceArea = iter->Area();
-            totalArea += faceArea;
-
-            Base::Vector3d C = Base::toVector<double>(iter->GetGravityPoint());
+    std::vector<Base::Vector3d> moved(point_indices.size());
+    MeshCore::parallel_chunks(
+        point_indices.size(),
+        MinChunkSize,
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                PointIndex pos = point_indices[i];
+                Base::Vector3d P = Base::toVector<double>(points[pos]);
+                const std::set<FacetIndex>& cv = vf_it[pos];
+
+                double totalArea = 0.0;
+                Base::Vector3d totalvT;
+                for (auto it : cv) {
+                    double faceArea = areas[it];
+                    totalArea += faceArea;
+
+                    Base::Vector3d PC = centers[it] - P;
+                    Base::Vector3d mT = faceNormals[it];
+                    Base::Vector3d vT = (PC * mT) * mT;
+                    totalvT += vT * faceArea;
+                }
 
-            Base::Vector3d PC = C - P;
-            Base::Vector3d mT = faceNormals[it];
-            Base::Vector3d vT = (PC * mT) * mT;
-            totalvT += vT * faceArea;
+                moved[i] = P + totalvT / totalArea;
+            }
         }
+    );
 
-        P = P + totalvT / totalArea;
-        kernel.SetPoint(pos, Base::toVector<float>(P));
+    for (std::size_t i = 0; i < point_indices.size(); i++) {
+        kernel.SetPoint(point_indices[i], Base::toVector<float>(moved[i]));
     }
 }
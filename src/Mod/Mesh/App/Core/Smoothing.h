@@ -106,18 +106,33 @@ public:
     {
         return lambda;
     }
+    /** If \a on is true (the default) the border points keep their position. */
+    void SetFixedBorder(bool on)
+    {
+        fixBorder = on;
+    }
+    bool GetFixedBorder() const
+    {
+        return fixBorder;
+    }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(
-        const MeshRefPointToPoints&,
-        const MeshRefPointToFacets&,
-        double,
-        const std::vector<PointIndex>&
-    );
+    /** The neighbour points of all points in compressed sparse row format. */
+    struct Adjacency
+    {
+        /// the neighbours of point i are points[offsets[i]] up to points[offsets[i + 1] - 1]
+        std::vector<PointIndex> offsets;
+        std::vector<PointIndex> points;
+        /// the points that are not moved
+        std::vector<bool> fixed;
+    };
+    Adjacency BuildAdjacency() const;
+    void Umbrella(const Adjacency&, double);
+    void Umbrella(const Adjacency&, double, const std::vector<PointIndex>&);
 
 private:
     double lambda {0.6307};
+    bool fixBorder {true};
 };
 
 class MeshExport TaubinSmoothing: public LaplaceSmoothing
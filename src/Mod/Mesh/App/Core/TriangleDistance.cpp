@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <cmath>
+#include <limits>
+
+#include "Elements.h"
+#include "TriangleDistance.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// The maximum distance as squared distance that keeps infinity
+float squared(float dist)
+{
+    return dist < std::sqrt(std::numeric_limits<float>::max())
+        ? dist * dist
+        : std::numeric_limits<float>::infinity();
+}
+
+}  // namespace
+
+MeshNearestFacetSearch::MeshNearestFacetSearch(const Base::Vector3f& rclPt, float fMaxDist)
+    : pnt {rclPt.x, rclPt.y, rclPt.z}
+    , best(squared(fMaxDist))
+{}
+
+void MeshNearestFacetSearch::AddFacet(const MeshGeomFacet& rclFacet, FacetIndex ulIndex)
+{
+    AddFacet(rclFacet._aclPoints[0], rclFacet._aclPoints[1], rclFacet._aclPoints[2], ulIndex);
+}
+
+void MeshNearestFacetSearch::AddFacet(
+    const Base::Vector3f& rclP0,
+    const Base::Vector3f& rclP1,
+    const Base::Vector3f& rclP2,
+    FacetIndex ulIndex
+)
+{
+    block.set(count, rclP0, rclP1, rclP2);
+    index[count] = ulIndex;
+    if (++count == Lanes) {
+        testBlock();
+    }
+}
+
+FacetIndex MeshNearestFacetSearch::NearestFacet(float& rfDist)
+{
+    if (count > 0) {
+        testBlock();
+    }
+    if (facet != FACET_INDEX_MAX) {
+        rfDist = std::sqrt(best);
+    }
+    return facet;
+}
+
+void MeshNearestFacetSearch::testBlock()
+{
+    float dist2[Lanes];
+    block.distance2(pnt, dist2);
+    for (int i = 0; i < count; i++) {
+        if (dist2[i] < best) {
+            best = dist2[i];
+            facet = index[i];
+        }
+    }
+    count = 0;
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshFacetBatch::Clear()
+{
+    blocks.clear();
+    indices.clear();
+    numFacets = 0;
+}
+
+void MeshFacetBatch::AddFacet(const MeshGeomFacet& rclFacet, FacetIndex ulIndex)
+{
+    AddFacet(rclFacet._aclPoints[0], rclFacet._aclPoints[1], rclFacet._aclPoints[2], ulIndex);
+}
+
+void MeshFacetBatch::AddFacet(
+    const Base::Vector3f& rclP0,
+    const Base::Vector3f& rclP1,
+    const Base::Vector3f& rclP2,
+    FacetIndex ulIndex
+)
+{
+    int lane = static_cast<int>(numFacets % Lanes);
+    if (lane == 0) {
+        // the unused lanes repeat the first facet and thus never win
+        blocks.emplace_back();
+        for (int i = 0; i < Lanes; i++) {
+            blocks.back().set(i, rclP0, rclP1, rclP2);
+            indices.push_back(ulIndex);
+        }
+    }
+    else {
+        blocks.back().set(lane, rclP0, rclP1, rclP2);
+        indices[numFacets] = ulIndex;
+    }
+    numFacets++;
+}
+
+bool MeshFacetBatch::NearestFacet(
+    const Base::Vector3f& rclPt,
+    float& rfMinDist,
+    FacetIndex& rulFacet
+) const
+{
+    const float pnt[3] = {rclPt.x, rclPt.y, rclPt.z};
+    float best = squared(rfMinDist);
+    FacetIndex facet = FACET_INDEX_MAX;
+
+    float dist2[Lanes];
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        blocks[b].distance2(pnt, dist2);
+        for (int i = 0; i < Lanes; i++) {
+            if (dist2[i] < best) {
+                best = dist2[i];
+                facet = indices[b * Lanes + i];
+            }
+        }
+    }
+
+    if (facet == FACET_INDEX_MAX) {
+        return false;
+    }
+
+    rfMinDist = std::sqrt(best);
+    rulFacet = facet;
+    return true;
+}
+
+void MeshFacetBatch::NearestFacets(
+    const Base::Vector3f* pnts,
+    std::size_t count,
+    float* dist,
+    FacetIndex* facets
+) const
+{
+    std::vector<float> best(count);
+    for (std::size_t j = 0; j < count; j++) {
+        best[j] = squared(dist[j]);
+    }
+
+    float dist2[Lanes];
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        const TriangleLanes<Lanes>& block = blocks[b];
+        const FacetIndex* index = &indices[b * Lanes];
+        for (std::size_t j = 0; j < count; j++) {
+            const float pnt[3] = {pnts[j].x, pnts[j].y, pnts[j].z};
+            block.distance2(pnt, dist2);
+            for (int i = 0; i < Lanes; i++) {
+                if (dist2[i] < best[j]) {
+                    best[j] = dist2[i];
+                    facets[j] = index[i];
+                }
+            }
+        }
+    }
+
+    for (std::size_t j = 0; j < count; j++) {
+        if (best[j] < squared(dist[j])) {
+            dist[j] = std::sqrt(best[j]);
+        }
+    }
+}
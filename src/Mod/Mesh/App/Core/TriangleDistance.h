@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshGeomFacet;
+
+/**
+ * Triangles in structure-of-arrays layout, so that the distances of a point to all \a N
+ * triangles are computed at once.
+ *
+ * The distance computation has no branches, which lets the compiler vectorise the loop over the
+ * lanes with the SIMD instructions of the target, e.g. NEON, and with AVX2 where FC_SIMD_CLONES
+ * is supported. A triangle is stored as its first corner and the two edges to the other
+ * corners. Degenerated triangles get the distance to their edges.
+ */
+template<int N>
+struct TriangleLanes
+{
+    float v0[3][N];
+    float e1[3][N];
+    float e2[3][N];
+
+    /// Sets the triangle of \a lane
+    void set(int lane, const Base::Vector3f& p0, const Base::Vector3f& p1, const Base::Vector3f& p2)
+    {
+        v0[0][lane] = p0.x;
+        v0[1][lane] = p0.y;
+        v0[2][lane] = p0.z;
+        e1[0][lane] = p1.x - p0.x;
+        e1[1][lane] = p1.y - p0.y;
+        e1[2][lane] = p1.z - p0.z;
+        e2[0][lane] = p2.x - p0.x;
+        e2[1][lane] = p2.y - p0.y;
+        e2[2][lane] = p2.z - p0.z;
+    }
+
+    /// Computes the squared distances of \a pnt to the triangles of all lanes
+    FC_SIMD_CLONES void distance2(const float pnt[3], float dist2[N]) const
+    {
+        // local copies so that the compiler needn't check for aliasing
+        const float px = pnt[0], py = pnt[1], pz = pnt[2];
+        float result[N];
+        for (int i = 0; i < N; i++) {
+            float ax = px - v0[0][i], ay = py - v0[1][i], az = pz - v0[2][i];
+            float e1x = e1[0][i], e1y = e1[1][i], e1z = e1[2][i];
+            float e2x = e2[0][i], e2y = e2[1][i], e2z = e2[2][i];
+
+            // barycentric coordinates of the projection onto the plane, scaled by det
+            float a11 = e1x * e1x + e1y * e1y + e1z * e1z;
+            float a12 = e1x * e2x + e1y * e2y + e1z * e2z;
+            float a22 = e2x * e2x + e2y * e2y + e2z * e2z;
+            float d1 = e1x * ax + e1y * ay + e1z * az;
+            float d2 = e2x * ax + e2y * ay + e2z * az;
+            float det = a11 * a22 - a12 * a12;
+            float s = a22 * d1 - a12 * d2;
+            float t = a11 * d2 - a12 * d1;
+            // no short-circuit evaluation, it would prevent the vectorisation
+            bool inside = (det > 0.0F) & (s >= 0.0F) & (t >= 0.0F) & (s + t <= det);
+
+            float nx = e1y * e2z - e1z * e2y;
+            float ny = e1z * e2x - e1x * e2z;
+            float nz = e1x * e2y - e1y * e2x;
+            float nn = nx * nx + ny * ny + nz * nz;
+            float an = ax * nx + ay * ny + az * nz;
+            float plane = an * an / std::max(nn, Tiny);
+
+            // the third edge goes from v0 + e1 to v0 + e2
+            float e3x = e2x - e1x, e3y = e2y - e1y, e3z = e2z - e1z;
+            float edge = std::min(
+                std::min(segment2(ax, ay, az, e1x, e1y, e1z), segment2(ax, ay, az, e2x, e2y, e2z)),
+                segment2(ax - e1x, ay - e1y, az - e1z, e3x, e3y, e3z)
+            );
+
+            // the plane distance is never higher than the edge distance and only valid inside
+            float outside = inside ? 0.0F : Infinity;
+            result[i] = std::min(plane + outside, edge);
+        }
+        std::copy(result, result + N, dist2);
+    }
+
+private:
+    static constexpr float Tiny = 1.0e-30F;
+    static constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+    // Squared distance of the point a to the segment from the origin to e
+    static float segment2(float ax, float ay, float az, float ex, float ey, float ez)
+    {
+        float ee = ex * ex + ey * ey + ez * ez;
+        float ae = ax * ex + ay * ey + az * ez;
+        // clamping the numerator keeps the compiler from splitting the code below
+        float den = std::max(ee, Tiny);
+        float u = std::min(std::max(ae, 0.0F), den) / den;
+        float dx = ax - u * ex, dy = ay - u * ey, dz = az - u * ez;
+        return dx * dx + dy * dy + dz * dz;
+    }
+};
+
+/**
+ * Searches for the facet nearest to a point among facets that are added one by one.
+ *
+ * The facets are collected in a block of TriangleLanes whose distances are computed at once
+ * when it is full, so no memory is allocated.
+ */
+class MeshExport MeshNearestFacetSearch
+{
+public:
+    static constexpr int Lanes = 8;
+
+    /// Only facets with a distance lower than \a fMaxDist to \a rclPt are found.
+    MeshNearestFacetSearch(const Base::Vector3f& rclPt, float fMaxDist);
+
+    void AddFacet(const MeshGeomFacet& rclFacet, FacetIndex ulIndex);
+    void AddFacet(
+        const Base::Vector3f& rclP0,
+        const Base::Vector3f& rclP1,
+        const Base::Vector3f& rclP2,
+        FacetIndex ulIndex
+    );
+    /**
+     * Returns the index of the nearest facet and sets \a rfDist to its distance. If no facet is
+     * nearer than the maximum distance FACET_INDEX_MAX is returned.
+     */
+    FacetIndex NearestFacet(float& rfDist);
+
+private:
+    void testBlock();
+
+private:
+    TriangleLanes<Lanes> block {};
+    FacetIndex index[Lanes] {};
+    float pnt[3];
+    float best;
+    FacetIndex facet {FACET_INDEX_MAX};
+    int count {0};
+};
+
+/**
+ * A set of facets that is tested against many points.
+ *
+ * The facets are stored in blocks of TriangleLanes and each block is tested against all points
+ * before the next one is loaded, e.g. to get the distances of the points in a grid cell to the
+ * facets around it.
+ */
+class MeshExport MeshFacetBatch
+{
+public:
+    static constexpr int Lanes = 8;
+
+    void Clear();
+    void AddFacet(const MeshGeomFacet& rclFacet, FacetIndex ulIndex);
+    void AddFacet(
+        const Base::Vector3f& rclP0,
+        const Base::Vector3f& rclP1,
+        const Base::Vector3f& rclP2,
+        FacetIndex ulIndex
+    );
+    /// Returns the number of facets.
+    std::size_t CountFacets() const
+    {
+        return numFacets;
+    }
+
+    /**
+     * Searches for the facet nearest to \a rclPt with a distance lower than \a rfMinDist.
+     * On success \a rfMinDist holds the distance and \a rulFacet the index of the facet.
+     */
+    bool NearestFacet(const Base::Vector3f& rclPt, float& rfMinDist, FacetIndex& rulFacet) const;
+    /**
+     * Does the same as NearestFacet() for all \a count points of \a pnts. The arrays \a dist and
+     * \a facets have the same size, \a dist holds the maximum distances on input. The entries of
+     * points without a facet nearer than their maximum distance are left unchanged.
+     */
+    void NearestFacets(
+        const Base::Vector3f* pnts,
+        std::size_t count,
+        float* dist,
+        FacetIndex* facets
+    ) const;
+
+private:
+    std::vector<TriangleLanes<Lanes>> blocks;
+    std::vector<FacetIndex> indices;
+    std::size_t numFacets {0};
+};
+
+}  // namespace MeshCore
@@ -23,6 +23,8 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
+#include <limits>
 #include <sstream>
 
 
@@ -31,6 +33,7 @@
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Interpreter.h>
+#include <Base/PyWrapParseTupleAndKeywords.h>
 #include <Base/Reader.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
@@ -526,15 +529,21 @@ void MeshObject::save(std::ostream& out) const
     _kernel.Write(out);
 }
 
+void MeshObject::saveNative(std::ostream& out) const
+{
+    _kernel.WriteNative(out);
+}
+
 void MeshObject::load(std::istream& in)
 {
-    _kernel.Read(in);
+    bool verified = _kernel.Read(in);
     this->_segments.clear();
 
 #ifndef FC_DEBUG
     try {
+        // the native format already checks the neighbourhood while reading
         MeshCore::MeshEvalNeighbourhood nb(_kernel);
-        if (!nb.Evaluate()) {
+        if (!verified && !nb.Evaluate()) {
             Base::Console().warning("Errors in neighbourhood of mesh found...");
             _kernel.RebuildNeighbours();
             Base::Console().warning("fixed\n");
@@ -1109,6 +1118,61 @@ void MeshObject::decimate(int targetSize)
     dm.simplify(targetSize);
 }
 
+bool MeshObject::decimate(const MeshCore::MeshSimplify::Parameters& params)
+{
+    // without any limit the decimation would collapse the whole mesh
+    if (params.targetSize == 0 && params.maxError >= std::numeric_limits<float>::max()) {
+        throw Base::ValueError("Either the target size or the maximum error must be set");
+    }
+    MeshCore::MeshSimplify dm(this->_kernel);
+    return dm.simplify(params);
+}
+
+bool MeshObject::getDecimateParameters(
+    PyObject* args,
+    PyObject* kwds,
+    MeshCore::MeshSimplify::Parameters& params
+)
+{
+    Py_ssize_t targetSize = 0;
+    double maxError = std::numeric_limits<float>::max();
+    int keepBorders = 0;
+    double creaseAngle = 0.0;
+    auto partitionSize = static_cast<Py_ssize_t>(params.partitionSize);
+    static const std::array<const char*, 6> keywords_decimate {
+        "TargetSize",
+        "MaxError",
+        "KeepBorders",
+        "CreaseAngle",
+        "PartitionSize",
+        nullptr
+    };
+    if (!Base::Wrapped_ParseTupleAndKeywords(
+            args,
+            kwds,
+            "|$ndpdn",
+            keywords_decimate,
+            &targetSize,
+            &maxError,
+            &keepBorders,
+            &creaseAngle,
+            &partitionSize
+        )) {
+        return false;
+    }
+    if (targetSize < 0 || maxError < 0.0 || creaseAngle < 0.0 || partitionSize < 0) {
+        PyErr_SetString(PyExc_ValueError, "Negative values are not allowed");
+        return false;
+    }
+
+    params.targetSize = static_cast<std::size_t>(targetSize);
+    params.maxError = static_cast<float>(maxError);
+    params.keepBorders = keepBorders != 0;
+    params.creaseAngle = static_cast<float>(Base::toRadians(creaseAngle));
+    params.partitionSize = static_cast<std::size_t>(partitionSize);
+    return true;
+}
+
 Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
 {
     std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
@@ -36,6 +36,7 @@
 #include <Base/Matrix.h>
 #include <Base/Tools3D.h>
 
+#include "Core/Decimation.h"
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
@@ -219,6 +220,8 @@ public:
     bool load(std::istream&, MeshCore::MeshIO::Format f, MeshCore::Material* mat = nullptr);
     // Save and load in internal format
     void save(std::ostream&) const;
+    // Save in the native format, which older versions can't read
+    void saveNative(std::ostream&) const;
     void load(std::istream&);
     void writeInventor(std::ostream& str, float creaseangle = 0.0F) const;
     //@}
@@ -283,6 +286,19 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    /** Decimates the mesh down to the target size or maximum error of \a params, at least one
+     * of them must be set. Returns false if the progress callback canceled the decimation.
+     */
+    bool decimate(const MeshCore::MeshSimplify::Parameters& params);
+    /** Fills \a params from the keywords TargetSize, MaxError, KeepBorders, CreaseAngle (in
+     * degrees) and PartitionSize of a Python call. Returns false with a Python error set if the
+     * arguments are invalid.
+     */
+    static bool getDecimateParameters(
+        PyObject* args,
+        PyObject* kwds,
+        MeshCore::MeshSimplify::Parameters& params
+    );
     Base::Vector3d getPointNormal(PointIndex) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(
@@ -438,17 +438,31 @@ class Mesh(ComplexGeoData):
     @constmethod
     def smooth(self, **kwargs) -> Any:
         """Smooth the mesh
-        smooth([iteration=1,maxError=FLT_MAX])"""
+        smooth([Method="Laplace",Iteration=1,Lambda,Micro,Maximum=1000,Weight=1,FixedBorder=True])
+        Method: Laplace, Taubin, PlaneFit or MedianFilter
+        FixedBorder: keep the border points in place (Laplace and Taubin only)"""
         ...
 
-    def decimate(self) -> Any:
+    def decimate(self, **kwargs) -> Any:
         """Decimate the mesh
         decimate(tolerance(Float), reduction(Float))
         tolerance: maximum error
         reduction: reduction factor must be in the range [0.0,1.0]
         Example:
         mesh.decimate(0.5, 0.1) # reduction by up to 10 percent
-        mesh.decimate(0.5, 0.9) # reduction by up to 90 percent"""
+        mesh.decimate(0.5, 0.9) # reduction by up to 90 percent
+
+        or
+
+        decimate([TargetSize=0, MaxError, KeepBorders=False, CreaseAngle=0, PartitionSize=100000])
+        TargetSize: number of facets to reach, 0 lets only MaxError stop the decimation
+        MaxError: maximum distance of a moved point to the original surface
+        KeepBorders: keep the points of open borders
+        CreaseAngle: keep the points of edges whose facets enclose a greater angle (in degrees)
+        PartitionSize: larger meshes are split into parts of this size decimated in parallel
+        At least one of TargetSize and MaxError must be given.
+        Example:
+        mesh.decimate(TargetSize=mesh.CountFacets // 10, KeepBorders=True, CreaseAngle=30)"""
         ...
 
     def mergeFacets(self) -> Any:
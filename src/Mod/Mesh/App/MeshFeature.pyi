@@ -42,7 +42,7 @@ class MeshFeature(GeoFeature):
         """Smooth the mesh data"""
         ...
 
-    def decimate(self) -> Any:
+    def decimate(self, **kwargs) -> Any:
         """
         Decimate the mesh
         decimate(tolerance(Float), reduction(Float))
@@ -56,6 +56,12 @@ class MeshFeature(GeoFeature):
 
         decimate(targwt size(int))
         mesh.decimate(mesh.CountFacets/2)
+
+        or
+
+        decimate([TargetSize=0, MaxError, KeepBorders=False, CreaseAngle=0, PartitionSize=100000])
+        The parallel decimation, see Mesh.decimate() for the meaning of the keywords.
+        At least one of TargetSize and MaxError must be given.
         """
         ...
 
@@ -92,8 +92,29 @@ PyObject* MeshFeaturePy::smooth(PyObject* args)
     Py_Return;
 }
 
-PyObject* MeshFeaturePy::decimate(PyObject* args)
+PyObject* MeshFeaturePy::decimate(PyObject* args, PyObject* kwds)
 {
+    if (kwds && PyDict_Size(kwds) > 0) {
+        MeshCore::MeshSimplify::Parameters params;
+        if (!MeshObject::getDecimateParameters(args, kwds, params)) {
+            return nullptr;
+        }
+        PY_TRY
+        {
+            Mesh::Feature* obj = getFeaturePtr();
+            // check the parameters before touching the property
+            if (params.targetSize == 0 && params.maxError >= std::numeric_limits<float>::max()) {
+                throw Base::ValueError("Either the target size or the maximum error must be set");
+            }
+            MeshObject* kernel = obj->Mesh.startEditing();
+            kernel->decimate(params);
+            obj->Mesh.finishEditing();
+        }
+        PY_CATCH;
+
+        Py_Return;
+    }
+
     float fTol {};
     float fRed {};
     if (PyArg_ParseTuple(args, "ff", &fTol, &fRed)) {
@@ -126,7 +147,9 @@ PyObject* MeshFeaturePy::decimate(PyObject* args)
 
     PyErr_SetString(
         PyExc_ValueError,
-        "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)"
+        "decimate(tolerance=float, reduction=float), decimate(targetSize=int) or "
+        "decimate(TargetSize=int, MaxError=float, KeepBorders=bool, CreaseAngle=float, "
+        "PartitionSize=int)"
     );
     return nullptr;
 }
@@ -23,6 +23,11 @@
  ***************************************************************************/
 
 
+#include <iterator>
+#include <memory>
+#include <sstream>
+
+#include <App/Application.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -919,9 +924,41 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
     }
 }
 
+namespace
+{
+// Older versions can't read the native format, so documents only use it on request
+bool useNativeFormat()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Mesh"
+    );
+    return hGrp->GetBool("NativeFormat", false);
+}
+}  // namespace
+
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
-    _meshObject->save(writer.Stream());
+    if (useNativeFormat()) {
+        _meshObject->saveNative(writer.Stream());
+    }
+    else {
+        _meshObject->save(writer.Stream());
+    }
+}
+
+std::function<void(Base::Writer&)> PropertyMeshKernel::getSaveDocFileJob(const Base::Writer&) const
+{
+    // keep the mesh object alive, the property may get a new one while saving
+    Base::Reference<MeshObject> mesh = _meshObject;
+    bool native = useNativeFormat();
+    return [mesh, native](Base::Writer& writer) {
+        if (native) {
+            mesh->saveNative(writer.Stream());
+        }
+        else {
+            mesh->save(writer.Stream());
+        }
+    };
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
@@ -931,6 +968,24 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
     hasSetValue();
 }
 
+std::function<std::function<void()>()> PropertyMeshKernel::getRestoreDocFileJob(
+    Base::Reader& reader
+)
+{
+    auto data = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(reader),
+        std::istreambuf_iterator<char>()
+    );
+    return [this, data]() -> std::function<void()> {
+        auto mesh = std::make_shared<MeshObject>();
+        std::istringstream str(*data);
+        mesh->load(str);
+        return [this, mesh]() {
+            swapMesh(mesh->getKernel());
+        };
+    };
+}
+
 App::Property* PropertyMeshKernel::Copy() const
 {
     // Note: Copy the content, do NOT reference the same mesh object
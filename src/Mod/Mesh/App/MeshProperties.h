@@ -316,6 +316,8 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    std::function<void(Base::Writer&)> getSaveDocFileJob(const Base::Writer& writer) const override;
+    std::function<std::function<void()>()> getRestoreDocFileJob(Base::Reader& reader) override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
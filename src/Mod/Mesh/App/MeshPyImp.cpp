@@ -23,6 +23,8 @@
  ***************************************************************************/
 
 
+#include <limits>
+
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
 #include <Base/MatrixPy.h>
@@ -2005,19 +2007,29 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
     double micro = 0;
     double maximum = 1000;
     int weight = 1;
-    static const std::array<const char*, 7>
-        keywords_smooth {"Method", "Iteration", "Lambda", "Micro", "Maximum", "Weight", nullptr};
+    int fixedBorder = 1;
+    static const std::array<const char*, 8> keywords_smooth {
+        "Method",
+        "Iteration",
+        "Lambda",
+        "Micro",
+        "Maximum",
+        "Weight",
+        "FixedBorder",
+        nullptr
+    };
     if (!Base::Wrapped_ParseTupleAndKeywords(
             args,
             kwds,
-            "|sidddi",
+            "|sidddip",
             keywords_smooth,
             &method,
             &iter,
             &lambda,
             &micro,
             &maximum,
-            &weight
+            &weight,
+            &fixedBorder
         )) {
         return nullptr;
     }
@@ -2031,6 +2043,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
             if (lambda > 0) {
                 smooth.SetLambda(lambda);
             }
+            smooth.SetFixedBorder(fixedBorder != 0);
             smooth.Smooth(iter);
         }
         else if (strcmp(method, "Taubin") == 0) {
@@ -2041,6 +2054,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
             if (micro > 0) {
                 smooth.SetMicro(micro);
             }
+            smooth.SetFixedBorder(fixedBorder != 0);
             smooth.Smooth(iter);
         }
         else if (strcmp(method, "PlaneFit") == 0) {
@@ -2062,8 +2076,22 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
     Py_Return;
 }
 
-PyObject* MeshPy::decimate(PyObject* args)
+PyObject* MeshPy::decimate(PyObject* args, PyObject* kwds)
 {
+    if (kwds && PyDict_Size(kwds) > 0) {
+        MeshCore::MeshSimplify::Parameters params;
+        if (!MeshObject::getDecimateParameters(args, kwds, params)) {
+            return nullptr;
+        }
+        PY_TRY
+        {
+            getMeshObjectPtr()->decimate(params);
+        }
+        PY_CATCH;
+
+        Py_Return;
+    }
+
     float fTol {};
     float fRed {};
     if (PyArg_ParseTuple(args, "ff", &fTol, &fRed)) {
@@ -2090,7 +2118,9 @@ PyObject* MeshPy::decimate(PyObject* args)
 
     PyErr_SetString(
         PyExc_ValueError,
-        "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)"
+        "decimate(tolerance=float, reduction=float), decimate(targetSize=int) or "
+        "decimate(TargetSize=int, MaxError=float, KeepBorders=bool, CreaseAngle=float, "
+        "PartitionSize=int)"
     );
     return nullptr;
 }
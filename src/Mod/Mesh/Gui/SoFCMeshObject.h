@@ -39,7 +39,7 @@ using GLfloat = float;
 
 namespace MeshCore
 {
-class MeshFacetGrid;
+class MeshFacetBVH;
 }
 
 namespace MeshGui
@@ -108,7 +108,7 @@ protected:
     ~SoFCMeshPickNode() override;
 
 private:
-    MeshCore::MeshFacetGrid* meshGrid {nullptr};
+    MeshCore::MeshFacetBVH* meshBVH {nullptr};
 };
 
 // -------------------------------------------------------
@@ -53,6 +53,7 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -64,6 +65,7 @@
 using namespace MeshPart;
 using MeshCore::MeshAlgorithm;
 using MeshCore::MeshFacet;
+using MeshCore::MeshFacetBVH;
 using MeshCore::MeshFacetGrid;
 using MeshCore::MeshFacetIterator;
 using MeshCore::MeshKernel;
@@ -687,10 +689,9 @@ void MeshProjection::projectOnMesh(
     std::vector<Base::Vector3f>& pointsOut
 ) const
 {
-    // calculate the average edge length and create a grid
+    // the hierarchy keeps fast where the facet density of the mesh varies a lot
     MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    MeshFacetBVH cBVH(_rcMesh);
 
     // get all boundary points and edges of the mesh
     std::vector<Base::Vector3f> boundaryPoints;
@@ -717,7 +718,7 @@ void MeshProjection::projectOnMesh(
     for (auto it : pointsIn) {
         Base::Vector3f result;
         MeshCore::FacetIndex index;
-        if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+        if (clAlg.NearestFacetOnRay(it, dir, cBVH, result, index)) {
             MeshCore::MeshGeomFacet geomFacet = _rcMesh.GetFacet(index);
             if (tolerance > 0 && geomFacet.IntersectPlaneWithLine(it, dir, result)) {
                 if (geomFacet.IsPointOfFace(result, tolerance)) {
@@ -771,10 +772,9 @@ void MeshProjection::projectParallelToMesh(
     std::vector<PolyLine>& rPolyLines
 ) const
 {
-    // calculate the average edge length and create a grid
+    // the hierarchy keeps fast where the facet density of the mesh varies a lot
     MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    MeshFacetBVH cBVH(_rcMesh);
     TopExp_Explorer Ex;
 
     int iCnt = 0;
@@ -796,7 +796,7 @@ void MeshProjection::projectParallelToMesh(
         for (auto it : points) {
             Base::Vector3f result;
             MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+            if (clAlg.NearestFacetOnRay(it, dir, cBVH, result, index)) {
                 hitPoints.emplace_back(result, index);
 
                 if (hitPoints.size() > 1) {
@@ -812,7 +812,7 @@ void MeshProjection::projectParallelToMesh(
         for (auto it : hitPointPairs) {
             points.clear();
             if (meshProjection.projectLineOnMesh(
-                    cGrid,
+                    cBVH,
                     it.first.first,
                     it.first.second,
                     it.second.first,
@@ -835,10 +835,9 @@ void MeshProjection::projectParallelToMesh(
     std::vector<PolyLine>& rPolyLines
 ) const
 {
-    // calculate the average edge length and create a grid
+    // the hierarchy keeps fast where the facet density of the mesh varies a lot
     MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    MeshFacetBVH cBVH(_rcMesh);
 
     Base::SequencerLauncher seq("Project curve on mesh", aEdges.size());
 
@@ -852,7 +851,7 @@ void MeshProjection::projectParallelToMesh(
         for (auto it : points) {
             Base::Vector3f result;
             MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+            if (clAlg.NearestFacetOnRay(it, dir, cBVH, result, index)) {
                 hitPoints.emplace_back(result, index);
 
                 if (hitPoints.size() > 1) {
@@ -868,7 +867,7 @@ void MeshProjection::projectParallelToMesh(
         for (auto it : hitPointPairs) {
             points.clear();
             if (meshProjection.projectLineOnMesh(
-                    cGrid,
+                    cBVH,
                     it.first.first,
                     it.first.second,
                     it.second.first,
@@ -27,6 +27,7 @@
 
 
 #include "BRepMesh.h"
+#include <Base/Profiler.h>
 #include <Base/Tools.h>
 
 using namespace Part;
@@ -244,6 +245,8 @@ void BRepMesh::getFacesFromDomains(
     std::vector<Facet>& faces
 )
 {
+    ZoneScoped;
+    ZoneTextObject;
     std::size_t numFaces = 0;
     for (const auto& it : domains) {
         numFaces += it.facets.size();
@@ -295,6 +298,7 @@ void BRepMesh::getFacesFromDomains(
         points = merge.getPoints();
         faces = merge.getFacets();
     }
+    TracyPlot("BRepMesh facets", static_cast<int64_t>(faces.size()));
 }
 
 std::vector<BRepMesh::Segment> BRepMesh::createSegments() const
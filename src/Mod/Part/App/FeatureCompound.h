@@ -49,6 +49,11 @@ public:
     short mustExecute() const override;
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
+    /// the compound only collects the linked shapes and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     /// returns the type name of the view provider
     const char* getViewProviderName() const override
     {
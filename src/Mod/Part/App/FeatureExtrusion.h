@@ -64,6 +64,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the extrusion only reads its profile and direction link and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     /// returns the type name of the view provider
     const char* getViewProviderName() const override
     {
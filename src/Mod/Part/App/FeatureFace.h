@@ -47,6 +47,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the face maker only reads the source shapes and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override
     {
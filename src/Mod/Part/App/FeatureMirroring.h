@@ -51,6 +51,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// mirroring only reads the base shape and plane reference and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override
     {
@@ -55,6 +55,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// offsets only read the source shape and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     const char* getViewProviderName() const override
     {
         return "PartGui::ViewProviderOffset";
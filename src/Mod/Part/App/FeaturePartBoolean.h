@@ -53,6 +53,11 @@ public:
     /// recalculate the Feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the operation only reads the input shapes and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     //@}
 
     void Restore(Base::XMLReader& reader) override;
@@ -46,6 +46,11 @@ public:
     /// recalculate the Feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// The shape depends on the content of FileName
+    bool canUseRecomputeCache() const override
+    {
+        return false;
+    }
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override
     {
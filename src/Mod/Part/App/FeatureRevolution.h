@@ -56,6 +56,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the revolution only reads its profile and axis link and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
 
     void onChanged(const App::Property* prop) override;
 
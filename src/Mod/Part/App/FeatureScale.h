@@ -68,6 +68,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// scaling only reads the base shape and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     /// returns the type name of the view provider
     const char* getViewProviderName() const override
     {
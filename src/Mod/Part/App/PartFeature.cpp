@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 
+#include <algorithm>
 #include <sstream>
 #include <Bnd_Box.hxx>
 #include <BRep_Builder.hxx>
@@ -69,24 +70,48 @@
 #include <App/GeoFeatureGroupExtension.h>
 #include <App/ElementNamingUtils.h>
 #include <App/Placement.h>
+#include <App/PropertyFile.h>
 #include <App/Datums.h>
 #include <Base/Exception.h>
 #include <Base/Placement.h>
+#include <Base/Profiler.h>
 #include <Base/Rotation.h>
 #include <Base/Stream.h>
 #include <Base/Tools.h>
 #include <Mod/Material/App/MaterialManager.h>
 
+#include "AttachExtension.h"
 #include "Geometry.h"
 #include "PartFeature.h"
 #include "PartFeaturePy.h"
 #include "PartPyCXX.h"
+#include "RecomputeCache.h"
 #include "TopoShapePy.h"
 #include "Tools.h"
 
 using namespace Part;
 namespace sp = std::placeholders;
 
+namespace
+{
+
+// The shape histories that execute() sets along with the shape, e.g. for the boolean features
+std::vector<PropertyShapeHistory*> getOutputHistories(const Feature* feature)
+{
+    std::vector<App::Property*> props;
+    feature->getPropertyList(props);
+    std::vector<PropertyShapeHistory*> histories;
+    for (auto prop : props) {
+        auto history = freecad_cast<PropertyShapeHistory*>(prop);
+        if (history && (prop->getType() & App::Prop_Output)) {
+            histories.push_back(history);
+        }
+    }
+    return histories;
+}
+
+}  // namespace
+
 FC_LOG_LEVEL_INIT("Part", true, true)
 
 PROPERTY_SOURCE(Part::Feature, App::GeoFeature)
@@ -108,8 +133,58 @@ short Feature::mustExecute() const
 
 App::DocumentObjectExecReturn* Feature::recompute()
 {
+    ZoneScoped;
+    ZoneObject(getFullName());
+    ZoneTextObject;
+
     try {
-        return App::GeoFeature::recompute();
+        // the dependencies may have changed since the key was computed
+        {
+            std::lock_guard<std::mutex> lock(_recomputeCacheMutex);
+            _recomputeCacheKey.clear();
+        }
+
+        std::string key;
+        auto cache = canUseRecomputeCache() ? RecomputeCache::instance() : nullptr;
+        auto outputs = getOutputHistories(this);
+        if (cache) {
+            key = getRecomputeCacheKey();
+            TopoShape shape;
+            RecomputeCache::Histories histories;
+            if (cache->restore(key, getDocument()->getStringHasher(), shape, &histories)
+                && std::all_of(outputs.begin(), outputs.end(), [&](auto prop) {
+                       return histories.contains(prop->getName());
+                   })) {
+                FC_LOG("Restored " << getFullName() << " from recompute cache");
+                Base::ObjectStatusLocker<App::ObjectStatus, App::DocumentObject> exe(
+                    App::Recompute,
+                    this
+                );
+                // The attachment is not part of the cached shape, so position the feature
+                // like execute() does before the shape takes over the placement
+                for (auto ext : getExtensionsDerivedFromType<AttachExtension>()) {
+                    auto ret = ext->extensionExecute();
+                    if (ret != App::DocumentObject::StdReturn) {
+                        return ret;
+                    }
+                }
+                Shape.setValue(shape);
+                for (auto prop : outputs) {
+                    prop->setValues(histories[prop->getName()]);
+                }
+                return App::DocumentObject::StdReturn;
+            }
+        }
+
+        auto ret = App::GeoFeature::recompute();
+        if (ret == App::DocumentObject::StdReturn && !key.empty()) {
+            RecomputeCache::Histories histories;
+            for (auto prop : outputs) {
+                histories[prop->getName()] = prop->getValues();
+            }
+            cache->store(key, Shape.getShape(), histories);
+        }
+        return ret;
     }
     catch (Standard_Failure& e) {
 
@@ -127,6 +202,59 @@ App::DocumentObjectExecReturn* Feature::execute()
     return GeoFeature::execute();
 }
 
+bool Feature::canUseRecomputeCache() const
+{
+    // A plain feature doesn't compute its shape, the shape is its input
+    if (getTypeId() == Feature::getClassTypeId() || getPropertyByName("Proxy")) {
+        return false;
+    }
+    // A cache hit runs the attachment, but no other extension. The properties of the
+    // attachment are part of the key like any other input.
+    if (getExtensionsDerivedFromType<App::Extension>().size()
+        != getExtensionsDerivedFromType<AttachExtension>().size()) {
+        return false;
+    }
+
+    std::vector<App::Property*> props;
+    getPropertyList(props);
+    for (auto prop : props) {
+        // The element map version is part of the key
+        if (prop == &Shape || prop == &Label || prop == &_ElementMapVersion) {
+            continue;
+        }
+        // A cache hit only restores the shape and its histories, so execute() must not set any
+        // other output. This includes transient ones.
+        if (prop->getType() & App::Prop_Output) {
+            if (prop->isDerivedFrom<PropertyShapeHistory>()) {
+                continue;
+            }
+            return false;
+        }
+        if (prop->getType() & App::Prop_Transient) {
+            continue;
+        }
+        if (prop->isDerivedFrom<App::PropertyComplexGeoData>()) {
+            return false;
+        }
+        // The key only covers the file name, not the content of the file
+        if (prop->isDerivedFrom<App::PropertyFile>()
+            || prop->isDerivedFrom<App::PropertyFileIncluded>()
+            || prop->isDerivedFrom<App::PropertyPath>()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string Feature::getRecomputeCacheKey() const
+{
+    std::lock_guard<std::mutex> lock(_recomputeCacheMutex);
+    if (_recomputeCacheKey.empty()) {
+        _recomputeCacheKey = RecomputeCache::computeKey(this);
+    }
+    return _recomputeCacheKey;
+}
+
 PyObject* Feature::getPyObject()
 {
     if (PythonObject.is(Py::_None())) {
@@ -1528,6 +1656,11 @@ void Feature::onBeforeChange(const App::Property* prop)
 
 void Feature::onChanged(const App::Property* prop)
 {
+    if (prop != &this->Shape && !(prop->getType() & App::Prop_Output)) {
+        std::lock_guard<std::mutex> lock(_recomputeCacheMutex);
+        _recomputeCacheKey.clear();
+    }
+
     // if the placement has changed apply the change to the point data as well
     if (prop == &this->Placement) {
         TopoShape shape = this->Shape.getShape();
@@ -30,6 +30,8 @@
 #include <Mod/Part/PartGlobal.h>
 #include <Base/Bitmask.h>
 
+#include <mutex>
+
 #include <TopoDS_Face.hxx>
 
 #include <Mod/Part/PartGlobal.h>
@@ -81,6 +83,23 @@ public:
     short mustExecute() const override;
     //@}
 
+    /** @name Recompute cache
+     * @sa RecomputeCache
+     */
+    //@{
+    /** Whether the result of execute() may be taken from the recompute cache
+     *
+     * By default this is the case for features whose only results are their
+     * Shape and shape histories, i.e. that have no other geometry or output
+     * properties, no extensions besides the attachment, no Python proxy, and
+     * no file properties. Features that read external files must override
+     * this, because the cache can't tell when such a file has changed.
+     */
+    virtual bool canUseRecomputeCache() const;
+    /// Key of this feature in the recompute cache, empty if it has no valid key
+    std::string getRecomputeCacheKey() const;
+    //@}
+
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override;
     const App::PropertyComplexGeoData* getPropertyOfGeometry() const override;
@@ -257,6 +276,9 @@ private:
     struct ElementCache;
     std::map<std::string, ElementCache> _elementCache;
     std::vector<std::pair<std::string, PropertyPartShape*>> _elementCachePrefixMap;
+
+    mutable std::mutex _recomputeCacheMutex;
+    mutable std::string _recomputeCacheKey;
 };
 
 class PartExport FilletBase: public Part::Feature
@@ -273,6 +295,11 @@ public:
     short mustExecute() const override;
     App::DocumentObjectExecReturn* execute() override;
     void onUpdateElementReference(const App::Property* prop) override;
+    /// fillets and chamfers only change their own edge list and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
 
 protected:
     void onDocumentRestored() override;
@@ -51,6 +51,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the surface only reads the two curves and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     const char* getViewProviderName() const override
     {
         return "PartGui::ViewProviderRuledSurface";
@@ -86,6 +91,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the loft only reads its sections and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     const char* getViewProviderName() const override
     {
         return "PartGui::ViewProviderLoft";
@@ -118,6 +128,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the sweep only reads its sections and spine and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     const char* getViewProviderName() const override
     {
         return "PartGui::ViewProviderSweep";
@@ -150,6 +165,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the thickness only reads the solid and faces and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     const char* getViewProviderName() const override
     {
         return "PartGui::ViewProviderThickness";
@@ -181,6 +201,11 @@ public:
     //@{
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
+    /// refining only reads the source shape and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     const char* getViewProviderName() const override
     {
         return "PartGui::ViewProviderRefine";
@@ -201,6 +226,11 @@ public:
     //@{
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
+    /// reversing only reads the source shape and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     const char* getViewProviderName() const override
     {
         return "PartGui::ViewProviderReverse";
@@ -46,6 +46,11 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// primitives only build their own shape and may recompute in parallel
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     PyObject* getPyObject() override;
     //@}
 
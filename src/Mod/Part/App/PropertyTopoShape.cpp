@@ -23,6 +23,8 @@
  ***************************************************************************/
 
 
+#include <iterator>
+#include <mutex>
 #include <sstream>
 #include <Bnd_Box.hxx>
 #include <BRepBndLib.hxx>
@@ -59,12 +61,49 @@ using namespace Part;
 
 TYPESYSTEM_SOURCE(Part::PropertyPartShape, App::PropertyComplexGeoData)
 
+struct PropertyPartShape::DeferredShape
+{
+    std::once_flag loaded;
+    std::string data;
+    std::string fileName;
+    bool binary {false};
+};
+
+namespace
+{
+// Parses a BRep file that has been read into memory, may be called from any thread
+TopoDS_Shape readShape(const std::string& data, bool binary, const std::string& fileName)
+{
+    std::istringstream str(data);
+    if (binary) {
+        TopoShape shape;
+        shape.importBinary(str);
+        return shape.getShape();
+    }
+
+    TopoDS_Shape shape;
+    try {
+        str.exceptions(std::istream::failbit | std::istream::badbit);
+        BRep_Builder builder;
+        BRepTools::Read(shape, str, builder);
+    }
+    catch (const std::exception&) {
+        if (!str.eof()) {
+            Base::Console().warning("Failed to load BRep file %s\n", fileName.c_str());
+        }
+        shape.Nullify();
+    }
+    return shape;
+}
+}  // namespace
+
 PropertyPartShape::PropertyPartShape() = default;
 
 PropertyPartShape::~PropertyPartShape() = default;
 
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
+    _Deferred.reset();
     aboutToSetValue();
     _Shape = sh;
     auto obj = freecad_cast<App::DocumentObject*>(getContainer());
@@ -95,6 +134,7 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 
 void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 {
+    _Deferred.reset();
     aboutToSetValue();
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if (obj) {
@@ -107,11 +147,13 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 
 const TopoDS_Shape& PropertyPartShape::getValue() const
 {
+    loadDeferredShape();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadDeferredShape();
     _Shape.initCache(-1);
     // March, 2024 Toponaming project:  There was originally an unused feature to disable
     // elementMapping that has not been kept:
@@ -128,12 +170,14 @@ const TopoShape& PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadDeferredShape();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    loadDeferredShape();
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull()) {
         return box;
@@ -161,16 +205,19 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D& rclTrf)
 {
+    loadDeferredShape();
     _Shape.setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    loadDeferredShape();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D& rclTrf)
 {
+    loadDeferredShape();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -178,6 +225,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D& rclTrf)
 
 PyObject* PropertyPartShape::getPyObject()
 {
+    loadDeferredShape();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop) {
         prop->setConst();
@@ -216,6 +264,7 @@ void PropertyPartShape::setPyObject(PyObject* value)
 
 App::Property* PropertyPartShape::Copy() const
 {
+    loadDeferredShape();
     PropertyPartShape* prop = new PropertyPartShape();
 
     // March, 2024 Toponaming project:  There was originally a feature to enable making an element
@@ -234,6 +283,7 @@ void PropertyPartShape::Paste(const App::Property& from)
 {
     auto prop = freecad_cast<const PropertyPartShape*>(&from);
     if (prop) {
+        prop->loadDeferredShape();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -241,6 +291,7 @@ void PropertyPartShape::Paste(const App::Property& from)
 
 unsigned int PropertyPartShape::getMemSize() const
 {
+    loadDeferredShape();
     return _Shape.getMemSize();
 }
 
@@ -352,6 +403,7 @@ void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier>& paths) cons
 
 void PropertyPartShape::beforeSave() const
 {
+    loadDeferredShape();
     _HasherIndex = 0;
     _SaveHasher = false;
     auto owner = freecad_cast<App::DocumentObject*>(getContainer());
@@ -364,6 +416,7 @@ void PropertyPartShape::beforeSave() const
 }
 void PropertyPartShape::Save(Base::Writer& writer) const
 {
+    loadDeferredShape();
     // See SaveDocFile(), RestoreDocFile()
     writer.Stream() << writer.ind() << "<Part";
     auto owner = dynamic_cast<App::DocumentObject*>(getContainer());
@@ -711,6 +764,7 @@ void PropertyPartShape::loadFromStream(Base::Reader& reader)
 
 void PropertyPartShape::SaveDocFile(Base::Writer& writer) const
 {
+    loadDeferredShape();
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape.getShape().IsNull()) {
@@ -737,14 +791,67 @@ void PropertyPartShape::SaveDocFile(Base::Writer& writer) const
     }
 }
 
+std::function<void(Base::Writer&)> PropertyPartShape::getSaveDocFileJob(
+    const Base::Writer& writer
+) const
+{
+    loadDeferredShape();
+    if (_Shape.getShape().IsNull()) {
+        return {};
+    }
+    bool binary = writer.getMode("BinaryBrep");
+    if (!binary) {
+        bool direct = App::GetApplication()
+                          .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
+                          ->GetBool("DirectAccess", true);
+        // saveToFile() goes through a shared temporary file
+        if (!direct) {
+            return {};
+        }
+    }
+    // The job only works on its own copy of the shape, the property may change
+    // after the job has been created
+    TopoShape shape;
+    shape.setShape(_Shape.getShape());
+    return [shape = std::move(shape), binary](Base::Writer& writer) {
+        if (binary) {
+            shape.exportBinary(writer.Stream());
+        }
+        else {
+            shape.exportBrep(writer.Stream());
+        }
+    };
+}
+
 void PropertyPartShape::RestoreDocFile(Base::Reader& reader)
 {
+    _Deferred.reset();
+
+    Base::FileInfo brep(reader.getFileName());
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General"
+    );
+    bool binary = brep.hasExtension("bin");
+    bool direct = hGrp->GetBool("DirectAccess", true);
+    // Only keep the data, the shape is parsed by loadDeferredShape() once it's accessed
+    if (hGrp->GetBool("DeferShapeRestore", false) && (binary || direct)) {
+        auto deferred = std::make_shared<DeferredShape>();
+        deferred->data.assign(
+            std::istreambuf_iterator<char>(reader),
+            std::istreambuf_iterator<char>()
+        );
+        deferred->fileName = reader.getFileName();
+        deferred->binary = binary;
+        if (!deferred->data.empty()) {
+            _Deferred = deferred;
+        }
+        return;
+    }
 
     // save the element map
     auto elementMap = _Shape.resetElementMap();
     auto hasher = _Shape.Hasher;
 
-    Base::FileInfo brep(reader.getFileName());
     TopoShape shape;
 
     // In LS3 the following statement is executed right before shape.Hasher = hasher;
@@ -756,13 +863,10 @@ void PropertyPartShape::RestoreDocFile(Base::Reader& reader)
 
     std::string ver = _Ver;
 
-    if (brep.hasExtension("bin")) {
+    if (binary) {
         shape.importBinary(reader);
     }
     else {
-        bool direct = App::GetApplication()
-                          .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
-                          ->GetBool("DirectAccess", true);
         if (!direct) {
             loadFromFile(reader);
         }
@@ -781,6 +885,69 @@ void PropertyPartShape::RestoreDocFile(Base::Reader& reader)
     _Ver = ver;
 }
 
+std::function<std::function<void()>()> PropertyPartShape::getRestoreDocFileJob(
+    Base::Reader& reader
+)
+{
+    bool binary = Base::FileInfo(reader.getFileName()).hasExtension("bin");
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General"
+    );
+    bool direct = hGrp->GetBool("DirectAccess", true);
+    // Deferred shapes are cheap to restore and loadFromFile() goes through a temporary file
+    if (hGrp->GetBool("DeferShapeRestore", false) || (!binary && !direct)) {
+        return {};
+    }
+
+    auto data = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(reader),
+        std::istreambuf_iterator<char>()
+    );
+    return [this, data, binary, fileName = reader.getFileName()]() -> std::function<void()> {
+        TopoDS_Shape shape = readShape(*data, binary, fileName);
+        return [this, shape]() {
+            setRestoredShape(shape);
+        };
+    };
+}
+
+void PropertyPartShape::setRestoredShape(const TopoDS_Shape& sh)
+{
+    // keep the element map and its version restored from the document
+    auto elementMap = _Shape.resetElementMap();
+    std::string ver = _Ver;
+
+    TopoShape shape;
+    shape.setShape(sh);
+    shape.Hasher = _Shape.Hasher;
+    shape.resetElementMap(elementMap);
+    setValue(shape);
+    _Ver = ver;
+}
+
+void PropertyPartShape::loadDeferredShape() const
+{
+    // The shape may be accessed from several threads, e.g. on a parallel recompute
+    if (!_Deferred) {
+        return;
+    }
+    std::call_once(_Deferred->loaded, [this] {
+        TopoDS_Shape shape;
+        try {
+            shape = readShape(_Deferred->data, _Deferred->binary, _Deferred->fileName);
+        }
+        catch (...) {
+            Base::Console().error(
+                "Reading failed from embedded file: %s\n",
+                _Deferred->fileName.c_str()
+            );
+        }
+        // The element map was already restored, so only the geometry is set
+        _Shape.setShape(shape, false);
+        std::string().swap(_Deferred->data);
+    });
+}
+
 // -------------------------------------------------------------------------
 
 ShapeHistory::ShapeHistory(
@@ -1173,6 +1340,11 @@ void PropertyShapeCache::setShape(const App::DocumentObject* obj, const TopoShap
     // that has not been kept:
     //    if (PartParams::getDisableShapeCache())
     //        return;
+
+    // the cache belongs to another object that may be read concurrently
+    if (App::Document::isConcurrentRecomputeThread()) {
+        return;
+    }
     auto prop = get(obj, true);
     if (!prop) {
         return;
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <App/PropertyGeo.h>
@@ -93,6 +94,8 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    std::function<void(Base::Writer&)> getSaveDocFileJob(const Base::Writer& writer) const override;
+    std::function<std::function<void()>()> getRestoreDocFileJob(Base::Reader& reader) override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
@@ -116,12 +119,18 @@ private:
     void saveToFile(Base::Writer& writer) const;
     void loadFromFile(Base::Reader& reader);
     void loadFromStream(Base::Reader& reader);
+    void setRestoredShape(const TopoDS_Shape& shape);
+    void loadDeferredShape() const;
 
 private:
-    TopoShape _Shape;
+    /// Data of a shape whose parsing is deferred until it is accessed
+    struct DeferredShape;
+
+    mutable TopoShape _Shape;
     std::string _Ver;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
+    std::shared_ptr<DeferredShape> _Deferred;
 };
 
 struct PartExport ShapeHistory
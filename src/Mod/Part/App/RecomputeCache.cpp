@@ -0,0 +1,568 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                   *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include <QCryptographicHash>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/MappedElement.h>
+#include <App/PropertyGeo.h>
+#include <Base/Console.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Base/Writer.h>
+
+#include "AttachExtension.h"
+#include "PartFeature.h"
+#include "RecomputeCache.h"
+#include "TopoShape.h"
+
+
+FC_LOG_LEVEL_INIT("Part", true, true)
+
+using namespace Part;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+// Bump whenever the key or the entry layout changes
+constexpr int cacheVersion = 2;
+constexpr const char* entryHeader = "FreeCAD-RecomputeCache";
+constexpr const char* entryExtension = ".fcshape";
+// Check the cache size after this many stores
+constexpr unsigned pruneInterval = 64;
+
+/* Writer used to serialize properties for hashing. Files requested by a
+ * property are written inline, i.e. the key covers their content as well.
+ */
+class KeyWriter: public Base::Writer
+{
+public:
+    std::ostream& Stream() override
+    {
+        return stream;
+    }
+    const std::ostream& Stream() const override
+    {
+        return stream;
+    }
+    void writeFiles() override
+    {
+        // use a while loop because it is possible that while
+        // processing the files new ones can be added
+        std::size_t index = 0;
+        while (index < FileList.size()) {
+            FileEntry entry = FileList[index];
+            stream << '\n' << entry.FileName << '\n';
+            entry.Object->SaveDocFile(*this);
+            ++index;
+        }
+        FileList.clear();
+    }
+    std::string data() const
+    {
+        return stream.str();
+    }
+
+private:
+    std::stringstream stream;
+};
+
+// Objects whose key is being computed by the current thread, used to break cycles
+thread_local std::set<const App::DocumentObject*> visiting;
+
+void hashGeometry(KeyWriter& writer, const App::PropertyComplexGeoData* prop)
+{
+    // The shape is written directly instead of through PropertyPartShape::SaveDocFile()
+    // which may go through a temporary file that is shared by all threads.
+    if (auto shapeProp = freecad_cast<const PropertyPartShape*>(prop)) {
+        shapeProp->getShape().exportBinary(writer.Stream());
+    }
+    else {
+        prop->SaveDocFile(writer);
+    }
+
+    // Mapped names refer to the document's string IDs, which stay stable as
+    // long as the document is saved and reopened.
+    auto data = prop->getComplexData();
+    if (data && data->getElementMapSize() > 0) {
+        auto map = data->getElementMap();
+        std::sort(map.begin(), map.end());
+        for (const auto& element : map) {
+            writer.Stream() << element.index << ' ' << element.name << '\n';
+        }
+    }
+}
+
+// The placement of an attached object is computed from its attachment properties
+const App::Property* getAttachedPlacement(const App::DocumentObject* obj)
+{
+    auto ext = obj->getExtensionByType<AttachExtension>(true);
+    if (!ext || ext->MapMode.getValue() == Attacher::mmDeactivated) {
+        return nullptr;
+    }
+    return obj->getPropertyByName("Placement");
+}
+
+/* Hash the properties of \a obj. If \a inputsOnly is true, output and
+ * geometry properties are skipped, i.e. the properties that are the result
+ * of a recompute, and so is the placement of an attached object.  Otherwise
+ * they are hashed by content.
+ */
+void hashProperties(KeyWriter& writer, const App::DocumentObject* obj, bool inputsOnly)
+{
+    std::vector<App::Property*> props;
+    obj->getPropertyList(props);
+    auto placement = inputsOnly ? getAttachedPlacement(obj) : nullptr;
+    for (auto prop : props) {
+        if ((prop->getType() & App::Prop_Transient) || prop == &obj->Label2
+            || prop == &obj->Visibility || prop == placement) {
+            continue;
+        }
+        auto geometry = freecad_cast<App::PropertyComplexGeoData*>(prop);
+        if (inputsOnly && (geometry || (prop->getType() & App::Prop_Output))) {
+            continue;
+        }
+
+        writer.Stream() << '\n' << prop->getName() << '\n';
+        if (geometry) {
+            hashGeometry(writer, geometry);
+        }
+        else {
+            prop->Save(writer);
+            writer.writeFiles();
+        }
+    }
+}
+
+bool hashDependencies(QCryptographicHash& hash, const App::DocumentObject* obj)
+{
+    for (auto dep : obj->getOutList()) {
+        if (!dep || !dep->isAttachedToDocument() || visiting.contains(dep)) {
+            return false;
+        }
+        // The element map refers to the dependencies by their object ID. Together with the
+        // document UID it stays the same when the document is reopened, even under a
+        // different name.
+        hash.addData(QByteArray::fromStdString(
+            dep->getDocument()->Uid.getValueStr() + ' ' + std::to_string(dep->getID())
+        ));
+
+        auto feature = freecad_cast<const Feature*>(dep);
+        if (feature && feature->canUseRecomputeCache()) {
+            std::string key = feature->getRecomputeCacheKey();
+            if (key.empty()) {
+                return false;
+            }
+            hash.addData(QByteArray::fromStdString(key));
+            continue;
+        }
+
+        // The dependency is not cached, so identify it by its current content
+        KeyWriter writer;
+        writer.Stream() << dep->getTypeId().getName();
+        hashProperties(writer, dep, false);
+        hash.addData(QByteArray::fromStdString(writer.data()));
+    }
+    return true;
+}
+
+std::string digest(const App::StringIDRef& sid)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(sid.deref().data());
+    hash.addData(sid.deref().postfix());
+    return hash.result().toHex().toStdString();
+}
+
+}  // namespace
+
+RecomputeCache::RecomputeCache(std::string path, std::uintmax_t maxSize)
+    : path(std::move(path))
+    , maxSize(maxSize)
+{}
+
+std::shared_ptr<RecomputeCache> RecomputeCache::instance()
+{
+    static std::mutex mutex;
+    static std::shared_ptr<RecomputeCache> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General"
+    );
+    if (!hGrp->GetBool("EnableRecomputeCache", false)) {
+        return {};
+    }
+
+    std::string dir = hGrp->GetASCII("RecomputeCacheDir", "");
+    if (dir.empty()) {
+        dir = App::Application::getUserCachePath() + "RecomputeCache";
+    }
+    if (!cache || cache->getPath() != dir) {
+        cache = std::make_shared<RecomputeCache>(dir);
+    }
+    constexpr std::uintmax_t megaByte = 1024 * 1024;
+    auto size = std::max<long>(0, hGrp->GetInt("RecomputeCacheMaxSize", 1024));
+    cache->setMaxSize(static_cast<std::uintmax_t>(size) * megaByte);
+    return cache;
+}
+
+std::string RecomputeCache::computeKey(const Feature* feature)
+{
+    if (!feature || !feature->isAttachedToDocument() || visiting.contains(feature)) {
+        return {};
+    }
+
+    visiting.insert(feature);
+    try {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        KeyWriter writer;
+        writer.Stream() << entryHeader << ' ' << cacheVersion << '\n'
+                        << feature->getTypeId().getName() << '\n'
+                        << feature->getDocument()->Uid.getValueStr() << ' ' << feature->getID()
+                        << '\n'
+                        << feature->getElementMapVersion(&feature->Shape) << '\n'
+                        << Feature::isElementMappingDisabled(const_cast<Feature*>(feature)) << '\n';
+        hashProperties(writer, feature, true);
+        hash.addData(QByteArray::fromStdString(writer.data()));
+
+        bool valid = hashDependencies(hash, feature);
+        visiting.erase(feature);
+        if (!valid) {
+            return {};
+        }
+        return hash.result().toHex().toStdString();
+    }
+    catch (const Base::Exception& e) {
+        FC_LOG("Cannot compute cache key of " << feature->getFullName() << ": " << e.what());
+    }
+    catch (const std::exception& e) {
+        FC_LOG("Cannot compute cache key of " << feature->getFullName() << ": " << e.what());
+    }
+    visiting.erase(feature);
+    return {};
+}
+
+std::string RecomputeCache::entryPath(const std::string& key) const
+{
+    return path + "/" + key + entryExtension;
+}
+
+bool RecomputeCache::restore(
+    const std::string& key,
+    const App::StringHasherRef& hasher,
+    TopoShape& shape,
+    Histories* histories
+) const
+{
+    if (key.empty()) {
+        return false;
+    }
+
+    std::string file = entryPath(key);
+    Base::ifstream str(Base::FileInfo(file), std::ios::in | std::ios::binary);
+    if (!str) {
+        return false;
+    }
+
+    try {
+        std::string tmp;
+        int version = 0;
+        long tag = 0;
+        std::size_t count = 0;
+        if (!(str >> tmp >> version) || tmp != entryHeader || version != cacheVersion) {
+            return false;
+        }
+        if (!(str >> tmp >> tag) || tmp != "Tag") {
+            return false;
+        }
+
+        // Make sure the string IDs referenced by the element map still have the same meaning
+        if (!(str >> tmp >> count) || tmp != "StringIDs") {
+            return false;
+        }
+        if (count > 0 && !hasher) {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            long id = 0;
+            if (!(str >> id >> tmp)) {
+                return false;
+            }
+            auto sid = hasher->getID(id);
+            if (!sid || digest(sid) != tmp) {
+                FC_LOG("Recompute cache entry " << key << " refers to an unknown string ID " << id);
+                return false;
+            }
+        }
+
+        struct Entry
+        {
+            std::string index;
+            std::string name;
+            Data::ElementIDRefs sids;
+        };
+        std::vector<Entry> entries;
+        if (!(str >> tmp >> count) || tmp != "ElementMap") {
+            return false;
+        }
+        entries.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            Entry entry;
+            std::size_t sidCount = 0;
+            if (!(str >> entry.index >> entry.name >> sidCount)) {
+                return false;
+            }
+            for (std::size_t j = 0; j < sidCount; ++j) {
+                long id = 0;
+                if (!(str >> id)) {
+                    return false;
+                }
+                entry.sids.push_back(hasher->getID(id));
+            }
+            entries.push_back(std::move(entry));
+        }
+
+        Histories storedHistories;
+        if (!(str >> tmp >> count) || tmp != "Histories") {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t size = 0;
+            if (!(str >> tmp >> size)) {
+                return false;
+            }
+            auto& values = storedHistories[tmp];
+            for (std::size_t j = 0; j < size; ++j) {
+                ShapeHistory history;
+                int type = 0;
+                std::size_t mapSize = 0;
+                if (!(str >> type >> mapSize)) {
+                    return false;
+                }
+                history.type = static_cast<TopAbs_ShapeEnum>(type);
+                for (std::size_t k = 0; k < mapSize; ++k) {
+                    int index = 0;
+                    std::size_t listSize = 0;
+                    if (!(str >> index >> listSize)) {
+                        return false;
+                    }
+                    auto& list = history.shapeMap[index];
+                    list.resize(listSize);
+                    for (auto& value : list) {
+                        if (!(str >> value)) {
+                            return false;
+                        }
+                    }
+                }
+                values.push_back(std::move(history));
+            }
+        }
+
+        if (!(str >> tmp) || tmp != "BRep") {
+            return false;
+        }
+        std::getline(str, tmp);
+
+        TopoShape result;
+        result.importBinary(str);
+        result.Tag = tag;
+        result.Hasher = hasher;
+        const auto& types = result.getElementTypes();
+        for (auto& entry : entries) {
+            result.setElementName(
+                Data::IndexedName(entry.index.c_str(), types),
+                Data::MappedName(entry.name),
+                tag,
+                &entry.sids
+            );
+        }
+        shape = result;
+        if (histories) {
+            *histories = std::move(storedHistories);
+        }
+    }
+    catch (const Base::Exception& e) {
+        FC_WARN("Failed to restore recompute cache entry " << key << ": " << e.what());
+        return false;
+    }
+    catch (const std::exception& e) {
+        FC_WARN("Failed to restore recompute cache entry " << key << ": " << e.what());
+        return false;
+    }
+    str.close();
+
+    // keep recently used entries when pruning
+    std::error_code ec;
+    fs::last_write_time(Base::FileInfo::stringToPath(file), fs::file_time_type::clock::now(), ec);
+    return true;
+}
+
+bool RecomputeCache::store(
+    const std::string& key,
+    const TopoShape& shape,
+    const Histories& histories
+)
+{
+    if (key.empty() || shape.isNull()) {
+        return false;
+    }
+
+    Base::FileInfo dir(path);
+    if (!dir.exists() && !dir.createDirectories()) {
+        FC_WARN("Cannot create recompute cache directory " << path);
+        return false;
+    }
+
+    std::vector<Data::IndexedName> indices;
+    std::map<long, App::StringIDRef> sids;
+    if (shape.getElementMapSize() > 0) {
+        for (const auto& element : shape.getElementMap()) {
+            indices.push_back(element.index);
+        }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    }
+
+    std::ostringstream map;
+    std::size_t count = 0;
+    for (const auto& index : indices) {
+        for (const auto& [name, ids] : shape.getElementMappedNames(index)) {
+            map << index << ' ' << name.toString() << ' ' << ids.size();
+            for (const auto& sid : ids) {
+                map << ' ' << sid.value();
+                sids.emplace(sid.value(), sid);
+            }
+            map << '\n';
+            ++count;
+        }
+    }
+
+    // Write to a temporary file first, so that concurrent readers never see a partial entry
+    std::ostringstream tmpName;
+    tmpName << entryPath(key) << '.' << std::this_thread::get_id() << ".tmp";
+    Base::FileInfo tmp(tmpName.str());
+    {
+        Base::ofstream str(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!str) {
+            return false;
+        }
+        str << entryHeader << ' ' << cacheVersion << '\n';
+        str << "Tag " << shape.Tag << '\n';
+        str << "StringIDs " << sids.size() << '\n';
+        for (const auto& [id, sid] : sids) {
+            str << id << ' ' << digest(sid) << '\n';
+        }
+        str << "ElementMap " << count << '\n' << map.str();
+        str << "Histories " << histories.size() << '\n';
+        for (const auto& [name, values] : histories) {
+            str << name << ' ' << values.size() << '\n';
+            for (const auto& history : values) {
+                str << history.type << ' ' << history.shapeMap.size() << '\n';
+                for (const auto& [index, list] : history.shapeMap) {
+                    str << index << ' ' << list.size();
+                    for (int value : list) {
+                        str << ' ' << value;
+                    }
+                    str << '\n';
+                }
+            }
+        }
+        str << "BRep\n";
+        shape.exportBinary(str);
+        if (!str) {
+            str.close();
+            tmp.deleteFile();
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmp.filePath(), Base::FileInfo::stringToPath(entryPath(key)), ec);
+    if (ec) {
+        tmp.deleteFile();
+        return false;
+    }
+
+    if (maxSize > 0 && ++storeCount % pruneInterval == 0) {
+        prune(maxSize);
+    }
+    return true;
+}
+
+void RecomputeCache::prune(std::uintmax_t size) const
+{
+    struct Item
+    {
+        fs::path file;
+        fs::file_time_type time;
+        std::uintmax_t size;
+    };
+    std::vector<Item> items;
+    std::uintmax_t total = 0;
+
+    std::error_code ec;
+    for (const auto& it : fs::directory_iterator(Base::FileInfo::stringToPath(path), ec)) {
+        if (it.path().extension() != entryExtension) {
+            continue;
+        }
+        Item item {it.path(), it.last_write_time(ec), it.file_size(ec)};
+        if (ec) {
+            continue;
+        }
+        total += item.size;
+        items.push_back(std::move(item));
+    }
+    if (total <= size) {
+        return;
+    }
+
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.time < b.time;
+    });
+    for (const auto& item : items) {
+        if (total <= size) {
+            break;
+        }
+        if (fs::remove(item.file, ec)) {
+            total -= item.size;
+        }
+    }
+}
+
+void RecomputeCache::clear() const
+{
+    prune(0);
+}
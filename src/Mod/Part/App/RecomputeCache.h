@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                   *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <App/StringHasher.h>
+#include <Mod/Part/PartGlobal.h>
+
+#include "PropertyTopoShape.h"
+
+namespace Part
+{
+
+class Feature;
+class TopoShape;
+
+/** Persistent, content addressed cache of recomputed shapes
+ *
+ * A shape feature is identified by a key hashed from its type, its object ID
+ * and document UID, its input properties and the keys (or the content) of its
+ * dependencies. The object IDs are the tags the element map refers to, so an
+ * entry is never restored for another object that happens to reuse a name.
+ * After a successful recompute the resulting shape is stored under that key,
+ * together with the shape histories of the feature, so that recomputing a
+ * feature with unchanged inputs later on, e.g. after reopening the document,
+ * restores the shape and its element map instead of rebuilding it.
+ *
+ * An entry only records the string IDs of the element map, so it is only
+ * restored if the document's string hasher still holds the same IDs with the
+ * same content. Otherwise the lookup is a miss and the feature is executed.
+ *
+ * The cache is disabled by default. It is controlled by the parameters
+ * EnableRecomputeCache, RecomputeCacheDir and RecomputeCacheMaxSize (in MB)
+ * of the group BaseApp/Preferences/Mod/Part/General.
+ */
+class PartExport RecomputeCache
+{
+public:
+    /// Shape histories by property name, e.g. the History of the boolean features
+    using Histories = std::map<std::string, std::vector<ShapeHistory>>;
+
+    /// Create a cache stored in the directory \a path
+    explicit RecomputeCache(std::string path, std::uintmax_t maxSize = 0);
+
+    /// Returns the cache configured in the preferences, or null if disabled
+    static std::shared_ptr<RecomputeCache> instance();
+
+    /** Compute the cache key of a feature
+     *
+     * @param feature: the feature to identify
+     * @return the hex digest of the key, or an empty string if the feature
+     * cannot be identified, e.g. because of a dependency cycle.
+     */
+    static std::string computeKey(const Feature* feature);
+
+    const std::string& getPath() const
+    {
+        return path;
+    }
+
+    /// Maximum size of the cache in bytes, 0 means unlimited
+    std::uintmax_t getMaxSize() const
+    {
+        return maxSize;
+    }
+    void setMaxSize(std::uintmax_t size)
+    {
+        maxSize = size;
+    }
+
+    /** Restore a shape
+     *
+     * @param key: the key of the feature
+     * @param hasher: the string hasher of the document the shape is restored for
+     * @param shape: returns the shape with its element map on success
+     * @param histories: if not null, returns the stored shape histories
+     * @return false on a cache miss
+     */
+    bool restore(
+        const std::string& key,
+        const App::StringHasherRef& hasher,
+        TopoShape& shape,
+        Histories* histories = nullptr
+    ) const;
+    /// Store \a shape and \a histories under \a key, false if the entry couldn't be written
+    bool store(const std::string& key, const TopoShape& shape, const Histories& histories = {});
+    /// Remove the least recently used entries until the cache fits into \a size bytes
+    void prune(std::uintmax_t size) const;
+    /// Remove all entries
+    void clear() const;
+
+private:
+    std::string entryPath(const std::string& key) const;
+
+    std::string path;
+    std::atomic<std::uintmax_t> maxSize;
+    std::atomic<unsigned> storeCount {0};
+};
+
+}  // namespace Part
@@ -29,6 +29,7 @@
 # include <stdexcept>
 # include <iostream>
 # include <csignal>
+# include <mutex>
 # include <OSD.hxx>
 # include <OSD_WhoAmI.hxx>
 # include <OSD_SIGHUP.hxx>
@@ -208,16 +209,18 @@ static void setSignal(OSD_SignalMode theSignalMode)
 // ----------------------------------------------------------------------------
 
 #if defined(__GNUC__) && defined(FC_OS_LINUX)
-static OSD_SignalMode currentSignalMode = OSD_SignalMode_Unset;  // NOLINT
+// The handlers are process wide and may be requested from several threads at once, so the
+// first user installs them and the last one resets them
+static std::mutex signalMutex;  // NOLINT
+static int signalUsers = 0;     // NOLINT
 #endif
 
 SignalException::SignalException()
 {
 #if defined(__GNUC__) && defined(FC_OS_LINUX)
-    if (currentSignalMode == OSD_SignalMode_Unset) {
-        currentSignalMode = OSD_SignalMode_Set;
-        setSignal(currentSignalMode);
-        enabled = true;
+    std::lock_guard<std::mutex> lock(signalMutex);
+    if (signalUsers++ == 0) {
+        setSignal(OSD_SignalMode_Set);
     }
 #endif
 }
@@ -225,9 +228,9 @@ SignalException::SignalException()
 SignalException::~SignalException()
 {
 #if defined(__GNUC__) && defined(FC_OS_LINUX)
-    if (enabled && currentSignalMode == OSD_SignalMode_Set) {
-        currentSignalMode = OSD_SignalMode_Unset;
-        setSignal(currentSignalMode);
+    std::lock_guard<std::mutex> lock(signalMutex);
+    if (--signalUsers == 0) {
+        setSignal(OSD_SignalMode_Unset);
         // this is the default handler
         Base::SystemHandler::installSegfaultHandler();
     }
@@ -34,13 +34,10 @@ public:
     SignalException();
     ~SignalException();
 
-    SignalException(const SignalException&) = default;
-    SignalException(SignalException&&) = default;
-    SignalException& operator=(const SignalException&) = default;
-    SignalException& operator=(SignalException&&) = default;
-
-private:
-    [[maybe_unused]] bool enabled {false};
+    SignalException(const SignalException&) = delete;
+    SignalException(SignalException&&) = delete;
+    SignalException& operator=(const SignalException&) = delete;
+    SignalException& operator=(SignalException&&) = delete;
 };
 
 }  // namespace Part
@@ -28,6 +28,8 @@
 #include <array>
 #include <cmath>
 #include <cstdlib>
+#include <iterator>
+#include <memory>
 #include <sstream>
 #include <boost/regex.hpp>
 
@@ -168,6 +170,7 @@
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Placement.h>
+#include <Base/Profiler.h>
 #include <Base/Tools.h>
 #include <Base/Vector3D.h>
 #include <Base/Reader.h>
@@ -1261,6 +1264,25 @@ void TopoShape::RestoreDocFile(Base::Reader& reader)
     Data::ComplexGeoData::RestoreDocFile(reader);
 }
 
+std::function<std::function<void()>()> TopoShape::getRestoreDocFileJob(Base::Reader& reader)
+{
+    // The element map is written right after the shape. It's restored on the calling thread once
+    // the shape has been applied, but with a job the shapes of the other objects still being
+    // parsed don't have to be waited for.
+    auto data = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(reader),
+        std::istreambuf_iterator<char>()
+    );
+    return [this, data, fileName = reader.getFileName(), version = reader.getFileVersion()]()
+               -> std::function<void()> {
+        return [this, data, fileName, version]() {
+            std::istringstream str(*data);
+            Base::Reader reader(str, fileName, version);
+            RestoreDocFile(reader);
+        };
+    };
+}
+
 
 unsigned int TopoShape_RefCountShapes(const TopoDS_Shape& aShape)
 {
@@ -3661,6 +3683,8 @@ void TopoShape::
         return;
     }
 
+    ZoneScopedN("BRepMesh");
+    ZoneTextObject;
     // get the meshes of all faces and then merge them
     BRepMesh_IncrementalMesh aMesh(
         this->_Shape,
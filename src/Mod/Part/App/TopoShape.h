@@ -501,6 +501,7 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    std::function<std::function<void()>()> getRestoreDocFileJob(Base::Reader& reader) override;
     unsigned int getMemSize() const override;
     //@}
 
@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <sstream>
 
@@ -106,6 +107,7 @@
 #include <App/ElementNamingUtils.h>
 #include <Base/BoundBox.h>
 #include <Base/Exception.h>
+#include <Base/Profiler.h>
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 #include <SignalException.h>
@@ -5997,6 +5999,9 @@ TopoShape& TopoShape::makeElementBoolean(
         FC_THROWM(Base::CADKernelError, "no maker");
     }
 
+    ZoneScoped;
+    ZoneText(maker, std::strlen(maker));
+
     if (shapes.empty()) {
         FC_THROWM(NullShapeException, "Null shape");
     }
@@ -73,6 +73,7 @@
 #include <App/Document.h>
 #include <Base/Console.h>
 #include <Base/Parameter.h>
+#include <Base/Profiler.h>
 #include <Base/TimeInfo.h>
 #include <Base/Tools.h>
 
@@ -1053,6 +1054,9 @@ void ViewProviderPartExt::setupCoinGeometry(
         return;
     }
 
+    ZoneScoped;
+    ZoneTextObject;
+
     // time measurement and book keeping
     Base::TimeElapsed startTime;
 
@@ -1093,7 +1097,11 @@ void ViewProviderPartExt::setupCoinGeometry(
     BRepTools::Clean(shape, Standard_True);
 #endif
 
-    BRepMesh_IncrementalMesh(shape, meshParams);
+    {
+        ZoneScopedN("BRepMesh");
+        ZoneTextObject;
+        BRepMesh_IncrementalMesh(shape, meshParams);
+    }
 
     // We must reset the location here because the transformation data
     // are set in the placement property
@@ -1472,6 +1480,10 @@ void ViewProviderPartExt::updateVisual()
         return;
     }
 
+    ZoneScoped;
+    ZoneObject(getObject() ? getObject()->getFullName() : std::string("?"));
+    ZoneTextObject;
+
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
 
@@ -26,6 +26,7 @@
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 
+#include "FeaturePointsFilter.h"
 #include "Points.h"
 #include "PointsPy.h"
 #include "Properties.h"
@@ -61,6 +62,11 @@ PyMOD_INIT_FUNC(Points)
     Points::FeatureCustom           ::init();
     Points::StructuredCustom        ::init();
     Points::FeaturePython           ::init();
+    Points::Filter                  ::init();
+    Points::VoxelDownsample         ::init();
+    Points::RadiusOutlierFilter     ::init();
+    Points::StatisticalOutlierFilter::init();
+    Points::NormalEstimation        ::init();
     PyMOD_Return(pointsModule);
     // clang-format on
 }
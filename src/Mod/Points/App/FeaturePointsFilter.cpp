@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <limits>
+
+#include <App/PropertyStandard.h>
+#include <Base/Converter.h>
+#include <Base/Exception.h>
+
+#include "FeaturePointsFilter.h"
+#include "PointsFilter.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+using size_type = PointKernel::size_type;
+
+const App::PropertyIntegerConstraint::Constraints neighbourRange = {
+    1,
+    std::numeric_limits<int>::max(),
+    1
+};
+const App::PropertyIntegerConstraint::Constraints normalRange = {
+    3,
+    std::numeric_limits<int>::max(),
+    1
+};
+const App::PropertyFloatConstraint::Constraints ratioRange = {
+    0.0,
+    std::numeric_limits<float>::max(),
+    0.1
+};
+
+// Copies the per-point values of the property name of source to target
+template<typename PropertyT>
+void copyValues(
+    const Feature* source,
+    Feature* target,
+    const char* type,
+    const char* name,
+    const std::vector<size_type>* indices
+)
+{
+    auto values = dynamic_cast<PropertyT*>(source->getPropertyByName(name));
+    bool valid = values && values->getSize() == int(source->Points.getValue().size());
+
+    App::Property* prop = target->getPropertyByName(name);
+    auto copy = dynamic_cast<PropertyT*>(prop);
+    if (!copy) {
+        // don't touch a property of another type
+        if (prop || !valid) {
+            return;
+        }
+        copy = static_cast<PropertyT*>(target->addDynamicProperty(type, name));
+    }
+    if (!copy) {
+        return;
+    }
+
+    if (!valid) {
+        copy->setValues({});
+    }
+    else if (indices) {
+        copy->setValues(PointsFilter::select(values->getValues(), *indices));
+    }
+    else {
+        copy->setValues(values->getValues());
+    }
+}
+
+}  // namespace
+
+//===========================================================================
+// Filter Feature
+//===========================================================================
+
+PROPERTY_SOURCE(Points::Filter, Points::Feature)
+
+Filter::Filter()
+{
+    ADD_PROPERTY(Source, (nullptr));
+}
+
+short Filter::mustExecute() const
+{
+    if (Source.isTouched()) {
+        return 1;
+    }
+    return Feature::mustExecute();
+}
+
+App::DocumentObjectExecReturn* Filter::execute()
+{
+    Feature* source = getSource();
+    if (!source) {
+        return new App::DocumentObjectExecReturn("No points linked");
+    }
+    setPoints(source, nullptr);
+    return App::DocumentObject::StdReturn;
+}
+
+Feature* Filter::getSource() const
+{
+    return dynamic_cast<Feature*>(Source.getValue());
+}
+
+void Filter::setPoints(const Feature* source, const std::vector<size_type>* indices)
+{
+    const PointKernel& kernel = source->Points.getValue();
+    if (indices) {
+        PointKernel kept;
+        kept.setTransform(kernel.getTransform());
+        std::vector<PointKernel::value_type> points =
+            PointsFilter::select(kernel.getBasicPoints(), *indices);
+        kept.swap(points);
+        Points.setValue(kept);
+    }
+    else {
+        Points.setValue(kernel);
+    }
+
+    copyValues<PropertyGreyValueList>(
+        source,
+        this,
+        "Points::PropertyGreyValueList",
+        "Intensity",
+        indices
+    );
+    copyValues<App::PropertyColorList>(source, this, "App::PropertyColorList", "Color", indices);
+    copyValues<PropertyNormalList>(source, this, "Points::PropertyNormalList", "Normal", indices);
+}
+
+// ----------------------------------------------------------------------
+
+PROPERTY_SOURCE(Points::VoxelDownsample, Points::Filter)
+
+VoxelDownsample::VoxelDownsample()
+{
+    ADD_PROPERTY(VoxelSize, (1.0));
+}
+
+short VoxelDownsample::mustExecute() const
+{
+    if (VoxelSize.isTouched()) {
+        return 1;
+    }
+    return Filter::mustExecute();
+}
+
+App::DocumentObjectExecReturn* VoxelDownsample::execute()
+{
+    Feature* source = getSource();
+    if (!source) {
+        return new App::DocumentObjectExecReturn("No points linked");
+    }
+
+    try {
+        PointsFilter filter(source->Points.getValue());
+        std::vector<size_type> indices = filter.voxelDownsample(VoxelSize.getValue());
+        setPoints(source, &indices);
+    }
+    catch (const Base::Exception& e) {
+        return new App::DocumentObjectExecReturn(e.what());
+    }
+    return App::DocumentObject::StdReturn;
+}
+
+// ----------------------------------------------------------------------
+
+PROPERTY_SOURCE(Points::RadiusOutlierFilter, Points::Filter)
+
+RadiusOutlierFilter::RadiusOutlierFilter()
+{
+    ADD_PROPERTY(Radius, (1.0));
+    ADD_PROPERTY(MinNeighbours, (4));
+    MinNeighbours.setConstraints(&neighbourRange);
+}
+
+short RadiusOutlierFilter::mustExecute() const
+{
+    if (Radius.isTouched() || MinNeighbours.isTouched()) {
+        return 1;
+    }
+    return Filter::mustExecute();
+}
+
+App::DocumentObjectExecReturn* RadiusOutlierFilter::execute()
+{
+    Feature* source = getSource();
+    if (!source) {
+        return new App::DocumentObjectExecReturn("No points linked");
+    }
+
+    try {
+        PointsFilter filter(source->Points.getValue());
+        std::vector<size_type> indices =
+            filter.radiusFilter(Radius.getValue(), MinNeighbours.getValue());
+        setPoints(source, &indices);
+    }
+    catch (const Base::Exception& e) {
+        return new App::DocumentObjectExecReturn(e.what());
+    }
+    return App::DocumentObject::StdReturn;
+}
+
+// ----------------------------------------------------------------------
+
+PROPERTY_SOURCE(Points::StatisticalOutlierFilter, Points::Filter)
+
+StatisticalOutlierFilter::StatisticalOutlierFilter()
+{
+    ADD_PROPERTY(Neighbours, (20));
+    ADD_PROPERTY(StdDevRatio, (2.0));
+    Neighbours.setConstraints(&neighbourRange);
+    StdDevRatio.setConstraints(&ratioRange);
+}
+
+short StatisticalOutlierFilter::mustExecute() const
+{
+    if (Neighbours.isTouched() || StdDevRatio.isTouched()) {
+        return 1;
+    }
+    return Filter::mustExecute();
+}
+
+App::DocumentObjectExecReturn* StatisticalOutlierFilter::execute()
+{
+    Feature* source = getSource();
+    if (!source) {
+        return new App::DocumentObjectExecReturn("No points linked");
+    }
+
+    try {
+        PointsFilter filter(source->Points.getValue());
+        std::vector<size_type> indices =
+            filter.statisticalFilter(Neighbours.getValue(), StdDevRatio.getValue());
+        setPoints(source, &indices);
+    }
+    catch (const Base::Exception& e) {
+        return new App::DocumentObjectExecReturn(e.what());
+    }
+    return App::DocumentObject::StdReturn;
+}
+
+// ----------------------------------------------------------------------
+
+PROPERTY_SOURCE(Points::NormalEstimation, Points::Filter)
+
+NormalEstimation::NormalEstimation()
+{
+    ADD_PROPERTY(Neighbours, (10));
+    ADD_PROPERTY(Viewpoint, (Base::Vector3d()));
+    ADD_PROPERTY(Normal, (Base::Vector3f()));
+    Neighbours.setConstraints(&normalRange);
+}
+
+short NormalEstimation::mustExecute() const
+{
+    if (Neighbours.isTouched() || Viewpoint.isTouched()) {
+        return 1;
+    }
+    return Filter::mustExecute();
+}
+
+App::DocumentObjectExecReturn* NormalEstimation::execute()
+{
+    Feature* source = getSource();
+    if (!source) {
+        return new App::DocumentObjectExecReturn("No points linked");
+    }
+
+    try {
+        // the normals are computed without the placement of the points
+        Base::Vector3d viewpoint;
+        source->Placement.getValue().inverse().multVec(Viewpoint.getValue(), viewpoint);
+
+        PointsFilter filter(source->Points.getValue());
+        std::vector<Base::Vector3f> normals = filter.estimateNormals(
+            Neighbours.getValue(),
+            Base::convertTo<Base::Vector3f>(viewpoint)
+        );
+        setPoints(source, nullptr);
+        Normal.setValues(normals);
+    }
+    catch (const Base::Exception& e) {
+        return new App::DocumentObjectExecReturn(e.what());
+    }
+    return App::DocumentObject::StdReturn;
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include <App/PropertyLinks.h>
+#include <App/PropertyStandard.h>
+#include <App/PropertyUnits.h>
+
+#include "PointsFeature.h"
+#include "Properties.h"
+
+
+namespace Points
+{
+
+/** Base class of the features that compute a point cloud from the linked points feature.
+ * The intensities, colors and normals of the kept points are taken over as well.
+ */
+class PointsExport Filter: public Points::Feature
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(Points::Filter);
+
+public:
+    /// Constructor
+    Filter();
+
+    /** @name Properties */
+    //@{
+    App::PropertyLink Source;
+    //@}
+
+    /** @name methods override Feature */
+    //@{
+    /// recalculate the Feature
+    App::DocumentObjectExecReturn* execute() override;
+    short mustExecute() const override;
+    //@}
+
+protected:
+    /// Returns the linked points feature or null
+    Feature* getSource() const;
+    /// Keeps the points of \a source at \a indices, or all of them if \a indices is null
+    void setPoints(const Feature* source, const std::vector<PointKernel::size_type>* indices);
+};
+
+/**
+ * The VoxelDownsample class keeps one point per cube of a grid.
+ */
+class PointsExport VoxelDownsample: public Filter
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(Points::VoxelDownsample);
+
+public:
+    /// Constructor
+    VoxelDownsample();
+
+    App::PropertyLength VoxelSize;
+
+    /** @name methods override Feature */
+    //@{
+    /// recalculate the Feature
+    App::DocumentObjectExecReturn* execute() override;
+    short mustExecute() const override;
+    //@}
+};
+
+/**
+ * The RadiusOutlierFilter class removes the points with too few neighbours within a radius.
+ */
+class PointsExport RadiusOutlierFilter: public Filter
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(Points::RadiusOutlierFilter);
+
+public:
+    /// Constructor
+    RadiusOutlierFilter();
+
+    App::PropertyLength Radius;
+    App::PropertyIntegerConstraint MinNeighbours;
+
+    /** @name methods override Feature */
+    //@{
+    /// recalculate the Feature
+    App::DocumentObjectExecReturn* execute() override;
+    short mustExecute() const override;
+    //@}
+};
+
+/**
+ * The StatisticalOutlierFilter class removes the points that are far from their neighbours
+ * compared to the other points.
+ */
+class PointsExport StatisticalOutlierFilter: public Filter
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(Points::StatisticalOutlierFilter);
+
+public:
+    /// Constructor
+    StatisticalOutlierFilter();
+
+    App::PropertyIntegerConstraint Neighbours;
+    App::PropertyFloatConstraint StdDevRatio;
+
+    /** @name methods override Feature */
+    //@{
+    /// recalculate the Feature
+    App::DocumentObjectExecReturn* execute() override;
+    short mustExecute() const override;
+    //@}
+};
+
+/**
+ * The NormalEstimation class keeps all points and estimates their normals.
+ */
+class PointsExport NormalEstimation: public Filter
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(Points::NormalEstimation);
+
+public:
+    /// Constructor
+    NormalEstimation();
+
+    App::PropertyIntegerConstraint Neighbours;
+    App::PropertyVector Viewpoint; /**< The normals point towards this position. */
+    PropertyNormalList Normal;
+
+    /** @name methods override Feature */
+    //@{
+    /// recalculate the Feature
+    App::DocumentObjectExecReturn* execute() override;
+    short mustExecute() const override;
+    //@}
+};
+
+}  // namespace Points
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#pragma once
+
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Points
+{
+
+/// Smaller numbers of points are processed by the calling thread
+constexpr std::size_t MinParallelSize = 1 << 16;
+
+/// The items [begin, end) handled by one task
+struct Chunk
+{
+    std::size_t begin {};
+    std::size_t end {};
+};
+
+/// Returns the number of tasks a large job is split into
+inline std::size_t taskCount()
+{
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency()) * 4;
+}
+
+/// Splits \a count items into chunks whose size is a multiple of \a grain. Less than
+/// \a minCount items are kept in a single chunk.
+template<typename T = Chunk>
+std::vector<T> splitChunks(std::size_t count, std::size_t minCount, std::size_t grain = 1)
+{
+    std::size_t tasks = count < minCount ? 1 : taskCount();
+    std::size_t step = (count / tasks + grain) / grain * grain;
+    std::vector<T> chunks;
+    for (std::size_t begin = 0; begin < count; begin += step) {
+        T chunk;
+        chunk.begin = begin;
+        chunk.end = std::min(count, begin + step);
+        chunks.push_back(chunk);
+    }
+    return chunks;
+}
+
+/// Calls \a func for each of the items, in parallel if there is more than one
+template<typename T, typename Func>
+void forEachItem(std::vector<T>& items, Func func)
+{
+    if (items.size() == 1) {
+        func(items.front());
+    }
+    else if (!items.empty()) {
+        QtConcurrent::blockingMap(items, func);
+    }
+}
+
+/// Splits \a count items into chunks as splitChunks() does and calls func(begin, end) for each
+template<typename Func>
+void forEachRange(std::size_t count, std::size_t minCount, Func func)
+{
+    std::vector<Chunk> chunks = splitChunks(count, minCount);
+    forEachItem(chunks, [&func](const Chunk& chunk) {
+        func(chunk.begin, chunk.end);
+    });
+}
+
+/// Sorts the values in parallel, the order of equal values is kept
+template<typename T, typename Less>
+void parallelSort(std::vector<T>& values, Less less)
+{
+    std::size_t parts = 1;
+    if (values.size() >= MinParallelSize) {
+        while (parts < taskCount() / 4) {
+            parts *= 2;
+        }
+    }
+
+    std::vector<std::size_t> bounds(parts + 1);
+    for (std::size_t i = 0; i <= parts; i++) {
+        bounds[i] = values.size() / parts * i + std::min(i, values.size() % parts);
+    }
+
+    T* data = values.data();
+    std::vector<std::size_t> pieces(parts);
+    for (std::size_t i = 0; i < parts; i++) {
+        pieces[i] = i;
+    }
+    forEachItem(pieces, [&](std::size_t i) {
+        std::stable_sort(data + bounds[i], data + bounds[i + 1], less);
+    });
+
+    for (std::size_t width = 1; width < parts; width *= 2) {
+        std::vector<std::size_t> merges;
+        for (std::size_t i = 0; i + width < parts; i += 2 * width) {
+            merges.push_back(i);
+        }
+        forEachItem(merges, [&](std::size_t i) {
+            std::size_t last = std::min(i + 2 * width, parts);
+            std::inplace_merge(
+                data + bounds[i],
+                data + bounds[i + width],
+                data + bounds[last],
+                less
+            );
+        });
+    }
+}
+
+}  // namespace Points
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include "PointKDTree.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+using value_type = PointKDTree::value_type;
+using size_type = PointKDTree::size_type;
+
+// Ranges of at most this many points are leaves
+constexpr size_type LeafSize = 16;
+// Smaller subtrees are built by the calling thread
+constexpr size_type MinParallelSize = 1 << 16;
+
+struct Entry
+{
+    value_type point;
+    size_type index;
+};
+
+// The box that contains the points of a subtree
+struct Cell
+{
+    std::array<float, 3> min;
+    std::array<float, 3> max;
+};
+
+class Builder
+{
+public:
+    Builder(std::vector<Entry>& entries, std::vector<std::uint8_t>& axes)
+        : entries(entries)
+        , axes(axes)
+    {}
+
+    // Arranges the entries from begin to end as the subtree of cell
+    void build(size_type begin, size_type end, const Cell& cell) const
+    {
+        if (end - begin <= LeafSize) {
+            return;
+        }
+
+        // split the longest side of the cell at the median
+        unsigned short axis = 0;
+        for (unsigned short i = 1; i < 3; i++) {
+            if (cell.max[i] - cell.min[i] > cell.max[axis] - cell.min[axis]) {
+                axis = i;
+            }
+        }
+        size_type mid = begin + (end - begin) / 2;
+        Entry* data = entries.data();
+        auto less = [axis](const Entry& a, const Entry& b) {
+            return a.point[axis] < b.point[axis];
+        };
+        std::nth_element(data + begin, data + mid, data + end, less);
+        axes[mid] = static_cast<std::uint8_t>(axis);
+
+        struct Child
+        {
+            size_type begin;
+            size_type end;
+            Cell cell;
+        };
+        float split = entries[mid].point[axis];
+        std::array<Child, 2> children {{{begin, mid, cell}, {mid + 1, end, cell}}};
+        children[0].cell.max[axis] = split;
+        children[1].cell.min[axis] = split;
+
+        auto buildChild = [this](const Child& child) {
+            build(child.begin, child.end, child.cell);
+        };
+        if (end - begin < MinParallelSize) {
+            std::for_each(children.begin(), children.end(), buildChild);
+        }
+        else {
+            QtConcurrent::blockingMap(children, buildChild);
+        }
+    }
+
+private:
+    std::vector<Entry>& entries;
+    std::vector<std::uint8_t>& axes;
+};
+
+}  // namespace
+
+PointKDTree::PointKDTree() = default;
+
+PointKDTree::PointKDTree(const PointKernel& kernel)
+{
+    build(kernel);
+}
+
+void PointKDTree::build(const PointKernel& kernel)
+{
+    const std::vector<value_type>& points = kernel.getBasicPoints();
+    auto isValid = [](const value_type& pnt) {
+        return std::isfinite(pnt.x) && std::isfinite(pnt.y) && std::isfinite(pnt.z);
+    };
+
+    // The box around the valid points
+    std::mutex mutex;
+    Base::BoundBox3f box;
+    size_type valid = 0;
+    kernel.forEachChunk([&](size_type begin, size_type end) {
+        Base::BoundBox3f chunkBox;
+        size_type chunkValid = 0;
+        for (size_type i = begin; i < end; i++) {
+            if (isValid(points[i])) {
+                chunkBox.Add(points[i]);
+                chunkValid++;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (chunkValid > 0) {
+            box.Add(chunkBox);
+        }
+        valid += chunkValid;
+    });
+
+    std::vector<Entry> entries;
+    entries.reserve(valid);
+    for (size_type i = 0; i < points.size(); i++) {
+        if (isValid(points[i])) {
+            entries.push_back({points[i], i});
+        }
+    }
+
+    std::vector<std::uint8_t> axes(entries.size());
+    Cell cell {{box.MinX, box.MinY, box.MinZ}, {box.MaxX, box.MaxY, box.MaxZ}};
+    Builder(entries, axes).build(0, entries.size(), cell);
+
+    std::vector<value_type> sorted(entries.size());
+    std::vector<size_type> indices(entries.size());
+    kernel.forEachChunk([&](size_type begin, size_type end) {
+        for (size_type i = begin; i < std::min(end, entries.size()); i++) {
+            sorted[i] = entries[i].point;
+            indices[i] = entries[i].index;
+        }
+    });
+
+    _Points.swap(sorted);
+    _Indices.swap(indices);
+    _Axes.swap(axes);
+}
+
+template<typename Visit>
+void PointKDTree::search(const value_type& pnt, float& maxDistance2, Visit& visit) const
+{
+    // A subtree together with a lower bound of the squared distance of its points
+    struct Range
+    {
+        size_type begin;
+        size_type end;
+        float distance2;
+    };
+
+    // the far subtrees that still have to be searched, at most one per level
+    std::array<Range, 64> stack {};
+    std::size_t top = 0;
+    stack[top++] = {0, _Points.size(), 0.0F};
+    while (top > 0) {
+        Range range = stack[--top];
+        if (range.distance2 > maxDistance2) {
+            continue;
+        }
+
+        while (range.end - range.begin > LeafSize) {
+            size_type mid = range.begin + (range.end - range.begin) / 2;
+            unsigned short axis = _Axes[mid];
+            visit(mid, Base::DistanceP2(pnt, _Points[mid]));
+
+            float diff = pnt[axis] - _Points[mid][axis];
+            Range left {range.begin, mid, range.distance2};
+            Range right {mid + 1, range.end, range.distance2};
+            Range& nearSide = diff < 0.0F ? left : right;
+            Range& farSide = diff < 0.0F ? right : left;
+            // the points on the far side are at least as far as the split plane
+            farSide.distance2 = std::max(range.distance2, diff * diff);
+            if (farSide.distance2 <= maxDistance2) {
+                stack[top++] = farSide;
+            }
+            range = nearSide;
+        }
+
+        for (size_type i = range.begin; i < range.end; i++) {
+            visit(i, Base::DistanceP2(pnt, _Points[i]));
+        }
+    }
+}
+
+void PointKDTree::nearest(
+    const value_type& pnt,
+    std::size_t count,
+    std::vector<Neighbour>& result
+) const
+{
+    result.clear();
+    if (count == 0) {
+        return;
+    }
+
+    // a max-heap of the nearest points found so far
+    auto nearer = [](const Neighbour& a, const Neighbour& b) {
+        return a.distance2 < b.distance2;
+    };
+    float maxDistance2 = std::numeric_limits<float>::infinity();
+    auto visit = [&](size_type i, float distance2) {
+        if (result.size() < count) {
+            result.push_back({_Indices[i], distance2});
+            std::push_heap(result.begin(), result.end(), nearer);
+        }
+        else if (distance2 < result.front().distance2) {
+            std::pop_heap(result.begin(), result.end(), nearer);
+            result.back() = {_Indices[i], distance2};
+            std::push_heap(result.begin(), result.end(), nearer);
+        }
+        else {
+            return;
+        }
+        if (result.size() == count) {
+            maxDistance2 = result.front().distance2;
+        }
+    };
+    search(pnt, maxDistance2, visit);
+    std::sort_heap(result.begin(), result.end(), nearer);
+}
+
+void PointKDTree::within(
+    const value_type& pnt,
+    float radius,
+    std::vector<Neighbour>& result
+) const
+{
+    result.clear();
+    float maxDistance2 = radius * radius;
+    auto visit = [&](size_type i, float distance2) {
+        if (distance2 <= maxDistance2) {
+            result.push_back({_Indices[i], distance2});
+        }
+    };
+    search(pnt, maxDistance2, visit);
+}
+
+PointKDTree::size_type PointKDTree::countWithin(
+    const value_type& pnt,
+    float radius,
+    size_type limit
+) const
+{
+    size_type count = 0;
+    float radius2 = radius * radius;
+    float maxDistance2 = count < limit ? radius2 : -1.0F;
+    auto visit = [&](size_type /*i*/, float distance2) {
+        if (count < limit && distance2 <= radius2) {
+            count++;
+            if (count == limit) {
+                // nothing left to search
+                maxDistance2 = -1.0F;
+            }
+        }
+    };
+    search(pnt, maxDistance2, visit);
+    return count;
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/** Balanced kd-tree of the valid points of a point kernel.
+ *
+ * The tree is implicit: the points are reordered so that the median of each
+ * range of points splits it into the ranges of the two subtrees, and only the
+ * split axis is stored per node. Small ranges are leaves that are searched
+ * linearly. The tree is built in parallel and all queries are const, so they
+ * can be run from several threads at once.
+ *
+ * The points are taken without the placement of the kernel.
+ */
+class PointsExport PointKDTree
+{
+public:
+    using value_type = PointKernel::value_type;
+    using size_type = PointKernel::size_type;
+
+    /// A point found by a query
+    struct Neighbour
+    {
+        size_type index;  /**< Index of the point in the kernel. */
+        float distance2;  /**< Squared distance to the query point. */
+    };
+
+    PointKDTree();
+    explicit PointKDTree(const PointKernel& kernel);
+
+    /// Builds the tree of the points of \a kernel, points with NaN or infinite coordinates are
+    /// left out
+    void build(const PointKernel& kernel);
+    /// Returns the number of points of the tree
+    size_type size() const
+    {
+        return _Points.size();
+    }
+
+    /** Finds the \a count points nearest to \a pnt, sorted by their distance. A point of the tree
+     * that coincides with \a pnt is found as well.
+     */
+    void nearest(const value_type& pnt, std::size_t count, std::vector<Neighbour>& result) const;
+    /// Finds the points within \a radius of \a pnt in no particular order
+    void within(const value_type& pnt, float radius, std::vector<Neighbour>& result) const;
+    /// Counts the points within \a radius of \a pnt, but stops counting at \a limit
+    size_type countWithin(const value_type& pnt, float radius, size_type limit) const;
+
+private:
+    template<typename Visit>
+    void search(const value_type& pnt, float& maxDistance2, Visit& visit) const;
+
+private:
+    std::vector<value_type> _Points;
+    std::vector<size_type> _Indices;
+    /// The split axis of the node whose median is at the same index
+    std::vector<std::uint8_t> _Axes;
+};
+
+}  // namespace Points
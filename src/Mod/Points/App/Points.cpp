@@ -22,24 +22,25 @@
  *                                                                         *
  ***************************************************************************/
 
-#include <QtConcurrentMap>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
 
 
 #include <Base/Matrix.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
 
+#include "Parallel.h"
 #include "Points.h"
 #include "PointsAlgos.h"
 
 
-#ifdef _MSC_VER
-# include <ppl.h>
-#endif
-
 using namespace Points;
 using namespace std;
 
@@ -81,58 +82,367 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
     return nullptr;
 }
 
+namespace
+{
+
+// The loops below are written so that the compiler can vectorize them, see FC_SIMD_CLONES
+
+using float_type = PointKernel::float_type;
+using value_type = PointKernel::value_type;
+
+// Number of points of a block. The transformed coordinates of a block are kept in separate
+// arrays, so that the reductions over them vectorize.
+constexpr std::size_t BlockSize = 512;
+
+struct Block
+{
+    alignas(64) double x[BlockSize];
+    alignas(64) double y[BlockSize];
+    alignas(64) double z[BlockSize];
+};
+
+// Upper 3x4 part of a placement matrix
+struct Affine
+{
+    explicit Affine(const Base::Matrix4D& mat)
+    {
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 4; j++) {
+                m[i][j] = mat[i][j];
+            }
+        }
+    }
+    // Whether the matrix only scales and moves, so that the bounds of the transformed points
+    // follow from the bounds of the untransformed ones
+    bool isAxisAligned() const
+    {
+        return m[0][1] == 0.0 && m[0][2] == 0.0 && m[1][0] == 0.0 && m[1][2] == 0.0
+            && m[2][0] == 0.0 && m[2][1] == 0.0;
+    }
+
+    double m[3][4] {};
+};
+
+FC_SIMD_CLONES void transformPoints(const Affine& mat, value_type* pts, std::size_t count)
+{
+    const double m00 = mat.m[0][0], m01 = mat.m[0][1], m02 = mat.m[0][2], m03 = mat.m[0][3];
+    const double m10 = mat.m[1][0], m11 = mat.m[1][1], m12 = mat.m[1][2], m13 = mat.m[1][3];
+    const double m20 = mat.m[2][0], m21 = mat.m[2][1], m22 = mat.m[2][2], m23 = mat.m[2][3];
+    for (std::size_t i = 0; i < count; i++) {
+        double sx = pts[i].x;
+        double sy = pts[i].y;
+        double sz = pts[i].z;
+        pts[i].x = static_cast<float>(m00 * sx + m01 * sy + m02 * sz + m03);
+        pts[i].y = static_cast<float>(m10 * sx + m11 * sy + m12 * sz + m13);
+        pts[i].z = static_cast<float>(m20 * sx + m21 * sy + m22 * sz + m23);
+    }
+}
+
+FC_SIMD_CLONES void movePoints(const value_type& offset, value_type* pts, std::size_t count)
+{
+    const float ox = offset.x;
+    const float oy = offset.y;
+    const float oz = offset.z;
+    for (std::size_t i = 0; i < count; i++) {
+        pts[i].x += ox;
+        pts[i].y += oy;
+        pts[i].z += oz;
+    }
+}
+
+FC_SIMD_CLONES void transformPoints(
+    const Affine& mat,
+    const value_type* pts,
+    std::size_t count,
+    Base::Vector3d* out
+)
+{
+    const double m00 = mat.m[0][0], m01 = mat.m[0][1], m02 = mat.m[0][2], m03 = mat.m[0][3];
+    const double m10 = mat.m[1][0], m11 = mat.m[1][1], m12 = mat.m[1][2], m13 = mat.m[1][3];
+    const double m20 = mat.m[2][0], m21 = mat.m[2][1], m22 = mat.m[2][2], m23 = mat.m[2][3];
+    for (std::size_t i = 0; i < count; i++) {
+        double sx = pts[i].x;
+        double sy = pts[i].y;
+        double sz = pts[i].z;
+        out[i].x = m00 * sx + m01 * sy + m02 * sz + m03;
+        out[i].y = m10 * sx + m11 * sy + m12 * sz + m13;
+        out[i].z = m20 * sx + m21 * sy + m22 * sz + m23;
+    }
+}
+
+// Transforms up to BlockSize points into the separate coordinate arrays of a block
+FC_SIMD_CLONES void loadBlock(
+    const Affine& mat,
+    const value_type* pts,
+    std::size_t count,
+    Block& blk
+)
+{
+    const double m00 = mat.m[0][0], m01 = mat.m[0][1], m02 = mat.m[0][2], m03 = mat.m[0][3];
+    const double m10 = mat.m[1][0], m11 = mat.m[1][1], m12 = mat.m[1][2], m13 = mat.m[1][3];
+    const double m20 = mat.m[2][0], m21 = mat.m[2][1], m22 = mat.m[2][2], m23 = mat.m[2][3];
+    for (std::size_t i = 0; i < count; i++) {
+        double sx = pts[i].x;
+        double sy = pts[i].y;
+        double sz = pts[i].z;
+        blk.x[i] = m00 * sx + m01 * sy + m02 * sz + m03;
+        blk.y[i] = m10 * sx + m11 * sy + m12 * sz + m13;
+        blk.z[i] = m20 * sx + m21 * sy + m22 * sz + m23;
+    }
+}
+
+// Number of independent accumulators of the reductions, two AVX2 registers of doubles
+constexpr std::size_t Lanes = 8;
+
+// Like BoundBox3d::Add() the comparisons skip NaN coordinates
+FC_SIMD_CLONES void boundBlock(const double* val, std::size_t count, double* lo, double* hi)
+{
+    double l[Lanes];
+    double h[Lanes];
+    std::copy(lo, lo + Lanes, l);
+    std::copy(hi, hi + Lanes, h);
+    std::size_t i = 0;
+    for (; i + Lanes <= count; i += Lanes) {
+        for (std::size_t k = 0; k < Lanes; k++) {
+            l[k] = val[i + k] < l[k] ? val[i + k] : l[k];
+            h[k] = val[i + k] > h[k] ? val[i + k] : h[k];
+        }
+    }
+    for (std::size_t k = 0; i < count; i++, k++) {
+        l[k] = val[i] < l[k] ? val[i] : l[k];
+        h[k] = val[i] > h[k] ? val[i] : h[k];
+    }
+    std::copy(l, l + Lanes, lo);
+    std::copy(h, h + Lanes, hi);
+}
+
+// Bounds of the coordinates of count points stored one after another, lane k of lo and hi
+// collects the coordinate k % 3
+constexpr std::size_t CoordLanes = 3 * Lanes;
+
+FC_SIMD_CLONES void boundPoints(const value_type* pts, std::size_t count, float* lo, float* hi)
+{
+    static_assert(sizeof(value_type) == 3 * sizeof(float_type));
+    const auto* val = reinterpret_cast<const float_type*>(pts);  // NOLINT
+    std::size_t num = 3 * count;
+    float l[CoordLanes];
+    float h[CoordLanes];
+    std::copy(lo, lo + CoordLanes, l);
+    std::copy(hi, hi + CoordLanes, h);
+    std::size_t i = 0;
+    for (; i + CoordLanes <= num; i += CoordLanes) {
+        for (std::size_t k = 0; k < CoordLanes; k++) {
+            l[k] = val[i + k] < l[k] ? val[i + k] : l[k];
+            h[k] = val[i + k] > h[k] ? val[i + k] : h[k];
+        }
+    }
+    for (std::size_t k = 0; i < num; i++, k++) {
+        l[k] = val[i] < l[k] ? val[i] : l[k];
+        h[k] = val[i] > h[k] ? val[i] : h[k];
+    }
+    std::copy(l, l + CoordLanes, lo);
+    std::copy(h, h + CoordLanes, hi);
+}
+
+FC_SIMD_CLONES void nearestInBlock(
+    const Block& blk,
+    std::size_t count,
+    std::size_t offset,
+    const Base::Vector3d& pnt,
+    double* best,
+    std::size_t* index
+)
+{
+    const double px = pnt.x;
+    const double py = pnt.y;
+    const double pz = pnt.z;
+    double b[Lanes];
+    std::size_t n[Lanes];
+    std::copy(best, best + Lanes, b);
+    std::copy(index, index + Lanes, n);
+    std::size_t i = 0;
+    for (; i + Lanes <= count; i += Lanes) {
+        for (std::size_t k = 0; k < Lanes; k++) {
+            double dx = blk.x[i + k] - px;
+            double dy = blk.y[i + k] - py;
+            double dz = blk.z[i + k] - pz;
+            double dist = dx * dx + dy * dy + dz * dz;
+            n[k] = dist < b[k] ? offset + i + k : n[k];
+            b[k] = dist < b[k] ? dist : b[k];
+        }
+    }
+    for (std::size_t k = 0; i < count; i++, k++) {
+        double dx = blk.x[i] - px;
+        double dy = blk.y[i] - py;
+        double dz = blk.z[i] - pz;
+        double dist = dx * dx + dy * dy + dz * dz;
+        n[k] = dist < b[k] ? offset + i : n[k];
+        b[k] = dist < b[k] ? dist : b[k];
+    }
+    std::copy(b, b + Lanes, best);
+    std::copy(n, n + Lanes, index);
+}
+
+// A range of points handled by one task together with its partial result
+struct Range
+{
+    std::size_t begin {};
+    std::size_t end {};
+    Base::BoundBox3d box;
+    double distance {std::numeric_limits<double>::max()};
+    std::size_t index {std::numeric_limits<std::size_t>::max()};
+};
+
+// Splits count points into ranges of whole blocks and calls func for each of them
+template<typename Func>
+std::vector<Range> forEachBlockRange(std::size_t count, Func func)
+{
+    auto ranges = splitChunks<Range>(count, MinParallelSize, BlockSize);
+    forEachItem(ranges, func);
+    return ranges;
+}
+
+}  // namespace
+
 void PointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
-    std::vector<value_type>& kernel = getBasicPoints();
-#ifdef _MSC_VER
-    // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we
-    // cannot use QtConcurrent We could also rewrite Points to leverage SIMD instructions Other
-    // option: openMP. But with VC2013 results in high CPU usage even after computation (busy-waits
-    // for >100ms)
-    Concurrency::parallel_for_each(kernel.begin(), kernel.end(), [rclMat](value_type& value) {
-        value = rclMat * value;
+    Affine mat(rclMat);
+    value_type* pts = _Points.data();
+    forEachBlockRange(_Points.size(), [&mat, pts](Range& range) {
+        transformPoints(mat, pts + range.begin, range.end - range.begin);
     });
-#else
-    QtConcurrent::blockingMap(kernel, [rclMat](value_type& value) { rclMat.multVec(value, value); });
-#endif
 }
 
 void PointKernel::moveGeometry(const Base::Vector3d& vec)
 {
-    Base::Vector3f offset = Base::toVector<float>(vec);
-    std::vector<value_type>& kernel = getBasicPoints();
-#ifdef _MSC_VER
-    Concurrency::parallel_for_each(kernel.begin(), kernel.end(), [offset](value_type& value) {
-        value += offset;
+    value_type offset = Base::toVector<float_type>(vec);
+    value_type* pts = _Points.data();
+    forEachBlockRange(_Points.size(), [&offset, pts](Range& range) {
+        movePoints(offset, pts + range.begin, range.end - range.begin);
     });
-#else
-    QtConcurrent::blockingMap(kernel, [offset](value_type& value) { value += offset; });
-#endif
 }
 
 Base::BoundBox3d PointKernel::getBoundBox() const
 {
-    Base::BoundBox3d bnd;
+    Affine mat(_Mtrx);
+    const value_type* pts = _Points.data();
+    auto ranges = forEachBlockRange(_Points.size(), [&mat, pts](Range& range) {
+        if (mat.isAxisAligned()) {
+            constexpr float max = std::numeric_limits<float>::max();
+            float lo[CoordLanes];
+            float hi[CoordLanes];
+            std::fill(lo, lo + CoordLanes, max);
+            std::fill(hi, hi + CoordLanes, -max);
+            boundPoints(pts + range.begin, range.end - range.begin, lo, hi);
+
+            double bounds[3][2];
+            for (std::size_t i = 0; i < 3; i++) {
+                float l = max;
+                float h = -max;
+                for (std::size_t k = i; k < CoordLanes; k += 3) {
+                    l = std::min(l, lo[k]);
+                    h = std::max(h, hi[k]);
+                }
+                if (l > h) {
+                    return;  // no valid coordinate
+                }
+                double scale = mat.m[i][i];
+                double a = scale * static_cast<double>(l) + mat.m[i][3];
+                double b = scale * static_cast<double>(h) + mat.m[i][3];
+                bounds[i][0] = std::min(a, b);
+                bounds[i][1] = std::max(a, b);
+            }
+            range.box = Base::BoundBox3d(
+                bounds[0][0],
+                bounds[1][0],
+                bounds[2][0],
+                bounds[0][1],
+                bounds[1][1],
+                bounds[2][1]
+            );
+            return;
+        }
 
-#ifdef _MSC_VER
-    // Thread-local bounding boxes
-    Concurrency::combinable<Base::BoundBox3d> bbs;
-    // Cannot use a const_point_iterator here as it is *not* a proper iterator (fails the for_each
-    // template)
-    Concurrency::parallel_for_each(_Points.begin(), _Points.end(), [this, &bbs](const value_type& value) {
-        Base::Vector3d vertd(value.x, value.y, value.z);
-        bbs.local().Add(this->_Mtrx * vertd);
+        constexpr double max = std::numeric_limits<double>::max();
+        double lo[3][Lanes];
+        double hi[3][Lanes];
+        std::fill(&lo[0][0], &lo[0][0] + 3 * Lanes, max);
+        std::fill(&hi[0][0], &hi[0][0] + 3 * Lanes, -max);
+
+        auto blk = std::make_unique<Block>();
+        for (std::size_t i = range.begin; i < range.end; i += BlockSize) {
+            std::size_t count = std::min(BlockSize, range.end - i);
+            loadBlock(mat, pts + i, count, *blk);
+            boundBlock(blk->x, count, lo[0], hi[0]);
+            boundBlock(blk->y, count, lo[1], hi[1]);
+            boundBlock(blk->z, count, lo[2], hi[2]);
+        }
+
+        Base::BoundBox3d& box = range.box;
+        for (std::size_t k = 0; k < Lanes; k++) {
+            box.MinX = std::min(box.MinX, lo[0][k]);
+            box.MinY = std::min(box.MinY, lo[1][k]);
+            box.MinZ = std::min(box.MinZ, lo[2][k]);
+            box.MaxX = std::max(box.MaxX, hi[0][k]);
+            box.MaxY = std::max(box.MaxY, hi[1][k]);
+            box.MaxZ = std::max(box.MaxZ, hi[2][k]);
+        }
     });
-    // Combine each thread-local bounding box in the final bounding box
-    bbs.combine_each([&bnd](const Base::BoundBox3d& lbb) { bnd.Add(lbb); });
-#else
-    for (const auto& it : *this) {
-        bnd.Add(it);
+
+    Base::BoundBox3d bnd;
+    for (const auto& range : ranges) {
+        bnd.Add(range.box);
     }
-#endif
     return bnd;
 }
 
+PointKernel::size_type PointKernel::nearestPoint(const Base::Vector3d& pnt, double* distance) const
+{
+    Affine mat(_Mtrx);
+    const value_type* pts = _Points.data();
+    auto ranges = forEachBlockRange(_Points.size(), [&mat, &pnt, pts](Range& range) {
+        double best[Lanes];
+        std::size_t index[Lanes];
+        std::fill(best, best + Lanes, std::numeric_limits<double>::max());
+        std::fill(index, index + Lanes, std::numeric_limits<std::size_t>::max());
+
+        auto blk = std::make_unique<Block>();
+        for (std::size_t i = range.begin; i < range.end; i += BlockSize) {
+            std::size_t count = std::min(BlockSize, range.end - i);
+            loadBlock(mat, pts + i, count, *blk);
+            nearestInBlock(*blk, count, i, pnt, best, index);
+        }
+
+        // Prefer the lower index on ties, like a sequential search
+        for (std::size_t k = 0; k < Lanes; k++) {
+            if (best[k] < range.distance || (best[k] == range.distance && index[k] < range.index)) {
+                range.distance = best[k];
+                range.index = index[k];
+            }
+        }
+    });
+
+    size_type index = size();
+    double best = std::numeric_limits<double>::max();
+    for (const auto& range : ranges) {
+        if (range.distance < best) {
+            best = range.distance;
+            index = range.index;
+        }
+    }
+    if (distance && index < size()) {
+        *distance = std::sqrt(best);
+    }
+    return index;
+}
+
+void PointKernel::forEachChunk(const std::function<void(size_type, size_type)>& func) const
+{
+    forEachBlockRange(_Points.size(), [&func](Range& range) {
+        func(range.begin, range.end);
+    });
+}
+
 PointKernel& PointKernel::operator=(const PointKernel& Kernel)
 {
     if (this != &Kernel) {
@@ -224,20 +534,44 @@ void PointKernel::Restore(Base::XMLReader& reader)
     }
 }
 
-void PointKernel::RestoreDocFile(Base::Reader& reader)
+namespace
+{
+void readPoints(std::istream& in, std::vector<PointKernel::value_type>& points)
 {
-    Base::InputStream str(reader);
+    Base::InputStream str(in);
     uint32_t uCt = 0;
     str >> uCt;
-    _Points.resize(uCt);
+    points.resize(uCt);
     for (unsigned long i = 0; i < uCt; i++) {
         float x {};
         float y {};
         float z {};
         str >> x >> y >> z;
-        _Points[i].Set(x, y, z);
+        points[i].Set(x, y, z);
     }
 }
+}  // namespace
+
+void PointKernel::RestoreDocFile(Base::Reader& reader)
+{
+    readPoints(reader, _Points);
+}
+
+std::function<std::function<void()>()> PointKernel::getRestoreDocFileJob(Base::Reader& reader)
+{
+    auto data = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(reader),
+        std::istreambuf_iterator<char>()
+    );
+    return [this, data]() -> std::function<void()> {
+        auto points = std::make_shared<std::vector<value_type>>();
+        std::istringstream str(*data);
+        readPoints(str, *points);
+        return [this, points]() {
+            swap(*points);
+        };
+    };
+}
 
 void PointKernel::save(const char* file) const
 {
@@ -265,11 +599,14 @@ void PointKernel::getPoints(
     uint16_t /*flags*/
 ) const
 {
-    unsigned long ctpoints = _Points.size();
-    Points.reserve(ctpoints);
-    for (unsigned long i = 0; i < ctpoints; i++) {
-        Points.push_back(this->getPoint(i));
-    }
+    Affine mat(_Mtrx);
+    const value_type* pts = _Points.data();
+    std::size_t offset = Points.size();
+    Points.resize(offset + _Points.size());
+    Base::Vector3d* out = Points.data() + offset;
+    forEachBlockRange(_Points.size(), [&mat, pts, out](Range& range) {
+        transformPoints(mat, pts + range.begin, range.end - range.begin, out + range.begin);
+    });
 }
 
 // ----------------------------------------------------------------------------
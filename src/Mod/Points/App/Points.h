@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <functional>
 #include <iterator>
 #include <vector>
 
@@ -111,6 +112,12 @@ public:
     void transformGeometry(const Base::Matrix4D& rclMat) override;
     void moveGeometry(const Base::Vector3d& vec);
     Base::BoundBox3d getBoundBox() const override;
+    /// Returns the index of the point nearest to \a pnt and optionally its distance, or size()
+    /// if there is no such point
+    size_type nearestPoint(const Base::Vector3d& pnt, double* distance = nullptr) const;
+    /// Calls \a func with the begin and end index of consecutive chunks of the points. The
+    /// chunks of a large kernel are processed in parallel.
+    void forEachChunk(const std::function<void(size_type, size_type)>& func) const;
 
     /** @name I/O */
     //@{
@@ -120,6 +127,7 @@ public:
     void SaveDocFile(Base::Writer& writer) const override;
     void Restore(Base::XMLReader& reader) override;
     void RestoreDocFile(Base::Reader& reader) override;
+    std::function<std::function<void()>()> getRestoreDocFileJob(Base::Reader& reader) override;
     void save(const char* file) const;
     void save(std::ostream&) const;
     void load(const char* file);
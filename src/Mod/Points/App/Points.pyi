@@ -60,6 +60,38 @@ class Points(object):
     def fromValid(self) -> Any:
         """Get a new point object from points with valid coordinates (i.e. that are not NaN)"""
         ...
+
+    @constmethod
+    def downsample(self) -> Any:
+        """downsample(voxelSize) -> Points
+
+        Get a new point object that keeps one point per cube of a grid with the given edge length"""
+        ...
+
+    @constmethod
+    def radiusFilter(self) -> Any:
+        """radiusFilter(radius, minNeighbours) -> Points
+
+        Get a new point object without the points that have fewer than minNeighbours other
+        points within radius"""
+        ...
+
+    @constmethod
+    def statisticalFilter(self) -> Any:
+        """statisticalFilter(neighbours, stdDevRatio) -> Points
+
+        Get a new point object without the points whose mean distance to their nearest neighbours
+        exceeds the average by more than stdDevRatio standard deviations"""
+        ...
+
+    @constmethod
+    def estimateNormals(self) -> Any:
+        """estimateNormals(neighbours, [viewpoint]) -> list
+
+        Estimate the normals of the points from their nearest neighbours. The normals point
+        towards the viewpoint, which is the origin by default. Points with NaN coordinates get a
+        null vector."""
+        ...
     CountPoints: Final[int]
     """Return the number of vertices of the points object."""
 
@@ -27,13 +27,26 @@
 #ifdef FC_OS_LINUX
 # include <unistd.h>
 #endif
+#include <QFile>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <sstream>
+#include <string_view>
+#include <thread>
+#include <version>
 
+#include <Eigen/Core>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
-#include <boost/regex.hpp>
 
 #include <Base/Console.h>
 #include <Base/Converter.h>
@@ -41,13 +54,499 @@
 #include <Base/FileInfo.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 
+#include "Parallel.h"
 #include "PointsAlgos.h"
 #include <E57Format.h>
 
 
 using namespace Points;
 
+namespace
+{
+
+// Text is split into ranges of at least this many bytes
+constexpr std::size_t MinTextSize = 1 << 20;
+// The characters that separate the numbers of a line
+constexpr std::string_view Blanks = " \t\r\f\v";
+constexpr std::size_t NoField = std::numeric_limits<std::size_t>::max();
+
+// Splits text at line breaks into ranges that can be parsed in parallel
+std::vector<std::string_view> splitLines(std::string_view text)
+{
+    std::vector<std::string_view> ranges;
+    std::size_t step = std::max(text.size() / taskCount() + 1, MinTextSize);
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = text.find('\n', std::min(begin + step, text.size()) - 1);
+        end = end == std::string_view::npos ? text.size() : end + 1;
+        ranges.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return ranges;
+}
+
+// Calls func for each line of text without the line break
+template<typename Func>
+void forEachLine(std::string_view text, Func func)
+{
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        func(text.substr(0, end));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(end + 1);
+    }
+}
+
+bool isBlank(std::string_view line)
+{
+    return line.find_first_not_of(Blanks) == std::string_view::npos;
+}
+
+// Calls func for each of the numbers of line
+template<typename Func>
+void forEachToken(std::string_view line, Func func)
+{
+    std::size_t pos = line.find_first_not_of(Blanks);
+    while (pos != std::string_view::npos) {
+        std::size_t end = line.find_first_of(Blanks, pos);
+        func(line.substr(pos, end - pos));
+        pos = line.find_first_not_of(Blanks, end);
+    }
+}
+
+// Parses token as a number, returns false if it is not a number as a whole
+bool parseNumber(std::string_view token, double& value)
+{
+    // std::from_chars() doesn't accept a leading plus sign
+    if (token.size() > 1 && token.front() == '+') {
+        token.remove_prefix(1);
+    }
+    const char* end = token.data() + token.size();
+#if defined(__cpp_lib_to_chars)
+    auto [ptr, ec] = std::from_chars(token.data(), end, value);
+    return ec == std::errc() && ptr == end;
+#else
+    // some standard libraries can't parse floating point numbers with std::from_chars()
+    std::string str(token);
+    char* ptr = nullptr;
+    value = std::strtod(str.c_str(), &ptr);
+    return !str.empty() && ptr == str.c_str() + str.size();
+#endif
+}
+
+// Whether token is a decimal number like [-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?
+bool isDecimal(std::string_view token)
+{
+    std::size_t pos = 0;
+    auto skipSign = [&token, &pos]() {
+        if (pos < token.size() && (token[pos] == '-' || token[pos] == '+')) {
+            pos++;
+        }
+    };
+    auto skipDigits = [&token, &pos]() {
+        std::size_t start = pos;
+        while (pos < token.size() && token[pos] >= '0' && token[pos] <= '9') {
+            pos++;
+        }
+        return pos - start;
+    };
+
+    skipSign();
+    std::size_t digits = skipDigits();
+    if (pos < token.size() && token[pos] == '.') {
+        pos++;
+        digits = skipDigits();
+    }
+    if (digits == 0) {
+        return false;
+    }
+    if (pos < token.size() && (token[pos] == 'e' || token[pos] == 'E')) {
+        pos++;
+        skipSign();
+        if (skipDigits() == 0) {
+            return false;
+        }
+    }
+    return pos == token.size();
+}
+
+/** The rest of a file after the current position of a stream. The file is memory-mapped if
+ * possible and read into memory otherwise.
+ */
+class FileBody
+{
+public:
+    FileBody(const Base::FileInfo& fi, std::istream& inp)
+        : file(QString::fromUtf8(fi.filePath().c_str()))
+    {
+        std::streamoff pos = inp.tellg();
+        if (pos >= 0 && file.open(QIODevice::ReadOnly) && file.size() > pos) {
+            qint64 size = file.size() - pos;
+            if (uchar* mem = file.map(pos, size)) {
+                ptr = reinterpret_cast<const char*>(mem);  // NOLINT
+                len = static_cast<std::size_t>(size);
+                return;
+            }
+        }
+        buffer.assign(std::istreambuf_iterator<char>(inp), std::istreambuf_iterator<char>());
+        ptr = buffer.data();
+        len = buffer.size();
+    }
+
+    const char* data() const
+    {
+        return ptr;
+    }
+    std::size_t size() const
+    {
+        return len;
+    }
+    std::string_view text() const
+    {
+        return {ptr, len};
+    }
+
+private:
+    QFile file;
+    std::vector<char> buffer;
+    const char* ptr {nullptr};
+    std::size_t len {0};
+};
+
+// A number of a binary record
+struct BinaryField
+{
+    char type {};            // 'I', 'U' or 'F'
+    std::size_t size {};
+    std::size_t offset {};   // position of the number of the first record
+    std::size_t stride {};   // distance of the numbers of consecutive records
+
+    template<typename T>
+    double load(const char* data, std::size_t index, bool swap) const
+    {
+        T value;
+        std::memcpy(&value, data + offset + index * stride, sizeof(T));
+        if (swap) {
+            Base::SwapEndian(value);
+        }
+        return static_cast<double>(value);
+    }
+
+    double value(const char* data, std::size_t index, bool swap) const
+    {
+        switch (size) {
+            case 1:
+                return type == 'I' ? load<std::int8_t>(data, index, swap)
+                                   : load<std::uint8_t>(data, index, swap);
+            case 2:
+                return type == 'I' ? load<std::int16_t>(data, index, swap)
+                                   : load<std::uint16_t>(data, index, swap);
+            case 4:
+                if (type == 'I') {
+                    return load<std::int32_t>(data, index, swap);
+                }
+                if (type == 'U') {
+                    return load<std::uint32_t>(data, index, swap);
+                }
+                return load<float>(data, index, swap);
+            default:
+                return load<double>(data, index, swap);
+        }
+    }
+};
+
+BinaryField makeField(char type, int size)
+{
+    bool integer = type == 'I' || type == 'U';
+    bool valid = false;
+    switch (size) {
+        case 1:
+        case 2:
+            valid = integer;
+            break;
+        case 4:
+            valid = integer || type == 'F';
+            break;
+        case 8:
+            valid = type == 'F';
+            break;
+        default:
+            break;
+    }
+    if (!valid) {
+        throw Base::BadFormatError("Unexpected type");
+    }
+
+    BinaryField field;
+    field.type = type;
+    field.size = static_cast<std::size_t>(size);
+    return field;
+}
+
+/** Sets the positions of the numbers of numPoints records that are stored one record after
+ * another, or one field after another if \a byField is true. Returns the size of a record.
+ */
+std::size_t layoutFields(std::vector<BinaryField>& fields, bool byField, std::size_t numPoints)
+{
+    std::size_t recordSize = 0;
+    for (const auto& field : fields) {
+        recordSize += field.size;
+    }
+    std::size_t offset = 0;
+    for (auto& field : fields) {
+        field.offset = offset;
+        field.stride = byField ? field.size : recordSize;
+        offset += byField ? field.size * numPoints : field.size;
+    }
+    return recordSize;
+}
+
+// Returns the type letter of PCD files for a number type of PLY files
+char plyType(const std::string& type)
+{
+    if (type == "char" || type == "int8" || type == "short" || type == "int16" || type == "int"
+        || type == "int32") {
+        return 'I';
+    }
+    if (type == "float" || type == "float32" || type == "double" || type == "float64") {
+        return 'F';
+    }
+    return 'U';
+}
+
+std::size_t findField(
+    const std::vector<std::string>& fields,
+    std::initializer_list<const char*> names
+)
+{
+    for (const char* name : names) {
+        auto it = std::ranges::find(fields, name);
+        if (it != fields.end()) {
+            return static_cast<std::size_t>(std::distance(fields.begin(), it));
+        }
+    }
+    return NoField;
+}
+
+/** The kernel and the property arrays a reader decodes into. They are allocated in advance
+ * so that the points can be decoded in parallel.
+ */
+class PointTarget
+{
+public:
+    enum class ColorType
+    {
+        None,
+        Byte,
+        Float,
+        PackedInt,
+        PackedFloat
+    };
+
+    explicit PointTarget(const std::vector<std::string>& fields)
+        : x {findField(fields, {"x"})}
+        , y {findField(fields, {"y"})}
+        , z {findField(fields, {"z"})}
+        , nx {findField(fields, {"normal_x", "nx"})}
+        , ny {findField(fields, {"normal_y", "ny"})}
+        , nz {findField(fields, {"normal_z", "nz"})}
+        , grey {findField(fields, {"intensity"})}
+        , red {findField(fields, {"red"})}
+        , green {findField(fields, {"green"})}
+        , blue {findField(fields, {"blue"})}
+        , alpha {findField(fields, {"alpha"})}
+        , packed {findField(fields, {"rgb", "rgba"})}
+    {}
+
+    /// Returns the red field if there are red, green and blue fields, or NoField
+    std::size_t rgbField() const
+    {
+        return green != NoField && blue != NoField ? red : NoField;
+    }
+    /// Returns the field of packed colors, or NoField
+    std::size_t packedField() const
+    {
+        return packed;
+    }
+
+    // Allocates numPoints elements of the arrays whose fields exist, nothing without points
+    void allocate(
+        std::size_t numPoints,
+        ColorType type,
+        Points::PointKernel& kernel,
+        std::vector<Base::Vector3f>& normals,
+        std::vector<float>& intensity,
+        std::vector<Base::Color>& colors
+    )
+    {
+        if (x == NoField || y == NoField || z == NoField) {
+            return;
+        }
+        kernel.resize(numPoints);
+        pnts = kernel.getBasicPoints().data();
+        if (nx != NoField && ny != NoField && nz != NoField) {
+            normals.resize(numPoints);
+            nrms = normals.data();
+        }
+        if (grey != NoField) {
+            intensity.resize(numPoints);
+            greys = intensity.data();
+        }
+        if (type != ColorType::None) {
+            colors.resize(numPoints);
+            cols = colors.data();
+            colorType = type;
+        }
+    }
+
+    // Sets point i, value(j) returns the number of field j
+    template<typename Value>
+    void set(std::size_t i, const Value& value) const
+    {
+        if (!pnts) {
+            return;
+        }
+        auto num = [&value](std::size_t j) {
+            return static_cast<float>(value(j));
+        };
+        // the kernel of a reader has no placement
+        pnts[i].Set(num(x), num(y), num(z));
+        if (nrms) {
+            nrms[i].Set(num(nx), num(ny), num(nz));
+        }
+        if (greys) {
+            greys[i] = num(grey);
+        }
+
+        float a = 1.0F;
+        std::uint32_t argb {};
+        switch (colorType) {
+            case ColorType::Byte:
+                if (alpha != NoField) {
+                    a = num(alpha);
+                }
+                cols[i] = Base::Color(
+                    num(red) / 255.0F,
+                    num(green) / 255.0F,
+                    num(blue) / 255.0F,
+                    a / 255.0F
+                );
+                break;
+            case ColorType::Float:
+                if (alpha != NoField) {
+                    a = num(alpha);
+                }
+                cols[i] = Base::Color(num(red), num(green), num(blue), a);
+                break;
+            case ColorType::PackedInt:
+                cols[i].setPackedARGB(static_cast<std::uint32_t>(value(packed)));
+                break;
+            case ColorType::PackedFloat:
+                a = num(packed);
+                std::memcpy(&argb, &a, sizeof(argb));
+                cols[i].setPackedARGB(argb);
+                break;
+            case ColorType::None:
+                break;
+        }
+    }
+
+private:
+    std::size_t x, y, z;
+    std::size_t nx, ny, nz;
+    std::size_t grey;
+    std::size_t red, green, blue, alpha;
+    std::size_t packed;
+    ColorType colorType {ColorType::None};
+    Base::Vector3f* pnts {nullptr};
+    Base::Vector3f* nrms {nullptr};
+    float* greys {nullptr};
+    Base::Color* cols {nullptr};
+};
+
+static_assert(sizeof(float) == sizeof(std::uint32_t), "float and uint32_t have different sizes");
+
+/** Parses the lines of \a text that are not blank as records of \a numFields numbers and
+ * decodes the records from \a skip to \a skip + \a numPoints into \a target. Returns false if
+ * a value is not a number.
+ */
+bool decodeAscii(
+    std::string_view text,
+    std::size_t skip,
+    std::size_t numPoints,
+    std::size_t numFields,
+    const PointTarget& target
+)
+{
+    std::vector<std::string_view> ranges = splitLines(text);
+
+    // the number of the first record of each range
+    std::vector<std::size_t> first(ranges.size() + 1, 0);
+    forEachRange(ranges.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; k++) {
+            forEachLine(ranges[k], [&first, k](std::string_view line) {
+                if (!isBlank(line)) {
+                    first[k + 1]++;
+                }
+            });
+        }
+    });
+    std::partial_sum(first.begin(), first.end(), first.begin());
+
+    // an exception must not leave a parallel task
+    std::atomic<bool> valid {true};
+    forEachRange(ranges.size(), 1, [&](std::size_t begin, std::size_t end) {
+        std::vector<double> values(numFields);
+        for (std::size_t k = begin; k < end && first[k] < skip + numPoints; k++) {
+            std::size_t record = first[k];
+            forEachLine(ranges[k], [&](std::string_view line) {
+                if (isBlank(line)) {
+                    return;
+                }
+                std::size_t index = record++;
+                if (index < skip || index >= skip + numPoints) {
+                    return;
+                }
+                std::fill(values.begin(), values.end(), 0.0);
+                std::size_t col = 0;
+                forEachToken(line, [&](std::string_view token) {
+                    if (col < numFields && !parseNumber(token, values[col++])) {
+                        valid = false;
+                    }
+                });
+                target.set(index - skip, [&values](std::size_t j) {
+                    return values[j];
+                });
+            });
+        }
+    });
+    return valid;
+}
+
+// Decodes numPoints binary records of fields from data into target
+void decodeBinary(
+    const char* data,
+    std::size_t numPoints,
+    const std::vector<BinaryField>& fields,
+    bool swap,
+    const PointTarget& target
+)
+{
+    forEachRange(numPoints, MinParallelSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            target.set(i, [&fields, data, i, swap](std::size_t j) {
+                return fields[j].value(data, i, swap);
+            });
+        }
+    });
+}
+
+}  // namespace
+
 void PointsAlgos::Load(PointKernel& points, const char* FileName)
 {
     Base::FileInfo File(FileName);
@@ -67,62 +566,68 @@ void PointsAlgos::Load(PointKernel& points, const char* FileName)
 
 void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
 {
-    boost::regex rx(
-        "^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$"
-    );
-    // boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    // boost::regex
-    // rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt = 0;
-    std::string line;
     Base::FileInfo fi(FileName);
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+    FileBody body(fi, file);
+
+    // the points are stored without the placement of the kernel
+    Base::Matrix4D inverse = points.getTransform();
+    inverse.inverse();
+
+    // lines of three numbers are points, all other lines are ignored
+    std::vector<std::string_view> ranges = splitLines(body.text());
+    std::vector<std::vector<Base::Vector3f>> parsed(ranges.size());
+    auto parseRange = [&](std::size_t k) {
+        forEachLine(ranges[k], [&](std::string_view line) {
+            std::array<std::string_view, 3> tokens;
+            std::size_t count = 0;
+            forEachToken(line, [&tokens, &count](std::string_view token) {
+                if (count < tokens.size()) {
+                    tokens[count] = token;
+                }
+                count++;
+            });
+            Base::Vector3d pnt;
+            if (count == 3 && std::ranges::all_of(tokens, isDecimal)
+                && parseNumber(tokens[0], pnt.x) && parseNumber(tokens[1], pnt.y)
+                && parseNumber(tokens[2], pnt.z)) {
+                pnt = inverse * pnt;
+                parsed[k].emplace_back(
+                    static_cast<float>(pnt.x),
+                    static_cast<float>(pnt.y),
+                    static_cast<float>(pnt.z)
+                );
+            }
+        });
+    };
 
-    Base::ifstream tmp_str(fi, std::ios::in);
-
-    // estimating size
-    while (std::getline(tmp_str, line)) {
-        LineCnt++;
-    }
-
-    // resize the PointKernel
-    points.resize(LineCnt);
-
-    Base::SequencerLauncher seq("Loading points…", LineCnt);
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
-
-    try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt, pt);
-                seq.next();
-                LineCnt++;
+    // the ranges are parsed in batches because the progress can only be reported from the
+    // calling thread
+    Base::SequencerLauncher seq("Loading points…", ranges.size());
+    std::size_t batch = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    for (std::size_t offset = 0; offset < ranges.size(); offset += batch) {
+        std::size_t count = std::min(batch, ranges.size() - offset);
+        forEachRange(count, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; k++) {
+                parseRange(offset + k);
             }
+        });
+        for (std::size_t k = 0; k < count; k++) {
+            seq.next();
         }
     }
-    catch (...) {
-        points.clear();
-        throw Base::BadFormatError("Reading in points failed.");
-    }
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size()) {
-        points.erase(LineCnt, points.size());
+    std::vector<std::size_t> first(parsed.size() + 1, 0);
+    for (std::size_t k = 0; k < parsed.size(); k++) {
+        first[k + 1] = first[k] + parsed[k].size();
     }
+    std::vector<Base::Vector3f> pts(first.back());
+    forEachRange(parsed.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; k++) {
+            std::ranges::copy(parsed[k], pts.begin() + static_cast<std::ptrdiff_t>(first[k]));
+        }
+    });
+    points.swap(pts);
 }
 
 // ----------------------------------------------------------------------------
@@ -214,8 +719,6 @@ public:
     Converter() = default;
     virtual ~Converter() = default;
     virtual std::string toString(double) const = 0;
-    virtual double toDouble(Base::InputStream&) const = 0;
-    virtual int getSizeOf() const = 0;
 
     Converter(const Converter&) = delete;
     Converter(Converter&&) = delete;
@@ -235,108 +738,10 @@ public:
         oss << c;
         return oss.str();
     }
-    double toDouble(Base::InputStream& str) const override
-    {
-        T c;
-        str >> c;
-        return static_cast<double>(c);
-    }
-    int getSizeOf() const override
-    {
-        return sizeof(T);
-    }
 };
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
-    {}
-    ~DataStreambuf() override = default;
-
-protected:
-    int_type uflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    std::streamsize showmanyc() override
-    {
-        return _end - _cur;
-    }
-    pos_type seekoff(
-        std::streambuf::off_type off,
-        std::ios_base::seekdir way,
-        std::ios_base::openmode mode = std::ios::in | std::ios::out
-    ) override
-    {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
-        }
-
-        if (p_pos > _end) {
-            return traits_type::eof();
-        }
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
-        }
-
-        _cur = p_pos + off;
-
-        return ((p_pos + off) - _beg);
-    }
-    pos_type seekpos(
-        std::streambuf::pos_type pos,
-        std::ios_base::openmode which = std::ios::in | std::ios::out
-    ) override
-    {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
-};
-
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int lzfDecompress(
@@ -568,165 +973,47 @@ void PlyReader::read(const std::string& filename)
     std::vector<std::string> types;
     std::vector<int> sizes;
     std::size_t offset = 0;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
+    std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
 
-    this->width = numPoints;
+    this->width = static_cast<int>(numPoints);
     this->height = 1;
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
+    PointTarget target(fields);
+    PointTarget::ColorType colorType = PointTarget::ColorType::None;
+    std::size_t red = target.rgbField();
+    if (red != NoField && types[red] == "uchar") {
+        colorType = PointTarget::ColorType::Byte;
     }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
+    else if (red != NoField && types[red] == "float") {
+        colorType = PointTarget::ColorType::Float;
     }
 
-    // rgb(a) field
-    Eigen::Index red = max_size;
-    Eigen::Index green = max_size;
-    Eigen::Index blue = max_size;
-    Eigen::Index alpha = max_size;
-    it = std::ranges::find(fields, "red");
-    if (it != fields.end()) {
-        red = std::distance(fields.begin(), it);
-    }
-
-    it = std::ranges::find(fields, "green");
-    if (it != fields.end()) {
-        green = std::distance(fields.begin(), it);
-    }
-
-    it = std::ranges::find(fields, "blue");
-    if (it != fields.end()) {
-        blue = std::distance(fields.begin(), it);
-    }
-
-    it = std::ranges::find(fields, "alpha");
-    if (it != fields.end()) {
-        alpha = std::distance(fields.begin(), it);
-    }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    if (format == "ascii") {
+        FileBody body(fi, inp);
+        target.allocate(numPoints, colorType, points, normals, intensity, colors);
+        // the offset is the number of lines of the elements before the vertices
+        if (!decodeAscii(body.text(), offset, numPoints, fields.size(), target)) {
+            clear();
+            throw Base::BadFormatError("Not a valid number");
         }
     }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+    else if (format == "binary_little_endian" || format == "binary_big_endian") {
+        std::vector<BinaryField> binary;
+        for (std::size_t j = 0; j < fields.size(); j++) {
+            binary.push_back(makeField(plyType(types[j]), sizes[j]));
         }
-    }
+        std::size_t recordSize = layoutFields(binary, false, numPoints);
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+        // the offset is the size of the elements before the vertices
+        FileBody body(fi, inp);
+        if (offset > body.size() || recordSize * numPoints > body.size() - offset) {
+            throw Base::BadFormatError("File expects too many elements");
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(
-                    static_cast<float>(r) / 255.0F,
-                    static_cast<float>(g) / 255.0F,
-                    static_cast<float>(b) / 255.0F,
-                    static_cast<float>(a) / 255.0F
-                );
-            }
-        }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(r, g, b, a);
-            }
-        }
+        bool bigEndian = format == "binary_big_endian";
+        bool swap = bigEndian != (std::endian::native == std::endian::big);
+        target.allocate(numPoints, colorType, points, normals, intensity, colors);
+        decodeBinary(body.data() + offset, numPoints, binary, swap, target);
     }
 }
 
@@ -902,138 +1189,6 @@ std::size_t PlyReader::readHeader(
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PlyReader::readBinary(
-    bool swapByteOrder,
-    std::istream& inp,
-    std::size_t offset,
-    const std::vector<std::string>& types,
-    const std::vector<int>& sizes,
-    Eigen::MatrixXd& data
-)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        const std::string& t = types[j];
-        switch (sizes[j]) {
-            case 1:
-                if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 PcdReader::PcdReader() = default;
@@ -1051,154 +1206,64 @@ void PcdReader::read(const std::string& filename)
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
-
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
-        }
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
+    std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
 
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
+    PointTarget target(fields);
+    PointTarget::ColorType colorType = PointTarget::ColorType::None;
+    std::size_t rgba = target.packedField();
+    if (rgba != NoField && types[rgba] == "U") {
+        colorType = PointTarget::ColorType::PackedInt;
     }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
+    else if (rgba != NoField && types[rgba] == "F") {
+        colorType = PointTarget::ColorType::PackedFloat;
     }
 
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
-
-    // rgb(a) field
-    Eigen::Index rgba = max_size;
-    it = std::ranges::find(fields, "rgb");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "rgba");
-    }
-    if (it != fields.end()) {
-        rgba = std::distance(fields.begin(), it);
-    }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
-        }
-    }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
-        }
-    }
-
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+    if (format == "ascii") {
+        FileBody body(fi, inp);
+        target.allocate(numPoints, colorType, points, normals, intensity, colors);
+        if (!decodeAscii(body.text(), 0, numPoints, fields.size(), target)) {
+            clear();
+            throw Base::BadFormatError("Not a valid number");
+        }
+    }
+    else if (format == "binary" || format == "binary_compressed") {
+        // the compressed data is stored field by field
+        bool compressed = format == "binary_compressed";
+        std::vector<BinaryField> binary;
+        for (std::size_t j = 0; j < fields.size(); j++) {
+            binary.push_back(makeField(types[j][0], sizes[j]));
+        }
+        std::size_t recordSize = layoutFields(binary, compressed, numPoints);
+
+        FileBody body(fi, inp);
+        const char* data = body.data();
+        std::size_t size = body.size();
+        std::vector<char> uncompressed;
+        if (compressed) {
+            // the sizes of the compressed and the uncompressed data precede the data
+            std::uint32_t c {};
+            std::uint32_t u {};
+            if (size < sizeof(c) + sizeof(u)) {
+                throw Base::BadFormatError("Failed to decompress binary data");
             }
-        }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t), "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+            std::memcpy(&c, data, sizeof(c));
+            std::memcpy(&u, data + sizeof(c), sizeof(u));
+            data += sizeof(c) + sizeof(u);
+            size -= sizeof(c) + sizeof(u);
+
+            uncompressed.resize(u);
+            if (c > size || lzfDecompress(data, c, uncompressed.data(), u) != u) {
+                throw Base::BadFormatError("Failed to decompress binary data");
             }
+            data = uncompressed.data();
+            size = uncompressed.size();
+        }
+
+        if (recordSize * numPoints > size) {
+            throw Base::BadFormatError("File expects too many elements");
         }
+        target.allocate(numPoints, colorType, points, normals, intensity, colors);
+        decodeBinary(data, numPoints, binary, false, target);
     }
 }
 
@@ -1275,141 +1340,6 @@ std::size_t PcdReader::readHeader(
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PcdReader::readBinary(
-    bool transpose,
-    std::istream& inp,
-    const std::vector<std::string>& types,
-    const std::vector<int>& sizes,
-    Eigen::MatrixXd& data
-)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        char t = types[j][0];
-        switch (sizes[j]) {
-            case 1:
-                if (t == 'I') {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == 'I') {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == 'I') {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == 'F') {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == 'F') {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 namespace
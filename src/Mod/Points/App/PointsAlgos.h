@@ -24,8 +24,6 @@
 
 #pragma once
 
-#include <Eigen/Core>
-
 #include "Points.h"
 #include "Properties.h"
 
@@ -104,15 +102,6 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(
-        bool swapByteOrder,
-        std::istream&,
-        std::size_t offset,
-        const std::vector<std::string>& types,
-        const std::vector<int>& sizes,
-        Eigen::MatrixXd& data
-    );
 };
 
 class PointsExport PcdReader: public Reader
@@ -129,14 +118,6 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(
-        bool transpose,
-        std::istream&,
-        const std::vector<std::string>& types,
-        const std::vector<int>& sizes,
-        Eigen::MatrixXd& data
-    );
 };
 
 class PointsExport E57Reader: public Reader
@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include <Eigen/Eigenvalues>
+
+#include <Base/Converter.h>
+#include <Base/Exception.h>
+
+#include "Parallel.h"
+#include "PointsFilter.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+using value_type = PointKernel::value_type;
+using size_type = PointKernel::size_type;
+
+// Number of bits per coordinate of the cell of a voxel
+constexpr int CellBits = 21;
+constexpr std::uint64_t InvalidKey = std::numeric_limits<std::uint64_t>::max();
+
+bool isValid(const value_type& pnt)
+{
+    return std::isfinite(pnt.x) && std::isfinite(pnt.y) && std::isfinite(pnt.z);
+}
+
+// Returns the indices of the set flags
+std::vector<size_type> indicesOf(const std::vector<char>& flags)
+{
+    std::vector<size_type> indices;
+    for (size_type i = 0; i < flags.size(); i++) {
+        if (flags[i]) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+}  // namespace
+
+PointsFilter::PointsFilter(const PointKernel& kernel)
+    : _kernel(kernel)
+{}
+
+PointsFilter::~PointsFilter() = default;
+
+const PointKDTree& PointsFilter::getTree() const
+{
+    if (!_tree) {
+        _tree = std::make_unique<PointKDTree>(_kernel);
+    }
+    return *_tree;
+}
+
+std::vector<size_type> PointsFilter::voxelDownsample(double voxelSize) const
+{
+    if (!(voxelSize > 0.0)) {
+        throw Base::ValueError("The voxel size must be positive");
+    }
+    const std::vector<value_type>& points = _kernel.getBasicPoints();
+
+    // The box around the valid points
+    std::mutex mutex;
+    Base::BoundBox3d box;
+    _kernel.forEachChunk([&](size_type begin, size_type end) {
+        Base::BoundBox3d chunkBox;
+        for (size_type i = begin; i < end; i++) {
+            if (isValid(points[i])) {
+                chunkBox.Add(Base::convertTo<Base::Vector3d>(points[i]));
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (chunkBox.IsValid()) {
+            box.Add(chunkBox);
+        }
+    });
+    if (!box.IsValid()) {
+        return {};
+    }
+    double maxCells = double(1 << CellBits);
+    if (box.LengthX() / voxelSize >= maxCells || box.LengthY() / voxelSize >= maxCells
+        || box.LengthZ() / voxelSize >= maxCells) {
+        throw Base::ValueError("The voxel size is too small for the extent of the points");
+    }
+
+    // Sort the points by their voxel, so that the points of a voxel are consecutive
+    struct Voxel
+    {
+        std::uint64_t key;
+        size_type index;
+    };
+    std::vector<Voxel> voxels(points.size());
+    _kernel.forEachChunk([&](size_type begin, size_type end) {
+        auto cell = [voxelSize](float value, double min) {
+            return static_cast<std::uint64_t>((double(value) - min) / voxelSize);
+        };
+        for (size_type i = begin; i < end; i++) {
+            const value_type& pnt = points[i];
+            voxels[i].index = i;
+            voxels[i].key = isValid(pnt)
+                ? cell(pnt.x, box.MinX) << (2 * CellBits) | cell(pnt.y, box.MinY) << CellBits
+                    | cell(pnt.z, box.MinZ)
+                : InvalidKey;
+        }
+    });
+    parallelSort(voxels, [](const Voxel& a, const Voxel& b) {
+        return a.key < b.key;
+    });
+    auto last = std::partition_point(voxels.begin(), voxels.end(), [](const Voxel& voxel) {
+        return voxel.key != InvalidKey;
+    });
+    auto numValid = static_cast<size_type>(last - voxels.begin());
+
+    // Each range handles the voxels whose first point lies in it
+    std::vector<size_type> kept;
+    forEachRange(numValid, MinParallelSize, [&](size_type begin, size_type end) {
+        while (begin > 0 && begin < end && voxels[begin].key == voxels[begin - 1].key) {
+            begin++;
+        }
+        std::vector<size_type> chunkKept;
+        for (size_type i = begin; i < end;) {
+            size_type next = i + 1;
+            while (next < numValid && voxels[next].key == voxels[i].key) {
+                next++;
+            }
+
+            Base::Vector3d centroid;
+            for (size_type j = i; j < next; j++) {
+                centroid += Base::convertTo<Base::Vector3d>(points[voxels[j].index]);
+            }
+            centroid /= double(next - i);
+
+            size_type nearest = voxels[i].index;
+            double minDistance = std::numeric_limits<double>::max();
+            for (size_type j = i; j < next; j++) {
+                size_type index = voxels[j].index;
+                double distance = Base::DistanceP2(
+                    centroid,
+                    Base::convertTo<Base::Vector3d>(points[index])
+                );
+                if (distance < minDistance || (distance == minDistance && index < nearest)) {
+                    minDistance = distance;
+                    nearest = index;
+                }
+            }
+            chunkKept.push_back(nearest);
+            i = next;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        kept.insert(kept.end(), chunkKept.begin(), chunkKept.end());
+    });
+
+    parallelSort(kept, std::less<>());
+    return kept;
+}
+
+std::vector<size_type> PointsFilter::radiusFilter(double radius, int minNeighbours) const
+{
+    if (!(radius > 0.0)) {
+        throw Base::ValueError("The radius must be positive");
+    }
+    const PointKDTree& tree = getTree();
+    const std::vector<value_type>& points = _kernel.getBasicPoints();
+
+    // a point counts itself as neighbour
+    auto limit = static_cast<size_type>(std::max(minNeighbours, 0)) + 1;
+    std::vector<char> keep(points.size(), 0);
+    _kernel.forEachChunk([&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; i++) {
+            if (isValid(points[i])) {
+                keep[i] = tree.countWithin(points[i], float(radius), limit) == limit;
+            }
+        }
+    });
+    return indicesOf(keep);
+}
+
+std::vector<size_type> PointsFilter::statisticalFilter(int neighbours, double stdDevRatio) const
+{
+    if (neighbours < 1) {
+        throw Base::ValueError("At least one neighbour is needed");
+    }
+    const PointKDTree& tree = getTree();
+    const std::vector<value_type>& points = _kernel.getBasicPoints();
+
+    // The mean distance of each point to its neighbours and the statistics of these
+    std::vector<double> meanDistance(points.size());
+    std::mutex mutex;
+    double sum = 0.0;
+    double sum2 = 0.0;
+    size_type count = 0;
+    _kernel.forEachChunk([&](size_type begin, size_type end) {
+        std::vector<PointKDTree::Neighbour> found;
+        double chunkSum = 0.0;
+        double chunkSum2 = 0.0;
+        size_type chunkCount = 0;
+        for (size_type i = begin; i < end; i++) {
+            if (!isValid(points[i])) {
+                continue;
+            }
+            // the point itself is found with distance zero
+            tree.nearest(points[i], std::size_t(neighbours) + 1, found);
+            double distance = 0.0;
+            for (const auto& neighbour : found) {
+                distance += std::sqrt(double(neighbour.distance2));
+            }
+            if (found.size() > 1) {
+                distance /= double(found.size() - 1);
+            }
+            meanDistance[i] = distance;
+            chunkSum += distance;
+            chunkSum2 += distance * distance;
+            chunkCount++;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        sum += chunkSum;
+        sum2 += chunkSum2;
+        count += chunkCount;
+    });
+    if (count == 0) {
+        return {};
+    }
+
+    double mean = sum / double(count);
+    double stdDev = std::sqrt(std::max(sum2 / double(count) - mean * mean, 0.0));
+    double maxDistance = mean + stdDevRatio * stdDev;
+    std::vector<char> keep(points.size(), 0);
+    _kernel.forEachChunk([&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; i++) {
+            keep[i] = isValid(points[i]) && meanDistance[i] <= maxDistance;
+        }
+    });
+    return indicesOf(keep);
+}
+
+std::vector<Base::Vector3f> PointsFilter::estimateNormals(
+    int neighbours,
+    const Base::Vector3f& viewpoint
+) const
+{
+    if (neighbours < 3) {
+        throw Base::ValueError("At least three neighbours are needed");
+    }
+    const PointKDTree& tree = getTree();
+    const std::vector<value_type>& points = _kernel.getBasicPoints();
+
+    std::vector<Base::Vector3f> normals(points.size());
+    _kernel.forEachChunk([&](size_type begin, size_type end) {
+        std::vector<PointKDTree::Neighbour> found;
+        for (size_type i = begin; i < end; i++) {
+            if (!isValid(points[i])) {
+                continue;
+            }
+            tree.nearest(points[i], std::size_t(neighbours), found);
+            if (found.size() < 3) {
+                continue;
+            }
+
+            Eigen::Vector3d centroid = Eigen::Vector3d::Zero();
+            for (const auto& neighbour : found) {
+                const value_type& pnt = points[neighbour.index];
+                centroid += Eigen::Vector3d(pnt.x, pnt.y, pnt.z);
+            }
+            centroid /= double(found.size());
+            Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+            for (const auto& neighbour : found) {
+                const value_type& pnt = points[neighbour.index];
+                Eigen::Vector3d diff = Eigen::Vector3d(pnt.x, pnt.y, pnt.z) - centroid;
+                covariance += diff * diff.transpose();
+            }
+
+            // the eigenvalues are sorted in increasing order
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eig(covariance);
+            Eigen::Vector3d dir = eig.eigenvectors().col(0);
+            Base::Vector3f normal(float(dir.x()), float(dir.y()), float(dir.z()));
+            if ((viewpoint - points[i]) * normal < 0.0F) {
+                normal = -normal;
+            }
+            normals[i] = normal;
+        }
+    });
+    return normals;
+}
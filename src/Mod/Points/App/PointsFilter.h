@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026                                                    *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "PointKDTree.h"
+#include "Points.h"
+
+
+namespace Points
+{
+
+/** Thinning, cleaning and normal estimation of point clouds.
+ *
+ * The neighbours of the points are searched with a kd-tree that is built on
+ * first use, and the points are processed in parallel. Points with NaN
+ * coordinates are never kept. The points are taken without the placement of
+ * the kernel.
+ */
+class PointsExport PointsFilter
+{
+public:
+    using size_type = PointKernel::size_type;
+
+    explicit PointsFilter(const PointKernel& kernel);
+    ~PointsFilter();
+
+    PointsFilter(const PointsFilter&) = delete;
+    PointsFilter(PointsFilter&&) = delete;
+    PointsFilter& operator=(const PointsFilter&) = delete;
+    PointsFilter& operator=(PointsFilter&&) = delete;
+
+    /** Keeps one point per cube of a grid with the edge length \a voxelSize, the point nearest
+     * to the centroid of the points in the cube. Returns the indices of the kept points in
+     * ascending order.
+     */
+    std::vector<size_type> voxelDownsample(double voxelSize) const;
+    /** Keeps the points that have at least \a minNeighbours other points within \a radius.
+     * Returns the indices of the kept points in ascending order.
+     */
+    std::vector<size_type> radiusFilter(double radius, int minNeighbours) const;
+    /** Keeps the points whose mean distance to their \a neighbours nearest points exceeds the
+     * average of all points by at most \a stdDevRatio standard deviations. Returns the indices of
+     * the kept points in ascending order.
+     */
+    std::vector<size_type> statisticalFilter(int neighbours, double stdDevRatio) const;
+    /** Estimates the normal of each point as the direction of least variance of its
+     * \a neighbours nearest points. The normals point towards \a viewpoint, the normal of a
+     * point with NaN coordinates or too few neighbours is the null vector.
+     */
+    std::vector<Base::Vector3f> estimateNormals(
+        int neighbours,
+        const Base::Vector3f& viewpoint
+    ) const;
+
+    /// Returns the elements of \a values at \a indices
+    template<typename T>
+    static std::vector<T> select(
+        const std::vector<T>& values,
+        const std::vector<size_type>& indices
+    )
+    {
+        std::vector<T> result;
+        result.reserve(indices.size());
+        for (size_type index : indices) {
+            result.push_back(values[index]);
+        }
+        return result;
+    }
+
+private:
+    const PointKDTree& getTree() const;
+
+private:
+    const PointKernel& _kernel;
+    mutable std::unique_ptr<PointKDTree> _tree;
+};
+
+}  // namespace Points
@@ -22,6 +22,9 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <QtConcurrentMap>
+#include <limits>
+#include <numeric>
 
 #include "PointsGrid.h"
 
@@ -103,10 +106,7 @@ PointsGrid::PointsGrid(const PointKernel& rclM, double fGridLen)
     , _fMinY(0.0F)
     , _fMinZ(0.0F)
 {
-    Base::BoundBox3d clBBPts;  // = _pclPoints->GetBoundBox();
-    for (const auto& pnt : *_pclPoints) {
-        clBBPts.Add(pnt);
-    }
+    Base::BoundBox3d clBBPts = _pclPoints->getBoundBox();
     PointsGrid::Rebuild(
         std::max<unsigned long>((unsigned long)(clBBPts.LengthX() / fGridLen), 1),
         std::max<unsigned long>((unsigned long)(clBBPts.LengthY() / fGridLen), 1),
@@ -162,10 +162,7 @@ void PointsGrid::InitGrid()
     // Determine the grid length and offset
     //
     {
-        Base::BoundBox3d clBBPts;  // = _pclPoints->GetBoundBox();
-        for (const auto& pnt : *_pclPoints) {
-            clBBPts.Add(pnt);
-        }
+        Base::BoundBox3d clBBPts = _pclPoints->getBoundBox();
 
         double fLengthX = clBBPts.LengthX();
         double fLengthY = clBBPts.LengthY();
@@ -356,10 +353,7 @@ void PointsGrid::CalculateGridLength(unsigned long ulCtGrid, unsigned long ulMax
     // Calculate grid lengths or number of grids per dimension
     // There should be about 10 (?!?!) facets per grid
     // or max grids should not exceed 10000
-    Base::BoundBox3d clBBPtsEnlarged;  // = _pclPoints->GetBoundBox();
-    for (const auto& pnt : *_pclPoints) {
-        clBBPtsEnlarged.Add(pnt);
-    }
+    Base::BoundBox3d clBBPtsEnlarged = _pclPoints->getBoundBox();
     double fVolElem {};
 
     if (_ulCtElements > (ulMaxGrids * ulCtGrid)) {
@@ -397,10 +391,7 @@ void PointsGrid::CalculateGridLength(int iCtGridPerAxis)
     // Calculate grid lengths or number of grids per dimension
     // There should be about 10 (?!?!) facets per grid
     // or max grids should not exceed 10000
-    Base::BoundBox3d clBBPts;  // = _pclPoints->GetBoundBox();
-    for (const auto& pnt : *_pclPoints) {
-        clBBPts.Add(pnt);
-    }
+    Base::BoundBox3d clBBPts = _pclPoints->getBoundBox();
 
     double fLenghtX = clBBPts.LengthX();
     double fLenghtY = clBBPts.LengthY();
@@ -760,11 +751,55 @@ void PointsGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
+    // The grid elements of the points are determined chunk by chunk in parallel. Sorted by their
+    // grid element the points are then added to the slices of the grid in parallel.
+    constexpr unsigned long Outside = std::numeric_limits<unsigned long>::max();
+    const std::vector<PointKernel::value_type>& points = _pclPoints->getBasicPoints();
+    Base::Matrix4D mat = _pclPoints->getTransform();
+    std::vector<unsigned long> cells(points.size());
+    _pclPoints->forEachChunk([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            unsigned long ulX {}, ulY {}, ulZ {};
+            Pos(mat * Base::toVector<double>(points[i]), ulX, ulY, ulZ);
+            if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
+                cells[i] = (ulX * _ulCtGridsY + ulY) * _ulCtGridsZ + ulZ;
+            }
+            else {
+                cells[i] = Outside;
+            }
+        }
+    });
 
-    unsigned long i = 0;
-    for (const auto& pnt : *_pclPoints) {
-        AddPoint(pnt, i++);
+    std::vector<std::size_t> start(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ + 1, 0);
+    for (unsigned long cell : cells) {
+        if (cell != Outside) {
+            start[cell + 1]++;
+        }
+    }
+    std::partial_sum(start.begin(), start.end(), start.begin());
+
+    std::vector<unsigned long> order(start.back());
+    std::vector<std::size_t> next(start.begin(), start.end() - 1);
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        if (cells[i] != Outside) {
+            order[next[cells[i]]++] = static_cast<unsigned long>(i);
+        }
     }
+
+    std::vector<unsigned long> slices(_ulCtGridsX);
+    std::iota(slices.begin(), slices.end(), 0);
+    auto fillSlice = [&](unsigned long ulX) {
+        for (unsigned long ulY = 0; ulY < _ulCtGridsY; ulY++) {
+            for (unsigned long ulZ = 0; ulZ < _ulCtGridsZ; ulZ++) {
+                std::size_t cell = (ulX * _ulCtGridsY + ulY) * _ulCtGridsZ + ulZ;
+                _aulGrid[ulX][ulY][ulZ].insert(
+                    order.begin() + static_cast<std::ptrdiff_t>(start[cell]),
+                    order.begin() + static_cast<std::ptrdiff_t>(start[cell + 1])
+                );
+            }
+        }
+    };
+    QtConcurrent::blockingMap(slices, fillSlice);
 }
 
 void PointsGrid::Pos(
@@ -28,9 +28,11 @@
 #include <Base/Builder3D.h>
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/Placement.h>
 #include <Base/VectorPy.h>
 
 #include "Points.h"
+#include "PointsFilter.h"
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
 #include "PointsPy.cpp"
@@ -38,6 +40,25 @@
 
 using namespace Points;
 
+namespace
+{
+
+// Returns the points of kernel at indices with the same placement
+PointKernel* selectPoints(
+    const PointKernel& kernel,
+    const std::vector<PointKernel::size_type>& indices
+)
+{
+    std::unique_ptr<PointKernel> pts(new PointKernel());
+    pts->setTransform(kernel.getTransform());
+    std::vector<PointKernel::value_type> points =
+        PointsFilter::select(kernel.getBasicPoints(), indices);
+    pts->swap(points);
+    return pts.release();
+}
+
+}  // namespace
+
 // returns a string which represents the object e.g. when printed in python
 std::string PointsPy::representation() const
 {
@@ -244,6 +265,90 @@ PyObject* PointsPy::fromValid(PyObject* args) const
     }
 }
 
+PyObject* PointsPy::downsample(PyObject* args) const
+{
+    double voxelSize {};
+    if (!PyArg_ParseTuple(args, "d", &voxelSize)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        PointsFilter filter(*getPointKernelPtr());
+        std::vector<PointKernel::size_type> indices = filter.voxelDownsample(voxelSize);
+        return new PointsPy(selectPoints(*getPointKernelPtr(), indices));
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::radiusFilter(PyObject* args) const
+{
+    double radius {};
+    int minNeighbours {};
+    if (!PyArg_ParseTuple(args, "di", &radius, &minNeighbours)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        PointsFilter filter(*getPointKernelPtr());
+        std::vector<PointKernel::size_type> indices = filter.radiusFilter(radius, minNeighbours);
+        return new PointsPy(selectPoints(*getPointKernelPtr(), indices));
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::statisticalFilter(PyObject* args) const
+{
+    int neighbours {};
+    double stdDevRatio {};
+    if (!PyArg_ParseTuple(args, "id", &neighbours, &stdDevRatio)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        PointsFilter filter(*getPointKernelPtr());
+        std::vector<PointKernel::size_type> indices =
+            filter.statisticalFilter(neighbours, stdDevRatio);
+        return new PointsPy(selectPoints(*getPointKernelPtr(), indices));
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::estimateNormals(PyObject* args) const
+{
+    int neighbours {};
+    PyObject* pcObj = nullptr;
+    if (!PyArg_ParseTuple(args, "i|O!", &neighbours, &Base::VectorPy::Type, &pcObj)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        // the normals are computed without the placement of the points
+        const PointKernel* kernel = getPointKernelPtr();
+        Base::Placement plm(kernel->getTransform());
+        Base::Vector3d viewpoint;
+        if (pcObj) {
+            viewpoint = *static_cast<Base::VectorPy*>(pcObj)->getVectorPtr();
+        }
+        plm.inverse().multVec(viewpoint, viewpoint);
+
+        PointsFilter filter(*kernel);
+        std::vector<Base::Vector3f> normals =
+            filter.estimateNormals(neighbours, Base::convertTo<Base::Vector3f>(viewpoint));
+
+        Py::List list;
+        for (const auto& normal : normals) {
+            Base::Vector3d dir = plm.getRotation().multVec(Base::convertTo<Base::Vector3d>(normal));
+            list.append(Py::Vector(dir));
+        }
+        return Py::new_reference_to(list);
+    }
+    PY_CATCH;
+}
+
 Py::Long PointsPy::getCountPoints() const
 {
     return Py::Long((long)getPointKernelPtr()->size());
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/Expression.h>
+#include <App/FeatureTest.h>
+#include <App/ObjectIdentifier.h>
+#include <Base/FileInfo.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace
+{
+
+void bindExpression(App::DocumentObject* obj, App::Property& prop, const std::string& text)
+{
+    App::ObjectIdentifier path(prop);
+    std::shared_ptr<App::Expression> expr(App::Expression::parse(obj, text));
+    obj->setExpression(path, expr);
+}
+
+/* Build a layered DAG of \a width x \a depth objects. Every object of a layer
+ * depends on two objects of the previous layer, so the graph has both long
+ * chains and independent branches.
+ */
+std::vector<App::DocumentObject*> makeDag(App::Document* doc, int width, int depth)
+{
+    std::vector<App::DocumentObject*> roots;
+    std::vector<App::FeatureTestPlacement*> previous;
+    for (int layer = 0; layer < depth; ++layer) {
+        std::vector<App::FeatureTestPlacement*> current;
+        for (int i = 0; i < width; ++i) {
+            auto obj = static_cast<App::FeatureTestPlacement*>(
+                doc->addObject("App::FeatureTestPlacement")
+            );
+            if (previous.empty()) {
+                obj->Input1.setValue(Base::Placement(Base::Vector3d(i, 0, 0), Base::Rotation()));
+                obj->Input2.setValue(Base::Placement(Base::Vector3d(0, 1, 0), Base::Rotation()));
+                roots.push_back(obj);
+            }
+            else {
+                std::string first = previous[i]->getNameInDocument();
+                std::string second = previous[(i + 1) % width]->getNameInDocument();
+                bindExpression(obj, obj->Input1, first + ".MultLeft");
+                bindExpression(obj, obj->Input2, second + ".MultRight");
+            }
+            current.push_back(obj);
+        }
+        previous = std::move(current);
+    }
+    return roots;
+}
+
+class DocumentFixture: public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& /*state*/) override
+    {
+        docName = App::GetApplication().getUniqueDocumentName("bench");
+        doc = App::GetApplication().newDocument(docName.c_str(), "bench");
+    }
+
+    void TearDown(benchmark::State& /*state*/) override
+    {
+        App::GetApplication().closeDocument(docName.c_str());
+        doc = nullptr;
+    }
+
+    std::string docName;
+    App::Document* doc {};
+};
+
+}  // namespace
+
+/* Recompute of a synthetic DAG after touching its roots. The arguments are
+ * the width and depth of the DAG, and the number of recompute threads where 1
+ * runs the plain serial recompute.
+ */
+BENCHMARK_DEFINE_F(DocumentFixture, Recompute)(benchmark::State& state)
+{
+    auto roots = makeDag(doc, static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+    doc->recompute();
+
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document"
+    );
+    bool parallel = hGrp->GetBool("EnableParallelRecompute", false);
+    hGrp->SetBool("EnableParallelRecompute", state.range(2) != 1);
+    doc->setRecomputeThreadLimit(static_cast<int>(state.range(2)));
+
+    int count = 0;
+    for (auto _ : state) {
+        for (auto root : roots) {
+            root->touch();
+        }
+        count = doc->recompute({}, true);
+    }
+
+    hGrp->SetBool("EnableParallelRecompute", parallel);
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["objects"] = static_cast<double>(doc->countObjects());
+}
+BENCHMARK_REGISTER_F(DocumentFixture, Recompute)
+    ->ArgNames({"width", "depth", "threads"})
+    ->Args({1, 1000, 1})
+    ->Args({32, 32, 1})
+    ->Args({32, 32, 0})
+    ->Args({256, 8, 1})
+    ->Args({256, 8, 0})
+    ->Unit(benchmark::kMillisecond);
+
+/* Restore of a saved document, i.e. the XMLReader path of openDocument().
+ * The argument is the number of objects in the document.
+ */
+BENCHMARK_DEFINE_F(DocumentFixture, Restore)(benchmark::State& state)
+{
+    auto count = static_cast<int>(state.range(0));
+    makeDag(doc, 32, count / 32);
+    doc->recompute();
+    std::string file = App::Application::getTempFileName("bench") + ".FCStd";
+    // save a copy, so that opening the file doesn't just return the existing document
+    if (!doc->saveCopy(file.c_str())) {
+        state.SkipWithError("Failed to save document");
+        return;
+    }
+    auto size = Base::FileInfo(file).size();
+
+    for (auto _ : state) {
+        auto restored = App::GetApplication().openDocument(file.c_str(), {.createView = false});
+        if (!restored) {
+            state.SkipWithError("Failed to open document");
+            break;
+        }
+        state.PauseTiming();
+        App::GetApplication().closeDocument(restored->getName());
+        state.ResumeTiming();
+    }
+
+    Base::FileInfo(file).deleteFile();
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["bytes"] = static_cast<double>(size);
+}
+BENCHMARK_REGISTER_F(DocumentFixture, Restore)
+    ->Arg(1 << 10)
+    ->Arg(1 << 13)
+    ->Unit(benchmark::kMillisecond);
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
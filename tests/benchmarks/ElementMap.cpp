@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <App/ElementMap.h>
+#include <App/StringHasher.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace
+{
+
+constexpr long tag = 42;
+
+struct ElementMapData
+{
+    App::StringHasherRef hasher {new App::StringHasher};
+    Data::ElementMapPtr map {std::make_shared<Data::ElementMap>()};
+    std::vector<Data::IndexedName> indices;
+    std::vector<Data::MappedName> names;
+};
+
+// Simulates the element map of a shape with \a count faces and twice as many edges
+ElementMapData makeElementMap(std::size_t count)
+{
+    ElementMapData data;
+    data.map->hasher = data.hasher;
+    for (std::size_t i = 1; i <= count; ++i) {
+        for (const char* type : {"Face", "Edge", "Edge"}) {
+            auto index = static_cast<int>(data.indices.size() + 1);
+            Data::IndexedName idx(type, index);
+            Data::MappedName name(
+                ";:H" + std::to_string(i) + "," + type[0] + ";:M" + std::to_string(index) + ";FUS"
+            );
+            data.map->setElementName(idx, name, tag);
+            data.indices.push_back(idx);
+            data.names.push_back(name);
+        }
+    }
+    return data;
+}
+
+}  // namespace
+
+static void ElementMap_SetElementName(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        auto data = makeElementMap(count);
+        benchmark::DoNotOptimize(data.map->size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 3);
+}
+BENCHMARK(ElementMap_SetElementName)->Arg(1 << 8)->Arg(1 << 12);
+
+static void ElementMap_FindByIndexedName(benchmark::State& state)
+{
+    auto data = makeElementMap(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& idx : data.indices) {
+            benchmark::DoNotOptimize(data.map->find(idx));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(data.indices.size()));
+}
+BENCHMARK(ElementMap_FindByIndexedName)->Arg(1 << 8)->Arg(1 << 12);
+
+static void ElementMap_FindByMappedName(benchmark::State& state)
+{
+    auto data = makeElementMap(static_cast<std::size_t>(state.range(0)));
+    std::vector<Data::MappedName> names;
+    for (const auto& idx : data.indices) {
+        names.push_back(data.map->find(idx));
+    }
+    for (auto _ : state) {
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(data.map->find(name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+}
+BENCHMARK(ElementMap_FindByMappedName)->Arg(1 << 8)->Arg(1 << 12);
+
+static void ElementMap_GetAll(benchmark::State& state)
+{
+    auto data = makeElementMap(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data.map->getAll());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(data.indices.size()));
+}
+BENCHMARK(ElementMap_GetAll)->Arg(1 << 8)->Arg(1 << 12);
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
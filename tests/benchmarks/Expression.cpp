@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/Expression.h>
+#include <App/ExpressionParser.h>
+#include <App/FeatureTest.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace
+{
+
+const char* const expressions[] = {
+    "2 * 3 + 4",
+    "(1 mm + 2 cm) * 3 / 4",
+    "sin(30 deg) * cos(45 deg) + sqrt(2) ^ 2",
+    "Owner.Input1.Base.x * 2 + Owner.Input2.Rotation.Angle",
+    "Owner.Input1.Base.x > 0 ? max(1 mm; Owner.Input2.Base.y) : -1 mm",
+};
+
+class ExpressionFixture: public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& /*state*/) override
+    {
+        docName = App::GetApplication().getUniqueDocumentName("bench");
+        auto doc = App::GetApplication().newDocument(docName.c_str(), "bench");
+        owner = static_cast<App::FeatureTestPlacement*>(
+            doc->addObject("App::FeatureTestPlacement", "Owner")
+        );
+        owner->Input1.setValue(Base::Placement(Base::Vector3d(1, 2, 3), Base::Rotation()));
+    }
+
+    void TearDown(benchmark::State& /*state*/) override
+    {
+        App::GetApplication().closeDocument(docName.c_str());
+    }
+
+    std::string docName;
+    App::FeatureTestPlacement* owner {};
+};
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(ExpressionFixture, Parse)(benchmark::State& state)
+{
+    const char* text = expressions[state.range(0)];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(App::ExpressionParser::parse(owner, text));
+    }
+    state.SetLabel(text);
+}
+BENCHMARK_REGISTER_F(ExpressionFixture, Parse)->DenseRange(0, std::size(expressions) - 1);
+
+BENCHMARK_DEFINE_F(ExpressionFixture, Eval)(benchmark::State& state)
+{
+    const char* text = expressions[state.range(0)];
+    auto expr = App::ExpressionParser::parse(owner, text);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expr->eval());
+    }
+    state.SetLabel(text);
+}
+BENCHMARK_REGISTER_F(ExpressionFixture, Eval)->DenseRange(0, std::size(expressions) - 1);
+
+BENCHMARK_DEFINE_F(ExpressionFixture, ToString)(benchmark::State& state)
+{
+    const char* text = expressions[state.range(0)];
+    auto expr = App::ExpressionParser::parse(owner, text);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expr->toString());
+    }
+    state.SetLabel(text);
+}
+BENCHMARK_REGISTER_F(ExpressionFixture, ToString)->DenseRange(0, std::size(expressions) - 1);
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <Base/Matrix.h>
+#include <Base/Placement.h>
+#include <Base/Rotation.h>
+#include <Base/Vector3D.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace
+{
+
+// Fixed seed, so that every run works on the same data
+std::vector<Base::Placement> makePlacements(std::size_t count)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<Base::Placement> placements;
+    placements.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Base::Vector3d pos(dist(gen) * 100, dist(gen) * 100, dist(gen) * 100);
+        Base::Vector3d axis(dist(gen), dist(gen), dist(gen) + 2.0);
+        placements.emplace_back(pos, Base::Rotation(axis, dist(gen) * 3.14));
+    }
+    return placements;
+}
+
+std::vector<Base::Vector3d> makePoints(std::size_t count)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<Base::Vector3d> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points.emplace_back(dist(gen), dist(gen), dist(gen));
+    }
+    return points;
+}
+
+}  // namespace
+
+static void Matrix4D_Multiply(benchmark::State& state)
+{
+    auto placements = makePlacements(64);
+    std::vector<Base::Matrix4D> matrices;
+    for (const auto& plm : placements) {
+        matrices.push_back(plm.toMatrix());
+    }
+
+    for (auto _ : state) {
+        Base::Matrix4D result;
+        for (const auto& mat : matrices) {
+            result = result * mat;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(matrices.size()));
+}
+BENCHMARK(Matrix4D_Multiply);
+
+static void Matrix4D_Inverse(benchmark::State& state)
+{
+    auto mat = makePlacements(1).front().toMatrix();
+    for (auto _ : state) {
+        Base::Matrix4D inv(mat);
+        inv.inverseGauss();
+        benchmark::DoNotOptimize(inv);
+    }
+}
+BENCHMARK(Matrix4D_Inverse);
+
+static void Matrix4D_MultVec(benchmark::State& state)
+{
+    auto mat = makePlacements(1).front().toMatrix();
+    auto points = makePoints(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (auto& pnt : points) {
+            mat.multVec(pnt, pnt);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Matrix4D_MultVec)->Arg(1 << 10)->Arg(1 << 16);
+
+static void Placement_Multiply(benchmark::State& state)
+{
+    auto placements = makePlacements(64);
+    for (auto _ : state) {
+        Base::Placement result;
+        for (const auto& plm : placements) {
+            result = result * plm;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(placements.size()));
+}
+BENCHMARK(Placement_Multiply);
+
+static void Placement_Inverse(benchmark::State& state)
+{
+    auto placements = makePlacements(64);
+    for (auto _ : state) {
+        for (const auto& plm : placements) {
+            benchmark::DoNotOptimize(plm.inverse());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(placements.size()));
+}
+BENCHMARK(Placement_Inverse);
+
+static void Placement_ToMatrix(benchmark::State& state)
+{
+    auto placements = makePlacements(64);
+    for (auto _ : state) {
+        for (const auto& plm : placements) {
+            benchmark::DoNotOptimize(plm.toMatrix());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(placements.size()));
+}
+BENCHMARK(Placement_ToMatrix);
+
+static void Placement_MultVec(benchmark::State& state)
+{
+    auto plm = makePlacements(1).front();
+    auto points = makePoints(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (auto& pnt : points) {
+            plm.multVec(pnt, pnt);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Placement_MultVec)->Arg(1 << 10)->Arg(1 << 16);
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <App/StringHasher.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace
+{
+
+std::vector<std::string> makeNames(std::size_t count)
+{
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        names.push_back(";:H" + std::to_string(i) + ",F;:M" + std::to_string(i * 7) + ";FUS;:T"
+                        + std::to_string(i % 97) + ":7,E");
+    }
+    return names;
+}
+
+}  // namespace
+
+static void StringHasher_Insert(benchmark::State& state)
+{
+    auto names = makeNames(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        App::StringHasherRef hasher(new App::StringHasher);
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(hasher->getID(name.c_str(), static_cast<int>(name.size())));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(StringHasher_Insert)->Arg(1 << 10)->Arg(1 << 16);
+
+static void StringHasher_InsertHashed(benchmark::State& state)
+{
+    auto names = makeNames(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        App::StringHasherRef hasher(new App::StringHasher);
+        hasher->setThreshold(1);
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(
+                hasher->getID(name.c_str(), static_cast<int>(name.size()), true)
+            );
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(StringHasher_InsertHashed)->Arg(1 << 10)->Arg(1 << 16);
+
+static void StringHasher_LookupByData(benchmark::State& state)
+{
+    auto names = makeNames(static_cast<std::size_t>(state.range(0)));
+    App::StringHasherRef hasher(new App::StringHasher);
+    std::vector<App::StringIDRef> sids;
+    for (const auto& name : names) {
+        sids.push_back(hasher->getID(name.c_str(), static_cast<int>(name.size())));
+    }
+
+    for (auto _ : state) {
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(hasher->getID(name.c_str(), static_cast<int>(name.size())));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(StringHasher_LookupByData)->Arg(1 << 10)->Arg(1 << 16);
+
+static void StringHasher_LookupByID(benchmark::State& state)
+{
+    auto names = makeNames(static_cast<std::size_t>(state.range(0)));
+    App::StringHasherRef hasher(new App::StringHasher);
+    std::vector<App::StringIDRef> sids;
+    for (const auto& name : names) {
+        sids.push_back(hasher->getID(name.c_str(), static_cast<int>(name.size())));
+    }
+
+    for (auto _ : state) {
+        for (const auto& sid : sids) {
+            benchmark::DoNotOptimize(hasher->getID(sid.value()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(StringHasher_LookupByID)->Arg(1 << 10)->Arg(1 << 16);
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
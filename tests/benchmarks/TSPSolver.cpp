@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "tsp_solver.h"
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace
+{
+
+// Fixed seed, so that every run works on the same data
+std::vector<TSPPoint> makeHoles(std::size_t count)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1000.0);
+    std::vector<TSPPoint> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points.emplace_back(dist(gen), dist(gen));
+    }
+    return points;
+}
+
+std::vector<TSPTunnel> makeTunnels(std::size_t count)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(0.0, 1000.0);
+    std::uniform_real_distribution<double> offset(-20.0, 20.0);
+    std::vector<TSPTunnel> tunnels;
+    tunnels.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        double x = dist(gen);
+        double y = dist(gen);
+        tunnels.emplace_back(x, y, x + offset(gen), y + offset(gen));
+    }
+    return tunnels;
+}
+
+double routeLength(const std::vector<TSPPoint>& points, const std::vector<int>& route)
+{
+    double length = 0.0;
+    for (std::size_t i = 1; i < route.size(); ++i) {
+        const auto& a = points[route[i - 1]];
+        const auto& b = points[route[i]];
+        length += std::hypot(b.x - a.x, b.y - a.y);
+    }
+    return length;
+}
+
+double routeLength(const std::vector<TSPTunnel>& route)
+{
+    double length = 0.0;
+    for (std::size_t i = 1; i < route.size(); ++i) {
+        length += std::hypot(
+            route[i].startX - route[i - 1].endX,
+            route[i].startY - route[i - 1].endY
+        );
+    }
+    return length;
+}
+
+}  // namespace
+
+// Route length and run time of both strategies, the counter "length" is the quality measure
+static void TSPSolver_Exhaustive(benchmark::State& state)
+{
+    auto points = makeHoles(static_cast<std::size_t>(state.range(0)));
+    TSPOptions options;
+    options.exhaustiveLimit = points.size();
+    double length = 0.0;
+    for (auto _ : state) {
+        auto route = TSPSolver::solve(points, nullptr, nullptr, options);
+        length = routeLength(points, route);
+    }
+    state.counters["length"] = length;
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(TSPSolver_Exhaustive)->Arg(500)->Arg(2000)->Unit(benchmark::kMillisecond);
+
+static void TSPSolver_Neighbours(benchmark::State& state)
+{
+    auto points = makeHoles(static_cast<std::size_t>(state.range(0)));
+    TSPOptions options;
+    options.exhaustiveLimit = 0;
+    double length = 0.0;
+    for (auto _ : state) {
+        auto route = TSPSolver::solve(points, nullptr, nullptr, options);
+        length = routeLength(points, route);
+    }
+    state.counters["length"] = length;
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(TSPSolver_Neighbours)
+    ->Arg(500)
+    ->Arg(2000)
+    ->Arg(20000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+// Route length reached within a time budget, the argument is the budget in milliseconds
+static void TSPSolver_TimeLimit(benchmark::State& state)
+{
+    auto points = makeHoles(20000);
+    TSPOptions options;
+    options.timeLimit = static_cast<double>(state.range(0)) / 1000.0;
+    double length = 0.0;
+    for (auto _ : state) {
+        auto route = TSPSolver::solve(points, nullptr, nullptr, options);
+        length = routeLength(points, route);
+    }
+    state.counters["length"] = length;
+}
+BENCHMARK(TSPSolver_TimeLimit)->Arg(1)->Arg(10)->Arg(50)->Arg(0)->Unit(benchmark::kMillisecond);
+
+static void TSPSolver_Tunnels(benchmark::State& state)
+{
+    auto tunnels = makeTunnels(static_cast<std::size_t>(state.range(0)));
+    TSPOptions options;
+    options.timeLimit = 1.0;
+    double length = 0.0;
+    for (auto _ : state) {
+        auto route = TSPSolver::solveTunnels(tunnels, true, nullptr, nullptr, options);
+        length = routeLength(route);
+    }
+    state.counters["length"] = length;
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(TSPSolver_Tunnels)->Arg(500)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
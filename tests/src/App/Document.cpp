@@ -5,6 +5,10 @@
 
 #include "App/Application.h"
 #include "App/Document.h"
+#include "App/Expression.h"
+#include "App/FeatureTest.h"
+#include "App/ObjectIdentifier.h"
+#include "App/RecomputeProfile.h"
 #include "App/StringHasher.h"
 #include "Base/Writer.h"
 #include <src/App/InitApplication.h>
@@ -94,4 +98,89 @@ TEST_F(DocumentTest, getStringHasherGivesExpectedHasher)
     EXPECT_EQ(hasher, foundHasher);
 }
 
+TEST_F(DocumentTest, recomputeThreadLimitIsStoredInDocument)
+{
+    // Arrange
+    int defaultLimit = doc()->getRecomputeThreadLimit();
+
+    // Act
+    doc()->setRecomputeThreadLimit(4);
+    int limit = doc()->getRecomputeThreadLimit();
+    doc()->setRecomputeThreadLimit(-2);
+    int clampedLimit = doc()->getRecomputeThreadLimit();
+
+    // Assert
+    EXPECT_EQ(defaultLimit, 0);
+    EXPECT_EQ(limit, 4);
+    EXPECT_EQ(clampedLimit, 0);
+}
+
+TEST_F(DocumentTest, parallelRecomputeRespectsDependencies)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool parallel = hGrp->GetBool("EnableParallelRecompute", false);
+    hGrp->SetBool("EnableParallelRecompute", true);
+    doc()->setRecomputeThreadLimit(4);
+
+    const int chains = 8;
+    const int length = 5;
+    std::vector<App::FeatureTestPlacement*> tails;
+    for (int i = 0; i < chains; ++i) {
+        App::FeatureTestPlacement* prev {};
+        for (int j = 0; j < length; ++j) {
+            auto obj = static_cast<App::FeatureTestPlacement*>(
+                doc()->addObject("App::FeatureTestPlacement"));
+            obj->Input2.setValue(Base::Placement(Base::Vector3d(1, 0, 0), Base::Rotation()));
+            if (prev) {
+                App::ObjectIdentifier path(obj->Input1);
+                std::shared_ptr<App::Expression> expr(App::Expression::parse(
+                    obj, std::string(prev->getNameInDocument()) + ".MultLeft"));
+                obj->setExpression(path, expr);
+            }
+            prev = obj;
+        }
+        tails.push_back(prev);
+    }
+
+    // Act
+    bool hasError = false;
+    int count = doc()->recompute({}, true, &hasError);
+    hGrp->SetBool("EnableParallelRecompute", parallel);
+
+    // Assert
+    EXPECT_FALSE(hasError);
+    EXPECT_EQ(count, chains * length);
+    for (auto tail : tails) {
+        EXPECT_DOUBLE_EQ(tail->MultLeft.getValue().getPosition().x, double(length));
+    }
+}
+
+TEST_F(DocumentTest, recomputeRecordsProfile)
+{
+    // Arrange
+    auto first = doc()->addObject("App::FeatureTestPlacement");
+    auto second = doc()->addObject("App::FeatureTestPlacement");
+
+    // Act
+    doc()->recompute();
+    auto timings = doc()->getRecomputeProfile().getTimings();
+    doc()->recomputeFeature(second);
+    auto single = doc()->getRecomputeProfile().getTimings();
+
+    // Assert
+    ASSERT_EQ(timings.size(), 2);
+    EXPECT_EQ(timings[0].name, first->getNameInDocument());
+    EXPECT_EQ(timings[1].name, second->getNameInDocument());
+    EXPECT_EQ(timings[1].type, "App::FeatureTestPlacement");
+    for (const auto& timing : timings) {
+        EXPECT_GE(timing.total, timing.execute);
+        EXPECT_GE(timing.execute, 0.0);
+        EXPECT_GE(timing.onChanged, 0.0);
+    }
+    ASSERT_EQ(single.size(), 1);
+    EXPECT_EQ(single[0].name, second->getNameInDocument());
+}
+
 // NOLINTEND(readability-magic-numbers)
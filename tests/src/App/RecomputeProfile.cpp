@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "App/RecomputeProfile.h"
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace
+{
+void fillProfile(App::RecomputeProfile& profile)
+{
+    profile.add({.name = "Box",
+                 .label = "My \"Box\", big",
+                 .type = "Part::Box",
+                 .total = 0.5,
+                 .execute = 0.25,
+                 .onChanged = 0.125,
+                 .gilWait = 0.0});
+    profile.add({.name = "Cut", .label = "Cut", .type = "Part::Cut", .total = 1.0});
+    profile.setWallTime(1.5);
+}
+}  // namespace
+
+TEST(RecomputeProfile, addKeepsOrder)
+{
+    // Arrange
+    App::RecomputeProfile profile;
+    fillProfile(profile);
+
+    // Act
+    auto timings = profile.getTimings();
+
+    // Assert
+    ASSERT_EQ(timings.size(), 2);
+    EXPECT_EQ(timings[0].name, "Box");
+    EXPECT_EQ(timings[1].name, "Cut");
+    EXPECT_DOUBLE_EQ(profile.getWallTime(), 1.5);
+}
+
+TEST(RecomputeProfile, clearRemovesTimings)
+{
+    // Arrange
+    App::RecomputeProfile profile;
+    fillProfile(profile);
+
+    // Act
+    profile.clear();
+
+    // Assert
+    EXPECT_TRUE(profile.getTimings().empty());
+    EXPECT_DOUBLE_EQ(profile.getWallTime(), 0.0);
+}
+
+TEST(RecomputeProfile, exportCsvQuotesFields)
+{
+    // Arrange
+    App::RecomputeProfile profile;
+    fillProfile(profile);
+    std::stringstream str;
+
+    // Act
+    profile.exportCsv(str);
+
+    // Assert
+    EXPECT_EQ(str.str(),
+              "name,label,type,total,execute,onChanged,gilWait\n"
+              "Box,\"My \"\"Box\"\", big\",Part::Box,0.5,0.25,0.125,0\n"
+              "Cut,Cut,Part::Cut,1,0,0,0\n");
+}
+
+TEST(RecomputeProfile, exportJsonEscapesStrings)
+{
+    // Arrange
+    App::RecomputeProfile profile;
+    fillProfile(profile);
+    std::stringstream str;
+
+    // Act
+    profile.exportJson(str);
+
+    // Assert
+    EXPECT_EQ(str.str(),
+              "{\n"
+              "  \"wallTime\": 1.5,\n"
+              "  \"objects\": [\n"
+              "    {\"name\": \"Box\", \"label\": \"My \\\"Box\\\", big\", \"type\": "
+              "\"Part::Box\", \"total\": 0.5, \"execute\": 0.25, \"onChanged\": 0.125, "
+              "\"gilWait\": 0},\n"
+              "    {\"name\": \"Cut\", \"label\": \"Cut\", \"type\": \"Part::Cut\", \"total\": 1, "
+              "\"execute\": 0, \"onChanged\": 0, \"gilWait\": 0}\n"
+              "  ]\n"
+              "}\n");
+}
+
+// NOLINTEND(readability-magic-numbers)
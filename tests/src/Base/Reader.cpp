@@ -12,12 +12,16 @@
 #include "Base/Exception.h"
 #include "Base/Persistence.h"
 #include "Base/Reader.h"
+#include "Base/Writer.h"
 #include <array>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <random>
+#include <sstream>
 #include <string>
 #include <xercesc/util/PlatformUtils.hpp>
+#include <zipios++/zipinputstream.h>
 
 namespace fs = std::filesystem;
 
@@ -616,3 +620,81 @@ TEST_F(ReaderTest, validateXmlString)
     std::string result = Base::Persistence::validateXMLString(input);
     EXPECT_EQ(output, result);
 }
+
+namespace
+{
+// Restores a file entry either serially or through a concurrent job
+class FileData: public Base::Persistence
+{
+public:
+    FileData(std::vector<std::string>& restored, bool concurrent)
+        : restored(restored)
+        , concurrent(concurrent)
+    {}
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void RestoreDocFile(Base::Reader& reader) override
+    {
+        restored.emplace_back(
+            std::istreambuf_iterator<char>(reader),
+            std::istreambuf_iterator<char>()
+        );
+    }
+    std::function<std::function<void()>()> getRestoreDocFileJob(Base::Reader& reader) override
+    {
+        if (!concurrent) {
+            return {};
+        }
+        std::string data(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+        return [this, data]() -> std::function<void()> {
+            std::string content = data;
+            return [this, content]() {
+                restored.push_back(content);
+            };
+        };
+    }
+
+private:
+    std::vector<std::string>& restored;
+    bool concurrent;
+};
+}  // namespace
+
+TEST_F(ReaderTest, readFilesConcurrently)
+{
+    // Arrange
+    std::vector<std::string> contents;
+    std::stringstream stream;
+    {
+        Base::ZipWriter writer(stream);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<?xml version='1.0' encoding='utf-8'?><Document/>";
+        for (int i = 0; i < 20; ++i) {
+            contents.emplace_back(std::size_t(100) * (i + 1), char('a' + i));
+            writer.putNextEntry(("Data" + std::to_string(i) + ".txt").c_str());
+            writer.Stream() << contents.back();
+        }
+    }
+    std::vector<std::string> restored;
+    std::vector<std::unique_ptr<FileData>> files;
+    zipios::ZipInputStream zipstream(stream);
+    Base::XMLReader reader("Document.xml", zipstream);
+    for (int i = 0; i < 20; ++i) {
+        files.push_back(std::make_unique<FileData>(restored, i % 3 != 0));
+        reader.addFile(("Data" + std::to_string(i) + ".txt").c_str(), files.back().get());
+    }
+    reader.readElement("Document");
+
+    // Act
+    reader.setThreads(4);
+    reader.readFiles(zipstream);
+
+    // Assert
+    EXPECT_EQ(restored, contents);
+}
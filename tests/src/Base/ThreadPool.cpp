@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <Base/ThreadPool.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+
+TEST(ThreadPoolTest, RunsAllSubmittedTasks)
+{
+    std::atomic<int> counter {0};
+    Base::ThreadPool pool(4);
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&counter] {
+            ++counter;
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, DefaultSizeIsHardwareConcurrency)
+{
+    Base::ThreadPool pool;
+    EXPECT_EQ(pool.size(), Base::ThreadPool::hardwareConcurrency());
+    EXPECT_GE(pool.size(), 1U);
+}
+
+TEST(ThreadPoolTest, TasksMaySubmitTasks)
+{
+    std::atomic<int> counter {0};
+    Base::ThreadPool pool(2);
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&pool, &counter] {
+            for (int j = 0; j < 10; ++j) {
+                pool.submit([&counter] {
+                    ++counter;
+                });
+            }
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(ThreadPoolTest, ThrowingTaskDoesNotStopWorker)
+{
+    std::atomic<int> counter {0};
+    Base::ThreadPool pool(1);
+    pool.submit([] {
+        throw std::runtime_error("task failure");
+    });
+    pool.submit([&counter] {
+        ++counter;
+    });
+    pool.wait();
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(ThreadPoolTest, DestructorWaitsForPendingTasks)
+{
+    std::atomic<int> counter {0};
+    {
+        Base::ThreadPool pool(3);
+        for (int i = 0; i < 30; ++i) {
+            pool.submit([&counter] {
+                std::this_thread::yield();
+                ++counter;
+            });
+        }
+    }
+    EXPECT_EQ(counter.load(), 30);
+}
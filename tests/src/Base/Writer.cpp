@@ -2,7 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+
+#include <zipios++/zipinputstream.h>
+
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
@@ -129,3 +134,175 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+namespace
+{
+// Writes a file entry either serially or through a concurrent job
+class FileData: public Base::Persistence
+{
+public:
+    FileData(std::string content, bool concurrent)
+        : content(std::move(content))
+        , concurrent(concurrent)
+    {}
+    unsigned int getMemSize() const override
+    {
+        return content.size();
+    }
+    void Save(Base::Writer& writer) const override
+    {
+        writer.addFile("Data.txt", this);
+    }
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << content;
+    }
+    std::function<void(Base::Writer&)> getSaveDocFileJob(const Base::Writer& /*writer*/) const override
+    {
+        if (!concurrent) {
+            return {};
+        }
+        return [content = content](Base::Writer& writer) {
+            writer.Stream() << content;
+        };
+    }
+
+private:
+    std::string content;
+    bool concurrent;
+};
+
+using ZipEntries = std::vector<std::pair<std::string, std::string>>;
+
+// Writes 20 files of growing size, the file \a changed gets a different content.
+// The storage method of each file is returned in \a methods and the raw archive in \a archive.
+ZipEntries writeZip(
+    const std::function<void(Base::ZipWriter&)>& setup,
+    std::vector<zipios::StorageMethod>* methods = nullptr,
+    int changed = -1,
+    std::string* archive = nullptr
+)
+{
+    std::vector<std::unique_ptr<FileData>> files;
+    for (int i = 0; i < 20; ++i) {
+        std::string content(std::size_t(1000) * i, char('a' + i));
+        if (i == changed) {
+            content.back() = 'z';
+        }
+        files.push_back(std::make_unique<FileData>(content, i % 3 != 0));
+    }
+
+    std::stringstream stream;
+    {
+        Base::ZipWriter writer(stream);
+        setup(writer);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (const auto& file : files) {
+            file->Save(writer);
+        }
+        writer.writeFiles();
+    }
+    if (archive) {
+        *archive = stream.str();
+    }
+
+    // The stream is positioned at the first entry, and reading past the
+    // last entry throws, so only read what was written
+    ZipEntries entries;
+    zipios::ZipInputStream zip(stream);
+    std::stringstream document;
+    document << zip.rdbuf();
+    entries.emplace_back("Document.xml", document.str());
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        auto entry = zip.getNextEntry();
+        if (!entry->isValid()) {
+            break;
+        }
+        std::stringstream content;
+        content << zip.rdbuf();
+        entries.emplace_back(entry->getName(), content.str());
+        if (methods) {
+            methods->push_back(entry->getMethod());
+        }
+    }
+    return entries;
+}
+}  // namespace
+
+TEST(ZipWriter, concurrentWriteMatchesSerial)
+{
+    // Act
+    auto serial = writeZip([](Base::ZipWriter& writer) {
+        writer.setThreads(1);
+    });
+    auto concurrent = writeZip([](Base::ZipWriter& writer) {
+        writer.setThreads(4);
+    });
+
+    // Assert
+    ASSERT_EQ(serial.size(), 21);
+    EXPECT_EQ(serial[0].second, "<Document/>");
+    EXPECT_EQ(serial[1].first, "Data.txt");
+    EXPECT_EQ(serial[2].first, "Data1.txt");
+    EXPECT_EQ(serial[20].second, std::string(19000, 't'));
+    EXPECT_EQ(concurrent, serial);
+}
+
+TEST(ZipWriter, storeThreshold)
+{
+    // Arrange
+    auto serial = writeZip([](Base::ZipWriter& /*writer*/) {});
+    std::vector<zipios::StorageMethod> methods;
+
+    // Act
+    auto stored = writeZip(
+        [](Base::ZipWriter& writer) {
+            writer.setStoreThreshold(10000);
+        },
+        &methods
+    );
+
+    // Assert
+    ASSERT_EQ(methods.size(), 20);
+    EXPECT_EQ(methods[9], zipios::DEFLATED);
+    EXPECT_EQ(methods[10], zipios::STORED);
+    EXPECT_EQ(stored, serial);
+}
+
+TEST(ZipWriter, entryCacheReusesUnchangedFiles)
+{
+    // Arrange
+    auto cache = std::make_shared<Base::ZipEntryCache>();
+    auto setup = [cache](Base::ZipWriter& writer) {
+        writer.setEntryCache(cache);
+    };
+    writeZip(setup);
+    ASSERT_EQ(cache->size(), 20);
+
+    // Replace the compressed data of an unchanged file with a stored deflate block of the
+    // same content, which differs from what the writer itself produces
+    std::string content(4000, 'e');
+    std::string stored {char(0x01), char(0xa0), char(0x0f), char(0x5f), char(0xf0)};
+    stored += content;
+    Base::ZipEntryCache::Entry entry = *cache->find("Data4.txt");
+    ASSERT_EQ(entry.size, content.size());
+    ASSERT_NE(entry.compressed, stored);
+    entry.compressed = stored;
+    cache->insert("Data4.txt", entry);
+
+    // Act
+    std::string archive;
+    auto entries = writeZip(setup, nullptr, 5, &archive);
+
+    // Assert
+    auto expected = writeZip([](Base::ZipWriter& /*writer*/) {}, nullptr, 5);
+    EXPECT_EQ(entries, expected);
+    EXPECT_NE(archive.find(stored), std::string::npos);
+    EXPECT_EQ(cache->size(), 20);
+    EXPECT_EQ(cache->find("Data4.txt")->compressed, stored);
+    EXPECT_EQ(cache->find("Data5.txt")->size, 5000);
+    EXPECT_EQ(cache->find("Missing.txt"), nullptr);
+}
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a large square at z=0 next to a row of small triangles at z=1
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        points.emplace_back(Base::Vector3f(-100.F, -100.F, 0.F));
+        points.emplace_back(Base::Vector3f(100.F, -100.F, 0.F));
+        points.emplace_back(Base::Vector3f(100.F, 100.F, 0.F));
+        points.emplace_back(Base::Vector3f(-100.F, 100.F, 0.F));
+        facets.emplace_back(0, 1, 2);
+        facets.emplace_back(0, 2, 3);
+        for (int i = 0; i < 100; i++) {
+            float x = 0.1F * float(i);
+            auto index = MeshCore::PointIndex(points.size());
+            points.emplace_back(Base::Vector3f(x, 0.F, 1.F));
+            points.emplace_back(Base::Vector3f(x + 0.1F, 0.F, 1.F));
+            points.emplace_back(Base::Vector3f(x, 0.1F, 1.F));
+            facets.emplace_back(index, index + 1, index + 2);
+        }
+        kernel.Adopt(points, facets, false);
+    }
+
+    void TearDown() override
+    {}
+
+    const MeshCore::MeshKernel& GetKernel() const
+    {
+        return kernel;
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(BVHTest, TestEmpty)
+{
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshFacetBVH bvh(kernel);
+    EXPECT_EQ(bvh.CountFacets(), 0);
+    EXPECT_FALSE(bvh.GetBoundBox().IsValid());
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    EXPECT_FALSE(bvh.NearestFacetOnRay(Base::Vector3f(), Base::Vector3f(0, 0, 1), res, index));
+    EXPECT_FALSE(bvh.NearestFacetToPoint(Base::Vector3f(), 10.F, res, index));
+}
+
+TEST_F(BVHTest, TestRay)
+{
+    MeshCore::MeshFacetBVH bvh(GetKernel());
+    EXPECT_EQ(bvh.CountFacets(), 102);
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    EXPECT_TRUE(bvh.NearestFacetOnRay(
+        Base::Vector3f(5.02F, 0.02F, 5.F),
+        Base::Vector3f(0, 0, -1),
+        res,
+        index
+    ));
+    EXPECT_EQ(index, 52);
+    EXPECT_FLOAT_EQ(res.z, 1.F);
+
+    // between the small triangles the ray hits the large square
+    EXPECT_TRUE(bvh.NearestFacetOnRay(
+        Base::Vector3f(5.02F, 0.5F, 5.F),
+        Base::Vector3f(0, 0, -1),
+        res,
+        index
+    ));
+    EXPECT_LT(index, 2);
+    EXPECT_FLOAT_EQ(res.z, 0.F);
+
+    // facets behind the start point are ignored
+    EXPECT_FALSE(bvh.NearestFacetOnRay(
+        Base::Vector3f(5.02F, 0.02F, 5.F),
+        Base::Vector3f(0, 0, 1),
+        res,
+        index
+    ));
+}
+
+TEST_F(BVHTest, TestNearestPoint)
+{
+    MeshCore::MeshFacetBVH bvh(GetKernel());
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    EXPECT_TRUE(bvh.NearestFacetToPoint(Base::Vector3f(-0.5F, 0.F, 1.F), 10.F, res, index));
+    EXPECT_EQ(index, 2);
+    EXPECT_FLOAT_EQ(res.x, 0.F);
+    EXPECT_FLOAT_EQ(res.z, 1.F);
+
+    EXPECT_TRUE(bvh.NearestFacetToPoint(Base::Vector3f(50.F, 50.F, 0.2F), 10.F, res, index));
+    EXPECT_LT(index, 2);
+    EXPECT_FLOAT_EQ(res.z, 0.F);
+
+    EXPECT_FALSE(bvh.NearestFacetToPoint(Base::Vector3f(50.F, 50.F, 20.F), 10.F, res, index));
+}
+
+TEST_F(BVHTest, TestTransform)
+{
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(0.F, 0.F, 10.F));
+    MeshCore::MeshFacetBVH bvh(GetKernel(), mat);
+    EXPECT_FLOAT_EQ(bvh.GetBoundBox().MinZ, 10.F);
+    EXPECT_FLOAT_EQ(bvh.GetBoundBox().MaxZ, 11.F);
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    EXPECT_TRUE(bvh.NearestFacetOnRay(
+        Base::Vector3f(5.02F, 0.02F, 20.F),
+        Base::Vector3f(0, 0, -1),
+        res,
+        index
+    ));
+    EXPECT_EQ(index, 52);
+    EXPECT_FLOAT_EQ(res.z, 11.F);
+}
+
+TEST_F(BVHTest, TestInside)
+{
+    MeshCore::MeshFacetBVH bvh(GetKernel());
+
+    std::vector<MeshCore::FacetIndex> facets;
+    bvh.Inside(Base::BoundBox3f(1.01F, 0.F, 0.5F, 1.19F, 0.1F, 1.5F), facets);
+    std::sort(facets.begin(), facets.end());
+    std::vector<MeshCore::FacetIndex> expected {12, 13};
+    EXPECT_EQ(facets, expected);
+}
+
+TEST_F(BVHTest, TestLargeMesh)
+{
+    // a wavy grid that is large enough to be built on several threads
+    constexpr int Size = 150;
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (int i = 0; i <= Size; i++) {
+        for (int j = 0; j <= Size; j++) {
+            float z = 0.1F * float((3 * i + 5 * j) % 7);
+            points.emplace_back(Base::Vector3f(float(i), float(j), z));
+        }
+    }
+    for (int i = 0; i < Size; i++) {
+        for (int j = 0; j < Size; j++) {
+            auto index = MeshCore::PointIndex((Size + 1) * i + j);
+            facets.emplace_back(index, index + Size + 1, index + Size + 2);
+            facets.emplace_back(index, index + Size + 2, index + 1);
+        }
+    }
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, false);
+    MeshCore::MeshFacetBVH bvh(kernel);
+    EXPECT_EQ(bvh.CountFacets(), kernel.CountFacets());
+
+    // every facet is found exactly once
+    Base::BoundBox3f box(10.5F, 20.5F, -1.F, 90.5F, 60.5F, 1.F);
+    std::vector<MeshCore::FacetIndex> found;
+    bvh.Inside(box, found);
+    std::sort(found.begin(), found.end());
+    std::vector<MeshCore::FacetIndex> expected;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        if (kernel.GetFacet(i).GetBoundBox() && box) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_EQ(found, expected);
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    for (int k = 0; k < 20; k++) {
+        // the ray hits quad (i, j) off its diagonal
+        int i = (7 * k) % Size;
+        int j = (5 * k) % Size;
+        float dx = 0.1F + 0.04F * float(k);
+        float dy = 0.88F - 0.04F * float(k);
+        Base::Vector3f pnt(float(i) + dx, float(j) + dy, 2.F);
+        auto facet = MeshCore::FacetIndex(2 * (Size * i + j) + (dx >= dy ? 0 : 1));
+        ASSERT_TRUE(bvh.NearestFacetOnRay(pnt, Base::Vector3f(0, 0, -1), res, index));
+        EXPECT_EQ(index, facet);
+        EXPECT_FLOAT_EQ(res.x, pnt.x);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/CompactKernel.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Visitor.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+
+class CountVisitor: public MeshCore::MeshFacetVisitor
+{
+public:
+    bool Visit(
+        const MeshCore::MeshFacet&,
+        const MeshCore::MeshFacet&,
+        MeshCore::FacetIndex,
+        unsigned long ulLevel
+    ) override
+    {
+        maxLevel = std::max(maxLevel, ulLevel);
+        return true;
+    }
+
+    unsigned long maxLevel = 0;
+};
+
+}  // namespace
+
+class CompactKernelTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy grid of 10x10 quads
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i <= 10; i++) {
+            for (int j = 0; j <= 10; j++) {
+                float x = 0.3F * float(i);
+                float y = 0.7F * float(j);
+                points.emplace_back(Base::Vector3f(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 10; j++) {
+                auto index = MeshCore::PointIndex(11 * i + j);
+                facets.emplace_back(index, index + 11, index + 12);
+                facets.emplace_back(index, index + 12, index + 1);
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    const MeshCore::MeshKernel& GetKernel() const
+    {
+        return kernel;
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(CompactKernelTest, TestGeometry)
+{
+    MeshCore::MeshCompactKernel compact(GetKernel());
+    EXPECT_FALSE(compact.IsQuantized());
+    EXPECT_EQ(compact.CountPoints(), GetKernel().CountPoints());
+    EXPECT_EQ(compact.CountFacets(), GetKernel().CountFacets());
+
+    for (MeshCore::PointIndex i = 0; i < compact.CountPoints(); i++) {
+        EXPECT_EQ(Base::Vector3f(compact.GetPoint(i)), Base::Vector3f(GetKernel().GetPoint(i)));
+    }
+
+    const MeshCore::MeshFacetArray& facets = GetKernel().GetFacets();
+    for (MeshCore::FacetIndex i = 0; i < compact.CountFacets(); i++) {
+        MeshCore::MeshFacet facet = compact.GetTopoFacet(i);
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facet._aulPoints[j], facets[i]._aulPoints[j]);
+            EXPECT_EQ(facet._aulNeighbours[j], facets[i]._aulNeighbours[j]);
+        }
+        EXPECT_EQ(compact.GetFacet(i).GetNormal(), GetKernel().GetFacet(i).GetNormal());
+    }
+}
+
+TEST_F(CompactKernelTest, TestQuantized)
+{
+    MeshCore::MeshCompactKernel compact(GetKernel(), true);
+    EXPECT_TRUE(compact.IsQuantized());
+
+    Base::Vector3f res = compact.GetResolution();
+    for (MeshCore::PointIndex i = 0; i < compact.CountPoints(); i++) {
+        Base::Vector3f dif = compact.GetPoint(i) - GetKernel().GetPoint(i);
+        EXPECT_LE(std::fabs(dif.x), 0.5F * res.x + 1e-6F);
+        EXPECT_LE(std::fabs(dif.y), 0.5F * res.y + 1e-6F);
+        EXPECT_LE(std::fabs(dif.z), 0.5F * res.z + 1e-6F);
+    }
+
+    MeshCore::MeshCompactKernel full(GetKernel());
+    EXPECT_LT(compact.GetMemSize(), full.GetMemSize());
+    EXPECT_LT(full.GetMemSize(), GetKernel().GetMemSize());
+}
+
+TEST_F(CompactKernelTest, TestIterators)
+{
+    MeshCore::MeshCompactKernel compact(GetKernel());
+    MeshCore::MeshCompactFacetIterator cIt(compact);
+    MeshCore::MeshFacetIterator fIt(GetKernel());
+    unsigned long count = 0;
+    for (cIt.Init(), fIt.Init(); cIt.More(); cIt.Next(), fIt.Next()) {
+        EXPECT_EQ(cIt->_aclPoints[1], fIt->_aclPoints[1]);
+        EXPECT_EQ(cIt.Position(), fIt.Position());
+        count++;
+    }
+    EXPECT_EQ(count, compact.CountFacets());
+    EXPECT_TRUE(fIt.EndReached());
+
+    MeshCore::MeshCompactPointIterator pIt(compact);
+    EXPECT_TRUE(pIt.Set(12));
+    EXPECT_EQ(Base::Vector3f(*pIt), Base::Vector3f(GetKernel().GetPoint(12)));
+    EXPECT_FALSE(pIt.Set(compact.CountPoints()));
+}
+
+TEST_F(CompactKernelTest, TestFlags)
+{
+    MeshCore::MeshCompactKernel compact(GetKernel());
+    compact.GetTopoFacet(0);  // builds the neighbours
+    std::size_t size = compact.GetMemSize();
+    EXPECT_FALSE(compact.IsFacetFlag(70, MeshCore::MeshFacet::MARKED));
+
+    compact.SetFacetFlag(70, MeshCore::MeshFacet::MARKED);
+    compact.SetPointFlag(5, MeshCore::MeshPoint::SELECTED);
+    EXPECT_GT(compact.GetMemSize(), size);
+    EXPECT_TRUE(compact.IsFacetFlag(70, MeshCore::MeshFacet::MARKED));
+    EXPECT_FALSE(compact.IsFacetFlag(71, MeshCore::MeshFacet::MARKED));
+    EXPECT_FALSE(compact.IsFacetFlag(70, MeshCore::MeshFacet::VISIT));
+    EXPECT_TRUE(compact.GetTopoFacet(70).IsFlag(MeshCore::MeshFacet::MARKED));
+    EXPECT_TRUE(compact.GetPoint(5).IsFlag(MeshCore::MeshPoint::SELECTED));
+
+    MeshCore::MeshCompactFacetIterator it(compact, 71);
+    it.SetFlag(MeshCore::MeshFacet::MARKED);
+    EXPECT_TRUE(compact.IsFacetFlag(71, MeshCore::MeshFacet::MARKED));
+    it.ResetFlag(MeshCore::MeshFacet::MARKED);
+    EXPECT_FALSE(it.IsFlag(MeshCore::MeshFacet::MARKED));
+
+    compact.ResetFacetFlags(MeshCore::MeshFacet::MARKED);
+    compact.ResetPointFlags(MeshCore::MeshPoint::SELECTED);
+    EXPECT_FALSE(compact.IsFacetFlag(70, MeshCore::MeshFacet::MARKED));
+    EXPECT_EQ(compact.GetMemSize(), size);
+}
+
+TEST_F(CompactKernelTest, TestVisitor)
+{
+    MeshCore::MeshCompactKernel compact(GetKernel());
+    CountVisitor visitor;
+    EXPECT_EQ(compact.VisitNeighbourFacets(visitor, 0), compact.CountFacets() - 1);
+    EXPECT_TRUE(compact.IsFacetFlag(199, MeshCore::MeshFacet::VISIT));
+
+    CountVisitor reference;
+    GetKernel().VisitNeighbourFacets(reference, 0);
+    EXPECT_EQ(visitor.maxLevel, reference.maxLevel);
+}
+
+TEST_F(CompactKernelTest, TestCopyTo)
+{
+    MeshCore::MeshCompactKernel compact(GetKernel());
+    compact.SetFacetFlag(3, MeshCore::MeshFacet::SELECTED);
+
+    MeshCore::MeshKernel kernel;
+    compact.CopyTo(kernel);
+    EXPECT_EQ(kernel.CountPoints(), GetKernel().CountPoints());
+    EXPECT_EQ(kernel.CountFacets(), GetKernel().CountFacets());
+    EXPECT_TRUE(kernel.GetFacets()[3].IsFlag(MeshCore::MeshFacet::SELECTED));
+    const MeshCore::MeshFacetArray& facets = GetKernel().GetFacets();
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        const MeshCore::MeshFacet& facet = kernel.GetFacets()[i];
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facet._aulPoints[j], facets[i]._aulPoints[j]);
+            EXPECT_EQ(facet._aulNeighbours[j], facets[i]._aulNeighbours[j]);
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
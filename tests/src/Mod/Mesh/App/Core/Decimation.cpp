@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a roof over the unit square with its ridge at x=0.5
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j <= size; j++) {
+                float x = float(i) / float(size);
+                float y = float(j) / float(size);
+                points.emplace_back(Base::Vector3f(x, y, height(x)));
+            }
+        }
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                auto index = MeshCore::PointIndex(i * (size + 1) + j);
+                facets.emplace_back(index, index + size + 1, index + 1);
+                facets.emplace_back(index + 1, index + size + 1, index + size + 2);
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    static float height(float x)
+    {
+        return 0.5F - std::fabs(x - 0.5F);
+    }
+
+    static std::size_t countOpenEdges(const MeshCore::MeshKernel& mesh)
+    {
+        std::size_t count = 0;
+        for (const auto& facet : mesh.GetFacets()) {
+            for (auto neighbour : facet._aulNeighbours) {
+                if (neighbour == MeshCore::FACET_INDEX_MAX) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    static float maxDeviation(const MeshCore::MeshKernel& mesh)
+    {
+        float dev = 0.0F;
+        for (const auto& point : mesh.GetPoints()) {
+            dev = std::max(dev, std::fabs(point.z - height(point.x)));
+        }
+        return dev;
+    }
+
+    static constexpr int size = 60;
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(DecimationTest, TestTargetSize)
+{
+    MeshCore::MeshSimplify::Parameters params;
+    params.targetSize = 1000;
+    MeshCore::MeshSimplify simplify(kernel);
+    EXPECT_TRUE(simplify.simplify(params));
+    EXPECT_LE(kernel.CountFacets(), 1000);
+    EXPECT_GT(kernel.CountFacets(), 0);
+}
+
+TEST_F(DecimationTest, TestKeepFeatures)
+{
+    MeshCore::MeshSimplify::Parameters params;
+    params.targetSize = 500;
+    params.keepBorders = true;
+    params.creaseAngle = 0.1F;
+    MeshCore::MeshSimplify simplify(kernel);
+    EXPECT_TRUE(simplify.simplify(params));
+    EXPECT_LT(kernel.CountFacets(), 2 * size * size);
+
+    // the locked points of the borders keep all border edges
+    EXPECT_EQ(countOpenEdges(kernel), 4 * size);
+    // the ridge is kept so that no point leaves the roof
+    EXPECT_LT(maxDeviation(kernel), 1e-5F);
+}
+
+TEST_F(DecimationTest, TestMaxError)
+{
+    MeshCore::MeshSimplify::Parameters params;
+    params.maxError = 0.01F;
+    MeshCore::MeshSimplify simplify(kernel);
+    EXPECT_TRUE(simplify.simplify(params));
+    EXPECT_LT(kernel.CountFacets(), 2 * size * size);
+    EXPECT_LE(maxDeviation(kernel), 0.01F);
+}
+
+TEST_F(DecimationTest, TestPartitions)
+{
+    MeshCore::MeshSimplify::Parameters params;
+    params.targetSize = 1000;
+    params.keepBorders = true;
+    params.partitionSize = 1000;
+    MeshCore::MeshSimplify simplify(kernel);
+    EXPECT_TRUE(simplify.simplify(params));
+    EXPECT_LE(kernel.CountFacets(), 1000);
+
+    // joining the parts leaves no gaps
+    EXPECT_EQ(countOpenEdges(kernel), 4 * size);
+}
+
+TEST_F(DecimationTest, TestCancel)
+{
+    MeshCore::MeshSimplify::Parameters params;
+    params.targetSize = 1000;
+    params.progress = [](float) {
+        return false;
+    };
+    MeshCore::MeshSimplify simplify(kernel);
+    EXPECT_FALSE(simplify.simplify(params));
+    EXPECT_EQ(kernel.CountFacets(), 2 * size * size);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
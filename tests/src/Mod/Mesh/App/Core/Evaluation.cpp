@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <Base/Exception.h>
+#include <Base/Sequencer.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+// Counts the progress steps and cancels the operation if it can be cancelled
+class CancelSequencer: public Base::SequencerBase
+{
+public:
+    int steps {0};
+
+protected:
+    void nextStep(bool canAbort) override
+    {
+        steps++;
+        if (canAbort) {
+            throw Base::AbortException("User aborted");
+        }
+    }
+};
+}  // namespace
+
+class SelfIntersectionTest: public ::testing::Test
+{
+protected:
+    using Pairs = std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>>;
+
+    // a flat grid of size x size quads and a triangle piercing the grid at each (x, y) of 'pierce'
+    static MeshCore::MeshKernel Mesh(int size, const std::vector<std::pair<float, float>>& pierce)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j <= size; j++) {
+                points.emplace_back(Base::Vector3f(float(i), float(j), 0.0F));
+            }
+        }
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                auto index = MeshCore::PointIndex((size + 1) * i + j);
+                facets.emplace_back(index, index + size + 1, index + size + 2);
+                facets.emplace_back(index, index + size + 2, index + 1);
+            }
+        }
+        for (const auto& [x, y] : pierce) {
+            Base::Vector3f pt(x, y, 0.0F);
+            auto index = MeshCore::PointIndex(points.size());
+            points.emplace_back(pt + Base::Vector3f(0.0F, 0.0F, -1.0F));
+            points.emplace_back(pt + Base::Vector3f(0.3F, 0.0F, 1.0F));
+            points.emplace_back(pt + Base::Vector3f(0.0F, 0.3F, 1.0F));
+            facets.emplace_back(index, index + 1, index + 2);
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    // checks all pairs of facets without a common point
+    static Pairs BruteForce(const MeshCore::MeshKernel& kernel)
+    {
+        Pairs pairs;
+        const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+        Base::Vector3f pt1, pt2;
+        for (MeshCore::FacetIndex i = 0; i < facets.size(); i++) {
+            for (MeshCore::FacetIndex j = i + 1; j < facets.size(); j++) {
+                const MeshCore::MeshFacet& facet1 = facets[i];
+                const MeshCore::MeshFacet& facet2 = facets[j];
+                if (facet1.HasPoint(facet2._aulPoints[0]) || facet1.HasPoint(facet2._aulPoints[1])
+                    || facet1.HasPoint(facet2._aulPoints[2])) {
+                    continue;
+                }
+                if (kernel.GetFacet(i).IntersectWithFacet(kernel.GetFacet(j), pt1, pt2) == 2) {
+                    pairs.emplace_back(i, j);
+                }
+            }
+        }
+        return pairs;
+    }
+};
+
+TEST_F(SelfIntersectionTest, TestNoIntersection)
+{
+    auto kernel = Mesh(10, {});
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    Pairs pairs;
+    eval.GetIntersections(pairs);
+
+    EXPECT_TRUE(eval.Evaluate());
+    EXPECT_TRUE(pairs.empty());
+}
+
+TEST_F(SelfIntersectionTest, TestPairsAreUniqueAndSorted)
+{
+    auto kernel = Mesh(10, {{7.2F, 3.4F}, {0.2F, 0.4F}, {4.4F, 4.3F}});
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    Pairs pairs;
+    eval.GetIntersections(pairs);
+
+    Pairs expected = BruteForce(kernel);
+    EXPECT_GE(expected.size(), 3);
+    EXPECT_EQ(pairs, expected);
+    EXPECT_FALSE(eval.Evaluate());
+}
+
+TEST_F(SelfIntersectionTest, TestEvaluateStopsAtFirst)
+{
+    // the grid is checked in several blocks, the intersection is in the first one
+    auto kernel = Mesh(100, {{0.2F, 0.4F}});
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+
+    CancelSequencer seq;
+    EXPECT_FALSE(eval.Evaluate());
+    EXPECT_EQ(seq.steps, 0);
+}
+
+TEST_F(SelfIntersectionTest, TestCancel)
+{
+    auto kernel = Mesh(100, {});
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    Pairs pairs;
+
+    CancelSequencer seq;
+    EXPECT_THROW(eval.GetIntersections(pairs), Base::AbortException);
+    EXPECT_EQ(seq.steps, 1);
+
+    // Evaluate() cannot be cancelled
+    seq.steps = 0;
+    EXPECT_TRUE(eval.Evaluate());
+    EXPECT_GT(seq.steps, 1);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
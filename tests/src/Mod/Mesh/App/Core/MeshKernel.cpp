@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshKernelTest: public ::testing::Test
+{
+protected:
+    static constexpr int Size = 30;
+    static constexpr std::size_t HeaderSize = 64;
+
+    void SetUp() override
+    {
+        // a grid of 30x30 quads
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i <= Size; i++) {
+            for (int j = 0; j <= Size; j++) {
+                points.emplace_back(Base::Vector3f(float(i), float(j), 0.01F * float(i * j)));
+            }
+        }
+        for (int i = 0; i < Size; i++) {
+            for (int j = 0; j < Size; j++) {
+                auto index = MeshCore::PointIndex((Size + 1) * i + j);
+                facets.emplace_back(index, index + Size + 1, index + Size + 2);
+                facets.emplace_back(index, index + Size + 2, index + 1);
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::MeshKernel& GetKernel()
+    {
+        return kernel;
+    }
+
+    std::size_t PointsOffset() const
+    {
+        return HeaderSize + 12 * kernel.CountPoints();
+    }
+
+    std::size_t NeighboursOffset() const
+    {
+        return PointsOffset() + 12 * kernel.CountFacets();
+    }
+
+    // Legacy format: magic, version, 256 bytes of text, then 32-bit values only
+    static std::string SwapLegacy(std::string data)
+    {
+        constexpr std::size_t InfoBegin = 8;
+        constexpr std::size_t InfoEnd = InfoBegin + 256;
+        for (std::size_t i = 0; i + 4 <= data.size(); i += 4) {
+            if (i >= InfoBegin && i < InfoEnd) {
+                continue;
+            }
+            std::swap(data[i], data[i + 3]);
+            std::swap(data[i + 1], data[i + 2]);
+        }
+        return data;
+    }
+
+    static void SetValue(std::string& data, std::size_t offset, std::uint32_t value)
+    {
+        std::memcpy(&data[offset], &value, sizeof(value));
+    }
+
+    static void SetValue64(std::string& data, std::size_t offset, std::uint64_t value)
+    {
+        std::memcpy(&data[offset], &value, sizeof(value));
+    }
+
+    void ExpectEqual(const MeshCore::MeshKernel& mesh) const
+    {
+        ASSERT_EQ(mesh.CountPoints(), kernel.CountPoints());
+        ASSERT_EQ(mesh.CountFacets(), kernel.CountFacets());
+        for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+            EXPECT_EQ(Base::Vector3f(mesh.GetPoint(i)), Base::Vector3f(kernel.GetPoint(i)));
+        }
+        const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+        for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+            const MeshCore::MeshFacet& facet = mesh.GetFacets()[i];
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(facet._aulPoints[j], facets[i]._aulPoints[j]);
+                EXPECT_EQ(facet._aulNeighbours[j], facets[i]._aulNeighbours[j]);
+            }
+        }
+        EXPECT_EQ(mesh.GetBoundBox().MaxZ, kernel.GetBoundBox().MaxZ);
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshKernelTest, TestWriteRead)
+{
+    GetKernel().GetFacets()[5].SetFlag(MeshCore::MeshFacet::SELECTED);
+    GetKernel().GetPoints()[7].SetFlag(MeshCore::MeshPoint::MARKED);
+
+    std::stringstream str;
+    GetKernel().WriteNative(str);
+    EXPECT_EQ(str.str().size() % 8, 0);
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_TRUE(mesh.Read(str));
+    ExpectEqual(mesh);
+    EXPECT_TRUE(mesh.GetFacets()[5].IsFlag(MeshCore::MeshFacet::SELECTED));
+    EXPECT_FALSE(mesh.GetFacets()[6].IsFlag(MeshCore::MeshFacet::SELECTED));
+    EXPECT_TRUE(mesh.GetPoints()[7].IsFlag(MeshCore::MeshPoint::MARKED));
+}
+
+TEST_F(MeshKernelTest, TestWriteLegacy)
+{
+    std::stringstream str;
+    GetKernel().Write(str);
+    std::string data = str.str();
+    std::uint32_t version {};
+    std::memcpy(&version, &data[4], sizeof(version));
+    EXPECT_EQ(version, 0x010000);
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_FALSE(mesh.Read(str));
+    ExpectEqual(mesh);
+}
+
+TEST_F(MeshKernelTest, TestReadLegacySwapped)
+{
+    std::stringstream out;
+    GetKernel().Write(out);
+    std::stringstream str(SwapLegacy(out.str()));
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_FALSE(mesh.Read(str));
+    ExpectEqual(mesh);
+}
+
+TEST_F(MeshKernelTest, TestCompressed)
+{
+    std::stringstream raw;
+    GetKernel().WriteNative(raw);
+    std::stringstream str;
+    GetKernel().WriteNative(str, true);
+    EXPECT_LT(str.str().size(), raw.str().size());
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_TRUE(mesh.Read(str));
+    ExpectEqual(mesh);
+}
+
+TEST_F(MeshKernelTest, TestEmpty)
+{
+    MeshCore::MeshKernel empty;
+    std::stringstream str;
+    empty.WriteNative(str);
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_TRUE(mesh.Read(str));
+    EXPECT_EQ(mesh.CountPoints(), 0);
+    EXPECT_EQ(mesh.CountFacets(), 0);
+}
+
+TEST_F(MeshKernelTest, TestInconsistentNeighbours)
+{
+    std::stringstream out;
+    GetKernel().WriteNative(out);
+    std::string data = out.str();
+
+    // facet 0 refers to a facet that is not adjacent
+    SetValue(data, NeighboursOffset(), 100);
+
+    std::stringstream str(data);
+    MeshCore::MeshKernel mesh;
+    EXPECT_FALSE(mesh.Read(str));
+    EXPECT_EQ(mesh.CountFacets(), GetKernel().CountFacets());
+}
+
+TEST_F(MeshKernelTest, TestInvalidData)
+{
+    std::stringstream out;
+    GetKernel().WriteNative(out);
+    std::string data = out.str();
+
+    std::string invalid = data;
+    SetValue(invalid, PointsOffset() + 4, GetKernel().CountPoints());
+    std::stringstream str1(invalid);
+    MeshCore::MeshKernel mesh;
+    EXPECT_THROW(mesh.Read(str1), Base::BadFormatError);
+    EXPECT_EQ(mesh.CountFacets(), 0);
+
+    std::stringstream str2(data.substr(0, data.size() / 2));
+    EXPECT_THROW(mesh.Read(str2), Base::BadFormatError);
+}
+
+TEST_F(MeshKernelTest, TestInvalidSizes)
+{
+    constexpr std::size_t CountFacetsOffset = 24;
+    constexpr std::size_t DataSizeOffset = 56;
+    const std::uint64_t countPoints = GetKernel().CountPoints();
+    const std::uint64_t countFacets = 0x7fffffff;
+    auto align = [](std::uint64_t offset) {
+        return (offset + 7) & ~std::uint64_t(7);
+    };
+    MeshCore::MeshKernel mesh;
+
+    // the counts and the size fit but the stream is much shorter
+    std::stringstream out;
+    GetKernel().WriteNative(out);
+    std::string raw = out.str();
+    SetValue64(raw, CountFacetsOffset, countFacets);
+    SetValue64(
+        raw,
+        DataSizeOffset,
+        align(align(12 * countPoints + 24 * countFacets + countPoints) + countFacets)
+    );
+    std::stringstream str1(raw);
+    EXPECT_THROW(mesh.Read(str1), Base::BadFormatError);
+
+    std::stringstream compressed;
+    GetKernel().WriteNative(compressed, true);
+
+    // more compressed data than the counts need
+    std::string data = compressed.str();
+    SetValue64(data, DataSizeOffset, std::uint64_t(1) << 40);
+    std::stringstream str2(data);
+    EXPECT_THROW(mesh.Read(str2), Base::BadFormatError);
+
+    // counts that need more data than zlib can compress into the stored size
+    data = compressed.str();
+    SetValue64(data, CountFacetsOffset, countFacets);
+    std::stringstream str3(data);
+    EXPECT_THROW(mesh.Read(str3), Base::BadFormatError);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
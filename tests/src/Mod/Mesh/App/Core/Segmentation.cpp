@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Segmentation.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+
+// Forces the facet visitor in MeshSegmentAlgorithm
+template<class Segment>
+class Sequential: public Segment
+{
+public:
+    using Segment::Segment;
+    bool HasFixedTest() const override
+    {
+        return false;
+    }
+};
+
+std::vector<MeshCore::MeshSegment> Sorted(const MeshCore::MeshSurfaceSegment& segm)
+{
+    std::vector<MeshCore::MeshSegment> segments = segm.GetSegments();
+    for (auto& it : segments) {
+        std::sort(it.begin(), it.end());
+    }
+    return segments;
+}
+
+}  // namespace
+
+class SegmentationTest: public ::testing::Test
+{
+protected:
+    static constexpr int Size = 40;
+
+    void SetUp() override
+    {
+        // a grid of 40x40 quads with steps and curvatures that vary in patches
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i <= Size; i++) {
+            for (int j = 0; j <= Size; j++) {
+                float z = 0.5F * float((i / 4 + j / 3) % 2);
+                points.emplace_back(Base::Vector3f(float(i), float(j), z));
+
+                MeshCore::CurvatureInfo ci {};
+                ci.fMaxCurvature = 0.1F * float((i / 5 + j / 7) % 3);
+                ci.fMinCurvature = 0.1F * float((i * j) % 4 == 0 ? 1 : 0);
+                curvature.push_back(ci);
+            }
+        }
+        for (int i = 0; i < Size; i++) {
+            for (int j = 0; j < Size; j++) {
+                auto index = MeshCore::PointIndex((Size + 1) * i + j);
+                facets.emplace_back(index, index + Size + 1, index + Size + 2);
+                facets.emplace_back(index, index + Size + 2, index + 1);
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    const MeshCore::MeshKernel& GetKernel() const
+    {
+        return kernel;
+    }
+
+    const std::vector<MeshCore::CurvatureInfo>& GetCurvature() const
+    {
+        return curvature;
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+    std::vector<MeshCore::CurvatureInfo> curvature;
+};
+
+TEST_F(SegmentationTest, TestFixedTest)
+{
+    MeshCore::MeshCurvaturePlanarSegment curv(GetCurvature(), 1, 0.05F);
+    EXPECT_TRUE(curv.HasFixedTest());
+
+    auto fixed = new MeshCore::PlaneSurfaceFit(Base::Vector3f(), Base::Vector3f(0, 0, 1));
+    MeshCore::MeshDistanceGenericSurfaceFitSegment plane(fixed, GetKernel(), 1, 0.01F);
+    EXPECT_TRUE(plane.HasFixedTest());
+
+    auto fit = new MeshCore::PlaneSurfaceFit();
+    MeshCore::MeshDistanceGenericSurfaceFitSegment adaptive(fit, GetKernel(), 1, 0.01F);
+    EXPECT_FALSE(adaptive.HasFixedTest());
+}
+
+TEST_F(SegmentationTest, TestCurvatureSegments)
+{
+    auto planar = std::make_shared<MeshCore::MeshCurvaturePlanarSegment>(GetCurvature(), 2, 0.05F);
+    auto freeform = std::make_shared<MeshCore::MeshCurvatureFreeformSegment>(
+        GetCurvature(),
+        2,
+        0.05F,
+        0.05F,
+        0.1F,
+        0.0F
+    );
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm {planar, freeform};
+    MeshCore::MeshSegmentAlgorithm(GetKernel()).FindSegments(segm);
+
+    auto seqPlanar = std::make_shared<Sequential<MeshCore::MeshCurvaturePlanarSegment>>(
+        GetCurvature(),
+        2,
+        0.05F
+    );
+    auto seqFreeform = std::make_shared<Sequential<MeshCore::MeshCurvatureFreeformSegment>>(
+        GetCurvature(),
+        2,
+        0.05F,
+        0.05F,
+        0.1F,
+        0.0F
+    );
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> seq {seqPlanar, seqFreeform};
+    MeshCore::MeshSegmentAlgorithm(GetKernel()).FindSegments(seq);
+
+    EXPECT_FALSE(planar->GetSegments().empty());
+    EXPECT_FALSE(freeform->GetSegments().empty());
+    EXPECT_EQ(Sorted(*planar), Sorted(*seqPlanar));
+    EXPECT_EQ(Sorted(*freeform), Sorted(*seqFreeform));
+}
+
+TEST_F(SegmentationTest, TestFixedSurface)
+{
+    auto plane = std::make_shared<MeshCore::MeshDistanceGenericSurfaceFitSegment>(
+        new MeshCore::PlaneSurfaceFit(Base::Vector3f(), Base::Vector3f(0, 0, 1)),
+        GetKernel(),
+        3,
+        0.01F
+    );
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm {plane};
+    MeshCore::MeshSegmentAlgorithm(GetKernel()).FindSegments(segm);
+
+    auto seqPlane = std::make_shared<Sequential<MeshCore::MeshDistanceGenericSurfaceFitSegment>>(
+        new MeshCore::PlaneSurfaceFit(Base::Vector3f(), Base::Vector3f(0, 0, 1)),
+        GetKernel(),
+        3,
+        0.01F
+    );
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> seq {seqPlane};
+    MeshCore::MeshSegmentAlgorithm(GetKernel()).FindSegments(seq);
+
+    EXPECT_FALSE(plane->GetSegments().empty());
+    EXPECT_EQ(Sorted(*plane), Sorted(*seqPlane));
+    for (const auto& segment : plane->GetSegments()) {
+        for (MeshCore::FacetIndex index : segment) {
+            MeshCore::MeshGeomFacet facet = GetKernel().GetFacet(index);
+            EXPECT_FLOAT_EQ(facet._aclPoints[0].z + facet._aclPoints[1].z, 0.0F);
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
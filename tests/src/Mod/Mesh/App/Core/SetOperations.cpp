@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cmath>
+#include <numbers>
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SetOperationsTest: public ::testing::Test
+{
+protected:
+    // a cube with edge length 1 and its minimum at 'offset'
+    static MeshCore::MeshKernel Box(const Base::Vector3f& offset)
+    {
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i < 8; i++) {
+            Base::Vector3f pt(float(i & 1), float((i >> 1) & 1), float((i >> 2) & 1));
+            points.emplace_back(pt + offset);
+        }
+        MeshCore::MeshFacetArray facets;
+        facets.emplace_back(0, 2, 3);
+        facets.emplace_back(0, 3, 1);
+        facets.emplace_back(4, 5, 7);
+        facets.emplace_back(4, 7, 6);
+        facets.emplace_back(0, 1, 5);
+        facets.emplace_back(0, 5, 4);
+        facets.emplace_back(2, 6, 7);
+        facets.emplace_back(2, 7, 3);
+        facets.emplace_back(0, 4, 6);
+        facets.emplace_back(0, 6, 2);
+        facets.emplace_back(1, 3, 7);
+        facets.emplace_back(1, 7, 5);
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    // a sphere with radius 1 made of 16 stacks and 32 slices
+    static MeshCore::MeshKernel Sphere(const Base::Vector3f& center)
+    {
+        constexpr int Stacks = 16;
+        constexpr int Slices = 32;
+        const float pi = std::numbers::pi_v<float>;
+
+        MeshCore::MeshPointArray points;
+        points.emplace_back(center + Base::Vector3f(0, 0, 1));
+        for (int i = 1; i < Stacks; i++) {
+            float theta = pi * float(i) / float(Stacks);
+            for (int j = 0; j < Slices; j++) {
+                float phi = 2.0F * pi * float(j) / float(Slices);
+                Base::Vector3f dir(
+                    std::sin(theta) * std::cos(phi),
+                    std::sin(theta) * std::sin(phi),
+                    std::cos(theta)
+                );
+                points.emplace_back(center + dir);
+            }
+        }
+        points.emplace_back(center - Base::Vector3f(0, 0, 1));
+
+        auto ring = [](int i, int j) {
+            return MeshCore::PointIndex(1 + (i - 1) * Slices + j % Slices);
+        };
+        auto bottom = MeshCore::PointIndex(points.size() - 1);
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j < Slices; j++) {
+            facets.emplace_back(0, ring(1, j), ring(1, j + 1));
+            for (int i = 1; i < Stacks - 1; i++) {
+                facets.emplace_back(ring(i, j), ring(i + 1, j), ring(i + 1, j + 1));
+                facets.emplace_back(ring(i, j), ring(i + 1, j + 1), ring(i, j + 1));
+            }
+            facets.emplace_back(ring(Stacks - 1, j), bottom, ring(Stacks - 1, j + 1));
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    static MeshCore::MeshKernel Compute(
+        const MeshCore::MeshKernel& mesh1,
+        const MeshCore::MeshKernel& mesh2,
+        MeshCore::SetOperations::OperationType type,
+        std::size_t threads = 0
+    )
+    {
+        MeshCore::MeshKernel result;
+        MeshCore::SetOperations setOp(mesh1, mesh2, result, type);
+        setOp.SetMaxThreads(threads);
+        setOp.Do();
+        return result;
+    }
+
+    static void ExpectEqual(const MeshCore::MeshKernel& mesh1, const MeshCore::MeshKernel& mesh2)
+    {
+        ASSERT_EQ(mesh1.CountPoints(), mesh2.CountPoints());
+        ASSERT_EQ(mesh1.CountFacets(), mesh2.CountFacets());
+        for (MeshCore::PointIndex i = 0; i < mesh1.CountPoints(); i++) {
+            EXPECT_EQ(Base::Vector3f(mesh1.GetPoint(i)), Base::Vector3f(mesh2.GetPoint(i)));
+        }
+        for (MeshCore::FacetIndex i = 0; i < mesh1.CountFacets(); i++) {
+            const MeshCore::MeshFacet& facet1 = mesh1.GetFacets()[i];
+            const MeshCore::MeshFacet& facet2 = mesh2.GetFacets()[i];
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(facet1._aulPoints[j], facet2._aulPoints[j]);
+            }
+        }
+    }
+};
+
+TEST_F(SetOperationsTest, TestDisjointBoxes)
+{
+    auto box1 = Box(Base::Vector3f(0, 0, 0));
+    auto box2 = Box(Base::Vector3f(3, 0, 0));
+
+    EXPECT_EQ(Compute(box1, box2, MeshCore::SetOperations::Union).CountFacets(), 24);
+    EXPECT_EQ(Compute(box1, box2, MeshCore::SetOperations::Intersect).CountFacets(), 0);
+    EXPECT_EQ(Compute(box1, box2, MeshCore::SetOperations::Difference).CountFacets(), 12);
+}
+
+TEST_F(SetOperationsTest, TestBoxes)
+{
+    // the boxes overlap in a block of 0.5 x 0.6 x 0.7
+    auto box1 = Box(Base::Vector3f(0, 0, 0));
+    auto box2 = Box(Base::Vector3f(0.5F, 0.4F, 0.3F));
+    ASSERT_FLOAT_EQ(box1.GetVolume(), 1.0F);
+
+    auto unite = Compute(box1, box2, MeshCore::SetOperations::Union);
+    auto inter = Compute(box1, box2, MeshCore::SetOperations::Intersect);
+    auto diff = Compute(box1, box2, MeshCore::SetOperations::Difference);
+
+    EXPECT_GT(unite.CountFacets(), 0);
+    EXPECT_GT(inter.CountFacets(), 0);
+    EXPECT_GT(diff.CountFacets(), 0);
+    EXPECT_FALSE(unite.HasOpenEdges());
+    EXPECT_FALSE(inter.HasOpenEdges());
+    EXPECT_FALSE(diff.HasOpenEdges());
+    EXPECT_NEAR(unite.GetVolume(), 1.79F, 1e-4F);
+    EXPECT_NEAR(inter.GetVolume(), 0.21F, 1e-4F);
+    EXPECT_NEAR(diff.GetVolume(), 0.79F, 1e-4F);
+}
+
+TEST_F(SetOperationsTest, TestSpheres)
+{
+    auto sphere1 = Sphere(Base::Vector3f(0, 0, 0));
+    auto sphere2 = Sphere(Base::Vector3f(0.7F, 0.1F, 0.05F));
+    float volume = sphere1.GetVolume();
+    ASSERT_GT(volume, 4.0F);
+
+    auto unite = Compute(sphere1, sphere2, MeshCore::SetOperations::Union);
+    auto inter = Compute(sphere1, sphere2, MeshCore::SetOperations::Intersect);
+    auto diff = Compute(sphere1, sphere2, MeshCore::SetOperations::Difference);
+
+    EXPECT_GT(unite.CountFacets(), sphere1.CountFacets());
+    EXPECT_GT(inter.CountFacets(), 0);
+    EXPECT_GT(diff.CountFacets(), 0);
+    EXPECT_FALSE(unite.HasOpenEdges());
+    EXPECT_FALSE(inter.HasOpenEdges());
+    EXPECT_FALSE(diff.HasOpenEdges());
+
+    // both spheres have the same volume
+    EXPECT_GT(inter.GetVolume(), 0.0F);
+    EXPECT_NEAR(unite.GetVolume() + inter.GetVolume(), 2.0F * volume, 1e-3F * volume);
+    EXPECT_NEAR(diff.GetVolume() + inter.GetVolume(), volume, 1e-3F * volume);
+}
+
+TEST_F(SetOperationsTest, TestThreadCountsGiveSameResult)
+{
+    auto sphere1 = Sphere(Base::Vector3f(0, 0, 0));
+    auto sphere2 = Sphere(Base::Vector3f(0.7F, 0.1F, 0.05F));
+
+    for (auto type : {MeshCore::SetOperations::Union,
+                      MeshCore::SetOperations::Intersect,
+                      MeshCore::SetOperations::Difference}) {
+        auto single = Compute(sphere1, sphere2, type, 1);
+        ExpectEqual(Compute(sphere1, sphere2, type, 2), single);
+        ExpectEqual(Compute(sphere1, sphere2, type, 7), single);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    static constexpr int Size = 20;
+
+    void SetUp() override
+    {
+        // a noisy plane of 20x20 quads
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i <= Size; i++) {
+            for (int j = 0; j <= Size; j++) {
+                float z = 0.05F * float((7 * i + 13 * j) % 5 - 2);
+                points.emplace_back(Base::Vector3f(float(i), float(j), z));
+            }
+        }
+        for (int i = 0; i < Size; i++) {
+            for (int j = 0; j < Size; j++) {
+                auto index = MeshCore::PointIndex((Size + 1) * i + j);
+                facets.emplace_back(index, index + Size + 1, index + Size + 2);
+                facets.emplace_back(index, index + Size + 2, index + 1);
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::MeshKernel& GetKernel()
+    {
+        return kernel;
+    }
+
+    static bool IsBorder(MeshCore::PointIndex index)
+    {
+        int i = int(index) / (Size + 1);
+        int j = int(index) % (Size + 1);
+        return i == 0 || j == 0 || i == Size || j == Size;
+    }
+
+    // sum of the heights of the inner points
+    float Roughness() const
+    {
+        float sum = 0.0F;
+        const MeshCore::MeshPointArray& points = kernel.GetPoints();
+        for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+            if (!IsBorder(i)) {
+                sum += std::fabs(points[i].z);
+            }
+        }
+        return sum;
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SmoothingTest, TestLaplace)
+{
+    MeshCore::MeshPointArray points = GetKernel().GetPoints();
+    float roughness = Roughness();
+
+    MeshCore::LaplaceSmoothing smooth(GetKernel());
+    EXPECT_TRUE(smooth.GetFixedBorder());
+    smooth.Smooth(5);
+    EXPECT_LT(Roughness(), 0.5F * roughness);
+
+    for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+        if (IsBorder(i)) {
+            EXPECT_EQ(Base::Vector3f(GetKernel().GetPoint(i)), Base::Vector3f(points[i]));
+        }
+    }
+}
+
+TEST_F(SmoothingTest, TestLaplaceFreeBorder)
+{
+    MeshCore::MeshPointArray points = GetKernel().GetPoints();
+
+    MeshCore::LaplaceSmoothing smooth(GetKernel());
+    smooth.SetFixedBorder(false);
+    smooth.Smooth(1);
+
+    // a corner of a single facet has only two neighbours and is still kept
+    MeshCore::PointIndex corner = Size * (Size + 1);
+    EXPECT_EQ(Base::Vector3f(GetKernel().GetPoint(corner)), Base::Vector3f(points[corner]));
+    EXPECT_NE(Base::Vector3f(GetKernel().GetPoint(1)), Base::Vector3f(points[1]));
+}
+
+TEST_F(SmoothingTest, TestLaplacePoints)
+{
+    MeshCore::MeshPointArray points = GetKernel().GetPoints();
+    std::vector<MeshCore::PointIndex> indices {23, 24, 25};
+
+    MeshCore::LaplaceSmoothing smooth(GetKernel());
+    smooth.SmoothPoints(2, indices);
+
+    int numMoved = 0;
+    for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+        if (Base::Vector3f(GetKernel().GetPoint(i)) != Base::Vector3f(points[i])) {
+            EXPECT_NE(std::find(indices.begin(), indices.end(), i), indices.end());
+            numMoved++;
+        }
+    }
+    EXPECT_EQ(numMoved, 3);
+}
+
+TEST_F(SmoothingTest, TestJacobi)
+{
+    // the points are updated at once so that a symmetric mesh stays symmetric
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    points.emplace_back(Base::Vector3f(0.F, 0.F, 1.F));
+    points.emplace_back(Base::Vector3f(1.F, 0.F, 1.F));
+    points.emplace_back(Base::Vector3f(0.F, 1.F, 1.F));
+    points.emplace_back(Base::Vector3f(0.F, 0.F, 0.F));
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(0, 3, 1);
+    facets.emplace_back(1, 3, 2);
+    facets.emplace_back(2, 3, 0);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.Smooth(1);
+    const MeshCore::MeshPointArray& result = kernel.GetPoints();
+    EXPECT_FLOAT_EQ(result[1].x, result[2].y);
+    EXPECT_FLOAT_EQ(result[1].y, result[2].x);
+    EXPECT_FLOAT_EQ(result[1].z, result[2].z);
+}
+
+TEST_F(SmoothingTest, TestTaubin)
+{
+    float roughness = Roughness();
+
+    MeshCore::TaubinSmoothing smooth(GetKernel());
+    smooth.Smooth(10);
+    EXPECT_LT(Roughness(), 0.5F * roughness);
+}
+
+TEST_F(SmoothingTest, TestMedianFilter)
+{
+    float roughness = Roughness();
+
+    MeshCore::MedianFilterSmoothing smooth(GetKernel());
+    smooth.Smooth(5);
+    EXPECT_LT(Roughness(), roughness);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/TriangleDistance.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class TriangleDistanceTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-10.0F, 10.0F);
+        auto random = [&]() {
+            return Base::Vector3f(dist(gen), dist(gen), dist(gen));
+        };
+        for (int i = 0; i < 100; i++) {
+            facets.emplace_back(random(), random(), random());
+        }
+        // slivers
+        for (int i = 0; i < 10; i++) {
+            Base::Vector3f p0 = random();
+            Base::Vector3f p1 = random();
+            Base::Vector3f p2 = p0 + (p1 - p0) * 0.3F + Base::Vector3f(0.0F, 0.0F, 0.01F);
+            facets.emplace_back(p0, p1, p2);
+        }
+        for (int i = 0; i < 200; i++) {
+            points.push_back(random() * 1.5F);
+        }
+    }
+
+    void TearDown() override
+    {}
+
+    static float distance(const float pnt[3], const MeshCore::MeshGeomFacet& facet)
+    {
+        MeshCore::TriangleLanes<1> lanes;
+        lanes.set(0, facet._aclPoints[0], facet._aclPoints[1], facet._aclPoints[2]);
+        float dist2 {};
+        lanes.distance2(pnt, &dist2);
+        return std::sqrt(dist2);
+    }
+
+    // DistanceToPoint() loses precision close to a facet, so the squared distances are compared
+    static void expectDistance(float dist, float expected)
+    {
+        EXPECT_NEAR(dist * dist, expected * expected, 1e-4F * (1.0F + expected * expected));
+    }
+
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    std::vector<Base::Vector3f> points;
+};
+
+TEST_F(TriangleDistanceTest, TestLanes)
+{
+    for (const auto& facet : facets) {
+        for (const auto& pnt : points) {
+            const float coords[3] = {pnt.x, pnt.y, pnt.z};
+            expectDistance(distance(coords, facet), facet.DistanceToPoint(pnt));
+        }
+    }
+}
+
+TEST_F(TriangleDistanceTest, TestDegenerated)
+{
+    const float pnt[3] = {1.0F, 2.0F, 0.0F};
+
+    // all corners are on a line
+    MeshCore::MeshGeomFacet line(
+        Base::Vector3f(0.0F, 0.0F, 0.0F),
+        Base::Vector3f(4.0F, 0.0F, 0.0F),
+        Base::Vector3f(2.0F, 0.0F, 0.0F)
+    );
+    EXPECT_FLOAT_EQ(distance(pnt, line), 2.0F);
+
+    // all corners are equal
+    MeshCore::MeshGeomFacet point(
+        Base::Vector3f(1.0F, 0.0F, 0.0F),
+        Base::Vector3f(1.0F, 0.0F, 0.0F),
+        Base::Vector3f(1.0F, 0.0F, 0.0F)
+    );
+    EXPECT_FLOAT_EQ(distance(pnt, point), 2.0F);
+}
+
+TEST_F(TriangleDistanceTest, TestNearestFacetSearch)
+{
+    for (const auto& pnt : points) {
+        MeshCore::MeshNearestFacetSearch search(pnt, std::numeric_limits<float>::max());
+        float minDist = std::numeric_limits<float>::max();
+        for (std::size_t i = 0; i < facets.size(); i++) {
+            search.AddFacet(facets[i], i);
+            minDist = std::min(minDist, facets[i].DistanceToPoint(pnt));
+        }
+
+        float dist {};
+        MeshCore::FacetIndex index = search.NearestFacet(dist);
+        ASSERT_LT(index, facets.size());
+        expectDistance(dist, minDist);
+        expectDistance(facets[index].DistanceToPoint(pnt), minDist);
+    }
+}
+
+TEST_F(TriangleDistanceTest, TestNearestFacetSearchMaxDist)
+{
+    MeshCore::MeshNearestFacetSearch search(Base::Vector3f(0.0F, 0.0F, 5.0F), 1.0F);
+    search.AddFacet(
+        MeshCore::MeshGeomFacet(
+            Base::Vector3f(0.0F, 0.0F, 0.0F),
+            Base::Vector3f(1.0F, 0.0F, 0.0F),
+            Base::Vector3f(0.0F, 1.0F, 0.0F)
+        ),
+        0
+    );
+
+    float dist = -1.0F;
+    EXPECT_EQ(search.NearestFacet(dist), MeshCore::FACET_INDEX_MAX);
+    EXPECT_EQ(dist, -1.0F);
+}
+
+TEST_F(TriangleDistanceTest, TestBatch)
+{
+    MeshCore::MeshFacetBatch batch;
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        batch.AddFacet(facets[i], i);
+    }
+    EXPECT_EQ(batch.CountFacets(), facets.size());
+
+    std::vector<float> dists(points.size(), std::numeric_limits<float>::max());
+    std::vector<MeshCore::FacetIndex> indices(points.size(), MeshCore::FACET_INDEX_MAX);
+    batch.NearestFacets(points.data(), points.size(), dists.data(), indices.data());
+
+    for (std::size_t j = 0; j < points.size(); j++) {
+        float minDist = std::numeric_limits<float>::max();
+        for (const auto& facet : facets) {
+            minDist = std::min(minDist, facet.DistanceToPoint(points[j]));
+        }
+        ASSERT_LT(indices[j], facets.size());
+        expectDistance(dists[j], minDist);
+
+        float dist = std::numeric_limits<float>::max();
+        MeshCore::FacetIndex index = MeshCore::FACET_INDEX_MAX;
+        EXPECT_TRUE(batch.NearestFacet(points[j], dist, index));
+        EXPECT_EQ(index, indices[j]);
+        EXPECT_FLOAT_EQ(dist, dists[j]);
+    }
+}
+
+TEST_F(TriangleDistanceTest, TestBatchMaxDist)
+{
+    MeshCore::MeshFacetBatch batch;
+    batch.AddFacet(facets[0], 0);
+
+    std::vector<float> dists(points.size(), 0.0F);
+    std::vector<MeshCore::FacetIndex> indices(points.size(), 7);
+    batch.NearestFacets(points.data(), points.size(), dists.data(), indices.data());
+    for (std::size_t j = 0; j < points.size(); j++) {
+        EXPECT_EQ(dists[j], 0.0F);
+        EXPECT_EQ(indices[j], 7);
+    }
+
+    batch.Clear();
+    EXPECT_EQ(batch.CountFacets(), 0);
+    float dist = std::numeric_limits<float>::max();
+    MeshCore::FacetIndex index = 0;
+    EXPECT_FALSE(batch.NearestFacet(points[0], dist, index));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,9 +1,13 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
 #include <Base/FileInfo.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
 #include <Mod/Mesh/App/Core/IO/ReaderOBJ.h>
+#include <Mod/Mesh/App/Core/IO/TextInput.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
 
@@ -14,6 +18,39 @@ protected:
     {
         XERCES_CPP_NAMESPACE::XMLPlatformUtils::Initialize();
     }
+
+    static MeshCore::MeshKernel loadCube()
+    {
+        std::string file(DATADIR);
+        file.append("/tests/mesh.obj");
+
+        MeshCore::MeshKernel kernel;
+        MeshCore::ReaderOBJ reader(kernel, nullptr);
+        reader.Load(file);
+        return kernel;
+    }
+
+    // a grid of size x size quads that is large enough to be parsed in several ranges
+    static MeshCore::MeshKernel makeGrid(int size)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j <= size; j++) {
+                points.emplace_back(Base::Vector3f(0.5F * float(i), 0.25F * float(j), 0.0F));
+            }
+        }
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                auto index = MeshCore::PointIndex((size + 1) * i + j);
+                facets.emplace_back(index, index + size + 1, index + size + 2);
+                facets.emplace_back(index, index + size + 2, index + 1);
+            }
+        }
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
 };
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
@@ -53,4 +90,222 @@ TEST_F(ImporterTest, TestOBJ)
     EXPECT_EQ(kernel.CountPoints(), 8);
     EXPECT_EQ(kernel.CountFacets(), 12);
 }
+
+TEST_F(ImporterTest, TestTextInput)
+{
+    std::stringstream str("v 1 2 3\r\nf 1 2 3\ng a_long_group_name\nf 4 5 6");
+    MeshCore::TextInput input(str, 10);
+
+    std::vector<std::string> lines;
+    while (input.next()) {
+        EXPECT_TRUE(input.block().back() == '\n' || input.block().back() == '6');
+        for (std::string_view range : input.split(4, 1)) {
+            MeshCore::TextInput::forEachLine(range, [&lines](std::string_view line) {
+                lines.emplace_back(line);
+            });
+        }
+    }
+    std::vector<std::string> expected {"v 1 2 3", "f 1 2 3", "g a_long_group_name", "f 4 5 6"};
+    EXPECT_EQ(lines, expected);
+
+    std::array<std::string_view, 4> tokens;
+    EXPECT_EQ(MeshCore::TextInput::tokenize(std::string_view("f 1/2/3  4//5"), " /", tokens), 6);
+    EXPECT_EQ(tokens[3], "3");
+
+    float value {};
+    EXPECT_TRUE(MeshCore::TextInput::number("+1.5e2", value));
+    EXPECT_FLOAT_EQ(value, 150.0F);
+    EXPECT_FALSE(MeshCore::TextInput::number("1.5x", value));
+    EXPECT_TRUE(MeshCore::TextInput::number("-1e-50", value));
+    EXPECT_FLOAT_EQ(value, 0.0F);
+    EXPECT_TRUE(MeshCore::TextInput::number("1e50", value));
+    EXPECT_EQ(value, std::numeric_limits<float>::infinity());
+    int index {};
+    EXPECT_TRUE(MeshCore::TextInput::number("-12", index));
+    EXPECT_EQ(index, -12);
+}
+
+TEST_F(ImporterTest, TestOBJUnderflow)
+{
+    std::stringstream str("v 1 1e-50 0\nv 1 1 0\nv 0 1 0\nf 1 2 3\n");
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderOBJ reader(kernel, nullptr);
+    EXPECT_EQ(reader.Load(str), true);
+
+    ASSERT_EQ(kernel.CountPoints(), 3);
+    ASSERT_EQ(kernel.CountFacets(), 1);
+    EXPECT_EQ(Base::Vector3f(kernel.GetPoint(0)), Base::Vector3f(1, 0, 0));
+    EXPECT_EQ(kernel.GetFacets()[0]._aulPoints[2], 2);
+}
+
+TEST_F(ImporterTest, TestOBJInvalidVertex)
+{
+    std::stringstream str("v 1 0x 0\nv 1 1 0\nv 0 1 0\nv 0 0 0\nf 1 2 3\n");
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderOBJ reader(kernel, nullptr);
+    EXPECT_EQ(reader.Load(str), false);
+}
+
+TEST_F(ImporterTest, TestOBJGroups)
+{
+    const int size = 200;
+    MeshCore::MeshKernel grid = makeGrid(size);
+    const MeshCore::MeshPointArray& points = grid.GetPoints();
+    const MeshCore::MeshFacetArray& facets = grid.GetFacets();
+    auto numPoints = int(points.size());
+
+    // the second group refers to the points relative to the end of the point list
+    std::stringstream str;
+    str << "mtllib grid.mtl\n";
+    for (const auto& pnt : points) {
+        str << "v " << pnt.x << " " << pnt.y << " " << pnt.z << "\n";
+    }
+    str << "g first\nusemtl red\n";
+    std::size_t half = facets.size() / 2;
+    for (std::size_t i = 0; i < half; i++) {
+        const auto& f = facets[i];
+        str << "f " << f._aulPoints[0] + 1 << "/1 " << f._aulPoints[1] + 1 << "/1 "
+            << f._aulPoints[2] + 1 << "/1\n";
+    }
+    str << "g second\nusemtl blue\n";
+    for (std::size_t i = half; i < facets.size(); i++) {
+        const auto& f = facets[i];
+        str << "f " << int(f._aulPoints[0]) - numPoints << " " << int(f._aulPoints[1]) - numPoints
+            << " " << int(f._aulPoints[2]) - numPoints << "\n";
+    }
+    ASSERT_GT(str.str().size(), std::size_t(1) << 21);
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::Material material;
+    MeshCore::ReaderOBJ reader(kernel, &material);
+    EXPECT_EQ(reader.Load(str), true);
+
+    EXPECT_EQ(kernel.CountPoints(), grid.CountPoints());
+    ASSERT_EQ(kernel.CountFacets(), grid.CountFacets());
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(kernel.GetFacets()[i]._aulPoints[j], facets[i]._aulPoints[j]);
+        }
+    }
+    EXPECT_EQ(kernel.GetFacets()[half - 1]._ulProp, 1);
+    EXPECT_EQ(kernel.GetFacets()[half]._ulProp, 2);
+
+    std::vector<std::string> groups {"first", "second"};
+    EXPECT_EQ(reader.GetGroupNames(), groups);
+    EXPECT_EQ(material.library, "grid.mtl");
+    EXPECT_EQ(material.binding, MeshCore::MeshIO::PER_FACE);
+    EXPECT_EQ(material.diffuseColor.size(), facets.size());
+}
+
+TEST_F(ImporterTest, TestAsciiSTL)
+{
+    MeshCore::MeshKernel grid = makeGrid(80);
+    std::stringstream str;
+    MeshCore::MeshOutput(grid).SaveAsciiSTL(str);
+    ASSERT_GT(str.str().size(), std::size_t(1) << 21);
+
+    MeshCore::MeshKernel kernel;
+    EXPECT_EQ(MeshCore::MeshInput(kernel).LoadSTL(str), true);
+    EXPECT_EQ(kernel.CountPoints(), grid.CountPoints());
+    EXPECT_EQ(kernel.CountFacets(), grid.CountFacets());
+    EXPECT_EQ(kernel.GetBoundBox().GetMaximum(), grid.GetBoundBox().GetMaximum());
+}
+
+TEST_F(ImporterTest, TestAsciiSTLUnderflow)
+{
+    std::stringstream str;
+    str << "solid underflow\n";
+    for (int i = 0; i < 2; i++) {
+        str << "facet normal 0 0 1\n  outer loop\n"
+            << "    vertex " << i << " 1e-50 0\n    vertex " << i + 1 << " 0 0\n"
+            << "    vertex " << i << " 1 0\n  endloop\nendfacet\n";
+    }
+    str << "endsolid underflow\n";
+
+    MeshCore::MeshKernel kernel;
+    EXPECT_EQ(MeshCore::MeshInput(kernel).LoadSTL(str), true);
+    EXPECT_EQ(kernel.CountFacets(), 2);
+    EXPECT_EQ(kernel.CountPoints(), 5);
+    EXPECT_FLOAT_EQ(kernel.GetBoundBox().MinY, 0.0F);
+}
+
+TEST_F(ImporterTest, TestAsciiSTLInvalidVertex)
+{
+    std::stringstream str;
+    str << "solid invalid\n";
+    for (int i = 0; i < 2; i++) {
+        str << "facet normal 0 0 1\n  outer loop\n"
+            << "    vertex " << i << " 0 0\n    vertex " << i + 1 << " 0 0\n"
+            << "    vertex " << i << " 1 0x\n  endloop\nendfacet\n";
+    }
+    str << "endsolid invalid\n";
+
+    MeshCore::MeshKernel kernel;
+    EXPECT_EQ(MeshCore::MeshInput(kernel).LoadSTL(str), false);
+}
+
+TEST_F(ImporterTest, TestBinarySTL)
+{
+    MeshCore::MeshKernel cube = loadCube();
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".stl");
+    MeshCore::MeshOutput(cube).SaveAny(fi.filePath().c_str(), MeshCore::MeshIO::BSTL);
+
+    // memory-mapped
+    MeshCore::MeshKernel kernel;
+    EXPECT_EQ(MeshCore::MeshInput(kernel).LoadAny(fi.filePath().c_str()), true);
+    EXPECT_EQ(kernel.CountPoints(), 8);
+    EXPECT_EQ(kernel.CountEdges(), 18);
+    EXPECT_EQ(kernel.CountFacets(), 12);
+    EXPECT_EQ(kernel.GetBoundBox().GetMinimum(), cube.GetBoundBox().GetMinimum());
+    EXPECT_EQ(kernel.GetBoundBox().GetMaximum(), cube.GetBoundBox().GetMaximum());
+
+    // from a stream
+    std::stringstream str;
+    MeshCore::MeshOutput(cube).SaveBinarySTL(str);
+    MeshCore::MeshKernel other;
+    EXPECT_EQ(MeshCore::MeshInput(other).LoadBinarySTL(str), true);
+    EXPECT_EQ(other.CountPoints(), 8);
+    EXPECT_EQ(other.CountFacets(), 12);
+
+    fi.deleteFile();
+}
+
+TEST_F(ImporterTest, TestBinarySTLTruncated)
+{
+    MeshCore::MeshKernel cube = loadCube();
+    std::stringstream str;
+    MeshCore::MeshOutput(cube).SaveBinarySTL(str);
+    std::string data = str.str();
+    std::stringstream truncated(data.substr(0, data.size() - 10));
+
+    MeshCore::MeshKernel kernel;
+    EXPECT_EQ(MeshCore::MeshInput(kernel).LoadBinarySTL(truncated), false);
+}
+
+TEST_F(ImporterTest, TestBinaryPLY)
+{
+    MeshCore::MeshKernel cube = loadCube();
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".ply");
+    MeshCore::MeshOutput(cube).SaveAny(fi.filePath().c_str(), MeshCore::MeshIO::PLY);
+
+    // memory-mapped
+    MeshCore::MeshKernel kernel;
+    EXPECT_EQ(MeshCore::MeshInput(kernel).LoadAny(fi.filePath().c_str()), true);
+    EXPECT_EQ(kernel.CountPoints(), 8);
+    EXPECT_EQ(kernel.CountEdges(), 18);
+    EXPECT_EQ(kernel.CountFacets(), 12);
+    EXPECT_EQ(kernel.GetBoundBox().GetMinimum(), cube.GetBoundBox().GetMinimum());
+    EXPECT_EQ(kernel.GetBoundBox().GetMaximum(), cube.GetBoundBox().GetMaximum());
+
+    // from a stream
+    std::stringstream str;
+    MeshCore::MeshOutput(cube).SaveBinaryPLY(str);
+    MeshCore::MeshKernel other;
+    EXPECT_EQ(MeshCore::MeshInput(other).LoadPLY(str), true);
+    EXPECT_EQ(other.CountPoints(), 8);
+    EXPECT_EQ(other.CountFacets(), 12);
+    EXPECT_EQ(other.GetPoint(7), cube.GetPoint(7));
+
+    fi.deleteFile();
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <Base/Exception.h>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 
@@ -108,4 +109,34 @@ TEST_F(MeshTest, TestGrid2OfAlmostPlanarMesh)
     EXPECT_EQ(countY, 1);
     EXPECT_EQ(countZ, 1);
 }
+
+TEST_F(MeshTest, TestDecimateWithParameters)
+{
+    const int size = 20;
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (int i = 0; i <= size; i++) {
+        for (int j = 0; j <= size; j++) {
+            points.emplace_back(Base::Vector3f(float(i), float(j), 0.0F));
+        }
+    }
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            auto index = MeshCore::PointIndex(i * (size + 1) + j);
+            facets.emplace_back(index, index + size + 1, index + 1);
+            facets.emplace_back(index + 1, index + size + 1, index + size + 2);
+        }
+    }
+    Mesh::MeshObject mesh;
+    mesh.getKernel().Adopt(points, facets, true);
+
+    MeshCore::MeshSimplify::Parameters params;
+    EXPECT_THROW(mesh.decimate(params), Base::ValueError);
+    EXPECT_EQ(mesh.countFacets(), 2 * size * size);
+
+    params.targetSize = 100;
+    EXPECT_TRUE(mesh.decimate(params));
+    EXPECT_LE(mesh.countFacets(), 100);
+    EXPECT_GT(mesh.countFacets(), 0);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
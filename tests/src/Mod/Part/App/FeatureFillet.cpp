@@ -132,6 +132,40 @@ TEST_F(FeatureFilletTest, testGetProviderName)
     EXPECT_STREQ(name, "PartGui::ViewProviderFillet");
 }
 
+TEST_F(FeatureFilletTest, testParallelRecompute)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document"
+    );
+    bool parallel = hGrp->GetBool("EnableParallelRecompute", false);
+    hGrp->SetBool("EnableParallelRecompute", true);
+    _doc->setRecomputeThreadLimit(4);
+    // the first box is bigger than the others
+    _fillet->Base.setValue(_boxes[1]);
+    _fillet->Edges.setValues(PartTestHelpers::_getFilletEdges({1}, 0.5, 0.5));
+    std::vector<Part::Fillet*> fillets {_fillet};
+    for (unsigned i = 2; i < _boxes.size(); i++) {
+        auto fillet = _doc->addObject<Part::Fillet>();
+        fillet->Base.setValue(_boxes[i]);
+        fillet->Edges.setValues(PartTestHelpers::_getFilletEdges({1}, 0.5, 0.5));
+        fillets.push_back(fillet);
+    }
+    // Act
+    bool hasError = false;
+    _doc->recompute({}, true, &hasError);
+    hGrp->SetBool("EnableParallelRecompute", parallel);
+    // Assert
+    EXPECT_TRUE(_fillet->canRecomputeConcurrently());
+    EXPECT_FALSE(hasError);
+    double boxVolume = PartTestHelpers::getVolume(_boxes[1]->Shape.getValue());
+    double filletVolume = PartTestHelpers::getVolume(_fillet->Shape.getValue());
+    EXPECT_LT(filletVolume, boxVolume);
+    for (auto fillet : fillets) {
+        EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(fillet->Shape.getValue()), filletVolume);
+    }
+}
+
 // NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
 
 // void PrintTo(const TopoDS_Shape& ds, std::ostream* os)
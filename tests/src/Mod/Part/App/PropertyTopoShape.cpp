@@ -3,6 +3,8 @@
 #include <gtest/gtest.h>
 
 #include <BRepFilletAPI_MakeFillet.hxx>
+#include <sstream>
+#include <Base/Reader.h>
 #include "Mod/Part/App/FeaturePartCommon.h"
 #include "Mod/Part/App/PropertyTopoShape.h"
 #include <src/App/InitApplication.h>
@@ -269,3 +271,27 @@ TEST_F(PropertyTopoShapeTest, testRestore)
     EXPECT_TRUE(reader.isValid());
     EXPECT_TRUE(reader.isEndOfElement());
 }
+
+TEST_F(PropertyTopoShapeTest, testPasteDeferredShape)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General"
+    );
+    bool defer = hGrp->GetBool("DeferShapeRestore", false);
+    hGrp->SetBool("DeferShapeRestore", true);
+    std::stringstream data;
+    _common->Shape.getShape().exportBrep(data);
+    Base::Reader reader(data, "Common.Shape.brp", 1);
+    Part::PropertyPartShape source;
+    source.RestoreDocFile(reader);
+    hGrp->SetBool("DeferShapeRestore", defer);
+
+    // Act
+    Part::PropertyPartShape target;
+    target.Paste(source);
+
+    // Assert
+    EXPECT_FALSE(target.getValue().IsNull());
+    EXPECT_EQ(source.getMemSize(), target.getMemSize());
+}
@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+
+#include "Mod/Part/App/FeaturePartFuse.h"
+#include "Mod/Part/App/FeatureMirroring.h"
+#include "Mod/Part/App/FeaturePartImportStep.h"
+#include "Mod/Part/App/RecomputeCache.h"
+#include <App/Application.h>
+#include <src/App/InitApplication.h>
+#include <Base/FileInfo.h>
+
+#include "PartTestHelpers.h"
+
+using namespace Part;
+using namespace PartTestHelpers;
+
+class RecomputeCacheTest: public ::testing::Test, public PartTestHelperClass
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        createTestDoc();
+        _fuse = _doc->addObject<Fuse>();
+        _fuse->Base.setValue(_boxes[0]);
+        _fuse->Tool.setValue(_boxes[1]);
+        _mirror = _doc->addObject<Mirroring>();
+        _mirror->Source.setValue(_fuse);
+        _doc->recompute();
+        auto path = Base::FileInfo::getTempFileName("RecomputeCache");
+        _cache = std::make_unique<RecomputeCache>(path);
+    }
+
+    void TearDown() override
+    {
+        getParameter()->RemoveBool("EnableRecomputeCache");
+        getParameter()->RemoveASCII("RecomputeCacheDir");
+        _cache->clear();
+        Base::FileInfo(_cache->getPath()).deleteDirectory();
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    static ParameterGrp::handle getParameter()
+    {
+        return App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General"
+        );
+    }
+
+    /// Let Feature::recompute() use the cache of this test
+    void enableCache()
+    {
+        getParameter()->SetBool("EnableRecomputeCache", true);
+        getParameter()->SetASCII("RecomputeCacheDir", _cache->getPath().c_str());
+    }
+
+    Fuse* _fuse = nullptr;                   // NOLINT Can't be private in a test framework
+    Mirroring* _mirror = nullptr;            // NOLINT
+    std::unique_ptr<RecomputeCache> _cache;  // NOLINT
+};
+
+TEST_F(RecomputeCacheTest, testBooleanAndPrimitiveCanUseCache)
+{
+    // Assert
+    EXPECT_TRUE(_fuse->canUseRecomputeCache());
+    EXPECT_TRUE(_mirror->canUseRecomputeCache());
+    EXPECT_TRUE(_boxes[0]->canUseRecomputeCache());
+}
+
+TEST_F(RecomputeCacheTest, testFileFeatureCannotUseCache)
+{
+    // Arrange
+    auto import = _doc->addObject<ImportStep>();
+    // Assert
+    EXPECT_FALSE(import->canUseRecomputeCache());
+}
+
+TEST_F(RecomputeCacheTest, testKeyIsStable)
+{
+    // Act
+    auto key = _mirror->getRecomputeCacheKey();
+    _doc->recompute();
+    _mirror->touch();
+    _doc->recompute();
+    // Assert
+    EXPECT_FALSE(key.empty());
+    EXPECT_EQ(_mirror->getRecomputeCacheKey(), key);
+}
+
+TEST_F(RecomputeCacheTest, testKeyTracksDependencies)
+{
+    // Arrange
+    auto key = _mirror->getRecomputeCacheKey();
+    // Act
+    _boxes[1]->Length.setValue(2);
+    _doc->recompute();
+    // Assert
+    EXPECT_FALSE(_mirror->getRecomputeCacheKey().empty());
+    EXPECT_NE(_mirror->getRecomputeCacheKey(), key);
+}
+
+TEST_F(RecomputeCacheTest, testKeyTracksObjectIdentity)
+{
+    // Arrange
+    auto key = _mirror->getRecomputeCacheKey();
+    std::string name = _mirror->getNameInDocument();
+    // Act
+    _doc->removeObject(name.c_str());
+    auto mirror = _doc->addObject<Mirroring>(name.c_str());
+    mirror->Source.setValue(_fuse);
+    // Assert
+    // The element map of the old entry is tagged with the ID of the removed object
+    EXPECT_EQ(mirror->getNameInDocument(), name);
+    EXPECT_FALSE(mirror->getRecomputeCacheKey().empty());
+    EXPECT_NE(mirror->getRecomputeCacheKey(), key);
+}
+
+TEST_F(RecomputeCacheTest, testKeyTracksInputs)
+{
+    // Arrange
+    auto key = _mirror->getRecomputeCacheKey();
+    // Act
+    _mirror->Normal.setValue(Base::Vector3d(0, 1, 0));
+    // Assert
+    EXPECT_NE(_mirror->getRecomputeCacheKey(), key);
+}
+
+TEST_F(RecomputeCacheTest, testStoreAndRestore)
+{
+    // Arrange
+    auto key = _mirror->getRecomputeCacheKey();
+    const TopoShape& original = _mirror->Shape.getShape();
+    TopoShape restored;
+    // Act
+    bool stored = _cache->store(key, original);
+    bool found = _cache->restore(key, _doc->getStringHasher(), restored);
+    // Assert
+    EXPECT_TRUE(stored);
+    EXPECT_TRUE(found);
+    EXPECT_DOUBLE_EQ(getVolume(restored.getShape()), getVolume(original.getShape()));
+    EXPECT_EQ(restored.Tag, original.Tag);
+    EXPECT_EQ(restored.getElementMapSize(), original.getElementMapSize());
+    EXPECT_EQ(elementMap(restored), elementMap(original));
+}
+
+TEST_F(RecomputeCacheTest, testStoreAndRestoreHistories)
+{
+    // Arrange
+    ShapeHistory history;
+    history.type = TopAbs_FACE;
+    history.shapeMap[0] = {1, 2};
+    history.shapeMap[3] = {};
+    RecomputeCache::Histories original {{"History", {history, ShapeHistory()}}};
+    auto key = _mirror->getRecomputeCacheKey();
+    TopoShape restored;
+    RecomputeCache::Histories histories;
+    // Act
+    bool stored = _cache->store(key, _mirror->Shape.getShape(), original);
+    bool found = _cache->restore(key, _doc->getStringHasher(), restored, &histories);
+    // Assert
+    EXPECT_TRUE(stored);
+    EXPECT_TRUE(found);
+    ASSERT_EQ(histories.size(), 1);
+    ASSERT_EQ(histories["History"].size(), 2);
+    EXPECT_EQ(histories["History"][0].type, TopAbs_FACE);
+    EXPECT_EQ(histories["History"][0].shapeMap, history.shapeMap);
+    EXPECT_TRUE(histories["History"][1].shapeMap.empty());
+}
+
+TEST_F(RecomputeCacheTest, testRestoreMissingKey)
+{
+    // Arrange
+    TopoShape restored;
+    // Act
+    bool found = _cache->restore(_mirror->getRecomputeCacheKey(), _doc->getStringHasher(), restored);
+    // Assert
+    EXPECT_FALSE(found);
+    EXPECT_TRUE(restored.isNull());
+}
+
+TEST_F(RecomputeCacheTest, testClear)
+{
+    // Arrange
+    auto key = _mirror->getRecomputeCacheKey();
+    _cache->store(key, _mirror->Shape.getShape());
+    TopoShape restored;
+    // Act
+    _cache->clear();
+    // Assert
+    EXPECT_FALSE(_cache->restore(key, _doc->getStringHasher(), restored));
+}
+
+TEST_F(RecomputeCacheTest, testRecomputeRestoresFromCache)
+{
+    // Arrange
+    enableCache();
+    const double volume = getVolume(_mirror->Shape.getShape().getShape());
+    // Store a shape that execute() would never produce, so restoring is distinguishable
+    TopoShape seeded(BRepPrimAPI_MakeBox(5, 5, 5).Shape());
+    ASSERT_TRUE(_cache->store(_mirror->getRecomputeCacheKey(), seeded));
+    // Act
+    _mirror->touch();
+    _doc->recompute();
+    // Assert
+    EXPECT_DOUBLE_EQ(getVolume(_mirror->Shape.getShape().getShape()), 125.0);
+    EXPECT_NE(volume, 125.0);
+}
+
+TEST_F(RecomputeCacheTest, testRecomputeIgnoresStaleEntry)
+{
+    // Arrange
+    enableCache();
+    TopoShape seeded(BRepPrimAPI_MakeBox(5, 5, 5).Shape());
+    ASSERT_TRUE(_cache->store(_mirror->getRecomputeCacheKey(), seeded));
+    // Act
+    _boxes[1]->Length.setValue(2);
+    _doc->recompute();
+    auto key = _mirror->getRecomputeCacheKey();
+    TopoShape stored;
+    bool found = _cache->restore(key, _doc->getStringHasher(), stored);
+    // Assert
+    EXPECT_NE(getVolume(_mirror->Shape.getShape().getShape()), 125.0);
+    // The freshly executed result is stored under the new key
+    EXPECT_TRUE(found);
+    EXPECT_DOUBLE_EQ(getVolume(stored.getShape()), getVolume(_mirror->Shape.getShape().getShape()));
+}
+
+TEST_F(RecomputeCacheTest, testRecomputeRestoresBoolean)
+{
+    // Arrange
+    enableCache();
+    ShapeHistory history;
+    history.type = TopAbs_FACE;
+    history.shapeMap[0] = {4};
+    TopoShape seeded(BRepPrimAPI_MakeBox(5, 5, 5).Shape());
+    ASSERT_TRUE(_cache->store(_fuse->getRecomputeCacheKey(), seeded, {{"History", {history}}}));
+    // Act
+    _fuse->touch();
+    _doc->recompute();
+    // Assert
+    EXPECT_DOUBLE_EQ(getVolume(_fuse->Shape.getShape().getShape()), 125.0);
+    ASSERT_EQ(_fuse->History.getSize(), 1);
+    EXPECT_EQ(_fuse->History.getValues()[0].shapeMap, history.shapeMap);
+}
+
+TEST_F(RecomputeCacheTest, testRecomputeRestoresAttachedPrimitive)
+{
+    // Arrange
+    auto box = _boxes[2];
+    box->AttachmentSupport.setValue(_boxes[0]);
+    box->MapMode.setValue("ObjectXY");
+    box->AttachmentOffset.setValue(Base::Placement(Base::Vector3d(0, 0, 4), Base::Rotation()));
+    _doc->recompute();
+    const Base::Placement placement = box->Placement.getValue();
+    enableCache();
+    ASSERT_TRUE(box->canUseRecomputeCache());
+    TopoShape seeded(BRepPrimAPI_MakeBox(5, 5, 5).Shape());
+    ASSERT_TRUE(_cache->store(box->getRecomputeCacheKey(), seeded));
+    // Act
+    box->touch();
+    _doc->recompute();
+    // Assert
+    EXPECT_DOUBLE_EQ(getVolume(box->Shape.getShape().getShape()), 125.0);
+    EXPECT_TRUE(box->Placement.getValue().isSame(placement));
+    EXPECT_EQ(box->Shape.getShape().getTransform(), placement.toMatrix());
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <Mod/Points/App/PointKDTree.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointKDTreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-10.0F, 10.0F);
+        std::vector<Base::Vector3f> points(20000);
+        for (auto& pnt : points) {
+            pnt.Set(dist(gen), dist(gen), 0.1F * dist(gen));
+        }
+        points[5].y = std::numeric_limits<float>::quiet_NaN();
+        points[6].z = std::numeric_limits<float>::infinity();
+        // duplicated points
+        points[7] = points[8];
+        kernel.setBasicPoints(points);
+        tree.build(kernel);
+    }
+
+    void TearDown() override
+    {}
+
+    const Points::PointKernel& getKernel() const
+    {
+        return kernel;
+    }
+    const Points::PointKDTree& getTree() const
+    {
+        return tree;
+    }
+
+    // Returns the squared distances of all valid points to pnt in ascending order
+    std::vector<float> distances(const Base::Vector3f& pnt) const
+    {
+        std::vector<float> result;
+        for (const auto& other : kernel.getBasicPoints()) {
+            if (std::isfinite(other.y) && std::isfinite(other.z)) {
+                result.push_back(Base::DistanceP2(pnt, other));
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    Points::PointKernel kernel;
+    Points::PointKDTree tree;
+};
+
+TEST_F(PointKDTreeTest, TestBuild)
+{
+    EXPECT_EQ(getTree().size(), getKernel().size() - 2);
+
+    Points::PointKDTree empty;
+    Points::PointKernel kernel;
+    empty.build(kernel);
+    EXPECT_EQ(empty.size(), 0);
+
+    std::vector<Points::PointKDTree::Neighbour> found;
+    empty.nearest(Base::Vector3f(), 5, found);
+    EXPECT_TRUE(found.empty());
+}
+
+TEST_F(PointKDTreeTest, TestNearest)
+{
+    const auto& points = getKernel().getBasicPoints();
+    std::vector<Points::PointKDTree::Neighbour> found;
+    std::vector<Base::Vector3f> queries {
+        Base::Vector3f(0.0F, 0.0F, 0.0F),
+        Base::Vector3f(9.5F, -3.0F, 2.0F),
+        Base::Vector3f(30.0F, 30.0F, 0.0F),
+        points[100],
+    };
+    for (const auto& pnt : queries) {
+        getTree().nearest(pnt, 10, found);
+        std::vector<float> expected = distances(pnt);
+        ASSERT_EQ(found.size(), 10);
+        for (std::size_t i = 0; i < found.size(); i++) {
+            EXPECT_FLOAT_EQ(found[i].distance2, expected[i]);
+            EXPECT_FLOAT_EQ(found[i].distance2, Base::DistanceP2(pnt, points[found[i].index]));
+        }
+    }
+
+    // a point finds itself
+    getTree().nearest(points[100], 1, found);
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0].index, 100);
+
+    // more points than available
+    getTree().nearest(points[0], getKernel().size() + 10, found);
+    EXPECT_EQ(found.size(), getKernel().size() - 2);
+}
+
+TEST_F(PointKDTreeTest, TestWithin)
+{
+    const auto& points = getKernel().getBasicPoints();
+    std::vector<Points::PointKDTree::Neighbour> found;
+    std::vector<Base::Vector3f> queries {Base::Vector3f(0.0F, 0.0F, 0.0F), points[8], points[1000]};
+    for (const auto& pnt : queries) {
+        std::vector<float> expected = distances(pnt);
+        auto count = std::count_if(expected.begin(), expected.end(), [](float distance2) {
+            return distance2 <= 0.25F;
+        });
+
+        getTree().within(pnt, 0.5F, found);
+        EXPECT_EQ(found.size(), count);
+        for (const auto& neighbour : found) {
+            EXPECT_LE(Base::DistanceP2(pnt, points[neighbour.index]), 0.25F);
+        }
+        EXPECT_EQ(getTree().countWithin(pnt, 0.5F, getKernel().size()), count);
+        EXPECT_EQ(getTree().countWithin(pnt, 0.5F, 2), std::min<std::size_t>(count, 2));
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,9 +1,18 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
+#include <Mod/Points/App/PointsGrid.h>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
 
@@ -62,6 +71,23 @@ protected:
         return col;
     }
 
+    // Appends the bytes of value in the given byte order
+    template<typename T>
+    static void append(std::string& data, T value, bool bigEndian = false)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (bigEndian != (std::endian::native == std::endian::big)) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        data.append(bytes, sizeof(T));
+    }
+    static void writeFile(const std::string& name, const std::string& data)
+    {
+        Base::ofstream str(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        str << data;
+    }
+
 private:
     Points::PointKernel kernel;
     Base::FileInfo tmp;
@@ -121,6 +147,185 @@ TEST_F(PointsTest, TestSwap)
     EXPECT_EQ(kernel.countValid(), 20);
 }
 
+namespace
+{
+// Enough points to be split over several threads
+Points::PointKernel makeCloud()
+{
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < 200000; i++) {
+        points.emplace_back(float(i % 97) * 0.5F, float(i % 89) - 40.0F, float(i % 83) * 0.1F);
+    }
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(points);
+    return kernel;
+}
+
+Base::Matrix4D makePlacement()
+{
+    Base::Matrix4D mat;
+    mat.rotX(0.3);
+    mat.rotZ(0.7);
+    mat.move(Base::Vector3d(1.0, 2.0, 3.0));
+    return mat;
+}
+}  // namespace
+
+TEST_F(PointsTest, TestBoundBox)
+{
+    Points::PointKernel kernel = getKernel();
+    kernel.setTransform(makePlacement());
+
+    Base::BoundBox3d expected;
+    for (const auto& pnt : kernel) {
+        expected.Add(pnt);
+    }
+    Base::BoundBox3d box = kernel.getBoundBox();
+    EXPECT_DOUBLE_EQ(box.MinX, expected.MinX);
+    EXPECT_DOUBLE_EQ(box.MinY, expected.MinY);
+    EXPECT_DOUBLE_EQ(box.MinZ, expected.MinZ);
+    EXPECT_DOUBLE_EQ(box.MaxX, expected.MaxX);
+    EXPECT_DOUBLE_EQ(box.MaxY, expected.MaxY);
+    EXPECT_DOUBLE_EQ(box.MaxZ, expected.MaxZ);
+}
+
+TEST_F(PointsTest, TestBoundBoxAxisAligned)
+{
+    Points::PointKernel kernel = makeCloud();
+    kernel.getBasicPoints()[10].Set(std::nanf(""), std::nanf(""), std::nanf(""));
+    Base::Matrix4D mat;
+    mat.scale(-2.0, 1.0, 0.5);
+    mat.move(Base::Vector3d(1.0, 2.0, 3.0));
+    kernel.setTransform(mat);
+
+    Base::BoundBox3d box = kernel.getBoundBox();
+    EXPECT_DOUBLE_EQ(box.MinX, -95.0);
+    EXPECT_DOUBLE_EQ(box.MaxX, 1.0);
+    EXPECT_DOUBLE_EQ(box.MinY, -38.0);
+    EXPECT_DOUBLE_EQ(box.MaxY, 50.0);
+    EXPECT_DOUBLE_EQ(box.MinZ, 3.0);
+    EXPECT_NEAR(box.MaxZ, 7.1, 1e-6);
+}
+
+TEST_F(PointsTest, TestBoundBoxLarge)
+{
+    Points::PointKernel kernel = makeCloud();
+    kernel.setTransform(makePlacement());
+
+    Base::BoundBox3d expected;
+    for (const auto& pnt : kernel) {
+        expected.Add(pnt);
+    }
+    Base::BoundBox3d box = kernel.getBoundBox();
+    EXPECT_DOUBLE_EQ(box.MinX, expected.MinX);
+    EXPECT_DOUBLE_EQ(box.MinY, expected.MinY);
+    EXPECT_DOUBLE_EQ(box.MinZ, expected.MinZ);
+    EXPECT_DOUBLE_EQ(box.MaxX, expected.MaxX);
+    EXPECT_DOUBLE_EQ(box.MaxY, expected.MaxY);
+    EXPECT_DOUBLE_EQ(box.MaxZ, expected.MaxZ);
+}
+
+TEST_F(PointsTest, TestBoundBoxEmpty)
+{
+    Points::PointKernel kernel;
+    EXPECT_FALSE(kernel.getBoundBox().IsValid());
+}
+
+TEST_F(PointsTest, TestTransformGeometry)
+{
+    Points::PointKernel kernel = makeCloud();
+    std::vector<Base::Vector3f> expected = kernel.getBasicPoints();
+    Base::Matrix4D mat = makePlacement();
+    for (auto& pnt : expected) {
+        mat.multVec(pnt, pnt);
+    }
+
+    kernel.transformGeometry(mat);
+    EXPECT_EQ(kernel.getBasicPoints(), expected);
+}
+
+TEST_F(PointsTest, TestMoveGeometry)
+{
+    Points::PointKernel kernel = makeCloud();
+    std::vector<Base::Vector3f> expected = kernel.getBasicPoints();
+    for (auto& pnt : expected) {
+        pnt += Base::Vector3f(1.0F, -2.0F, 0.5F);
+    }
+
+    kernel.moveGeometry(Base::Vector3d(1.0, -2.0, 0.5));
+    EXPECT_EQ(kernel.getBasicPoints(), expected);
+}
+
+TEST_F(PointsTest, TestNearestPoint)
+{
+    const Points::PointKernel& kernel = getKernel();
+    double distance {};
+    EXPECT_EQ(kernel.nearestPoint(Base::Vector3d(0.9, 0.1, 0.2), &distance), 4);
+    EXPECT_NEAR(distance, Base::Vector3d(0.1, 0.1, 0.2).Length(), 1e-6);
+
+    Points::PointKernel empty;
+    EXPECT_EQ(empty.nearestPoint(Base::Vector3d()), 0);
+}
+
+TEST_F(PointsTest, TestNearestPointLarge)
+{
+    Points::PointKernel kernel = makeCloud();
+    kernel.setTransform(makePlacement());
+    Base::Vector3d pnt(10.3, -5.2, 4.1);
+
+    std::size_t expected = 0;
+    double minDist = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < kernel.size(); i++) {
+        double dist = Base::Distance(kernel.getPoint(int(i)), pnt);
+        if (dist < minDist) {
+            minDist = dist;
+            expected = i;
+        }
+    }
+    double distance {};
+    EXPECT_EQ(kernel.nearestPoint(pnt, &distance), expected);
+    EXPECT_NEAR(distance, minDist, 1e-12);
+}
+
+TEST_F(PointsTest, TestForEachChunk)
+{
+    Points::PointKernel kernel = makeCloud();
+    std::mutex mutex;
+    std::vector<int> visited(kernel.size(), 0);
+    kernel.forEachChunk([&](std::size_t begin, std::size_t end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = begin; i < end; i++) {
+            visited[i]++;
+        }
+    });
+    EXPECT_EQ(std::count(visited.begin(), visited.end(), 1), kernel.size());
+}
+
+TEST_F(PointsTest, TestGrid)
+{
+    Points::PointKernel kernel = makeCloud();
+    kernel.setTransform(makePlacement());
+
+    Points::PointsGrid grid(kernel);
+    EXPECT_TRUE(grid.Verify());
+
+    unsigned long ulX {}, ulY {}, ulZ {};
+    grid.GetCtGrids(ulX, ulY, ulZ);
+    std::size_t count = 0;
+    for (unsigned long i = 0; i < ulX; i++) {
+        for (unsigned long j = 0; j < ulY; j++) {
+            for (unsigned long k = 0; k < ulZ; k++) {
+                count += grid.GetCtElements(i, j, k);
+            }
+        }
+    }
+    EXPECT_EQ(count, kernel.size());
+
+    std::set<unsigned long> elements;
+    grid.FindElements(kernel.getPoint(1234), elements);
+    EXPECT_EQ(elements.count(1234), 1);
+}
+
 TEST_F(PointsTest, TestASCII)
 {
     std::string name = getFileName() + ".asc";
@@ -240,4 +445,210 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestASCIIValues)
+{
+    std::string name = getFileName() + ".asc";
+    writeFile(
+        name,
+        "# comment\n1 2 3\n\n  4.5\t-5e1 +6 \r\nx 1 2\n1 2\n7 8 9 10\n.5 1. 2\n-1 -2 -3"
+    );
+
+    Points::AscReader reader;
+    reader.read(name);
+    Base::FileInfo(name).deleteFile();
+
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), 3);
+    EXPECT_EQ(points.getBasicPoints()[0], Base::Vector3f(1, 2, 3));
+    EXPECT_EQ(points.getBasicPoints()[1], Base::Vector3f(4.5F, -50, 6));
+    EXPECT_EQ(points.getBasicPoints()[2], Base::Vector3f(-1, -2, -3));
+}
+
+TEST_F(PointsTest, TestASCIILarge)
+{
+    // large enough to be parsed in several ranges
+    const int size = 200000;
+    std::string data;
+    for (int i = 0; i < size; i++) {
+        data += std::to_string(i) + " " + std::to_string(-i) + " 0.5\n";
+        if (i % 1000 == 0) {
+            data += "# comment\n";
+        }
+    }
+    std::string name = getFileName() + ".asc";
+    writeFile(name, data);
+
+    Points::AscReader reader;
+    reader.read(name);
+    Base::FileInfo(name).deleteFile();
+
+    const auto& points = reader.getPoints().getBasicPoints();
+    ASSERT_EQ(points.size(), size);
+    for (int i = 0; i < size; i++) {
+        ASSERT_EQ(points[i], Base::Vector3f(float(i), float(-i), 0.5F));
+    }
+}
+
+TEST_F(PointsTest, TestASCIIPLYValues)
+{
+    std::string name = getFileName();
+    writeFile(
+        name,
+        "ply\nformat ascii 1.0\nelement camera 1\nproperty float view\n"
+        "element vertex 2\nproperty float x\nproperty float y\nproperty float z\n"
+        "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n"
+        "element face 1\nproperty list uchar int vertex_indices\nend_header\n"
+        "7\n1 2 3 255 0 51 255\n\n-4 5.5 +6 0 255 0 102\n3 0 1 2\n"
+    );
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    ASSERT_EQ(reader.getWidth(), 2);
+    ASSERT_TRUE(reader.hasColors());
+    const auto& points = reader.getPoints().getBasicPoints();
+    EXPECT_EQ(points[0], Base::Vector3f(1, 2, 3));
+    EXPECT_EQ(points[1], Base::Vector3f(-4, 5.5F, 6));
+    EXPECT_EQ(reader.getColors()[0], Base::Color(1, 0, 0.2F, 1));
+    EXPECT_EQ(reader.getColors()[1], Base::Color(0, 1, 0, 0.4F));
+}
+
+TEST_F(PointsTest, TestBinaryPLY)
+{
+    std::string data =
+        "ply\nformat binary_little_endian 1.0\nelement camera 2\nproperty uchar id\n"
+        "property float view\nelement vertex 3\nproperty float x\nproperty float y\n"
+        "property float z\nproperty short intensity\nproperty uchar red\nproperty uchar green\n"
+        "property uchar blue\nend_header\n";
+    for (int i = 0; i < 2; i++) {
+        append<std::uint8_t>(data, 1);
+        append<float>(data, 2.0F);
+    }
+    for (int i = 0; i < 3; i++) {
+        append<float>(data, float(i));
+        append<float>(data, -float(i));
+        append<float>(data, 0.25F);
+        append<std::int16_t>(data, std::int16_t(-100 * i));
+        append<std::uint8_t>(data, 255);
+        append<std::uint8_t>(data, 0);
+        append<std::uint8_t>(data, std::uint8_t(51 * i));
+    }
+    std::string name = getFileName();
+    writeFile(name, data);
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    ASSERT_EQ(reader.getWidth(), 3);
+    ASSERT_TRUE(reader.hasIntensities());
+    ASSERT_TRUE(reader.hasColors());
+    EXPECT_FALSE(reader.hasNormals());
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(reader.getPoints().getBasicPoints()[i], Base::Vector3f(i, -i, 0.25F));
+        EXPECT_EQ(reader.getIntensities()[i], -100.0F * float(i));
+        EXPECT_FLOAT_EQ(reader.getColors()[i].b, 0.2F * float(i));
+    }
+}
+
+TEST_F(PointsTest, TestBigEndianPLY)
+{
+    std::string data =
+        "ply\nformat binary_big_endian 1.0\nelement vertex 2\nproperty double x\n"
+        "property double y\nproperty double z\nproperty float nx\nproperty float ny\n"
+        "property float nz\nend_header\n";
+    for (int i = 0; i < 2; i++) {
+        append<double>(data, 1.5 * i, true);
+        append<double>(data, 2.0, true);
+        append<double>(data, -3.0, true);
+        append<float>(data, 0.0F, true);
+        append<float>(data, float(i), true);
+        append<float>(data, 1.0F, true);
+    }
+    std::string name = getFileName();
+    writeFile(name, data);
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    ASSERT_EQ(reader.getWidth(), 2);
+    ASSERT_TRUE(reader.hasNormals());
+    EXPECT_EQ(reader.getPoints().getBasicPoints()[1], Base::Vector3f(1.5F, 2, -3));
+    EXPECT_EQ(reader.getNormals()[1], Base::Vector3f(0, 1, 1));
+}
+
+TEST_F(PointsTest, TestTruncatedPLY)
+{
+    std::string data =
+        "ply\nformat binary_little_endian 1.0\nelement vertex 2\nproperty float x\n"
+        "property float y\nproperty float z\nend_header\n";
+    append<float>(data, 1.0F);
+    std::string name = getFileName();
+    writeFile(name, data);
+
+    Points::PlyReader reader;
+    EXPECT_THROW(reader.read(name), Base::BadFormatError);
+}
+
+TEST_F(PointsTest, TestBinaryPCD)
+{
+    std::string data =
+        "VERSION .7\nFIELDS x y z rgb\nSIZE 4 4 4 4\nTYPE F F F U\nCOUNT 1 1 1 1\n"
+        "WIDTH 2\nHEIGHT 1\nPOINTS 2\nDATA binary\n";
+    for (int i = 0; i < 2; i++) {
+        append<float>(data, float(i));
+        append<float>(data, 2.0F);
+        append<float>(data, 3.0F);
+        append<std::uint32_t>(data, i == 0 ? 0xff0000ff : 0xff00ff00);
+    }
+    std::string name = getFileName();
+    writeFile(name, data);
+
+    Points::PcdReader reader;
+    reader.read(name);
+
+    ASSERT_EQ(reader.getPoints().size(), 2);
+    ASSERT_TRUE(reader.hasColors());
+    EXPECT_EQ(reader.getPoints().getBasicPoints()[1], Base::Vector3f(1, 2, 3));
+    EXPECT_EQ(reader.getColors()[0], Base::Color(0, 0, 1, 1));
+    EXPECT_EQ(reader.getColors()[1], Base::Color(0, 1, 0, 1));
+}
+
+TEST_F(PointsTest, TestCompressedPCD)
+{
+    // the fields are stored one after another
+    std::string fields;
+    for (int j = 0; j < 4; j++) {
+        for (int i = 0; i < 3; i++) {
+            append<float>(fields, float(10 * j + i));
+        }
+    }
+    // literal runs of at most 32 bytes
+    std::string compressed;
+    for (std::size_t pos = 0; pos < fields.size(); pos += 32) {
+        std::string run = fields.substr(pos, 32);
+        compressed += char(run.size() - 1);
+        compressed += run;
+    }
+
+    std::string data =
+        "VERSION .7\nFIELDS x y z intensity\nSIZE 4 4 4 4\nTYPE F F F F\nCOUNT 1 1 1 1\n"
+        "WIDTH 3\nHEIGHT 1\nPOINTS 3\nDATA binary_compressed\n";
+    append<std::uint32_t>(data, std::uint32_t(compressed.size()));
+    append<std::uint32_t>(data, std::uint32_t(fields.size()));
+    data += compressed;
+    std::string name = getFileName();
+    writeFile(name, data);
+
+    Points::PcdReader reader;
+    reader.read(name);
+
+    ASSERT_EQ(reader.getPoints().size(), 3);
+    ASSERT_TRUE(reader.hasIntensities());
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(reader.getPoints().getBasicPoints()[i], Base::Vector3f(i, 10 + i, 20 + i));
+        EXPECT_EQ(reader.getIntensities()[i], float(30 + i));
+    }
+}
+
 // NOLINTEND(cppcoreguidelines-*,readability-*)
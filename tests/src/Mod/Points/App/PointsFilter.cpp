@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <Base/Exception.h>
+#include <Mod/Points/App/PointsFilter.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsFilterTest: public ::testing::Test
+{
+protected:
+    static constexpr int Size = 100;
+
+    void SetUp() override
+    {
+        // a plane of 100x100 points with a spacing of 0.1, slightly noisy
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> noise(-0.001F, 0.001F);
+        std::vector<Base::Vector3f> points;
+        for (int i = 0; i < Size; i++) {
+            for (int j = 0; j < Size; j++) {
+                points.emplace_back(0.1F * float(i), 0.1F * float(j), noise(gen));
+            }
+        }
+        points[10].z = std::numeric_limits<float>::quiet_NaN();
+        // outliers
+        points.emplace_back(5.0F, 5.0F, 3.0F);
+        points.emplace_back(2.0F, 8.0F, -1.0F);
+        kernel.setBasicPoints(points);
+    }
+
+    void TearDown() override
+    {}
+
+    const Points::PointKernel& getKernel() const
+    {
+        return kernel;
+    }
+
+private:
+    Points::PointKernel kernel;
+};
+
+TEST_F(PointsFilterTest, TestVoxelDownsample)
+{
+    Points::PointsFilter filter(getKernel());
+    const auto& points = getKernel().getBasicPoints();
+
+    // the voxels hold 4x4 points of the plane, the outliers have their own voxel
+    std::vector<std::size_t> kept = filter.voxelDownsample(0.399);
+    EXPECT_EQ(kept.size(), 25 * 25 + 2);
+    EXPECT_TRUE(std::is_sorted(kept.begin(), kept.end()));
+    for (std::size_t index : kept) {
+        EXPECT_FALSE(std::isnan(points[index].z));
+    }
+
+    // small voxels keep all points
+    kept = filter.voxelDownsample(0.01);
+    EXPECT_EQ(kept.size(), points.size() - 1);
+
+    EXPECT_THROW(filter.voxelDownsample(0.0), Base::ValueError);
+    EXPECT_THROW(filter.voxelDownsample(1.0e-8), Base::ValueError);
+}
+
+TEST_F(PointsFilterTest, TestRadiusFilter)
+{
+    Points::PointsFilter filter(getKernel());
+    const auto& points = getKernel().getBasicPoints();
+
+    std::vector<std::size_t> kept = filter.radiusFilter(0.15, 2);
+    EXPECT_EQ(kept.size(), points.size() - 3);
+    EXPECT_EQ(kept.back(), Size * Size - 1);
+
+    // the corners of the plane and the neighbours of the invalid point on the border only have
+    // two neighbours within the radius
+    kept = filter.radiusFilter(0.105, 3);
+    EXPECT_EQ(kept.size(), Size * Size - 7);
+
+    EXPECT_THROW(filter.radiusFilter(-1.0, 2), Base::ValueError);
+}
+
+TEST_F(PointsFilterTest, TestStatisticalFilter)
+{
+    Points::PointsFilter filter(getKernel());
+    const auto& points = getKernel().getBasicPoints();
+
+    std::vector<std::size_t> kept = filter.statisticalFilter(8, 3.0);
+    EXPECT_EQ(kept.size(), points.size() - 3);
+    EXPECT_EQ(kept.back(), Size * Size - 1);
+
+    EXPECT_THROW(filter.statisticalFilter(0, 2.0), Base::ValueError);
+}
+
+TEST_F(PointsFilterTest, TestEstimateNormals)
+{
+    Points::PointsFilter filter(getKernel());
+    const auto& points = getKernel().getBasicPoints();
+
+    std::vector<Base::Vector3f> normals = filter.estimateNormals(10, Base::Vector3f(5, 5, -10));
+    ASSERT_EQ(normals.size(), points.size());
+    for (int i = 0; i < Size * Size; i++) {
+        if (i == 10) {
+            EXPECT_EQ(normals[i], Base::Vector3f());
+        }
+        else {
+            EXPECT_NEAR(normals[i].z, -1.0F, 1.0e-3F);
+        }
+    }
+
+    normals = filter.estimateNormals(10, Base::Vector3f(5, 5, 10));
+    EXPECT_NEAR(normals[0].z, 1.0F, 1.0e-3F);
+
+    EXPECT_THROW(filter.estimateNormals(2, Base::Vector3f()), Base::ValueError);
+}
+
+TEST_F(PointsFilterTest, TestSelect)
+{
+    std::vector<int> values {10, 11, 12, 13};
+    std::vector<int> selected = Points::PointsFilter::select(values, {1, 3});
+    EXPECT_EQ(selected, std::vector<int>({11, 13}));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)